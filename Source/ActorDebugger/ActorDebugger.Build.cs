@@ -39,11 +39,21 @@ public class ActorDebugger : ModuleRules
 				"Slate",
 				"SlateCore",
 				"InputCore",
+				"Json",
+				"Sockets",
+				"Networking",
+				"Projects",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
 		
 		
+		// watchpoints pause the play session through the editor
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("UnrealEd");
+		}
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
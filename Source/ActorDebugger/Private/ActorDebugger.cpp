@@ -1,18 +1,37 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ActorDebugger.h"
+#include "ActorDebuggerSchemaCache.h"
+#include "ActorDebuggerCallTracer.h"
+#include "ActorDebuggerDump.h"
+#include "ActorDebuggerServer.h"
+#include "ActorDebuggerRemote.h"
 
 #define LOCTEXT_NAMESPACE "FActorDebuggerModule"
 
+DEFINE_LOG_CATEGORY(LogActorDebugger);
+
 void FActorDebuggerModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+	FActorDebuggerSchemaCache::Get().RegisterDelegates();
 }
 
 void FActorDebuggerModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FActorDebuggerSchemaCache::Get().UnregisterDelegates();
+
+	// the hooked functions must get their pointers back before this module's code is unloaded
+	FActorDebuggerCallTracer::Get().Stop();
+
+	// dumps still running are closed so what they buffered reaches their files
+	FActorDebuggerDumps::Get().StopAll();
+
+	// the server's thread runs this module's code, it must be stopped before the module is unloaded
+	FActorDebuggerServer::Get().Close();
+	FActorDebuggerRemote::Get().Disconnect();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,217 @@
+#include "ActorDebuggerCallTimelineWidget.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SBox.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Views/STableRow.h"
+
+namespace ActorDebuggerCallTimelineWidget
+{
+    static const FName FrameColumnId(TEXT("Frame"));
+    static const FName TimeColumnId(TEXT("Time"));
+    static const FName CallColumnId(TEXT("Call"));
+    static const FName DurationColumnId(TEXT("Duration"));
+
+    /* Calls that took longer than this are shown in orange */
+    static constexpr double SlowCallMicroseconds = 1000.0;
+}
+
+using namespace ActorDebuggerCallTimelineWidget;
+
+/*
+* A row of the timeline, each cell formats the call when the row is generated
+*/
+class SActorDebuggerCallTimelineRow : public SMultiColumnTableRow<TSharedPtr<int32>>
+{
+public:
+    SLATE_BEGIN_ARGS(SActorDebuggerCallTimelineRow)
+    {}
+        SLATE_ARGUMENT(FActorDebuggerCallRecord, Call)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+    {
+        Call = InArgs._Call;
+
+        SMultiColumnTableRow<TSharedPtr<int32>>::Construct(FSuperRowType::FArguments().Padding(FMargin(0, 1)), OwnerTable);
+    }
+
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        const FActorDebuggerCallTracer& Tracer = FActorDebuggerCallTracer::Get();
+        const double DurationMicroseconds = FPlatformTime::ToSeconds64(Call.EndCycles - Call.StartCycles) * 1000000.0;
+
+        if (ColumnName == FrameColumnId)
+        {
+            return SNew(STextBlock)
+                .Text(FText::FromString(FString::Printf(TEXT("%llu"), Call.Frame)))
+                .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f));
+        }
+
+        if (ColumnName == TimeColumnId)
+        {
+            return SNew(STextBlock)
+                .Text(FText::FromString(FString::Printf(TEXT("%.3f ms"), FPlatformTime::ToSeconds64(Call.StartCycles - Tracer.GetStartCycles()) * 1000.0)))
+                .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f));
+        }
+
+        if (ColumnName == CallColumnId)
+        {
+            const FString Label = FString::Printf(TEXT("%s.%s"), *Tracer.GetObjectName(Call.ObjectIndex), *Tracer.GetFunctionName(Call.FunctionIndex).ToString());
+
+            return SNew(SBox)
+                .Padding(FMargin(Call.Depth * 12.0f, 0, 0, 0))
+                [
+                    SNew(STextBlock)
+                        .Text(FText::FromString(Label))
+                        .ColorAndOpacity(FLinearColor::Yellow)
+                ];
+        }
+
+        return SNew(STextBlock)
+            .Text(FText::FromString(FString::Printf(TEXT("%.1f us"), DurationMicroseconds)))
+            .ColorAndOpacity(DurationMicroseconds >= SlowCallMicroseconds ? FLinearColor(1.0f, 0.5f, 0.0f) : FLinearColor::White);
+    }
+
+private:
+    FActorDebuggerCallRecord Call;
+};
+
+BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
+
+/*
+* Constructs the summary line with the pause and clear buttons above the list of calls
+*/
+void SActorDebuggerCallTimeline::Construct(const FArguments& InArgs)
+{
+    MaxCalls = FMath::Max(InArgs._MaxCalls, 1);
+    RefreshInterval = InArgs._RefreshInterval;
+    Calls.Reserve(MaxCalls);
+
+    CallItems.Reserve(MaxCalls);
+    for (int32 Index = 0; Index < MaxCalls; ++Index)
+    {
+        CallItems.Add(MakeShared<int32>(Index));
+    }
+
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 2))
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .VAlign(VAlign_Center)
+                [
+                    SNew(STextBlock)
+                        .Text(this, &SActorDebuggerCallTimeline::GetSummaryText)
+                        .ColorAndOpacity(FLinearColor::White)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                        .Text_Lambda([this] { return FText::FromString(bPaused ? "Resume" : "Pause"); })
+                        .ToolTipText(FText::FromString("Freezes the list so it can be read, calls made while it is paused aren't listed"))
+                        .OnClicked_Lambda([this] { bPaused = !bPaused; return FReply::Handled(); })
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(FMargin(4, 0, 0, 0))
+                [
+                    SNew(SButton)
+                        .Text(FText::FromString("Clear"))
+                        .OnClicked_Lambda([this] { Reset(); return FReply::Handled(); })
+                ]
+            ]
+            + SVerticalBox::Slot()
+            .FillHeight(1.0f)
+            [
+                SAssignNew(CallsView, SListView<FCallPtr>)
+                    .ListItemsSource(&VisibleCalls)
+                    .SelectionMode(ESelectionMode::None)
+                    .OnGenerateRow(this, &SActorDebuggerCallTimeline::HandleGenerateRow)
+                    .HeaderRow(SNew(SHeaderRow)
+                        + SHeaderRow::Column(FrameColumnId)
+                        .DefaultLabel(FText::FromString("Frame"))
+                        .FillWidth(0.1f)
+                        + SHeaderRow::Column(TimeColumnId)
+                        .DefaultLabel(FText::FromString("Time"))
+                        .FillWidth(0.15f)
+                        + SHeaderRow::Column(CallColumnId)
+                        .DefaultLabel(FText::FromString("Call"))
+                        .FillWidth(0.6f)
+                        + SHeaderRow::Column(DurationColumnId)
+                        .DefaultLabel(FText::FromString("Duration"))
+                        .FillWidth(0.15f))
+            ]
+    ];
+}
+
+/*
+* Only the last MaxCalls of a large batch are copied. The list is rebuilt at most once per refresh interval, rows
+* are regenerated rather than updated since every row may now show a different call
+*/
+void SActorDebuggerCallTimeline::AddCalls(TConstArrayView<FActorDebuggerCallRecord> NewCalls)
+{
+    const double CurrentTime = FPlatformTime::Seconds();
+
+    NumCallsSinceRate += NewCalls.Num();
+    if (CurrentTime - LastRateTime >= 1.0)
+    {
+        CallsPerSecond = LastRateTime > 0.0 ? NumCallsSinceRate / (CurrentTime - LastRateTime) : 0.0;
+        NumCallsSinceRate = 0;
+        LastRateTime = CurrentTime;
+    }
+
+    if (bPaused == false && NewCalls.Num() > 0)
+    {
+        const int32 NumToAdd = FMath::Min(NewCalls.Num(), MaxCalls);
+        const int32 NumToRemove = FMath::Max(Calls.Num() + NumToAdd - MaxCalls, 0);
+        Calls.RemoveAt(0, NumToRemove, EAllowShrinking::No);
+        Calls.Append(NewCalls.GetData() + NewCalls.Num() - NumToAdd, NumToAdd);
+        bCallsChanged = true;
+    }
+
+    if (bCallsChanged && CurrentTime - LastRefreshTime >= RefreshInterval)
+    {
+        LastRefreshTime = CurrentTime;
+        RebuildRows();
+        CallsView->ScrollToBottom();
+    }
+}
+
+void SActorDebuggerCallTimeline::Reset()
+{
+    Calls.Reset();
+    NumCallsSinceRate = 0;
+    LastRateTime = 0.0;
+    CallsPerSecond = 0.0;
+    RebuildRows();
+}
+
+void SActorDebuggerCallTimeline::RebuildRows()
+{
+    bCallsChanged = false;
+    VisibleCalls.Reset(Calls.Num());
+    VisibleCalls.Append(CallItems.GetData(), Calls.Num());
+    CallsView->RebuildList();
+}
+
+TSharedRef<ITableRow> SActorDebuggerCallTimeline::HandleGenerateRow(FCallPtr Call, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(SActorDebuggerCallTimelineRow, OwnerTable)
+        .Call(Calls.IsValidIndex(*Call) ? Calls[*Call] : FActorDebuggerCallRecord());
+}
+
+FText SActorDebuggerCallTimeline::GetSummaryText() const
+{
+    const FActorDebuggerCallTracer& Tracer = FActorDebuggerCallTracer::Get();
+    return FText::FromString(FString::Printf(TEXT("%s%.0f calls/s | %d functions of %d objects | %llu dropped"),
+        Tracer.IsTracing() ? TEXT("") : TEXT("Stopped | "), CallsPerSecond, Tracer.GetNumFunctions(), Tracer.GetNumObjects(), Tracer.GetNumDropped()));
+}
+
+END_SLATE_FUNCTION_BUILD_OPTIMIZATION
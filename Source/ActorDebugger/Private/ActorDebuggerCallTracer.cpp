@@ -0,0 +1,346 @@
+#include "ActorDebuggerCallTracer.h"
+#include "ActorDebugger.h"
+#include "ActorDebuggerStats.h"
+#include "UObject/Class.h"
+#include "UObject/Stack.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/Package.h"
+#include "Templates/IntegerSequence.h"
+#include "Algo/StableSort.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/PackageName.h"
+#include "Interfaces/IPluginManager.h"
+#include "Interfaces/IProjectManager.h"
+#include "ProjectDescriptor.h"
+
+static TAutoConsoleVariable<bool> CVarActorDebuggerTraceEngineFunctions(
+    TEXT("ActorDebugger.TraceEngineFunctions"),
+    false,
+    TEXT("Whether an Actor Debugger call trace also hooks the functions declared on classes of the engine and its plugins, such as ReceiveTick, which puts the hooks in front of those calls on every object"));
+
+namespace ActorDebuggerCallTracer
+{
+    static const FString EmptyName;
+
+    /* Names of the modules of the project and of the plugins it brings along, every other module is the engine's */
+    static TSet<FName> GetProjectModules()
+    {
+        TSet<FName> Modules;
+        if (const FProjectDescriptor* Project = IProjectManager::Get().GetCurrentProject())
+        {
+            for (const FModuleDescriptor& Module : Project->Modules)
+            {
+                Modules.Add(Module.Name);
+            }
+        }
+
+        for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins())
+        {
+            if (Plugin->GetLoadedFrom() == EPluginLoadedFrom::Project)
+            {
+                for (const FModuleDescriptor& Module : Plugin->GetDescriptor().Modules)
+                {
+                    Modules.Add(Module.Name);
+                }
+            }
+        }
+        return Modules;
+    }
+
+    /* Functions declared on classes of the engine and its plugins are shared by objects all over the game. Native
+     * classes are told apart by their module, Blueprints by the plugin or directory their package is mounted from */
+    static bool IsEngineFunction(const UFunction* Function, const TSet<FName>& ProjectModules)
+    {
+        const FString PackageName = Function->GetPackage()->GetName();
+        if (FPackageName::IsScriptPackage(PackageName))
+        {
+            return ProjectModules.Contains(FPackageName::GetShortFName(PackageName)) == false;
+        }
+
+        if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPluginFromPath(PackageName))
+        {
+            return Plugin->GetLoadedFrom() == EPluginLoadedFrom::Engine;
+        }
+        return PackageName.StartsWith(TEXT("/Engine/"));
+    }
+}
+
+using namespace ActorDebuggerCallTracer;
+
+template <int32 Slot>
+void FActorDebuggerCallTracer::TraceThunk(UObject* Context, FFrame& Stack, RESULT_DECL)
+{
+    Get().TraceCall(Slot, Context, Stack, RESULT_PARAM);
+}
+
+/*
+* The hooks are instantiated once per slot, a slot is the only way a hook knows which function it replaced
+*/
+const FNativeFuncPtr* FActorDebuggerCallTracer::GetThunks()
+{
+    struct FThunks
+    {
+        FNativeFuncPtr Pointers[MaxFunctions];
+    };
+
+    static const FThunks Thunks = []<int32... Slots>(TIntegerSequence<int32, Slots...>)
+    {
+        return FThunks { { &TraceThunk<Slots>... } };
+    }(TMakeIntegerSequence<int32, MaxFunctions>());
+
+    return Thunks.Pointers;
+}
+
+FActorDebuggerCallTracer& FActorDebuggerCallTracer::Get()
+{
+    static FActorDebuggerCallTracer Instance;
+    return Instance;
+}
+
+/*
+* Hooks every function of the classes of the object and its subobjects. Functions inherited from classes of the engine
+* and its plugins are left alone unless ActorDebugger.TraceEngineFunctions is set, hooking them would rewrite functions
+* objects all over the game call through
+*/
+bool FActorDebuggerCallTracer::Start(UObject* InObject)
+{
+    check(IsInGameThread());
+    Stop();
+
+    if (IsValid(InObject) == false)
+    {
+        return false;
+    }
+
+    if (Records.Num() == 0)
+    {
+        Records.SetNumUninitialized(MaxCalls);
+    }
+
+    // records of the previous trace name functions and objects that are about to be replaced
+    Tail = Head;
+
+    TArray<UObject*> Subobjects;
+    GetObjectsWithOuter(InObject, Subobjects, true);
+
+    Subobjects.Insert(InObject, 0);
+
+    TracedObjects.Reset();
+    ObjectNames.Reset();
+    TSet<UClass*> Classes;
+    for (UObject* TracedObject : Subobjects)
+    {
+        TracedObjects.Add(FObjectKey(TracedObject), ObjectNames.Add(TracedObject->GetName()));
+        Classes.Add(TracedObject->GetClass());
+    }
+
+    const FNativeFuncPtr* Thunks = GetThunks();
+
+    const bool bTraceEngineFunctions = CVarActorDebuggerTraceEngineFunctions.GetValueOnGameThread();
+    const TSet<FName> ProjectModules = bTraceEngineFunctions ? TSet<FName>() : GetProjectModules();
+
+    TSet<UFunction*> HookedFunctions;
+    HookedSlots.Reset();
+    int32 NumSkipped = 0;
+    for (UClass* Class : Classes)
+    {
+        for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::IncludeSuper); It; ++It)
+        {
+            UFunction* Function = *It;
+
+            // delegate signatures are never invoked, they only describe parameters
+            if (Function->HasAnyFunctionFlags(FUNC_Delegate) || Function->GetNativeFunc() == nullptr || HookedFunctions.Contains(Function))
+            {
+                continue;
+            }
+
+            if (bTraceEngineFunctions == false && IsEngineFunction(Function, ProjectModules))
+            {
+                continue;
+            }
+
+            int32 Slot = INDEX_NONE;
+            if (const int32* FunctionSlot = FunctionSlots.Find(FObjectKey(Function)))
+            {
+                Slot = *FunctionSlot;
+            }
+            else if (NumSlots < MaxFunctions)
+            {
+                Slot = NumSlots++;
+                Functions[Slot].Function = Function;
+                FunctionSlots.Add(FObjectKey(Function), Slot);
+                FunctionNames.Add(Function->GetFName());
+            }
+            else
+            {
+                ++NumSkipped;
+                continue;
+            }
+
+            // the original is only stored when the function isn't hooked, and it is the same function's, so a call
+            // still inside the hook from an earlier trace finishes through either pointer
+            const FNativeFuncPtr OriginalFunc = Function->GetNativeFunc();
+            if (OriginalFunc != Functions[Slot].OriginalFunc.load(std::memory_order_relaxed))
+            {
+                Functions[Slot].OriginalFunc.store(OriginalFunc, std::memory_order_release);
+            }
+            HookedFunctions.Add(Function);
+            HookedSlots.Add(Slot);
+
+            Function->SetNativeFunc(Thunks[Slot]);
+        }
+    }
+
+    if (NumSkipped > 0)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %d functions of %s aren't traced, the process hooks at most %d"), NumSkipped, *InObject->GetName(), MaxFunctions);
+    }
+
+    Object = InObject;
+    ++TraceId;
+    NumDropped = 0;
+    StartCycles = FPlatformTime::Cycles64();
+
+    PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddRaw(this, &FActorDebuggerCallTracer::HandlePreGarbageCollect);
+    ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddRaw(this, &FActorDebuggerCallTracer::HandleObjectsReinstanced);
+
+    bTracing = true;
+
+    UE_LOG(LogActorDebugger, Display, TEXT("Actor Debugger: tracing %d functions on %s and %d subobjects"), HookedSlots.Num(), *InObject->GetName(), Subobjects.Num() - 1);
+    return true;
+}
+
+/*
+* Puts back the function pointers. A call already inside a hook finishes through the original function it read on
+* entry, the slots keep their functions and originals for the next trace that hooks them
+*/
+void FActorDebuggerCallTracer::Stop()
+{
+    check(IsInGameThread());
+    if (IsTracing() == false)
+    {
+        return;
+    }
+
+    bTracing = false;
+
+    const FNativeFuncPtr* Thunks = GetThunks();
+    for (const int32 Slot : HookedSlots)
+    {
+        // a function whose pointer was replaced since, e.g. by a reload, is left alone
+        UFunction* Function = Functions[Slot].Function.Get();
+        if (Function && Function->GetNativeFunc() == Thunks[Slot])
+        {
+            Function->SetNativeFunc(Functions[Slot].OriginalFunc.load(std::memory_order_relaxed));
+        }
+    }
+    HookedSlots.Reset();
+
+    FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+    FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+    PreGarbageCollectHandle.Reset();
+    ObjectsReinstancedHandle.Reset();
+}
+
+/*
+* The hot path. Calls on other threads and on objects that aren't traced cost the check and the lookup, recorded calls
+* also cost two timestamps and a store into the ring buffer. Only the game thread touches the traced objects, which
+* Start rebuilds on the game thread as well
+*/
+void FActorDebuggerCallTracer::TraceCall(int32 Slot, UObject* Context, FFrame& Stack, RESULT_DECL)
+{
+    const FNativeFuncPtr OriginalFunc = Functions[Slot].OriginalFunc.load(std::memory_order_acquire);
+
+    const int32* ObjectIndex = IsInGameThread() && bTracing ? TracedObjects.Find(FObjectKey(Context)) : nullptr;
+    if (ObjectIndex == nullptr)
+    {
+        (*OriginalFunc)(Context, Stack, RESULT_PARAM);
+        return;
+    }
+
+    FActorDebuggerCallRecord Record;
+    Record.FunctionIndex = Slot;
+    Record.ObjectIndex = *ObjectIndex;
+    Record.Frame = GFrameCounter;
+    Record.Depth = CallDepth++;
+    Record.StartCycles = FPlatformTime::Cycles64();
+
+    (*OriginalFunc)(Context, Stack, RESULT_PARAM);
+
+    Record.EndCycles = FPlatformTime::Cycles64();
+    --CallDepth;
+
+    if (Head - Tail >= MaxCalls)
+    {
+        ++NumDropped;
+        return;
+    }
+
+    Records[Head & (MaxCalls - 1)] = Record;
+    ++Head;
+}
+
+/*
+* Calls are written when they return, so callees come before callers until the records are sorted
+*/
+int32 FActorDebuggerCallTracer::Collect(TArray<FActorDebuggerCallRecord>& OutRecords)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_CollectCalls);
+    check(IsInGameThread());
+
+    const int32 FirstRecord = OutRecords.Num();
+    for (uint64 Index = Tail; Index < Head; ++Index)
+    {
+        OutRecords.Add(Records[Index & (MaxCalls - 1)]);
+    }
+    Tail = Head;
+
+    const int32 NumCollected = OutRecords.Num() - FirstRecord;
+    Algo::StableSortBy(MakeArrayView(OutRecords.GetData() + FirstRecord, NumCollected), &FActorDebuggerCallRecord::StartCycles);
+
+    INC_DWORD_STAT_BY(STAT_ActorDebugger_TracedCalls, NumCollected);
+    return NumCollected;
+}
+
+FName FActorDebuggerCallTracer::GetFunctionName(int32 Index) const
+{
+    return FunctionNames.IsValidIndex(Index) ? FunctionNames[Index] : NAME_None;
+}
+
+const FString& FActorDebuggerCallTracer::GetObjectName(int32 Index) const
+{
+    return ObjectNames.IsValidIndex(Index) ? ObjectNames[Index] : EmptyName;
+}
+
+SIZE_T FActorDebuggerCallTracer::GetAllocatedSize() const
+{
+    return TracedObjects.GetAllocatedSize() + FunctionSlots.GetAllocatedSize() + HookedSlots.GetAllocatedSize() + FunctionNames.GetAllocatedSize() + ObjectNames.GetAllocatedSize() + Records.GetAllocatedSize();
+}
+
+/*
+* A destroyed object is garbage by now, its functions are unhooked before the collection can take its class with it
+*/
+void FActorDebuggerCallTracer::HandlePreGarbageCollect()
+{
+    if (Object.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Display, TEXT("Actor Debugger: the traced object was destroyed, the call trace stopped"));
+        Stop();
+    }
+}
+
+/*
+* The old class's functions are about to be discarded, the trace is stopped rather than moved to the new ones
+*/
+void FActorDebuggerCallTracer::HandleObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap)
+{
+    for (const TPair<FObjectKey, int32>& TracedObject : TracedObjects)
+    {
+        if (OldToNewInstanceMap.Contains(TracedObject.Key.ResolveObjectPtrEvenIfGarbage()))
+        {
+            UE_LOG(LogActorDebugger, Display, TEXT("Actor Debugger: the traced object was reinstanced, the call trace stopped"));
+            Stop();
+            return;
+        }
+    }
+}
@@ -0,0 +1,1002 @@
+#include "ActorDebuggerCapture.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerValueHash.h"
+#include "ActorDebuggerStats.h"
+#include "ActorDebugger.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/UnrealType.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/Package.h"
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerCaptureKeyframeInterval(
+    TEXT("ActorDebugger.CaptureKeyframeInterval"),
+    60,
+    TEXT("How many frames apart the Actor Debugger writes keyframes to a capture. Seeking replays at most this many frames"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerCaptureDepth(
+    TEXT("ActorDebugger.CaptureDepth"),
+    2,
+    TEXT("How many levels of referenced objects the Actor Debugger captures along with the inspected object"));
+
+namespace ActorDebuggerCapture
+{
+    /* Magic, version, keyframe interval and a reserved word */
+    static constexpr int64 HeaderSize = 16;
+
+    /* Record type, three bytes of padding and the payload size */
+    static constexpr int64 RecordHeaderSize = 8;
+
+    /* Index record offset, trailer magic and version */
+    static constexpr int64 TrailerSize = 16;
+}
+
+FActorDebuggerCaptureWriter::~FActorDebuggerCaptureWriter()
+{
+    Close();
+}
+
+FString FActorDebuggerCaptureWriter::GetDefaultFilename()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ActorDebugger"), TEXT("Captures"), FString::Printf(TEXT("Capture-%s.adcap"), *FDateTime::Now().ToString()));
+}
+
+bool FActorDebuggerCaptureWriter::Open(const FString& Filename)
+{
+    Close();
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+    Writer.Reset(IFileManager::Get().CreateFileWriter(*Filename));
+
+    if (Writer.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: could not create capture file %s"), *Filename);
+        return false;
+    }
+
+    KeyframeInterval = FMath::Max(CVarActorDebuggerCaptureKeyframeInterval.GetValueOnGameThread(), 1);
+
+    uint32 Magic = ActorDebuggerCapture::Magic;
+    uint32 Version = ActorDebuggerCapture::Version;
+    uint32 Interval = KeyframeInterval;
+    uint32 Reserved = 0;
+    *Writer << Magic << Version << Interval << Reserved;
+
+    return true;
+}
+
+/*
+* The index lets the reader open the capture without walking it. If this is never called the capture is still
+* readable, just slower to open
+*/
+void FActorDebuggerCaptureWriter::Close()
+{
+    if (Writer.IsValid() == false)
+    {
+        return;
+    }
+
+    Payload.Reset();
+    FMemoryWriter Ar(Payload);
+
+    int32 NumSchemas = SchemaOffsets.Num();
+    Ar << NumSchemas;
+    for (int64& Offset : SchemaOffsets)
+    {
+        Ar << Offset;
+    }
+
+    int32 NumObjects = ObjectOffsets.Num();
+    Ar << NumObjects;
+    for (int64& Offset : ObjectOffsets)
+    {
+        Ar << Offset;
+    }
+
+    int32 NumFrames = FrameOffsets.Num();
+    Ar << NumFrames;
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        uint8 bKeyframe = FrameIsKeyframe[Frame] ? 1 : 0;
+        Ar << FrameOffsets[Frame] << FrameTimes[Frame] << bKeyframe;
+    }
+
+    int64 IndexOffset = WriteRecord(ActorDebuggerCapture::ERecordType::Index, Payload);
+    uint32 TrailerMagic = ActorDebuggerCapture::TrailerMagic;
+    uint32 Version = ActorDebuggerCapture::Version;
+    *Writer << IndexOffset << TrailerMagic << Version;
+
+    Writer->Close();
+    Writer.Reset();
+
+    Objects.Reset();
+    ObjectIds.Reset();
+    SchemaIds.Reset();
+    SchemaOffsets.Reset();
+    ObjectOffsets.Reset();
+    FrameOffsets.Reset();
+    FrameTimes.Reset();
+    FrameIsKeyframe.Reset();
+}
+
+int64 FActorDebuggerCaptureWriter::GetFileSize() const
+{
+    return Writer.IsValid() ? Writer->Tell() : 0;
+}
+
+void FActorDebuggerCaptureWriter::AddObjectGraph(UObject* Root)
+{
+    AddObjectGraph(Root, FMath::Max(CVarActorDebuggerCaptureDepth.GetValueOnGameThread(), 0));
+}
+
+/*
+* Follows the same references the tree does, object properties and arrays of them, and stops at the same objects:
+* actors and assets are not watched unless they are the root
+*/
+void FActorDebuggerCaptureWriter::AddObjectGraph(UObject* Object, int32 RemainingDepth)
+{
+    if (IsValid(Object) == false || ObjectIds.Contains(Object))
+    {
+        return;
+    }
+
+    const int32 ObjectId = AddObject(Object);
+    if (ObjectId == INDEX_NONE || RemainingDepth == 0)
+    {
+        return;
+    }
+
+    TArray<UObject*, TInlineAllocator<16>> References;
+
+    for (const FWatchedProperty& Watched : Objects[ObjectId].Properties)
+    {
+        const uint8* ValuePtr = Watched.Property->ContainerPtrToValuePtr<uint8>(Object);
+
+        if (Watched.Encoding == EActorDebuggerCaptureEncoding::ObjectRef)
+        {
+            References.Add(CastFieldChecked<FObjectPropertyBase>(Watched.Property)->GetObjectPropertyValue(ValuePtr));
+        }
+        else if (Watched.Encoding == EActorDebuggerCaptureEncoding::ObjectRefArray)
+        {
+            const FArrayProperty* ArrayProperty = CastFieldChecked<FArrayProperty>(Watched.Property);
+            const FObjectPropertyBase* Inner = CastFieldChecked<FObjectPropertyBase>(ArrayProperty->Inner);
+            FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+
+            for (int32 Index = 0; Index < Helper.Num(); ++Index)
+            {
+                References.Add(Inner->GetObjectPropertyValue(Helper.GetRawPtr(Index)));
+            }
+        }
+    }
+
+    for (UObject* Reference : References)
+    {
+        if (IsValid(Reference) && FActorDebuggerInspection::IsUObjectOfInterest(Reference))
+        {
+            AddObjectGraph(Reference, RemainingDepth - 1);
+        }
+    }
+}
+
+/*
+* Writes the object's schema if its class has not been seen yet, then the object record. Must be written before
+* any frame refers to the object
+*/
+int32 FActorDebuggerCaptureWriter::AddObject(UObject* Object)
+{
+    FActorDebuggerClassSchemaPtr Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(Object->GetClass());
+    if (Writer.IsValid() == false || Schema.IsValid() == false)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 ObjectId = Objects.Num();
+    int32 SchemaId = FindOrWriteSchema(Object->GetClass(), *Schema);
+
+    FWatchedObject& Watched = Objects.AddDefaulted_GetRef();
+    Watched.Object = Object;
+    Watched.SchemaId = SchemaId;
+    Watched.Properties.Reserve(Schema->Entries.Num());
+
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+    {
+        FWatchedProperty& Property = Watched.Properties.AddDefaulted_GetRef();
+        Property.Property = Entry.Property;
+        Property.Encoding = ChooseEncoding(Entry.Property);
+    }
+
+    ObjectIds.Add(Object, ObjectId);
+
+    TArray<uint8> ObjectPayload;
+    FMemoryWriter Ar(ObjectPayload);
+    FString Name = Object->GetName();
+    FString PathName = Object->GetPathName();
+    Ar << ObjectId << SchemaId << Name << PathName;
+
+    ObjectOffsets.Add(WriteRecord(ActorDebuggerCapture::ERecordType::Object, ObjectPayload));
+
+    return ObjectId;
+}
+
+int32 FActorDebuggerCaptureWriter::FindOrWriteSchema(const UClass* Class, const FActorDebuggerClassSchema& Schema)
+{
+    if (const int32* ExistingId = SchemaIds.Find(Class))
+    {
+        return *ExistingId;
+    }
+
+    int32 SchemaId = SchemaOffsets.Num();
+    SchemaIds.Add(Class, SchemaId);
+
+    TArray<uint8> SchemaPayload;
+    FMemoryWriter Ar(SchemaPayload);
+    FString ClassPath = Class->GetPathName();
+    int32 NumProperties = Schema.Entries.Num();
+    Ar << SchemaId << ClassPath << NumProperties;
+
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema.Entries)
+    {
+        FString Name = Entry.Name.ToString();
+        FString CPPType = Entry.Property->GetCPPType();
+        uint8 Encoding = static_cast<uint8>(ChooseEncoding(Entry.Property));
+        int32 ElementSize = Entry.ElementSize;
+        int32 ArrayDim = Entry.ArrayDim;
+        Ar << Name << CPPType << Encoding << ElementSize << ArrayDim;
+    }
+
+    SchemaOffsets.Add(WriteRecord(ActorDebuggerCapture::ERecordType::Schema, SchemaPayload));
+
+    return SchemaId;
+}
+
+/*
+* Object references are kept apart from the other values so that a replay can point them at the replay objects
+* rather than at whatever the original paths resolve to
+*/
+EActorDebuggerCaptureEncoding FActorDebuggerCaptureWriter::ChooseEncoding(const FProperty* Property)
+{
+    if (Property->IsA<FObjectProperty>())
+    {
+        return Property->ArrayDim == 1 ? EActorDebuggerCaptureEncoding::ObjectRef : EActorDebuggerCaptureEncoding::None;
+    }
+
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property); ArrayProperty && ArrayProperty->Inner->IsA<FObjectProperty>())
+    {
+        return EActorDebuggerCaptureEncoding::ObjectRefArray;
+    }
+
+    // bools may be bitfields and other object references are pointers, neither can be copied
+    if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData) && Property->IsA<FBoolProperty>() == false && Property->IsA<FObjectPropertyBase>() == false)
+    {
+        return EActorDebuggerCaptureEncoding::Raw;
+    }
+
+    return Property->ArrayDim == 1 ? EActorDebuggerCaptureEncoding::Text : EActorDebuggerCaptureEncoding::None;
+}
+
+/*
+* Every value is hashed and only the ones whose hash changed are encoded, so a frame where nothing changed costs a
+* hash per property and a few bytes of file
+*/
+void FActorDebuggerCaptureWriter::CaptureFrame(double Time)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_CaptureFrame);
+
+    if (Writer.IsValid() == false)
+    {
+        return;
+    }
+
+    int32 FrameIndex = FrameOffsets.Num();
+    uint8 bKeyframe = FrameIndex % KeyframeInterval == 0 ? 1 : 0;
+
+    Payload.Reset();
+    FMemoryWriter Ar(Payload);
+    Ar << FrameIndex << Time << bKeyframe;
+
+    for (int32 ObjectId = 0; ObjectId < Objects.Num(); ++ObjectId)
+    {
+        FWatchedObject& Watched = Objects[ObjectId];
+        UObject* Object = Watched.Object.Get();
+
+        // destroyed objects keep the last values they had
+        if (IsValid(Object) == false)
+        {
+            continue;
+        }
+
+        const bool bWriteAll = bKeyframe || Watched.bWriteAll;
+        Watched.bWriteAll = false;
+
+        for (int32 PropertyIndex = 0; PropertyIndex < Watched.Properties.Num(); ++PropertyIndex)
+        {
+            FWatchedProperty& Property = Watched.Properties[PropertyIndex];
+            if (Property.Encoding == EActorDebuggerCaptureEncoding::None)
+            {
+                continue;
+            }
+
+            const uint8* ValuePtr = Property.Property->ContainerPtrToValuePtr<uint8>(Object);
+            const uint64 Hash = ActorDebugger::HashPropertyValue(Property.Property, ValuePtr);
+
+            if (bWriteAll == false && Hash == Property.LastHash)
+            {
+                continue;
+            }
+
+            Property.LastHash = Hash;
+            EncodeValue(Property.Property, Property.Encoding, ValuePtr, Object, ValueBytes, [this](UObject* Referenced)
+            {
+                const int32* ReferencedId = ObjectIds.Find(Referenced);
+                return ReferencedId ? *ReferencedId : INDEX_NONE;
+            });
+
+            int32 Id = ObjectId;
+            int32 Index = PropertyIndex;
+            int32 NumBytes = ValueBytes.Num();
+            Ar << Id << Index << NumBytes;
+            Ar.Serialize(ValueBytes.GetData(), NumBytes);
+        }
+    }
+
+    FrameOffsets.Add(WriteRecord(ActorDebuggerCapture::ERecordType::Frame, Payload));
+    FrameTimes.Add(Time);
+    FrameIsKeyframe.Add(bKeyframe != 0);
+}
+
+void FActorDebuggerCaptureWriter::EncodeValue(const FProperty* Property, EActorDebuggerCaptureEncoding Encoding, const uint8* ValuePtr, UObject* Owner, TArray<uint8>& OutBytes, TFunctionRef<int32(UObject*)> FindObjectId)
+{
+    OutBytes.Reset();
+
+    switch (Encoding)
+    {
+    case EActorDebuggerCaptureEncoding::Raw:
+        OutBytes.Append(ValuePtr, Property->ElementSize * Property->ArrayDim);
+        break;
+
+    case EActorDebuggerCaptureEncoding::ObjectRef:
+    {
+        FMemoryWriter Ar(OutBytes);
+        EncodeObjectRef(CastFieldChecked<FObjectPropertyBase>(Property)->GetObjectPropertyValue(ValuePtr), Ar, FindObjectId);
+        break;
+    }
+
+    case EActorDebuggerCaptureEncoding::ObjectRefArray:
+    {
+        const FArrayProperty* ArrayProperty = CastFieldChecked<FArrayProperty>(Property);
+        const FObjectPropertyBase* Inner = CastFieldChecked<FObjectPropertyBase>(ArrayProperty->Inner);
+        FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+
+        FMemoryWriter Ar(OutBytes);
+        int32 Num = Helper.Num();
+        Ar << Num;
+
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            EncodeObjectRef(Inner->GetObjectPropertyValue(Helper.GetRawPtr(Index)), Ar, FindObjectId);
+        }
+        break;
+    }
+
+    case EActorDebuggerCaptureEncoding::Text:
+    {
+        FString Text;
+        Property->ExportText_Direct(Text, ValuePtr, ValuePtr, Owner, PPF_None);
+
+        FTCHARToUTF8 Converter(*Text);
+        OutBytes.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+void FActorDebuggerCaptureWriter::EncodeObjectRef(UObject* Object, FArchive& Ar, TFunctionRef<int32(UObject*)> FindObjectId)
+{
+    int32 Id = Object ? FindObjectId(Object) : INDEX_NONE;
+    Ar << Id;
+
+    if (Id == INDEX_NONE)
+    {
+        FString PathName = Object ? Object->GetPathName() : FString();
+        Ar << PathName;
+    }
+}
+
+int64 FActorDebuggerCaptureWriter::WriteRecord(ActorDebuggerCapture::ERecordType Type, const TArray<uint8>& RecordPayload)
+{
+    const int64 Offset = Writer->Tell();
+
+    uint8 Header[ActorDebuggerCapture::RecordHeaderSize] = {};
+    Header[0] = static_cast<uint8>(Type);
+    const uint32 PayloadSize = RecordPayload.Num();
+    FMemory::Memcpy(Header + 4, &PayloadSize, sizeof(PayloadSize));
+
+    Writer->Serialize(Header, sizeof(Header));
+    Writer->Serialize(const_cast<uint8*>(RecordPayload.GetData()), RecordPayload.Num());
+
+    return Offset;
+}
+
+FActorDebuggerCaptureReader::~FActorDebuggerCaptureReader()
+{
+    Close();
+}
+
+/*
+* Mapping the file costs nothing up front, pages are only read from disk when a frame that lives in them is
+* gathered. A closed capture is opened by reading its index, which is a small fraction of the file
+*/
+bool FActorDebuggerCaptureReader::Open(const FString& Filename)
+{
+    Close();
+
+    MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Filename));
+    if (MappedFile.IsValid())
+    {
+        MappedRegion.Reset(MappedFile->MapRegion());
+    }
+
+    if (MappedRegion.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: could not map capture file %s"), *Filename);
+        Close();
+        return false;
+    }
+
+    Data = MappedRegion->GetMappedPtr();
+    Size = MappedRegion->GetMappedSize();
+
+    uint32 Header[2] = {};
+    if (Size >= ActorDebuggerCapture::HeaderSize)
+    {
+        FMemory::Memcpy(Header, Data, sizeof(Header));
+    }
+
+    if (Header[0] != ActorDebuggerCapture::Magic || Header[1] != ActorDebuggerCapture::Version)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %s is not a capture or was written by another version"), *Filename);
+        Close();
+        return false;
+    }
+
+    if (ReadIndex() == false)
+    {
+        UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: %s has no index, it was not closed. Walking its records instead"), *Filename);
+
+        if (ScanRecords() == false)
+        {
+            Close();
+            return false;
+        }
+    }
+
+    for (const FObject& Object : Objects)
+    {
+        if (Schemas.IsValidIndex(Object.SchemaId) == false)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %s refers to a schema it does not contain"), *Filename);
+            Close();
+            return false;
+        }
+    }
+
+    if (Objects.Num() == 0 || Frames.Num() == 0)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %s contains no frames"), *Filename);
+        Close();
+        return false;
+    }
+
+    Values.SetNum(Objects.Num());
+    for (int32 ObjectId = 0; ObjectId < Objects.Num(); ++ObjectId)
+    {
+        Values[ObjectId].SetNum(Schemas[Objects[ObjectId].SchemaId].Properties.Num());
+    }
+
+    return true;
+}
+
+void FActorDebuggerCaptureReader::Close()
+{
+    Objects.Reset();
+    Schemas.Reset();
+    Frames.Reset();
+    Values.Reset();
+    GatheredFrame = INDEX_NONE;
+
+    // the region has to be released before the file it maps
+    Data = nullptr;
+    Size = 0;
+    MappedRegion.Reset();
+    MappedFile.Reset();
+}
+
+bool FActorDebuggerCaptureReader::ReadIndex()
+{
+    using namespace ActorDebuggerCapture;
+
+    if (Size < HeaderSize + RecordHeaderSize + TrailerSize)
+    {
+        return false;
+    }
+
+    int64 IndexOffset = 0;
+    uint32 Trailer[2] = {};
+    FMemory::Memcpy(&IndexOffset, Data + Size - TrailerSize, sizeof(IndexOffset));
+    FMemory::Memcpy(Trailer, Data + Size - TrailerSize + sizeof(IndexOffset), sizeof(Trailer));
+
+    ERecordType Type;
+    FMemoryView Payload;
+    if (Trailer[0] != TrailerMagic || ReadRecord(IndexOffset, Type, Payload) == false || Type != ERecordType::Index)
+    {
+        return false;
+    }
+
+    FMemoryReaderView Ar(Payload);
+
+    // schemas and objects are few and small, they are read now. Frames are only read when they are gathered
+    int32 NumSchemas = 0;
+    Ar << NumSchemas;
+    for (int32 Index = 0; Index < NumSchemas && Ar.IsError() == false; ++Index)
+    {
+        int64 Offset = 0;
+        Ar << Offset;
+
+        FMemoryView SchemaPayload;
+        if (ReadRecord(Offset, Type, SchemaPayload) == false || Type != ERecordType::Schema || ReadSchema(SchemaPayload) == false)
+        {
+            return false;
+        }
+    }
+
+    int32 NumObjects = 0;
+    Ar << NumObjects;
+    for (int32 Index = 0; Index < NumObjects && Ar.IsError() == false; ++Index)
+    {
+        int64 Offset = 0;
+        Ar << Offset;
+
+        FMemoryView ObjectPayload;
+        if (ReadRecord(Offset, Type, ObjectPayload) == false || Type != ERecordType::Object || ReadObject(ObjectPayload) == false)
+        {
+            return false;
+        }
+    }
+
+    int32 NumFrames = 0;
+    Ar << NumFrames;
+    if (NumFrames < 0 || NumFrames > Payload.GetSize())
+    {
+        return false;
+    }
+
+    Frames.Reserve(NumFrames);
+    for (int32 Index = 0; Index < NumFrames && Ar.IsError() == false; ++Index)
+    {
+        FFrame& Frame = Frames.AddDefaulted_GetRef();
+        uint8 bKeyframe = 0;
+        Ar << Frame.Offset << Frame.Time << bKeyframe;
+        Frame.bKeyframe = bKeyframe != 0;
+    }
+
+    if (Ar.IsError())
+    {
+        Schemas.Reset();
+        Objects.Reset();
+        Frames.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+/*
+* Only the record headers are read for frames, so walking even a large capture touches little of the file. A
+* record cut short by a crash ends the walk
+*/
+bool FActorDebuggerCaptureReader::ScanRecords()
+{
+    using namespace ActorDebuggerCapture;
+
+    Schemas.Reset();
+    Objects.Reset();
+    Frames.Reset();
+
+    int64 Offset = HeaderSize;
+    ERecordType Type;
+    FMemoryView Payload;
+
+    while (ReadRecord(Offset, Type, Payload))
+    {
+        bool bRead = true;
+
+        switch (Type)
+        {
+        case ERecordType::Schema:
+            bRead = ReadSchema(Payload);
+            break;
+        case ERecordType::Object:
+            bRead = ReadObject(Payload);
+            break;
+        case ERecordType::Frame:
+            bRead = ReadFrameInfo(Offset, Payload);
+            break;
+        default:
+            break;
+        }
+
+        if (bRead == false || Type == ERecordType::Index)
+        {
+            break;
+        }
+
+        Offset += RecordHeaderSize + Payload.GetSize();
+    }
+
+    return true;
+}
+
+bool FActorDebuggerCaptureReader::ReadRecord(int64 Offset, ActorDebuggerCapture::ERecordType& OutType, FMemoryView& OutPayload) const
+{
+    using namespace ActorDebuggerCapture;
+
+    if (Offset < HeaderSize || Offset + RecordHeaderSize > Size)
+    {
+        return false;
+    }
+
+    uint32 PayloadSize = 0;
+    FMemory::Memcpy(&PayloadSize, Data + Offset + 4, sizeof(PayloadSize));
+
+    if (Offset + RecordHeaderSize + PayloadSize > Size)
+    {
+        return false;
+    }
+
+    OutType = static_cast<ERecordType>(Data[Offset]);
+    OutPayload = MakeMemoryView(Data + Offset + RecordHeaderSize, PayloadSize);
+    return true;
+}
+
+bool FActorDebuggerCaptureReader::ReadSchema(FMemoryView Payload)
+{
+    FMemoryReaderView Ar(Payload);
+
+    int32 SchemaId = INDEX_NONE;
+    FString ClassPath;
+    int32 NumProperties = 0;
+    Ar << SchemaId << ClassPath << NumProperties;
+
+    if (Ar.IsError() || SchemaId < 0 || SchemaId > Payload.GetSize() || NumProperties < 0 || NumProperties > Payload.GetSize())
+    {
+        return false;
+    }
+
+    if (Schemas.Num() <= SchemaId)
+    {
+        Schemas.SetNum(SchemaId + 1);
+    }
+
+    FSchema& Schema = Schemas[SchemaId];
+    Schema.ClassPath = MoveTemp(ClassPath);
+    Schema.Properties.SetNum(NumProperties);
+
+    for (FSchemaProperty& Property : Schema.Properties)
+    {
+        uint8 Encoding = 0;
+        Ar << Property.Name << Property.CPPType << Encoding << Property.ElementSize << Property.ArrayDim;
+        Property.Encoding = static_cast<EActorDebuggerCaptureEncoding>(Encoding);
+    }
+
+    return Ar.IsError() == false;
+}
+
+bool FActorDebuggerCaptureReader::ReadObject(FMemoryView Payload)
+{
+    FMemoryReaderView Ar(Payload);
+
+    int32 ObjectId = INDEX_NONE;
+    int32 SchemaId = INDEX_NONE;
+    FString Name;
+    FString PathName;
+    Ar << ObjectId << SchemaId << Name << PathName;
+
+    if (Ar.IsError() || ObjectId < 0 || ObjectId > Objects.Num() + Payload.GetSize())
+    {
+        return false;
+    }
+
+    if (Objects.Num() <= ObjectId)
+    {
+        Objects.SetNum(ObjectId + 1);
+    }
+
+    FObject& Object = Objects[ObjectId];
+    Object.SchemaId = SchemaId;
+    Object.Name = MoveTemp(Name);
+    Object.PathName = MoveTemp(PathName);
+    return true;
+}
+
+bool FActorDebuggerCaptureReader::ReadFrameInfo(int64 Offset, FMemoryView Payload)
+{
+    FMemoryReaderView Ar(Payload);
+
+    int32 FrameIndex = 0;
+    FFrame Frame;
+    uint8 bKeyframe = 0;
+    Ar << FrameIndex << Frame.Time << bKeyframe;
+
+    if (Ar.IsError() || FrameIndex != Frames.Num())
+    {
+        return false;
+    }
+
+    Frame.Offset = Offset;
+    Frame.bKeyframe = bKeyframe != 0;
+    Frames.Add(Frame);
+    return true;
+}
+
+/*
+* Looks up the captured classes and properties in the running process. A property is only replayed if its C++ type
+* and size still match, the capture may have been made with another version of the class
+*/
+UObject* FActorDebuggerCaptureReader::CreateReplayObjects()
+{
+    check(IsInGameThread());
+
+    int32 NumSkipped = 0;
+
+    for (FSchema& Schema : Schemas)
+    {
+        Schema.LiveClass = FSoftClassPath(Schema.ClassPath).TryLoadClass<UObject>();
+
+        for (FSchemaProperty& Property : Schema.Properties)
+        {
+            Property.LiveProperty = FindLiveProperty(Schema.LiveClass, Property.Name, Property.CPPType, Property.Encoding, Property.ElementSize, Property.ArrayDim);
+            NumSkipped += Property.LiveProperty ? 0 : 1;
+        }
+    }
+
+    for (FObject& Object : Objects)
+    {
+        UClass* LiveClass = Schemas[Object.SchemaId].LiveClass;
+
+        if (LiveClass == nullptr || LiveClass->HasAnyClassFlags(CLASS_Abstract))
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: can't replay %s, its class %s is not loaded"), *Object.PathName, *Schemas[Object.SchemaId].ClassPath);
+            continue;
+        }
+
+        const FName ReplayName = MakeUniqueObjectName(GetTransientPackage(), LiveClass, FName(*(Object.Name + TEXT("_Replay"))));
+        Object.ReplayObject.Reset(NewObject<UObject>(GetTransientPackage(), LiveClass, ReplayName, RF_Transient));
+    }
+
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: replaying %d frames of %d objects, %d properties could not be matched to the loaded classes"),
+        Frames.Num(), Objects.Num(), NumSkipped);
+
+    return GetReplayObject(0);
+}
+
+FProperty* FActorDebuggerCaptureReader::FindLiveProperty(UClass* LiveClass, const FString& Name, const FString& CPPType, EActorDebuggerCaptureEncoding Encoding, int32 ElementSize, int32 ArrayDim)
+{
+    FProperty* LiveProperty = LiveClass ? FindFProperty<FProperty>(LiveClass, *Name) : nullptr;
+
+    const bool bMatches = LiveProperty
+        && Encoding != EActorDebuggerCaptureEncoding::None
+        && LiveProperty->GetCPPType() == CPPType
+        && LiveProperty->ElementSize == ElementSize
+        && LiveProperty->ArrayDim == ArrayDim;
+
+    return bMatches ? LiveProperty : nullptr;
+}
+
+UObject* FActorDebuggerCaptureReader::GetReplayObject(int32 ObjectId) const
+{
+    return Objects.IsValidIndex(ObjectId) ? Objects[ObjectId].ReplayObject.Get() : nullptr;
+}
+
+bool FActorDebuggerCaptureReader::ApplyFrame(int32 Frame)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_ReplayFrame);
+
+    if (GatherFrameValues(Frame) == false)
+    {
+        return false;
+    }
+
+    for (int32 ObjectId = 0; ObjectId < Objects.Num(); ++ObjectId)
+    {
+        UObject* ReplayObject = Objects[ObjectId].ReplayObject.Get();
+        if (ReplayObject == nullptr)
+        {
+            continue;
+        }
+
+        const TArray<FSchemaProperty>& Properties = Schemas[Objects[ObjectId].SchemaId].Properties;
+
+        for (int32 PropertyIndex = 0; PropertyIndex < Properties.Num(); ++PropertyIndex)
+        {
+            const FMemoryView Bytes = Values[ObjectId][PropertyIndex];
+
+            if (Properties[PropertyIndex].LiveProperty && Bytes.GetData())
+            {
+                ApplyValue(Properties[PropertyIndex].LiveProperty, Properties[PropertyIndex].Encoding, ReplayObject, Bytes, [this](FArchive& Ar)
+                {
+                    return DecodeObjectRef(Ar);
+                });
+            }
+        }
+    }
+
+    return true;
+}
+
+/*
+* Starts from the keyframe at or before the frame and lets each later frame overwrite the values it changed. When
+* moving forward from the frame gathered last, only the frames in between are read
+*/
+bool FActorDebuggerCaptureReader::GatherFrameValues(int32 Frame)
+{
+    using namespace ActorDebuggerCapture;
+
+    if (Frames.IsValidIndex(Frame) == false)
+    {
+        return false;
+    }
+
+    int32 StartFrame = Frame;
+    while (StartFrame > 0 && Frames[StartFrame].bKeyframe == false)
+    {
+        --StartFrame;
+    }
+
+    if (GatheredFrame != INDEX_NONE && GatheredFrame >= StartFrame && GatheredFrame <= Frame)
+    {
+        StartFrame = GatheredFrame + 1;
+    }
+    else
+    {
+        for (TArray<FMemoryView>& ObjectValues : Values)
+        {
+            for (FMemoryView& Value : ObjectValues)
+            {
+                Value = FMemoryView();
+            }
+        }
+    }
+
+    GatheredFrame = INDEX_NONE;
+
+    for (int32 Index = StartFrame; Index <= Frame; ++Index)
+    {
+        ERecordType Type;
+        FMemoryView Payload;
+        if (ReadRecord(Frames[Index].Offset, Type, Payload) == false || Type != ERecordType::Frame)
+        {
+            return false;
+        }
+
+        FMemoryReaderView Ar(Payload);
+
+        int32 FrameIndex = 0;
+        double Time = 0.0;
+        uint8 bKeyframe = 0;
+        Ar << FrameIndex << Time << bKeyframe;
+
+        while (Ar.IsError() == false && Ar.Tell() < static_cast<int64>(Payload.GetSize()))
+        {
+            int32 ObjectId = INDEX_NONE;
+            int32 PropertyIndex = INDEX_NONE;
+            int32 NumBytes = 0;
+            Ar << ObjectId << PropertyIndex << NumBytes;
+
+            if (Ar.IsError() || Values.IsValidIndex(ObjectId) == false || Values[ObjectId].IsValidIndex(PropertyIndex) == false
+                || NumBytes < 0 || Ar.Tell() + NumBytes > static_cast<int64>(Payload.GetSize()))
+            {
+                return false;
+            }
+
+            // a view into the mapped file, the value is only copied when it is applied
+            Values[ObjectId][PropertyIndex] = Payload.Mid(Ar.Tell(), NumBytes);
+            Ar.Seek(Ar.Tell() + NumBytes);
+        }
+    }
+
+    GatheredFrame = Frame;
+    return true;
+}
+
+void FActorDebuggerCaptureReader::ApplyValue(FProperty* LiveProperty, EActorDebuggerCaptureEncoding Encoding, UObject* Object, FMemoryView Bytes, TFunctionRef<UObject*(FArchive&)> DecodeObjectRef)
+{
+    uint8* ValuePtr = LiveProperty->ContainerPtrToValuePtr<uint8>(Object);
+
+    switch (Encoding)
+    {
+    case EActorDebuggerCaptureEncoding::Raw:
+        if (Bytes.GetSize() == static_cast<uint64>(LiveProperty->ElementSize * LiveProperty->ArrayDim))
+        {
+            FMemory::Memcpy(ValuePtr, Bytes.GetData(), Bytes.GetSize());
+        }
+        break;
+
+    case EActorDebuggerCaptureEncoding::ObjectRef:
+    {
+        FMemoryReaderView Ar(Bytes);
+        UObject* Value = DecodeObjectRef(Ar);
+
+        const FObjectPropertyBase* ObjectProperty = CastFieldChecked<FObjectPropertyBase>(LiveProperty);
+        if (Ar.IsError() == false && (Value == nullptr || Value->IsA(ObjectProperty->PropertyClass)))
+        {
+            ObjectProperty->SetObjectPropertyValue(ValuePtr, Value);
+        }
+        break;
+    }
+
+    case EActorDebuggerCaptureEncoding::ObjectRefArray:
+    {
+        const FArrayProperty* ArrayProperty = CastFieldChecked<FArrayProperty>(LiveProperty);
+        const FObjectPropertyBase* Inner = CastFieldChecked<FObjectPropertyBase>(ArrayProperty->Inner);
+
+        FMemoryReaderView Ar(Bytes);
+        int32 Num = 0;
+        Ar << Num;
+
+        // every element takes at least four bytes
+        if (Ar.IsError() || Num < 0 || Num > static_cast<int64>(Bytes.GetSize() / sizeof(int32)))
+        {
+            break;
+        }
+
+        FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+        Helper.Resize(Num);
+
+        for (int32 Index = 0; Index < Num && Ar.IsError() == false; ++Index)
+        {
+            UObject* Value = DecodeObjectRef(Ar);
+            Inner->SetObjectPropertyValue(Helper.GetRawPtr(Index), Value && Value->IsA(Inner->PropertyClass) ? Value : nullptr);
+        }
+        break;
+    }
+
+    case EActorDebuggerCaptureEncoding::Text:
+    {
+        const auto Converter = StringCast<TCHAR>(static_cast<const UTF8CHAR*>(Bytes.GetData()), static_cast<int32>(Bytes.GetSize()));
+        const FString Text(Converter.Length(), Converter.Get());
+        LiveProperty->ImportText_Direct(*Text, ValuePtr, Object, PPF_None);
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+/*
+* References to watched objects point at their replay objects, anything else is looked up by path and is null if
+* it doesn't exist in this process
+*/
+UObject* FActorDebuggerCaptureReader::DecodeObjectRef(FArchive& Ar) const
+{
+    int32 ObjectId = INDEX_NONE;
+    Ar << ObjectId;
+
+    if (ObjectId != INDEX_NONE)
+    {
+        return GetReplayObject(ObjectId);
+    }
+
+    FString PathName;
+    Ar << PathName;
+
+    return PathName.IsEmpty() || Ar.IsError() ? nullptr : StaticFindObject(UObject::StaticClass(), nullptr, *PathName);
+}
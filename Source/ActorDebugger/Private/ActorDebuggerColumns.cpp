@@ -0,0 +1,505 @@
+#include "ActorDebuggerColumns.h"
+#include "ActorDebuggerQuery.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerStats.h"
+#include "ActorDebuggerFormatters.h"
+#include "Async/ParallelFor.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include "GameFramework/Actor.h"
+#include "Math/VectorRegister.h"
+
+namespace ActorDebuggerColumns
+{
+    /* Fewer rows than this are sampled on the game thread, the sampling would cost less than waking the workers */
+    static constexpr int32 MinParallelRows = 256;
+
+    static constexpr int32 NumHistogramBins = 16;
+
+    static double ReadNumber(const FActorDebuggerColumn& Column, const uint8* ValuePtr)
+    {
+        switch (Column.Type)
+        {
+        case FActorDebuggerColumn::EType::Bool:
+            return static_cast<const FBoolProperty*>(Column.Path.GetLeafProperty())->GetPropertyValue(ValuePtr) ? 1.0 : 0.0;
+        case FActorDebuggerColumn::EType::Count:
+            return FReflectedActorProperty::GetContainerNum(Column.Path.GetLeafProperty(), ValuePtr);
+        default:
+            break;
+        }
+
+        if (Column.NumericProperty->IsFloatingPoint())
+        {
+            return Column.NumericProperty->GetFloatingPointPropertyValue(ValuePtr);
+        }
+        return static_cast<double>(Column.NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+    }
+
+    /* Applies an operator to the result of a three way comparison */
+    static bool MatchesOrder(int32 Order, EActorDebuggerConditionOp Op)
+    {
+        switch (Op)
+        {
+        case EActorDebuggerConditionOp::Equal:        return Order == 0;
+        case EActorDebuggerConditionOp::NotEqual:     return Order != 0;
+        case EActorDebuggerConditionOp::Less:         return Order < 0;
+        case EActorDebuggerConditionOp::LessEqual:    return Order <= 0;
+        case EActorDebuggerConditionOp::Greater:      return Order > 0;
+        case EActorDebuggerConditionOp::GreaterEqual: return Order >= 0;
+        default:                                      return false;
+        }
+    }
+
+    static FString GetObjectName(const UObject* Object)
+    {
+        const AActor* Actor = Cast<AActor>(Object);
+        return Actor ? Actor->GetActorNameOrLabel() : Object->GetName();
+    }
+}
+
+using namespace ActorDebuggerColumns;
+
+FString FActorDebuggerColumn::FormatValue(int32 Row) const
+{
+    if (HasValue.IsValidIndex(Row) == false || HasValue[Row] == false)
+    {
+        return FString();
+    }
+
+    switch (Type)
+    {
+    case EType::Text:
+        return Texts[Row];
+    case EType::Enum:
+        return Enum->GetNameStringByValue(static_cast<int64>(Numbers[Row]));
+    case EType::Bool:
+        return Numbers[Row] != 0.0 ? TEXT("true") : TEXT("false");
+    case EType::Count:
+    {
+        const int32 Num = static_cast<int32>(Numbers[Row]);
+        return FString::Printf(TEXT("%d %s"), Num, Num == 1 ? TEXT("element") : TEXT("elements"));
+    }
+    default:
+        return NumericProperty->IsFloatingPoint() ? FString::SanitizeFloat(Numbers[Row]) : FString::Printf(TEXT("%lld"), static_cast<int64>(Numbers[Row]));
+    }
+}
+
+void FActorDebuggerColumnTable::SetClass(UClass* InClass)
+{
+    Class = InClass;
+    Columns.Reset();
+    Objects.Reset();
+    RowNames.Reset();
+    View.Reset();
+    SortColumn = INDEX_NONE;
+    FilterColumn = INDEX_NONE;
+}
+
+/*
+* The column is sampled from the rows the table already has, so it can be shown before the next sample
+*/
+bool FActorDebuggerColumnTable::AddColumn(const FString& Path, FText& OutError)
+{
+    if (Class == nullptr)
+    {
+        OutError = FText::FromString("Choose a class first");
+        return false;
+    }
+
+    FActorDebuggerColumn Column;
+    if (Column.Path.Compile(Class, Path, OutError) == false)
+    {
+        return false;
+    }
+
+    const FProperty* Property = Column.Path.GetLeafProperty();
+    if (Column.Path.IsLeafContainer())
+    {
+        Column.Type = FActorDebuggerColumn::EType::Count;
+    }
+    else if (Property->IsA<FBoolProperty>())
+    {
+        Column.Type = FActorDebuggerColumn::EType::Bool;
+    }
+    else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+    {
+        Column.Type = FActorDebuggerColumn::EType::Enum;
+        Column.NumericProperty = EnumProperty->GetUnderlyingProperty();
+        Column.Enum = EnumProperty->GetEnum();
+    }
+    else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+    {
+        // bytes may hold an old style enum
+        Column.Enum = NumericProperty->GetIntPropertyEnum();
+        Column.Type = Column.Enum ? FActorDebuggerColumn::EType::Enum : FActorDebuggerColumn::EType::Number;
+        Column.NumericProperty = NumericProperty;
+    }
+    else
+    {
+        Column.Formatter = FActorDebuggerFormatters::Select(Property);
+    }
+
+    TArray<UObject*> RowObjects;
+    RowObjects.Reserve(Objects.Num());
+    for (const TWeakObjectPtr<UObject>& Object : Objects)
+    {
+        RowObjects.Add(Object.Get());
+    }
+
+    SampleColumn(Column, RowObjects);
+    Columns.Add(MoveTemp(Column));
+    UpdateView();
+    return true;
+}
+
+void FActorDebuggerColumnTable::RemoveColumn(int32 ColumnIndex)
+{
+    if (Columns.IsValidIndex(ColumnIndex) == false)
+    {
+        return;
+    }
+
+    Columns.RemoveAt(ColumnIndex);
+
+    // the sort and the filter refer to columns by index
+    auto Adjust = [ColumnIndex](int32& Index)
+    {
+        Index = Index == ColumnIndex ? INDEX_NONE : (Index > ColumnIndex ? Index - 1 : Index);
+    };
+    Adjust(SortColumn);
+    Adjust(FilterColumn);
+
+    UpdateView();
+}
+
+void FActorDebuggerColumnTable::Sample(const UWorld* World)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_SampleColumns);
+
+    TArray<UObject*> SampledObjects;
+    if (Class)
+    {
+        FActorDebuggerQuery::GatherObjects(Class, World, SampledObjects);
+    }
+
+    Objects.Reset(SampledObjects.Num());
+    RowNames.Reset(SampledObjects.Num());
+    for (UObject* Object : SampledObjects)
+    {
+        Objects.Add(Object);
+        RowNames.Add(GetObjectName(Object));
+    }
+
+    for (FActorDebuggerColumn& Column : Columns)
+    {
+        SampleColumn(Column, SampledObjects);
+    }
+
+    UpdateView();
+}
+
+/*
+* Number columns only read property memory through the compiled path, each worker writes its own rows. The game
+* thread waits for them, so the objects can't change underneath. Null objects are rows whose object is gone
+*/
+void FActorDebuggerColumnTable::SampleColumn(FActorDebuggerColumn& Column, const TArray<UObject*>& SampledObjects) const
+{
+    const int32 NumRows = SampledObjects.Num();
+    Column.HasValue.Reset();
+    Column.HasValue.SetNumZeroed(NumRows);
+
+    if (Column.IsNumber())
+    {
+        Column.Texts.Empty();
+        Column.Numbers.SetNumUninitialized(NumRows);
+
+        ParallelFor(NumRows, [&Column, &SampledObjects](int32 Row)
+        {
+            const uint8* ValuePtr = SampledObjects[Row] ? Column.Path.Resolve(SampledObjects[Row]) : nullptr;
+            Column.HasValue[Row] = ValuePtr != nullptr;
+            Column.Numbers[Row] = ValuePtr ? ReadNumber(Column, ValuePtr) : 0.0;
+        }, NumRows < MinParallelRows ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+        return;
+    }
+
+    Column.Numbers.Empty();
+    Column.Texts.SetNum(NumRows);
+
+    // the strings keep their allocations between samples, most values fit in the space the last one took
+    TStringBuilder<256> ValueString;
+    for (int32 Row = 0; Row < NumRows; ++Row)
+    {
+        FString& Text = Column.Texts[Row];
+        Text.Reset();
+
+        if (const uint8* ValuePtr = SampledObjects[Row] ? Column.Path.Resolve(SampledObjects[Row]) : nullptr)
+        {
+            ValueString.Reset();
+            Column.Formatter(Column.Path.GetLeafProperty(), ValuePtr, SampledObjects[Row], ValueString);
+            Text.Append(ValueString.GetData(), ValueString.Len());
+            Column.HasValue[Row] = true;
+        }
+    }
+}
+
+void FActorDebuggerColumnTable::SortBy(int32 ColumnIndex, bool bAscending)
+{
+    SortColumn = Columns.IsValidIndex(ColumnIndex) ? ColumnIndex : INDEX_NONE;
+    bSortAscending = bAscending;
+    UpdateView();
+}
+
+bool FActorDebuggerColumnTable::SetFilter(const FString& Filter, FText& OutError)
+{
+    const FString TrimmedFilter = Filter.TrimStartAndEnd();
+    if (TrimmedFilter.IsEmpty())
+    {
+        FilterColumn = INDEX_NONE;
+        UpdateView();
+        return true;
+    }
+
+    FString ColumnName;
+    FString Operand;
+    EActorDebuggerConditionOp Op;
+    if (FActorDebuggerCondition::Parse(TrimmedFilter, ColumnName, Op, Operand) == false || Op == EActorDebuggerConditionOp::Changed || ColumnName.IsEmpty())
+    {
+        OutError = FText::FromString("Filters look like \"Health < 10\", the name must be one of the columns");
+        return false;
+    }
+
+    const int32 ColumnIndex = Columns.IndexOfByPredicate([&ColumnName](const FActorDebuggerColumn& Column)
+    {
+        return Column.Path.ToString().Equals(ColumnName, ESearchCase::IgnoreCase);
+    });
+    if (ColumnIndex == INDEX_NONE)
+    {
+        OutError = FText::FromString(FString::Printf(TEXT("There is no column named %s"), *ColumnName));
+        return false;
+    }
+
+    const FActorDebuggerColumn& Column = Columns[ColumnIndex];
+    if (Column.IsNumber())
+    {
+        if (Column.Type == FActorDebuggerColumn::EType::Enum && FCString::IsNumeric(*Operand) == false)
+        {
+            const int64 Value = Column.Enum->GetValueByNameString(Operand);
+            if (Value == INDEX_NONE)
+            {
+                OutError = FText::FromString(FString::Printf(TEXT("%s has no value named %s"), *Column.Enum->GetName(), *Operand));
+                return false;
+            }
+            FilterNumber = static_cast<double>(Value);
+        }
+        else if (Column.Type == FActorDebuggerColumn::EType::Bool && FCString::IsNumeric(*Operand) == false)
+        {
+            FilterNumber = Operand.ToBool() ? 1.0 : 0.0;
+        }
+        else if (FCString::IsNumeric(*Operand))
+        {
+            FilterNumber = FCString::Atod(*Operand);
+        }
+        else
+        {
+            OutError = FText::FromString(FString::Printf(TEXT("%s is a number column, \"%s\" isn't a number"), *ColumnName, *Operand));
+            return false;
+        }
+    }
+    else
+    {
+        FilterText = Operand;
+    }
+
+    FilterColumn = ColumnIndex;
+    FilterOp = Op;
+    UpdateView();
+    return true;
+}
+
+bool FActorDebuggerColumnTable::PassesFilter(int32 Row) const
+{
+    if (FilterColumn == INDEX_NONE)
+    {
+        return true;
+    }
+
+    const FActorDebuggerColumn& Column = Columns[FilterColumn];
+    if (Column.HasValue[Row] == false)
+    {
+        return false;
+    }
+
+    if (Column.IsNumber())
+    {
+        const double Value = Column.Numbers[Row];
+        return MatchesOrder(Value < FilterNumber ? -1 : (Value > FilterNumber ? 1 : 0), FilterOp);
+    }
+
+    return MatchesOrder(Column.Texts[Row].Compare(FilterText, ESearchCase::IgnoreCase), FilterOp);
+}
+
+/*
+* The filter and the sort only touch the column buffers. The statistics describe the rows in the view, so
+* filtering narrows them down to the rows being looked at
+*/
+void FActorDebuggerColumnTable::UpdateView()
+{
+    View.Reset(Objects.Num());
+    for (int32 Row = 0; Row < Objects.Num(); ++Row)
+    {
+        if (PassesFilter(Row))
+        {
+            View.Add(Row);
+        }
+    }
+
+    if (SortColumn != INDEX_NONE)
+    {
+        const FActorDebuggerColumn& Column = Columns[SortColumn];
+        const bool bAscending = bSortAscending;
+
+        // rows without a value go last whichever way the column is sorted
+        View.StableSort([&Column, bAscending](int32 A, int32 B)
+        {
+            if (Column.HasValue[A] != Column.HasValue[B])
+            {
+                return Column.HasValue[A];
+            }
+            if (Column.HasValue[A] == false)
+            {
+                return false;
+            }
+
+            if (Column.IsNumber())
+            {
+                return bAscending ? Column.Numbers[A] < Column.Numbers[B] : Column.Numbers[A] > Column.Numbers[B];
+            }
+
+            const int32 Order = Column.Texts[A].Compare(Column.Texts[B], ESearchCase::IgnoreCase);
+            return bAscending ? Order < 0 : Order > 0;
+        });
+    }
+
+    for (FActorDebuggerColumn& Column : Columns)
+    {
+        Column.Stats = FActorDebuggerColumnStats();
+        if (Column.IsNumber() == false)
+        {
+            continue;
+        }
+
+        // NaNs and infinities would have no bin
+        Scratch.Reset(View.Num());
+        for (int32 Row : View)
+        {
+            if (Column.HasValue[Row] && FMath::IsFinite(Column.Numbers[Row]))
+            {
+                Scratch.Add(Column.Numbers[Row]);
+            }
+        }
+
+        ComputeStats(Scratch.GetData(), Scratch.Num(), NumHistogramBins, Column.Stats);
+    }
+}
+
+/*
+* Two passes over the values, four at a time. The first finds the range and the sum, the second maps each value
+* to its bin with vector arithmetic, only the increment of the bin's count is scalar. The last few values that
+* don't fill a vector are handled one at a time
+*/
+void FActorDebuggerColumnTable::ComputeStats(const double* Values, int32 NumValues, int32 NumBins, FActorDebuggerColumnStats& OutStats)
+{
+    OutStats.NumValues = NumValues;
+    OutStats.Histogram.Reset();
+    OutStats.Histogram.SetNumZeroed(NumBins);
+
+    if (NumValues == 0)
+    {
+        OutStats.Min = OutStats.Max = OutStats.Mean = 0.0;
+        return;
+    }
+
+    const int32 NumVectorValues = NumValues & ~3;
+
+    VectorRegister4Double MinVector = MakeVectorRegisterDouble(Values[0], Values[0], Values[0], Values[0]);
+    VectorRegister4Double MaxVector = MinVector;
+    VectorRegister4Double SumVector = MakeVectorRegisterDouble(0.0, 0.0, 0.0, 0.0);
+
+    for (int32 Index = 0; Index < NumVectorValues; Index += 4)
+    {
+        const VectorRegister4Double Vector = VectorLoad(Values + Index);
+        MinVector = VectorMin(MinVector, Vector);
+        MaxVector = VectorMax(MaxVector, Vector);
+        SumVector = VectorAdd(SumVector, Vector);
+    }
+
+    alignas(32) double Lanes[3][4];
+    VectorStore(MinVector, Lanes[0]);
+    VectorStore(MaxVector, Lanes[1]);
+    VectorStore(SumVector, Lanes[2]);
+
+    double Min = FMath::Min(FMath::Min(Lanes[0][0], Lanes[0][1]), FMath::Min(Lanes[0][2], Lanes[0][3]));
+    double Max = FMath::Max(FMath::Max(Lanes[1][0], Lanes[1][1]), FMath::Max(Lanes[1][2], Lanes[1][3]));
+    double Sum = (Lanes[2][0] + Lanes[2][1]) + (Lanes[2][2] + Lanes[2][3]);
+
+    for (int32 Index = NumVectorValues; Index < NumValues; ++Index)
+    {
+        Min = FMath::Min(Min, Values[Index]);
+        Max = FMath::Max(Max, Values[Index]);
+        Sum += Values[Index];
+    }
+
+    OutStats.Min = Min;
+    OutStats.Max = Max;
+    OutStats.Mean = Sum / NumValues;
+
+    if (NumBins == 0)
+    {
+        return;
+    }
+
+    // every value lands in the first bin if they are all the same
+    const double Scale = Max > Min ? NumBins / (Max - Min) : 0.0;
+    const double LastBin = NumBins - 1;
+    const VectorRegister4Double MinBroadcast = MakeVectorRegisterDouble(Min, Min, Min, Min);
+    const VectorRegister4Double ScaleBroadcast = MakeVectorRegisterDouble(Scale, Scale, Scale, Scale);
+    const VectorRegister4Double LastBinBroadcast = MakeVectorRegisterDouble(LastBin, LastBin, LastBin, LastBin);
+
+    alignas(32) double Bins[4];
+    for (int32 Index = 0; Index < NumVectorValues; Index += 4)
+    {
+        const VectorRegister4Double Vector = VectorLoad(Values + Index);
+        VectorStore(VectorMin(VectorMultiply(VectorSubtract(Vector, MinBroadcast), ScaleBroadcast), LastBinBroadcast), Bins);
+
+        ++OutStats.Histogram[static_cast<int32>(Bins[0])];
+        ++OutStats.Histogram[static_cast<int32>(Bins[1])];
+        ++OutStats.Histogram[static_cast<int32>(Bins[2])];
+        ++OutStats.Histogram[static_cast<int32>(Bins[3])];
+    }
+
+    for (int32 Index = NumVectorValues; Index < NumValues; ++Index)
+    {
+        ++OutStats.Histogram[static_cast<int32>(FMath::Min((Values[Index] - Min) * Scale, LastBin))];
+    }
+}
+
+SIZE_T FActorDebuggerColumnTable::GetAllocatedSize() const
+{
+    SIZE_T Size = Columns.GetAllocatedSize() + Objects.GetAllocatedSize() + RowNames.GetAllocatedSize() + View.GetAllocatedSize() + Scratch.GetAllocatedSize();
+
+    for (const FActorDebuggerColumn& Column : Columns)
+    {
+        Size += Column.Numbers.GetAllocatedSize() + Column.Texts.GetAllocatedSize() + Column.HasValue.GetAllocatedSize();
+        for (const FString& Text : Column.Texts)
+        {
+            Size += Text.GetAllocatedSize();
+        }
+    }
+
+    for (const FString& Name : RowNames)
+    {
+        Size += Name.GetAllocatedSize();
+    }
+
+    return Size;
+}
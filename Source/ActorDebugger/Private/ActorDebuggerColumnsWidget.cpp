@@ -0,0 +1,339 @@
+#include "ActorDebuggerColumnsWidget.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Views/STableRow.h"
+#include "ActorDebuggerLibrary.h"
+#include "ActorDebugger.h"
+
+namespace ActorDebuggerColumnsWidget
+{
+    static const FName ObjectColumnId(TEXT("Object"));
+
+    /* Columns of the table are named Column_1, Column_2..., the number is one more than the column's index */
+    static FName MakeColumnId(int32 ColumnIndex)
+    {
+        return FName(TEXT("Column"), ColumnIndex + 1);
+    }
+
+    static int32 GetColumnIndex(const FName& ColumnId)
+    {
+        return ColumnId == ObjectColumnId ? INDEX_NONE : ColumnId.GetNumber() - 1;
+    }
+
+    /* One block per bin, from an eighth of a block up to a full one for the fullest bin */
+    static FString MakeSparkline(const FActorDebuggerColumnStats& Stats)
+    {
+        static const TCHAR Blocks[] = { TEXT(' '), 0x2581, 0x2582, 0x2583, 0x2584, 0x2585, 0x2586, 0x2587, 0x2588 };
+        const int32 NumLevels = UE_ARRAY_COUNT(Blocks) - 1;
+
+        int32 MaxCount = 0;
+        for (int32 Count : Stats.Histogram)
+        {
+            MaxCount = FMath::Max(MaxCount, Count);
+        }
+
+        FString Sparkline;
+        for (int32 Count : Stats.Histogram)
+        {
+            Sparkline.AppendChar(MaxCount > 0 ? Blocks[FMath::DivideAndRoundUp(Count * NumLevels, MaxCount)] : Blocks[0]);
+        }
+        return Sparkline;
+    }
+}
+
+using namespace ActorDebuggerColumnsWidget;
+
+/*
+* A row of the table, each cell formats the table's value for the row when it is generated
+*/
+class SActorDebuggerColumnsRow : public SMultiColumnTableRow<TSharedPtr<int32>>
+{
+public:
+    SLATE_BEGIN_ARGS(SActorDebuggerColumnsRow)
+        : _Row(INDEX_NONE)
+        , _Table(nullptr)
+    {}
+        SLATE_ARGUMENT(int32, Row)
+        SLATE_ARGUMENT(const FActorDebuggerColumnTable*, Table)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
+    {
+        Row = InArgs._Row;
+        Table = InArgs._Table;
+
+        SMultiColumnTableRow<TSharedPtr<int32>>::Construct(FSuperRowType::FArguments().Padding(FMargin(0, 2)), OwnerTable);
+    }
+
+    virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+    {
+        if (ColumnName == ObjectColumnId)
+        {
+            return SNew(STextBlock)
+                .Text(FText::FromString(Table->GetRowName(Row)))
+                .ColorAndOpacity(FLinearColor::Yellow);
+        }
+
+        const int32 ColumnIndex = GetColumnIndex(ColumnName);
+        return SNew(STextBlock)
+            .Text(Table->GetColumns().IsValidIndex(ColumnIndex) ? FText::FromString(Table->GetColumns()[ColumnIndex].FormatValue(Row)) : FText::GetEmpty());
+    }
+
+private:
+    int32 Row {INDEX_NONE};
+    const FActorDebuggerColumnTable* Table {nullptr};
+};
+
+BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
+
+/*
+* Constructs the column and filter boxes, the statistics and the list of rows, then samples the table once
+*/
+void SActorDebuggerColumnsWidget::Construct(const FArguments& InArgs)
+{
+    World = InArgs._World;
+    bSearchAllWorlds = InArgs._World.IsExplicitlyNull();
+    Table.SetClass(InArgs._Class);
+
+    HeaderRow = SNew(SHeaderRow);
+
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 2))
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                [
+                    SNew(SEditableTextBox)
+                        .HintText(FText::FromString("Add a column, e.g. Health or Weapon.Ammo[0]"))
+                        .ClearKeyboardFocusOnCommit(false)
+                        .OnTextCommitted(this, &SActorDebuggerColumnsWidget::HandleAddColumnCommitted)
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .Padding(FMargin(4, 0, 0, 0))
+                [
+                    SNew(SEditableTextBox)
+                        .HintText(FText::FromString("Filter, e.g. Health < 10"))
+                        .OnTextCommitted(this, &SActorDebuggerColumnsWidget::HandleFilterCommitted)
+                ]
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            [
+                SAssignNew(ErrorTextBlock, STextBlock)
+                    .ColorAndOpacity(FLinearColor::Red)
+                    .Visibility_Lambda([this] { return ErrorTextBlock->GetText().IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible; })
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            [
+                SNew(STextBlock)
+                    .Text(this, &SActorDebuggerColumnsWidget::GetSummaryText)
+                    .ColorAndOpacity(FLinearColor::White)
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 2))
+            [
+                SNew(STextBlock)
+                    .Text(this, &SActorDebuggerColumnsWidget::GetStatsText)
+                    .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f))
+            ]
+            + SVerticalBox::Slot()
+            .FillHeight(1.0f)
+            [
+                SAssignNew(RowsView, SListView<FRowPtr>)
+                    .ListItemsSource(&VisibleRows)
+                    .SelectionMode(ESelectionMode::Single)
+                    .HeaderRow(HeaderRow)
+                    .OnGenerateRow(this, &SActorDebuggerColumnsWidget::HandleGenerateRow)
+                    .OnMouseButtonClick(this, &SActorDebuggerColumnsWidget::HandleRowClicked)
+            ]
+    ];
+
+    for (const FString& Path : InArgs._Columns)
+    {
+        FText Error;
+        if (Table.AddColumn(Path, Error) == false)
+        {
+            ErrorTextBlock->SetText(Error);
+        }
+    }
+
+    RebuildColumns();
+    Refresh();
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateSP(this, &SActorDebuggerColumnsWidget::HandleTicker),
+        InArgs._RefreshInterval
+    );
+}
+
+SActorDebuggerColumnsWidget::~SActorDebuggerColumnsWidget()
+{
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+}
+
+bool SActorDebuggerColumnsWidget::HandleTicker(float DeltaTime)
+{
+    Refresh();
+    return true;
+}
+
+/*
+* A world that has gone away, such as one from a play session that ended, isn't sampled again. The table keeps
+* the last values it sampled
+*/
+void SActorDebuggerColumnsWidget::Refresh()
+{
+    const UWorld* SampledWorld = World.Get();
+    if (bSearchAllWorlds == false && SampledWorld == nullptr)
+    {
+        return;
+    }
+
+    Table.Sample(SampledWorld);
+    RebuildRows();
+}
+
+bool SActorDebuggerColumnsWidget::AddColumn(const FString& Path, FText& OutError)
+{
+    if (Table.AddColumn(Path, OutError) == false)
+    {
+        return false;
+    }
+
+    RebuildColumns();
+    RebuildRows();
+    return true;
+}
+
+void SActorDebuggerColumnsWidget::RebuildColumns()
+{
+    HeaderRow->ClearColumns();
+
+    HeaderRow->AddColumn(SHeaderRow::Column(ObjectColumnId)
+        .DefaultLabel(FText::FromString("Object"))
+        .FillWidth(0.3f));
+
+    const TArray<FActorDebuggerColumn>& Columns = Table.GetColumns();
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        HeaderRow->AddColumn(SHeaderRow::Column(MakeColumnId(ColumnIndex))
+            .DefaultLabel(FText::FromString(Columns[ColumnIndex].Path.ToString()))
+            .FillWidth(0.7f / Columns.Num())
+            .SortMode(this, &SActorDebuggerColumnsWidget::GetColumnSortMode, ColumnIndex)
+            .OnSort(this, &SActorDebuggerColumnsWidget::HandleSort));
+    }
+}
+
+/*
+* Rows are generated from the table's view, the list itself never filters or sorts
+*/
+void SActorDebuggerColumnsWidget::RebuildRows()
+{
+    const int32 NumRows = Table.GetNumRows();
+    while (RowItems.Num() < NumRows)
+    {
+        RowItems.Add(MakeShared<int32>(RowItems.Num()));
+    }
+
+    VisibleRows.Reset(Table.GetView().Num());
+    for (int32 Row : Table.GetView())
+    {
+        VisibleRows.Add(RowItems[Row]);
+    }
+
+    // the values of every row may have changed, not just which rows are shown
+    RowsView->RebuildList();
+}
+
+TSharedRef<ITableRow> SActorDebuggerColumnsWidget::HandleGenerateRow(FRowPtr Row, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(SActorDebuggerColumnsRow, OwnerTable)
+        .Row(*Row)
+        .Table(&Table);
+}
+
+void SActorDebuggerColumnsWidget::HandleRowClicked(FRowPtr Row)
+{
+    if (UObject* Object = Row.IsValid() && *Row < Table.GetNumRows() ? Table.GetObject(*Row) : nullptr)
+    {
+        UActorDebuggerLibrary::AddInspectedObject(Object);
+    }
+}
+
+void SActorDebuggerColumnsWidget::HandleSort(EColumnSortPriority::Type Priority, const FName& ColumnId, EColumnSortMode::Type SortMode)
+{
+    Table.SortBy(GetColumnIndex(ColumnId), SortMode != EColumnSortMode::Descending);
+    RebuildRows();
+}
+
+EColumnSortMode::Type SActorDebuggerColumnsWidget::GetColumnSortMode(int32 ColumnIndex) const
+{
+    if (Table.GetSortColumn() != ColumnIndex)
+    {
+        return EColumnSortMode::None;
+    }
+    return Table.IsSortAscending() ? EColumnSortMode::Ascending : EColumnSortMode::Descending;
+}
+
+void SActorDebuggerColumnsWidget::HandleAddColumnCommitted(const FText& Text, ETextCommit::Type CommitType)
+{
+    if (CommitType != ETextCommit::OnEnter || Text.IsEmpty())
+    {
+        return;
+    }
+
+    FText Error;
+    AddColumn(Text.ToString(), Error);
+    ErrorTextBlock->SetText(Error);
+}
+
+void SActorDebuggerColumnsWidget::HandleFilterCommitted(const FText& Text, ETextCommit::Type CommitType)
+{
+    FText Error;
+    Table.SetFilter(Text.ToString(), Error);
+    ErrorTextBlock->SetText(Error);
+    RebuildRows();
+}
+
+FText SActorDebuggerColumnsWidget::GetSummaryText() const
+{
+    const UClass* Class = Table.GetClass();
+    return FText::FromString(FString::Printf(TEXT("%s: %d of %d objects"), Class ? *Class->GetName() : TEXT("None"), Table.GetView().Num(), Table.GetNumRows()));
+}
+
+/*
+* One line per number column, describing the rows in the view
+*/
+FText SActorDebuggerColumnsWidget::GetStatsText() const
+{
+    FString StatsText;
+
+    for (const FActorDebuggerColumn& Column : Table.GetColumns())
+    {
+        if (Column.IsNumber() == false || Column.Stats.NumValues == 0)
+        {
+            continue;
+        }
+
+        if (StatsText.IsEmpty() == false)
+        {
+            StatsText += TEXT("\n");
+        }
+
+        StatsText += FString::Printf(TEXT("%s: min %s  max %s  mean %s  %s"), *Column.Path.ToString(),
+            *FString::SanitizeFloat(Column.Stats.Min), *FString::SanitizeFloat(Column.Stats.Max), *FString::SanitizeFloat(Column.Stats.Mean), *MakeSparkline(Column.Stats));
+    }
+
+    return FText::FromString(StatsText);
+}
+
+END_SLATE_FUNCTION_BUILD_OPTIMIZATION
@@ -0,0 +1,328 @@
+#include "ActorDebuggerCondition.h"
+#include "ActorDebuggerInspection.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+
+namespace ActorDebuggerCondition
+{
+    typedef FActorDebuggerCondition::FTestFunction FTestFunction;
+
+    struct FOperator
+    {
+        const TCHAR* Text;
+        EActorDebuggerConditionOp Op;
+    };
+
+    // two character operators come first so that "<=" isn't read as "<"
+    static const FOperator Operators[] =
+    {
+        { TEXT("=="), EActorDebuggerConditionOp::Equal },
+        { TEXT("!="), EActorDebuggerConditionOp::NotEqual },
+        { TEXT("<="), EActorDebuggerConditionOp::LessEqual },
+        { TEXT(">="), EActorDebuggerConditionOp::GreaterEqual },
+        { TEXT("<"), EActorDebuggerConditionOp::Less },
+        { TEXT(">"), EActorDebuggerConditionOp::Greater },
+        { TEXT("="), EActorDebuggerConditionOp::Equal }
+    };
+
+    template<typename T, EActorDebuggerConditionOp Op>
+    static FORCEINLINE bool Compare(const T& Value, const T& Operand)
+    {
+        if constexpr (Op == EActorDebuggerConditionOp::Equal)
+        {
+            return Value == Operand;
+        }
+        else if constexpr (Op == EActorDebuggerConditionOp::NotEqual)
+        {
+            return Value != Operand;
+        }
+        else if constexpr (Op == EActorDebuggerConditionOp::Less)
+        {
+            return Value < Operand;
+        }
+        else if constexpr (Op == EActorDebuggerConditionOp::LessEqual)
+        {
+            return Value <= Operand;
+        }
+        else if constexpr (Op == EActorDebuggerConditionOp::Greater)
+        {
+            return Value > Operand;
+        }
+        else
+        {
+            return Value >= Operand;
+        }
+    }
+
+    /* Numbers and the underlying values of enums, read straight from the property's memory */
+    template<typename T>
+    struct TNumberTest
+    {
+        template<EActorDebuggerConditionOp Op>
+        static bool Run(const FActorDebuggerCondition& Condition, const uint8* ValuePtr)
+        {
+            return Compare<T, Op>(*reinterpret_cast<const T*>(ValuePtr), *reinterpret_cast<const T*>(Condition.Operand));
+        }
+    };
+
+    /* The element count of a script container or C style array */
+    struct FContainerNumTest
+    {
+        template<EActorDebuggerConditionOp Op>
+        static bool Run(const FActorDebuggerCondition& Condition, const uint8* ValuePtr)
+        {
+            return Compare<int32, Op>(FReflectedActorProperty::GetContainerNum(Condition.Property, ValuePtr), *reinterpret_cast<const int32*>(Condition.Operand));
+        }
+    };
+
+    /* Bools may be bitfields, the property knows which bit to read */
+    struct FBoolTest
+    {
+        template<EActorDebuggerConditionOp Op>
+        static bool Run(const FActorDebuggerCondition& Condition, const uint8* ValuePtr)
+        {
+            return Compare<bool, Op>(static_cast<const FBoolProperty*>(Condition.Property)->GetPropertyValue(ValuePtr), Condition.Operand[0] != 0);
+        }
+    };
+
+    struct FStringTest
+    {
+        template<EActorDebuggerConditionOp Op>
+        static bool Run(const FActorDebuggerCondition& Condition, const uint8* ValuePtr)
+        {
+            return Compare<FString, Op>(*reinterpret_cast<const FString*>(ValuePtr), Condition.OperandString);
+        }
+    };
+
+    struct FNameTest
+    {
+        template<EActorDebuggerConditionOp Op>
+        static bool Run(const FActorDebuggerCondition& Condition, const uint8* ValuePtr)
+        {
+            return Compare<FName, Op>(*reinterpret_cast<const FName*>(ValuePtr), Condition.OperandName);
+        }
+    };
+
+    /* Object references can only be compared with None */
+    struct FObjectTest
+    {
+        template<EActorDebuggerConditionOp Op>
+        static bool Run(const FActorDebuggerCondition& Condition, const uint8* ValuePtr)
+        {
+            return Compare<bool, Op>(static_cast<const FObjectPropertyBase*>(Condition.Property)->GetObjectPropertyValue(ValuePtr) == nullptr, true);
+        }
+    };
+
+    /* Picks the specialisation of a test for the given operator. Returns nullptr for ordering operators if the type
+     * can only be compared for equality, those are never instantiated */
+    template<typename TTest, bool bOrdered>
+    static FTestFunction SelectTest(EActorDebuggerConditionOp Op)
+    {
+        switch (Op)
+        {
+        case EActorDebuggerConditionOp::Equal:
+            return &TTest::template Run<EActorDebuggerConditionOp::Equal>;
+        case EActorDebuggerConditionOp::NotEqual:
+            return &TTest::template Run<EActorDebuggerConditionOp::NotEqual>;
+        default:
+            break;
+        }
+
+        if constexpr (bOrdered)
+        {
+            switch (Op)
+            {
+            case EActorDebuggerConditionOp::Less:
+                return &TTest::template Run<EActorDebuggerConditionOp::Less>;
+            case EActorDebuggerConditionOp::LessEqual:
+                return &TTest::template Run<EActorDebuggerConditionOp::LessEqual>;
+            case EActorDebuggerConditionOp::Greater:
+                return &TTest::template Run<EActorDebuggerConditionOp::Greater>;
+            case EActorDebuggerConditionOp::GreaterEqual:
+                return &TTest::template Run<EActorDebuggerConditionOp::GreaterEqual>;
+            default:
+                break;
+            }
+        }
+
+        return nullptr;
+    }
+
+    static FTestFunction SelectNumberTest(const FNumericProperty* Property, EActorDebuggerConditionOp Op)
+    {
+        if (Property->IsA<FInt8Property>())    { return SelectTest<TNumberTest<int8>, true>(Op); }
+        if (Property->IsA<FInt16Property>())   { return SelectTest<TNumberTest<int16>, true>(Op); }
+        if (Property->IsA<FIntProperty>())     { return SelectTest<TNumberTest<int32>, true>(Op); }
+        if (Property->IsA<FInt64Property>())   { return SelectTest<TNumberTest<int64>, true>(Op); }
+        if (Property->IsA<FByteProperty>())    { return SelectTest<TNumberTest<uint8>, true>(Op); }
+        if (Property->IsA<FUInt16Property>())  { return SelectTest<TNumberTest<uint16>, true>(Op); }
+        if (Property->IsA<FUInt32Property>())  { return SelectTest<TNumberTest<uint32>, true>(Op); }
+        if (Property->IsA<FUInt64Property>())  { return SelectTest<TNumberTest<uint64>, true>(Op); }
+        if (Property->IsA<FFloatProperty>())   { return SelectTest<TNumberTest<float>, true>(Op); }
+        if (Property->IsA<FDoubleProperty>())  { return SelectTest<TNumberTest<double>, true>(Op); }
+        return nullptr;
+    }
+
+    /*
+    * Parses a number or an enum value name into the property's own representation. Integers that don't fit the
+    * property's type are rejected rather than truncated
+    */
+    static bool ParseNumberOperand(const FNumericProperty* Property, const UEnum* Enum, const FString& Operand, uint8* OutOperand)
+    {
+        const bool bIsNumeric = FCString::IsNumeric(*Operand);
+
+        if (Property->IsFloatingPoint())
+        {
+            if (bIsNumeric == false)
+            {
+                return false;
+            }
+
+            Property->SetFloatingPointPropertyValue(OutOperand, FCString::Atod(*Operand));
+            return true;
+        }
+
+        int64 Value = 0;
+        if (Enum && bIsNumeric == false)
+        {
+            // accepts both "Dead" and "EState::Dead"
+            Value = Enum->GetValueByNameString(Operand);
+            if (Value == INDEX_NONE)
+            {
+                return false;
+            }
+        }
+        else if (bIsNumeric && Operand.Contains(TEXT(".")) == false)
+        {
+            Value = FCString::Atoi64(*Operand);
+        }
+        else
+        {
+            return false;
+        }
+
+        Property->SetIntPropertyValue(OutOperand, Value);
+        return Property->GetSignedIntPropertyValue(OutOperand) == Value;
+    }
+}
+
+using namespace ActorDebuggerCondition;
+
+/*
+* The leftmost operator wins, so the name can't contain one
+*/
+bool FActorDebuggerCondition::Parse(const FString& Text, FString& OutName, EActorDebuggerConditionOp& OutOp, FString& OutOperand)
+{
+    for (int32 CharIndex = 0; CharIndex < Text.Len(); ++CharIndex)
+    {
+        for (const FOperator& Operator : Operators)
+        {
+            const int32 OperatorLen = FCString::Strlen(Operator.Text);
+            if (FCString::Strncmp(*Text + CharIndex, Operator.Text, OperatorLen) == 0)
+            {
+                OutName = Text.Left(CharIndex).TrimStartAndEnd();
+                OutOp = Operator.Op;
+                OutOperand = Text.Mid(CharIndex + OperatorLen).TrimStartAndEnd().TrimQuotes();
+                return true;
+            }
+        }
+    }
+
+    OutName.Reset();
+    OutOp = EActorDebuggerConditionOp::Changed;
+    OutOperand.Reset();
+    return Text.IsEmpty() || Text.Equals(TEXT("changed"), ESearchCase::IgnoreCase);
+}
+
+/*
+* Picks the test for the property's type and operator and parses the operand into the form that test reads
+*/
+bool FActorDebuggerCondition::Compile(const FProperty* InProperty, EActorDebuggerConditionOp InOp, const FString& InOperand, bool bCompareNum, FText& OutError)
+{
+    check(InProperty);
+
+    Property = InProperty;
+    Op = InOp;
+    Test = nullptr;
+
+    if (Op == EActorDebuggerConditionOp::Changed)
+    {
+        OutError = FText::FromString("The condition has no operator");
+        return false;
+    }
+
+    if (InOperand.IsEmpty())
+    {
+        OutError = FText::FromString("The condition has no value to compare with");
+        return false;
+    }
+
+    bool bValidOperand = true;
+    const TCHAR* TypeName = nullptr;
+
+    if (bCompareNum)
+    {
+        TypeName = TEXT("Element counts");
+        bValidOperand = FCString::IsNumeric(*InOperand) && InOperand.Contains(TEXT(".")) == false;
+        *reinterpret_cast<int32*>(Operand) = FCString::Atoi(*InOperand);
+        Test = SelectTest<FContainerNumTest, true>(Op);
+    }
+    else if (Property->IsA<FBoolProperty>())
+    {
+        TypeName = TEXT("Bools");
+        bValidOperand = InOperand == TEXT("1") || InOperand == TEXT("0") || InOperand.Equals(TEXT("true"), ESearchCase::IgnoreCase) || InOperand.Equals(TEXT("false"), ESearchCase::IgnoreCase);
+        Operand[0] = InOperand == TEXT("1") || InOperand.Equals(TEXT("true"), ESearchCase::IgnoreCase);
+        Test = SelectTest<FBoolTest, false>(Op);
+    }
+    else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+    {
+        // enums are compared by their underlying value, so they can be ordered as well
+        TypeName = TEXT("Enums");
+        bValidOperand = ParseNumberOperand(EnumProperty->GetUnderlyingProperty(), EnumProperty->GetEnum(), InOperand, Operand);
+        Test = SelectNumberTest(EnumProperty->GetUnderlyingProperty(), Op);
+    }
+    else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+    {
+        TypeName = TEXT("Numbers");
+        bValidOperand = ParseNumberOperand(NumericProperty, NumericProperty->GetIntPropertyEnum(), InOperand, Operand);
+        Test = SelectNumberTest(NumericProperty, Op);
+    }
+    else if (Property->IsA<FStrProperty>())
+    {
+        TypeName = TEXT("Strings");
+        OperandString = InOperand;
+        Test = SelectTest<FStringTest, true>(Op);
+    }
+    else if (Property->IsA<FNameProperty>())
+    {
+        TypeName = TEXT("Names");
+        OperandName = FName(*InOperand);
+        Test = SelectTest<FNameTest, false>(Op);
+    }
+    else if (Property->IsA<FObjectPropertyBase>())
+    {
+        TypeName = TEXT("Object references");
+        bValidOperand = InOperand.Equals(TEXT("None"), ESearchCase::IgnoreCase) || InOperand.Equals(TEXT("nullptr"), ESearchCase::IgnoreCase);
+        Test = SelectTest<FObjectTest, false>(Op);
+    }
+    else
+    {
+        OutError = FText::FromString(FString::Printf(TEXT("%s values can't be compared"), *Property->GetCPPType()));
+        return false;
+    }
+
+    if (bValidOperand == false)
+    {
+        OutError = FText::FromString(FString::Printf(TEXT("\"%s\" isn't a valid value for %s"), *InOperand, *Property->GetCPPType()));
+        Test = nullptr;
+        return false;
+    }
+
+    if (Test == nullptr)
+    {
+        OutError = FText::FromString(FString::Printf(TEXT("%s can only be compared with == and !="), TypeName));
+        return false;
+    }
+
+    return true;
+}
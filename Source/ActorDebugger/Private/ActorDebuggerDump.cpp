@@ -0,0 +1,1009 @@
+#include "ActorDebuggerDump.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerQuery.h"
+#include "ActorDebuggerValueHash.h"
+#include "ActorDebuggerStats.h"
+#include "ActorDebugger.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+#include "UObject/UnrealType.h"
+#include <cstdio>
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerDumpDepth(
+    TEXT("ActorDebugger.DumpDepth"),
+    2,
+    TEXT("How many levels of subobjects an Actor Debugger dump follows below each selected object"));
+
+static TAutoConsoleVariable<float> CVarActorDebuggerDumpBudgetMs(
+    TEXT("ActorDebugger.DumpBudgetMs"),
+    2.0f,
+    TEXT("How many milliseconds Actor Debugger dumps may spend writing in one frame. A pass that doesn't fit carries on in the next frame"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerDumpMaxElements(
+    TEXT("ActorDebugger.DumpMaxElements"),
+    1024,
+    TEXT("Containers with more elements than this only have their first elements written to an Actor Debugger dump"));
+
+namespace ActorDebuggerDump
+{
+    /*
+    * Writes to the process's standard output, which is where dedicated servers print their log. What the writer hands
+    * over is held until it flushes at the end of a pass and then written in one go, so the log never lands in the
+    * middle of a line of JSON
+    */
+    class FStdoutArchive : public FArchive
+    {
+    public:
+        FStdoutArchive()
+        {
+            SetIsSaving(true);
+            SetIsPersistent(true);
+        }
+
+        virtual void Serialize(void* Data, int64 Num) override
+        {
+            Pending.Append(static_cast<const uint8*>(Data), Num);
+        }
+
+        virtual void Flush() override
+        {
+            if (Pending.Num() > 0)
+            {
+                fwrite(Pending.GetData(), 1, Pending.Num(), stdout);
+                Pending.Reset();
+            }
+            fflush(stdout);
+        }
+
+        virtual bool Close() override
+        {
+            Flush();
+            Pending.Empty();
+            return true;
+        }
+
+        virtual FString GetArchiveName() const override
+        {
+            return TEXT("stdout");
+        }
+
+    private:
+        /* The part of the pass handed over since the last flush */
+        TArray64<uint8> Pending;
+    };
+
+    static bool IsNumber(EActorDebuggerPropertyType Type)
+    {
+        switch (Type)
+        {
+        case EActorDebuggerPropertyType::Int8:
+        case EActorDebuggerPropertyType::Int16:
+        case EActorDebuggerPropertyType::Int32:
+        case EActorDebuggerPropertyType::Int64:
+        case EActorDebuggerPropertyType::Byte:
+        case EActorDebuggerPropertyType::UInt16:
+        case EActorDebuggerPropertyType::UInt32:
+        case EActorDebuggerPropertyType::UInt64:
+        case EActorDebuggerPropertyType::Float:
+        case EActorDebuggerPropertyType::Double:
+            return true;
+        default:
+            return false;
+        }
+    }
+}
+
+using namespace ActorDebuggerDump;
+
+FActorDebuggerDumpWriter::~FActorDebuggerDumpWriter()
+{
+    Close();
+}
+
+FString FActorDebuggerDumpWriter::GetDefaultFilename(EActorDebuggerDumpFormat Format)
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ActorDebugger"), TEXT("Dumps"),
+        FString::Printf(TEXT("Dump-%s.%s"), *FDateTime::Now().ToString(), Format == EActorDebuggerDumpFormat::Json ? TEXT("jsonl") : TEXT("addump")));
+}
+
+TUniquePtr<FArchive> FActorDebuggerDumpWriter::CreateOutput(const FString& Target)
+{
+    if (Target.Equals(TEXT("stdout"), ESearchCase::IgnoreCase))
+    {
+        return MakeUnique<FStdoutArchive>();
+    }
+
+    IFileManager::Get().MakeDirectory(*FPaths::GetPath(Target), true);
+    TUniquePtr<FArchive> Output(IFileManager::Get().CreateFileWriter(*Target));
+    if (Output.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: could not create dump file %s"), *Target);
+    }
+    return Output;
+}
+
+void FActorDebuggerDumpWriter::Open(TUniquePtr<FArchive> InOutput, EActorDebuggerDumpFormat InFormat)
+{
+    Close();
+
+    Output = MoveTemp(InOutput);
+    Format = InFormat;
+    MaxElements = FMath::Max(CVarActorDebuggerDumpMaxElements.GetValueOnGameThread(), 0);
+    BytesWritten = 0;
+    Buffer.Reset(FlushSize);
+    NameIds.Reset();
+    ObjectIds.Reset();
+    VisitedObjects.Reset();
+
+    if (Format == EActorDebuggerDumpFormat::Binary)
+    {
+        WriteBytes(&Magic, sizeof(Magic));
+        WriteBytes(&Version, sizeof(Version));
+    }
+}
+
+void FActorDebuggerDumpWriter::Close()
+{
+    if (Output.IsValid() == false)
+    {
+        return;
+    }
+
+    Flush();
+    Output->Close();
+    Output.Reset();
+
+    // the buffer is only worth keeping while it is used
+    Buffer.Empty();
+    NeedsSeparator.Reset();
+    VisitedObjects.Empty();
+}
+
+void FActorDebuggerDumpWriter::Flush()
+{
+    HandOver();
+    if (Output.IsValid())
+    {
+        Output->Flush();
+    }
+}
+
+/*
+* Gives the buffer to the output without flushing it, the output may hold it until the pass is complete
+*/
+void FActorDebuggerDumpWriter::HandOver()
+{
+    if (Output.IsValid() && Buffer.Num() > 0)
+    {
+        Output->Serialize(Buffer.GetData(), Buffer.Num());
+        BytesWritten += Buffer.Num();
+    }
+    Buffer.Reset();
+}
+
+SIZE_T FActorDebuggerDumpWriter::GetAllocatedSize() const
+{
+    return Buffer.GetAllocatedSize() + NeedsSeparator.GetAllocatedSize() + NameIds.GetAllocatedSize() + ObjectIds.GetAllocatedSize() + VisitedObjects.GetAllocatedSize();
+}
+
+void FActorDebuggerDumpWriter::BeginFrame(bool bDelta)
+{
+    const uint64 Frame = GFrameCounter;
+    const double Time = FPlatformTime::Seconds();
+    VisitedObjects.Reset();
+
+    if (Format == EActorDebuggerDumpFormat::Json)
+    {
+        ANSICHAR Header[128];
+        FCStringAnsi::Sprintf(Header, "{\"frame\":%llu,\"time\":%.6f,\"delta\":%s,\"objects\":[", static_cast<unsigned long long>(Frame), Time, bDelta ? "true" : "false");
+        WriteAscii(Header);
+        NeedsSeparator.Add(false);
+    }
+    else
+    {
+        const uint8 bDeltaByte = bDelta ? 1 : 0;
+        WriteToken(EToken::Frame);
+        WriteBytes(&Frame, sizeof(Frame));
+        WriteBytes(&Time, sizeof(Time));
+        WriteByte(bDeltaByte);
+    }
+}
+
+/*
+* A pass is flushed as soon as it is complete, whoever reads the output sees whole passes without waiting for the
+* buffer to fill
+*/
+void FActorDebuggerDumpWriter::EndFrame()
+{
+    if (Format == EActorDebuggerDumpFormat::Json)
+    {
+        NeedsSeparator.Pop(EAllowShrinking::No);
+        WriteAscii("]}\n");
+    }
+    else
+    {
+        WriteToken(EToken::EndFrame);
+    }
+    Flush();
+}
+
+/*
+* The objects expanded so far are kept for the whole pass, a tree that reaches an object an earlier tree of the pass
+* already expanded writes its id only, the same goes for a selected object that was already expanded
+*/
+void FActorDebuggerDumpWriter::WriteObjectTree(UObject* Object, int32 InMaxDepth)
+{
+    MaxDepth = InMaxDepth;
+
+    bool bAlreadyVisited = false;
+    VisitedObjects.Add(FObjectKey(Object), &bAlreadyVisited);
+
+    BeginObjectScope(NAME_None, Object);
+    if (bAlreadyVisited == false)
+    {
+        WriteObjectProperties(Object, 0);
+    }
+    EndScope(false);
+    FlushIfFull();
+}
+
+void FActorDebuggerDumpWriter::BeginObject(UObject* Object)
+{
+    MaxDepth = 0;
+    BeginObjectScope(NAME_None, Object);
+}
+
+void FActorDebuggerDumpWriter::WriteProperty(const FActorDebuggerPropertySchemaEntry& Entry, UObject* Object)
+{
+    WritePropertyValue(Entry.Name, Entry.Property, Entry.GetValuePtr(Object), Object, Entry.Formatter, 0);
+    FlushIfFull();
+}
+
+void FActorDebuggerDumpWriter::EndObject()
+{
+    EndScope(false);
+}
+
+/*
+* The properties of an object in the order of its schema, the same ones the tree shows
+*/
+void FActorDebuggerDumpWriter::WriteObjectProperties(UObject* Object, int32 Depth)
+{
+    FActorDebuggerClassSchemaPtr Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(Object->GetClass());
+    if (Schema.IsValid() == false)
+    {
+        return;
+    }
+
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+    {
+        WritePropertyValue(Entry.Name, Entry.Property, Entry.GetValuePtr(Object), Object, Entry.Formatter, Depth);
+        FlushIfFull();
+    }
+}
+
+/*
+* C style arrays are an array of their elements, anything else is a single element. Formatter formats the elements
+*/
+void FActorDebuggerDumpWriter::WritePropertyValue(FName Name, const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FActorDebuggerFormatFunction Formatter, int32 Depth)
+{
+    if (Property->ArrayDim == 1)
+    {
+        WriteElement(Name, Property, ValuePtr, Owner, Formatter, Depth);
+        return;
+    }
+
+    BeginArrayScope(Name, Property->ArrayDim);
+    for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+    {
+        WriteElement(NAME_None, Property, ValuePtr + Index * Property->ElementSize, Owner, Formatter, Depth);
+    }
+    EndScope(true);
+}
+
+/*
+* Script containers are arrays of their first MaxElements elements. Structs are their members unless they have a
+* formatter of their own, a vector reads better as one value. References to objects the tree would expand are the
+* object's properties the first time they are reached within MaxDepth levels, anything else is a single value
+*/
+void FActorDebuggerDumpWriter::WriteElement(FName Name, const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FActorDebuggerFormatFunction Formatter, int32 Depth)
+{
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+    {
+        FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+        const int32 Num = FMath::Min(Helper.Num(), MaxElements);
+
+        BeginArrayScope(Name, Num);
+        for (int32 Index = 0; Index < Num; ++Index)
+        {
+            WriteElement(NAME_None, ArrayProperty->Inner, Helper.GetRawPtr(Index), Owner, Formatter, Depth);
+            FlushIfFull();
+        }
+        EndScope(true);
+        return;
+    }
+
+    if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+    {
+        FScriptSetHelper Helper(SetProperty, ValuePtr);
+        const int32 Num = FMath::Min(Helper.Num(), MaxElements);
+
+        BeginArrayScope(Name, Num);
+        for (FScriptSetHelper::FIterator It(Helper); It && It.GetLogicalIndex() < Num; ++It)
+        {
+            WriteElement(NAME_None, SetProperty->ElementProp, Helper.GetElementPtr(It), Owner, Formatter, Depth);
+            FlushIfFull();
+        }
+        EndScope(true);
+        return;
+    }
+
+    if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+    {
+        FScriptMapHelper Helper(MapProperty, ValuePtr);
+        const int32 Num = FMath::Min(Helper.Num(), MaxElements);
+        const FActorDebuggerFormatFunction KeyFormatter = FActorDebuggerFormatters::Select(MapProperty->KeyProp);
+
+        BeginArrayScope(Name, Num);
+        for (FScriptMapHelper::FIterator It(Helper); It && It.GetLogicalIndex() < Num; ++It)
+        {
+            BeginArrayScope(NAME_None, 2);
+            WriteElement(NAME_None, MapProperty->KeyProp, Helper.GetKeyPtr(It), Owner, KeyFormatter, Depth);
+            WriteElement(NAME_None, MapProperty->ValueProp, Helper.GetValuePtr(It), Owner, Formatter, Depth);
+            EndScope(true);
+            FlushIfFull();
+        }
+        EndScope(true);
+        return;
+    }
+
+    if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property); StructProperty && FActorDebuggerFormatters::IsFallback(Formatter))
+    {
+        FActorDebuggerClassSchemaPtr Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(StructProperty->Struct);
+
+        BeginStructScope(Name);
+        for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+        {
+            WritePropertyValue(Entry.Name, Entry.Property, Entry.GetValuePtr(ValuePtr), Owner, Entry.Formatter, Depth);
+        }
+        EndScope(false);
+        return;
+    }
+
+    if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property); ObjectProperty && Depth < MaxDepth)
+    {
+        UObject* Object = ObjectProperty->GetObjectPropertyValue(ValuePtr);
+
+        bool bAlreadyVisited = true;
+        if (IsValid(Object) && FActorDebuggerInspection::IsUObjectOfInterest(Object))
+        {
+            VisitedObjects.Add(FObjectKey(Object), &bAlreadyVisited);
+        }
+
+        if (bAlreadyVisited == false)
+        {
+            BeginObjectScope(Name, Object);
+            WriteObjectProperties(Object, Depth + 1);
+            EndScope(false);
+            return;
+        }
+    }
+
+    WriteValue(Name, Property, ValuePtr, Owner, Formatter);
+}
+
+void FActorDebuggerDumpWriter::BeginObjectScope(FName Name, UObject* Object)
+{
+    bool bNew = false;
+    const uint32 ObjectId = FindOrAddObjectId(Object, bNew);
+
+    if (Format == EActorDebuggerDumpFormat::Json)
+    {
+        WriteJsonKey(Name);
+        WriteByte('{');
+        WriteJsonObjectHeader(Object, ObjectId, bNew);
+        NeedsSeparator.Add(true);
+        return;
+    }
+
+    const uint32 NameId = FindOrWriteName(Name);
+    if (bNew)
+    {
+        WriteToken(EToken::ObjectInfo);
+        WriteVarInt(ObjectId);
+        WriteString(Object->GetName());
+        WriteString(Object->GetClass()->GetPathName());
+        WriteString(Object->GetPathName());
+    }
+    WriteToken(EToken::Object);
+    WriteVarInt(NameId);
+    WriteVarInt(ObjectId);
+}
+
+void FActorDebuggerDumpWriter::BeginStructScope(FName Name)
+{
+    if (Format == EActorDebuggerDumpFormat::Json)
+    {
+        WriteJsonKey(Name);
+        WriteByte('{');
+        NeedsSeparator.Add(false);
+        return;
+    }
+
+    const uint32 NameId = FindOrWriteName(Name);
+    WriteToken(EToken::Struct);
+    WriteVarInt(NameId);
+}
+
+void FActorDebuggerDumpWriter::BeginArrayScope(FName Name, int32 Num)
+{
+    if (Format == EActorDebuggerDumpFormat::Json)
+    {
+        WriteJsonKey(Name);
+        WriteByte('[');
+        NeedsSeparator.Add(false);
+        return;
+    }
+
+    const uint32 NameId = FindOrWriteName(Name);
+    WriteToken(EToken::Array);
+    WriteVarInt(NameId);
+    WriteVarInt(Num);
+}
+
+void FActorDebuggerDumpWriter::EndScope(bool bArray)
+{
+    if (Format == EActorDebuggerDumpFormat::Json)
+    {
+        NeedsSeparator.Pop(EAllowShrinking::No);
+        WriteByte(bArray ? ']' : '}');
+        return;
+    }
+
+    WriteToken(EToken::EndScope);
+}
+
+/*
+* Numbers and bools keep their type, JSON has no NaN or infinity so those are written as text. Every other value is
+* the text the debugger shows
+*/
+void FActorDebuggerDumpWriter::WriteValue(FName Name, const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FActorDebuggerFormatFunction Formatter)
+{
+    const EActorDebuggerPropertyType Type = FActorDebuggerSchemaCache::GetPropertyType(Property);
+
+    if (Format == EActorDebuggerDumpFormat::Json)
+    {
+        WriteJsonKey(Name);
+
+        if (Type == EActorDebuggerPropertyType::Bool)
+        {
+            WriteAscii(static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValuePtr) ? "true" : "false");
+            return;
+        }
+
+        ValueText.Reset();
+        Formatter(Property, ValuePtr, Owner, ValueText);
+
+        const FNumericProperty* NumericProperty = IsNumber(Type) ? static_cast<const FNumericProperty*>(Property) : nullptr;
+        if (NumericProperty && (NumericProperty->IsInteger() || FMath::IsFinite(NumericProperty->GetFloatingPointPropertyValue(ValuePtr))))
+        {
+            WriteUtf8(ValueText);
+        }
+        else
+        {
+            WriteJsonString(ValueText);
+        }
+        return;
+    }
+
+    const uint32 NameId = FindOrWriteName(Name);
+    WriteToken(EToken::Value);
+    WriteVarInt(NameId);
+
+    if (Type == EActorDebuggerPropertyType::Bool)
+    {
+        WriteByte(static_cast<uint8>(EValueEncoding::Bool));
+        WriteVarInt(1);
+        WriteByte(static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValuePtr) ? 1 : 0);
+    }
+    else if (IsNumber(Type))
+    {
+        WriteByte(static_cast<uint8>(EValueEncoding::Raw));
+        WriteVarInt(Property->ElementSize);
+        WriteBytes(ValuePtr, Property->ElementSize);
+    }
+    else
+    {
+        ValueText.Reset();
+        Formatter(Property, ValuePtr, Owner, ValueText);
+        WriteByte(static_cast<uint8>(EValueEncoding::Text));
+        WriteString(ValueText);
+    }
+}
+
+/*
+* Elements have no key. Names are written through ValueText, before the value is formatted into it
+*/
+void FActorDebuggerDumpWriter::WriteJsonKey(FName Name)
+{
+    if (NeedsSeparator.Num() > 0)
+    {
+        if (NeedsSeparator.Last())
+        {
+            WriteByte(',');
+        }
+        NeedsSeparator.Last() = true;
+    }
+
+    if (Name.IsNone() == false)
+    {
+        ValueText.Reset();
+        Name.AppendString(ValueText);
+        WriteJsonString(ValueText);
+        WriteByte(':');
+    }
+}
+
+void FActorDebuggerDumpWriter::WriteJsonString(FStringView Text)
+{
+    EscapedText.Reset();
+    EscapedText.AppendChar(TEXT('"'));
+
+    for (const TCHAR Char : Text)
+    {
+        switch (Char)
+        {
+        case TEXT('"'):  EscapedText.Append(TEXT("\\\"")); break;
+        case TEXT('\\'): EscapedText.Append(TEXT("\\\\")); break;
+        case TEXT('\n'): EscapedText.Append(TEXT("\\n")); break;
+        case TEXT('\r'): EscapedText.Append(TEXT("\\r")); break;
+        case TEXT('\t'): EscapedText.Append(TEXT("\\t")); break;
+        default:
+            if (Char < 0x20)
+            {
+                EscapedText.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+            }
+            else
+            {
+                EscapedText.AppendChar(Char);
+            }
+        }
+    }
+
+    EscapedText.AppendChar(TEXT('"'));
+    WriteUtf8(EscapedText);
+}
+
+/*
+* Objects are described the first time they are written, after that their id is enough
+*/
+void FActorDebuggerDumpWriter::WriteJsonObjectHeader(UObject* Object, uint32 ObjectId, bool bNew)
+{
+    ANSICHAR Id[32];
+    FCStringAnsi::Sprintf(Id, "\"@id\":%u", ObjectId);
+    WriteAscii(Id);
+
+    if (bNew)
+    {
+        WriteAscii(",\"@name\":");
+        WriteJsonString(Object->GetName());
+        WriteAscii(",\"@class\":");
+        WriteJsonString(Object->GetClass()->GetPathName());
+        WriteAscii(",\"@path\":");
+        WriteJsonString(Object->GetPathName());
+    }
+}
+
+/*
+* Id 0 stands for no name, the elements of arrays
+*/
+uint32 FActorDebuggerDumpWriter::FindOrWriteName(FName Name)
+{
+    if (Name.IsNone())
+    {
+        return 0;
+    }
+
+    if (const uint32* NameId = NameIds.Find(Name))
+    {
+        return *NameId;
+    }
+
+    const uint32 NameId = NameIds.Num() + 1;
+    NameIds.Add(Name, NameId);
+
+    ValueText.Reset();
+    Name.AppendString(ValueText);
+    WriteToken(EToken::Name);
+    WriteVarInt(NameId);
+    WriteString(ValueText);
+
+    return NameId;
+}
+
+uint32 FActorDebuggerDumpWriter::FindOrAddObjectId(UObject* Object, bool& bOutNew)
+{
+    const int32 NumObjects = ObjectIds.Num();
+    const uint32 ObjectId = ObjectIds.FindOrAdd(Object, NumObjects);
+    bOutNew = ObjectIds.Num() > NumObjects;
+    return ObjectId;
+}
+
+/*
+* Seven bits per byte, least significant first, the top bit set on every byte but the last
+*/
+void FActorDebuggerDumpWriter::WriteVarInt(uint64 Value)
+{
+    while (Value >= 0x80)
+    {
+        WriteByte(static_cast<uint8>(Value) | 0x80);
+        Value >>= 7;
+    }
+    WriteByte(static_cast<uint8>(Value));
+}
+
+void FActorDebuggerDumpWriter::WriteString(FStringView Text)
+{
+    FTCHARToUTF8 Utf8(Text.GetData(), Text.Len());
+    WriteVarInt(Utf8.Length());
+    WriteBytes(Utf8.Get(), Utf8.Length());
+}
+
+void FActorDebuggerDumpWriter::WriteBytes(const void* Data, int32 Num)
+{
+    Buffer.Append(static_cast<const uint8*>(Data), Num);
+}
+
+void FActorDebuggerDumpWriter::WriteAscii(const ANSICHAR* Text)
+{
+    WriteBytes(Text, FCStringAnsi::Strlen(Text));
+}
+
+void FActorDebuggerDumpWriter::WriteUtf8(FStringView Text)
+{
+    FTCHARToUTF8 Utf8(Text.GetData(), Text.Len());
+    WriteBytes(Utf8.Get(), Utf8.Length());
+}
+
+bool FActorDebuggerDumpSession::Start(TConstArrayView<UObject*> Roots, const FOptions& InOptions, TUniquePtr<FArchive> Output)
+{
+    Options = InOptions;
+    Depth = FMath::Max(CVarActorDebuggerDumpDepth.GetValueOnGameThread(), 0);
+    Objects.Reset();
+    Cursor = INDEX_NONE;
+    NextPassTime = 0.0;
+    NumPasses = 0;
+
+    TSet<const UObject*> Watched;
+    for (UObject* Root : Roots)
+    {
+        // tree sessions expand the subobjects within each object's tree, delta sessions watch them separately
+        WatchObjectGraph(Root, Options.bDeltas ? Depth : 0, Watched);
+    }
+
+    if (Objects.Num() == 0 || Output.IsValid() == false)
+    {
+        return false;
+    }
+
+    Writer.Open(MoveTemp(Output), Options.Format);
+    return true;
+}
+
+/*
+* Follows the references the tree would expand, object properties and arrays of them, the way captures do
+*/
+void FActorDebuggerDumpSession::WatchObjectGraph(UObject* Object, int32 RemainingDepth, TSet<const UObject*>& Watched)
+{
+    if (IsValid(Object) == false)
+    {
+        return;
+    }
+
+    bool bAlreadyWatched = false;
+    Watched.Add(Object, &bAlreadyWatched);
+    if (bAlreadyWatched)
+    {
+        return;
+    }
+
+    FWatchedObject& WatchedObject = Objects.AddDefaulted_GetRef();
+    WatchedObject.Object = Object;
+    WatchedObject.Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(Object->GetClass());
+
+    if (RemainingDepth == 0 || WatchedObject.Schema.IsValid() == false)
+    {
+        return;
+    }
+
+    // the schema is held, adding to Objects may move the entry
+    const FActorDebuggerClassSchemaPtr Schema = WatchedObject.Schema;
+    TArray<UObject*, TInlineAllocator<16>> References;
+
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+    {
+        const uint8* ValuePtr = Entry.GetValuePtr(Object);
+
+        if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Entry.Property); ObjectProperty && Entry.ArrayDim == 1)
+        {
+            References.Add(ObjectProperty->GetObjectPropertyValue(ValuePtr));
+        }
+        else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Entry.Property); ArrayProperty && ArrayProperty->Inner->IsA<FObjectProperty>())
+        {
+            const FObjectProperty* Inner = CastFieldChecked<FObjectProperty>(ArrayProperty->Inner);
+            FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+            for (int32 Index = 0; Index < Helper.Num(); ++Index)
+            {
+                References.Add(Inner->GetObjectPropertyValue(Helper.GetRawPtr(Index)));
+            }
+        }
+    }
+
+    for (UObject* Reference : References)
+    {
+        if (IsValid(Reference) && FActorDebuggerInspection::IsUObjectOfInterest(Reference))
+        {
+            WatchObjectGraph(Reference, RemainingDepth - 1, Watched);
+        }
+    }
+}
+
+/*
+* Every pass writes at least one object, so a budget smaller than a single object still makes progress. Objects
+* destroyed since the session started are skipped
+*/
+bool FActorDebuggerDumpSession::Tick(double CurrentTime, double BudgetSeconds)
+{
+    if (Writer.IsOpen() == false)
+    {
+        return false;
+    }
+
+    if (Cursor == INDEX_NONE)
+    {
+        if (CurrentTime < NextPassTime)
+        {
+            return true;
+        }
+
+        Writer.BeginFrame(Options.bDeltas);
+        Cursor = 0;
+        NextPassTime = CurrentTime + Options.Interval;
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    while (Cursor < Objects.Num())
+    {
+        FWatchedObject& Watched = Objects[Cursor++];
+        if (UObject* Object = Watched.Object.Get(); IsValid(Object))
+        {
+            if (Options.bDeltas)
+            {
+                WriteDelta(Watched);
+            }
+            else
+            {
+                Writer.WriteObjectTree(Object, Depth);
+            }
+        }
+
+        if (FPlatformTime::Seconds() - StartSeconds >= BudgetSeconds)
+        {
+            break;
+        }
+    }
+
+    if (Cursor < Objects.Num())
+    {
+        return true;
+    }
+
+    Writer.EndFrame();
+    Cursor = INDEX_NONE;
+    ++NumPasses;
+
+    if (Options.Interval <= 0.0)
+    {
+        Writer.Close();
+        return false;
+    }
+    return true;
+}
+
+/*
+* Only the properties whose hash changed are written, an object where nothing changed isn't written at all
+*/
+void FActorDebuggerDumpSession::WriteDelta(FWatchedObject& Watched)
+{
+    UObject* Object = Watched.Object.Get();
+
+    if (Watched.Schema.IsValid() == false)
+    {
+        Watched.Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(Object->GetClass());
+        Watched.bWriteAll = true;
+        if (Watched.Schema.IsValid() == false)
+        {
+            return;
+        }
+    }
+
+    const TArray<FActorDebuggerPropertySchemaEntry>& Entries = Watched.Schema->Entries;
+    if (Watched.bWriteAll)
+    {
+        Watched.Hashes.SetNumZeroed(Entries.Num());
+    }
+
+    bool bBegun = false;
+    for (int32 Index = 0; Index < Entries.Num(); ++Index)
+    {
+        const FActorDebuggerPropertySchemaEntry& Entry = Entries[Index];
+        const uint64 Hash = ActorDebugger::HashPropertyValue(Entry.Property, Entry.GetValuePtr(Object));
+
+        if (Watched.bWriteAll == false && Hash == Watched.Hashes[Index])
+        {
+            continue;
+        }
+        Watched.Hashes[Index] = Hash;
+
+        if (bBegun == false)
+        {
+            Writer.BeginObject(Object);
+            bBegun = true;
+        }
+        Writer.WriteProperty(Entry, Object);
+    }
+
+    if (bBegun)
+    {
+        Writer.EndObject();
+    }
+    Watched.bWriteAll = false;
+}
+
+void FActorDebuggerDumpSession::HandleSchemasInvalidated()
+{
+    for (FWatchedObject& Watched : Objects)
+    {
+        Watched.Schema.Reset();
+    }
+}
+
+SIZE_T FActorDebuggerDumpSession::GetAllocatedSize() const
+{
+    SIZE_T Size = Writer.GetAllocatedSize() + Objects.GetAllocatedSize();
+    for (const FWatchedObject& Watched : Objects)
+    {
+        Size += Watched.Hashes.GetAllocatedSize();
+    }
+    return Size;
+}
+
+FActorDebuggerDumps& FActorDebuggerDumps::Get()
+{
+    static FActorDebuggerDumps Instance;
+    return Instance;
+}
+
+bool FActorDebuggerDumps::Start(TConstArrayView<UObject*> Roots, const FActorDebuggerDumpSession::FOptions& Options, const FString& Target)
+{
+    const FString OutputName = Target.IsEmpty() ? FActorDebuggerDumpWriter::GetDefaultFilename(Options.Format) : Target;
+    TUniquePtr<FArchive> Output = FActorDebuggerDumpWriter::CreateOutput(OutputName);
+    if (Output.IsValid() == false)
+    {
+        return false;
+    }
+
+    TUniquePtr<FActorDebuggerDumpSession> Session = MakeUnique<FActorDebuggerDumpSession>();
+    if (Session->Start(Roots, Options, MoveTemp(Output)) == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: there is nothing to dump"));
+        return false;
+    }
+
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: dumping %d objects to %s"), Session->GetNumObjects(), *OutputName);
+    Sessions.Add(MoveTemp(Session));
+
+    if (TickerHandle.IsValid() == false)
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FActorDebuggerDumps::HandleTicker));
+    }
+    if (SchemasInvalidatedHandle.IsValid() == false)
+    {
+        SchemasInvalidatedHandle = FActorDebuggerSchemaCache::Get().OnSchemasInvalidated.AddRaw(this, &FActorDebuggerDumps::HandleSchemasInvalidated);
+    }
+    return true;
+}
+
+void FActorDebuggerDumps::StopAll()
+{
+    for (const TUniquePtr<FActorDebuggerDumpSession>& Session : Sessions)
+    {
+        Session->Stop();
+    }
+    Sessions.Reset();
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+    if (SchemasInvalidatedHandle.IsValid())
+    {
+        FActorDebuggerSchemaCache::Get().OnSchemasInvalidated.Remove(SchemasInvalidatedHandle);
+        SchemasInvalidatedHandle.Reset();
+    }
+}
+
+/*
+* The sessions share the frame's budget. The ticker is removed along with the last session
+*/
+bool FActorDebuggerDumps::HandleTicker(float DeltaTime)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_Dump);
+
+    const double CurrentTime = FPlatformTime::Seconds();
+    const double BudgetSeconds = FMath::Max(CVarActorDebuggerDumpBudgetMs.GetValueOnGameThread(), 0.0f) / 1000.0 / FMath::Max(Sessions.Num(), 1);
+
+    for (int32 Index = Sessions.Num() - 1; Index >= 0; --Index)
+    {
+        FActorDebuggerDumpSession& Session = *Sessions[Index];
+        const int64 BytesBefore = Session.GetBytesWritten();
+        const bool bRunning = Session.Tick(CurrentTime, BudgetSeconds);
+        INC_DWORD_STAT_BY(STAT_ActorDebugger_DumpedBytes, Session.GetBytesWritten() - BytesBefore);
+
+        if (bRunning == false)
+        {
+            UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: dump finished, %lld bytes written"), Session.GetBytesWritten());
+            Sessions.RemoveAt(Index);
+        }
+    }
+
+    if (Sessions.Num() > 0)
+    {
+        return true;
+    }
+
+    TickerHandle.Reset();
+    FActorDebuggerSchemaCache::Get().OnSchemasInvalidated.Remove(SchemasInvalidatedHandle);
+    SchemasInvalidatedHandle.Reset();
+    return false;
+}
+
+void FActorDebuggerDumps::HandleSchemasInvalidated()
+{
+    for (const TUniquePtr<FActorDebuggerDumpSession>& Session : Sessions)
+    {
+        Session->HandleSchemasInvalidated();
+    }
+}
+
+/*
+* A class name selects every actor of the class, otherwise the actor with the name
+*/
+void FActorDebuggerDumps::FindActors(UWorld* World, const FString& Selector, TArray<UObject*>& OutActors)
+{
+    if (World == nullptr || Selector.IsEmpty())
+    {
+        return;
+    }
+
+    if (UClass* Class = FActorDebuggerQuery::FindClass(Selector); Class && Class->IsChildOf<AActor>())
+    {
+        for (TActorIterator<AActor> It(World, Class); It; ++It)
+        {
+            OutActors.Add(*It);
+        }
+        return;
+    }
+
+    for (TActorIterator<AActor> It(World); It; ++It)
+    {
+        if (It->GetName() == Selector)
+        {
+            OutActors.Add(*It);
+        }
+    }
+}
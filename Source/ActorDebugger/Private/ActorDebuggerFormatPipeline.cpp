@@ -0,0 +1,252 @@
+#include "ActorDebuggerFormatPipeline.h"
+#include "UObject/UnrealType.h"
+#include "UObject/GarbageCollection.h"
+#include "ActorDebuggerFormatters.h"
+#include "ActorDebuggerStats.h"
+
+FActorDebuggerFormatPipeline::~FActorDebuggerFormatPipeline()
+{
+    Reset();
+}
+
+/*
+* Copies a value into the staging buffer. Plain old data is a memcpy, anything else (strings, text) has to be
+* copy constructed so that the worker doesn't read memory the game thread is free to change
+*/
+void FActorDebuggerFormatPipeline::Enqueue(FReflectedActorPropertyPtr Item, const uint8* ValuePtr, uint64 ValueHash)
+{
+    check(IsInGameThread());
+
+    FProperty* Property = Item->Property;
+    const int32 Alignment = FMath::Max(Property->GetMinAlignment(), 1);
+    const int32 Offset = Align(Staging.Buffer.Num(), Alignment);
+
+    // non POD values are initialized for the whole static array even though only one element is copied
+    const int32 Size = Property->HasAnyPropertyFlags(CPF_IsPlainOldData) ? Property->ElementSize : Property->GetSize();
+    Staging.Buffer.AddUninitialized(Offset + Size - Staging.Buffer.Num());
+
+    uint8* Dest = Staging.Buffer.GetData() + Offset;
+    if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+    {
+        FMemory::Memcpy(Dest, ValuePtr, Property->ElementSize);
+    }
+    else
+    {
+        Property->InitializeValue(Dest);
+        Property->CopySingleValue(Dest, ValuePtr);
+    }
+
+    FJob& Job = Staging.Jobs.AddDefaulted_GetRef();
+    Job.Item = Item;
+    Job.Generation = Item->Generation;
+    Job.Property = Property;
+    Job.Formatter = Item->Formatter ? Item->Formatter : FActorDebuggerFormatters::Select(Property);
+    Job.Owner = Item->Object;
+    Job.Offset = Offset;
+    Job.ValueHash = ValueHash;
+
+    Job.FirstReference = Staging.References.Num();
+    Staging.References.Add(Job.Owner);
+    GatherObjectReferences(Property, Dest, Staging.References);
+    Job.NumReferences = Staging.References.Num() - Job.FirstReference;
+}
+
+/*
+* Both batches are reported, the staging batch may wait for the in flight one over several frames. The worker holds
+* a GC scope guard while it formats, so this never runs while it reads the references
+*/
+void FActorDebuggerFormatPipeline::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    Collector.AddReferencedObjects(Staging.References);
+    Collector.AddReferencedObjects(InFlight.References);
+}
+
+/*
+* Swaps the staging batch with the (empty) in flight batch and launches a task to format it. The arrays swap
+* their allocations so both batches keep their capacity
+*/
+void FActorDebuggerFormatPipeline::Dispatch()
+{
+    check(IsInGameThread());
+
+    if (bInFlight || Staging.Jobs.Num() == 0)
+    {
+        return;
+    }
+
+    Swap(Staging, InFlight);
+    bInFlight = true;
+
+    FBatch* Batch = &InFlight;
+    Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Batch]
+    {
+        // the copies may reference objects, they must not be collected while we export them
+        FGCScopeGuard GCGuard;
+        FormatBatch(*Batch);
+    });
+}
+
+/*
+* Nodes are never freed while the inspection exists, only released back to the arena, so a job's node can
+* always be read. A generation mismatch means it has been handed out again since the job was enqueued
+*/
+void FActorDebuggerFormatPipeline::CollectResults(TArray<TPair<FReflectedActorPropertyPtr, FText>>& OutResults)
+{
+    check(IsInGameThread());
+
+    if (bInFlight == false || Task.IsCompleted() == false)
+    {
+        return;
+    }
+
+    for (FJob& Job : InFlight.Jobs)
+    {
+        INC_DWORD_STAT_BY(STAT_ActorDebugger_ExportedBytes, Job.Result.Len() * sizeof(TCHAR));
+
+        if (Job.Item->Generation == Job.Generation && Job.Item->ValueHash == Job.ValueHash)
+        {
+            if (Job.bSkipped)
+            {
+                // sampled again, the node unlinks itself if it was its own object that went
+                Job.Item->bHasValue = false;
+                continue;
+            }
+            OutResults.Emplace(Job.Item, FText::FromString(MoveTemp(Job.Result)));
+        }
+    }
+
+    InFlight.Jobs.Reset();
+    InFlight.Buffer.Reset();
+    InFlight.References.Reset();
+    bInFlight = false;
+}
+
+void FActorDebuggerFormatPipeline::Reset()
+{
+    if (bInFlight)
+    {
+        Task.Wait();
+        InFlight.Jobs.Reset();
+        InFlight.Buffer.Reset();
+        InFlight.References.Reset();
+        bInFlight = false;
+    }
+
+    DestroyValues(Staging);
+    Staging.Jobs.Reset();
+    Staging.Buffer.Reset();
+    Staging.References.Reset();
+}
+
+/*
+* The worker only writes to the jobs' result strings, never to the arrays themselves, so their sizes can be read
+* while a batch is in flight
+*/
+SIZE_T FActorDebuggerFormatPipeline::GetAllocatedSize() const
+{
+    return Staging.Buffer.GetAllocatedSize() + Staging.Jobs.GetAllocatedSize() + Staging.References.GetAllocatedSize()
+        + InFlight.Buffer.GetAllocatedSize() + InFlight.Jobs.GetAllocatedSize() + InFlight.References.GetAllocatedSize();
+}
+
+/*
+* Runs on a worker thread under a GC scope guard. Every value is formatted into the same builder and copied out with
+* a single allocation of the right size. A job is skipped if a collection that ran before the guard was taken
+* cleared one of its references. The copies are destroyed as soon as they have been formatted so the game thread
+* only has to move the strings across
+*/
+void FActorDebuggerFormatPipeline::FormatBatch(FBatch& Batch)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_FormatBatch);
+
+    TStringBuilder<256> ValueString;
+    for (FJob& Job : Batch.Jobs)
+    {
+        for (int32 Index = Job.FirstReference; Index < Job.FirstReference + Job.NumReferences; ++Index)
+        {
+            Job.bSkipped |= Batch.References[Index] == nullptr;
+        }
+        if (Job.bSkipped)
+        {
+            continue;
+        }
+
+        const uint8* ValuePtr = Batch.Buffer.GetData() + Job.Offset;
+        ValueString.Reset();
+        Job.Formatter(Job.Property, ValuePtr, Job.Owner, ValueString);
+        Job.Result = FString(ValueString.Len(), ValueString.GetData());
+    }
+
+    DestroyValues(Batch);
+}
+
+void FActorDebuggerFormatPipeline::DestroyValues(FBatch& Batch)
+{
+    for (const FJob& Job : Batch.Jobs)
+    {
+        if (Job.Property->HasAnyPropertyFlags(CPF_IsPlainOldData | CPF_NoDestructor) == false)
+        {
+            Job.Property->DestroyValue(Batch.Buffer.GetData() + Job.Offset);
+        }
+    }
+}
+
+void FActorDebuggerFormatPipeline::GatherObjectReferences(const FProperty* Property, const uint8* ValuePtr, TArray<TObjectPtr<UObject>>& OutObjects)
+{
+    if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+    {
+        return;
+    }
+
+    for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+    {
+        const uint8* ElementPtr = ValuePtr + Index * Property->ElementSize;
+
+        // weak and soft references resolve safely on their own, only strong ones can dangle
+        if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+        {
+            if (UObject* Object = ObjectProperty->GetObjectPropertyValue(ElementPtr))
+            {
+                OutObjects.Add(Object);
+            }
+        }
+        else if (const FInterfaceProperty* InterfaceProperty = CastField<FInterfaceProperty>(Property))
+        {
+            if (UObject* Object = InterfaceProperty->GetPropertyValue(ElementPtr).GetObject())
+            {
+                OutObjects.Add(Object);
+            }
+        }
+        else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            for (const FProperty* Member = StructProperty->Struct->PropertyLink; Member; Member = Member->PropertyLinkNext)
+            {
+                GatherObjectReferences(Member, Member->ContainerPtrToValuePtr<uint8>(ElementPtr), OutObjects);
+            }
+        }
+        else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+        {
+            FScriptArrayHelper Helper(ArrayProperty, ElementPtr);
+            for (int32 ElementIndex = 0; ElementIndex < Helper.Num() && ArrayProperty->Inner->HasAnyPropertyFlags(CPF_IsPlainOldData) == false; ++ElementIndex)
+            {
+                GatherObjectReferences(ArrayProperty->Inner, Helper.GetRawPtr(ElementIndex), OutObjects);
+            }
+        }
+        else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+        {
+            FScriptSetHelper Helper(SetProperty, ElementPtr);
+            for (FScriptSetHelper::FIterator It(Helper); It; ++It)
+            {
+                GatherObjectReferences(SetProperty->ElementProp, Helper.GetElementPtr(It), OutObjects);
+            }
+        }
+        else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+        {
+            FScriptMapHelper Helper(MapProperty, ElementPtr);
+            for (FScriptMapHelper::FIterator It(Helper); It; ++It)
+            {
+                GatherObjectReferences(MapProperty->KeyProp, Helper.GetKeyPtr(It), OutObjects);
+                GatherObjectReferences(MapProperty->ValueProp, Helper.GetValuePtr(It), OutObjects);
+            }
+        }
+    }
+}
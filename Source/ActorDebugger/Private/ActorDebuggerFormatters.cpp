@@ -0,0 +1,230 @@
+#include "ActorDebuggerFormatters.h"
+#include "ActorDebuggerSchemaCache.h"
+#include "ActorDebuggerStats.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/Class.h"
+
+namespace ActorDebuggerFormatters
+{
+    /*
+    * Floating point values are exported with "%f", negative zero is shown as zero
+    */
+    static void AppendFloat(double Value, FStringBuilderBase& Out)
+    {
+        Out.Appendf(TEXT("%f"), Value == 0.0 ? 0.0 : Value);
+    }
+
+    template <typename T>
+    static void FormatSigned(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        Out.Appendf(TEXT("%lld"), static_cast<int64>(*reinterpret_cast<const T*>(ValuePtr)));
+    }
+
+    template <typename T>
+    static void FormatUnsigned(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        Out.Appendf(TEXT("%llu"), static_cast<uint64>(*reinterpret_cast<const T*>(ValuePtr)));
+    }
+
+    template <typename T>
+    static void FormatFloat(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        AppendFloat(static_cast<double>(*reinterpret_cast<const T*>(ValuePtr)), Out);
+    }
+
+    static void FormatBool(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        // bitfield bools need their mask, the property knows it
+        Out << (static_cast<const FBoolProperty*>(Property)->GetPropertyValue(ValuePtr) ? TEXT("True") : TEXT("False"));
+    }
+
+    /*
+    * Shows the name of the enum value without the enum's own name, as GetNameStringByValue does. The name is
+    * copied to the stack rather than into an FString
+    */
+    static void AppendEnumName(const UEnum* Enum, int64 Value, FStringBuilderBase& Out)
+    {
+        const FName Name = Enum ? Enum->GetNameByValue(Value) : FName();
+        if (Name.IsNone())
+        {
+            Out << TEXT("(INVALID)");
+            return;
+        }
+
+        TCHAR Buffer[NAME_SIZE];
+        Name.ToString(Buffer);
+
+        const TCHAR* ShortName = FCString::Strstr(Buffer, TEXT("::"));
+        Out << (ShortName ? ShortName + 2 : Buffer);
+    }
+
+    static void FormatEnum(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        const FEnumProperty* EnumProperty = static_cast<const FEnumProperty*>(Property);
+        AppendEnumName(EnumProperty->GetEnum(), EnumProperty->GetUnderlyingProperty()->GetSignedIntPropertyValue(ValuePtr), Out);
+    }
+
+    static void FormatByteEnum(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        AppendEnumName(static_cast<const FByteProperty*>(Property)->Enum, *ValuePtr, Out);
+    }
+
+    /*
+    * Also used for gameplay tags, whose only member is the tag's name
+    */
+    static void FormatName(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        reinterpret_cast<const FName*>(ValuePtr)->AppendString(Out);
+    }
+
+    static void FormatString(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        Out << *reinterpret_cast<const FString*>(ValuePtr);
+    }
+
+    static void AppendVector(const FVector& Vector, FStringBuilderBase& Out)
+    {
+        Out << TEXT("(X=");
+        AppendFloat(Vector.X, Out);
+        Out << TEXT(",Y=");
+        AppendFloat(Vector.Y, Out);
+        Out << TEXT(",Z=");
+        AppendFloat(Vector.Z, Out);
+        Out << TEXT(')');
+    }
+
+    static void FormatVector(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        AppendVector(*reinterpret_cast<const FVector*>(ValuePtr), Out);
+    }
+
+    static void FormatRotator(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        const FRotator& Rotator = *reinterpret_cast<const FRotator*>(ValuePtr);
+        Out << TEXT("(Pitch=");
+        AppendFloat(Rotator.Pitch, Out);
+        Out << TEXT(",Yaw=");
+        AppendFloat(Rotator.Yaw, Out);
+        Out << TEXT(",Roll=");
+        AppendFloat(Rotator.Roll, Out);
+        Out << TEXT(')');
+    }
+
+    /*
+    * Members are shown in the order they are declared in, like the generic struct export
+    */
+    static void FormatTransform(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        const FTransform& Transform = *reinterpret_cast<const FTransform*>(ValuePtr);
+        const FQuat Rotation = Transform.GetRotation();
+
+        Out << TEXT("(Rotation=(X=");
+        AppendFloat(Rotation.X, Out);
+        Out << TEXT(",Y=");
+        AppendFloat(Rotation.Y, Out);
+        Out << TEXT(",Z=");
+        AppendFloat(Rotation.Z, Out);
+        Out << TEXT(",W=");
+        AppendFloat(Rotation.W, Out);
+        Out << TEXT("),Translation=");
+        AppendVector(Transform.GetTranslation(), Out);
+        Out << TEXT(",Scale3D=");
+        AppendVector(Transform.GetScale3D(), Out);
+        Out << TEXT(')');
+    }
+
+    /*
+    * Shown as ClassPath'ObjectPath', the form ExportText uses, with both paths written straight into the builder
+    */
+    static void FormatObject(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+    {
+        const UObject* Object = static_cast<const FObjectPropertyBase*>(Property)->GetObjectPropertyValue(ValuePtr);
+        if (Object == nullptr)
+        {
+            Out << TEXT("None");
+            return;
+        }
+
+        Object->GetClass()->GetPathName(nullptr, Out);
+        Out << TEXT('\'');
+        Object->GetPathName(nullptr, Out);
+        Out << TEXT('\'');
+    }
+
+    /*
+    * FGameplayTag is declared by the GameplayTags module, which the plugin doesn't depend on. The struct is
+    * recognised by its name, and only formatted as a name if its layout is the one expected
+    */
+    static bool IsGameplayTag(const UScriptStruct* Struct)
+    {
+        static const FName GameplayTagName(TEXT("GameplayTag"));
+        if (Struct == nullptr || Struct->GetFName() != GameplayTagName)
+        {
+            return false;
+        }
+
+        const FProperty* TagName = Struct->FindPropertyByName(TEXT("TagName"));
+        return TagName && TagName->IsA<FNameProperty>() && TagName->GetOffset_ForInternal() == 0;
+    }
+
+    static FActorDebuggerFormatFunction SelectStruct(const FStructProperty* StructProperty)
+    {
+        const UScriptStruct* Struct = StructProperty->Struct;
+
+        if (Struct == TBaseStructure<FVector>::Get())    return &FormatVector;
+        if (Struct == TBaseStructure<FRotator>::Get())   return &FormatRotator;
+        if (Struct == TBaseStructure<FTransform>::Get()) return &FormatTransform;
+        if (IsGameplayTag(Struct))                       return &FormatName;
+
+        return &FActorDebuggerFormatters::ExportText;
+    }
+}
+
+using namespace ActorDebuggerFormatters;
+
+/*
+* Picks the formatter from the property's type tag. Script containers are formatted by ExportText, the debugger only
+* shows their element count and formats the elements through the element property
+*/
+FActorDebuggerFormatFunction FActorDebuggerFormatters::Select(const FProperty* Property)
+{
+    const EActorDebuggerContainerKind ContainerKind = FActorDebuggerSchemaCache::GetContainerKind(Property);
+    if (Property == nullptr || (ContainerKind != EActorDebuggerContainerKind::None && ContainerKind != EActorDebuggerContainerKind::StaticArray))
+    {
+        return &ExportText;
+    }
+
+    switch (FActorDebuggerSchemaCache::GetPropertyType(Property))
+    {
+    case EActorDebuggerPropertyType::Bool:      return &FormatBool;
+    case EActorDebuggerPropertyType::Int8:      return &FormatSigned<int8>;
+    case EActorDebuggerPropertyType::Int16:     return &FormatSigned<int16>;
+    case EActorDebuggerPropertyType::Int32:     return &FormatSigned<int32>;
+    case EActorDebuggerPropertyType::Int64:     return &FormatSigned<int64>;
+    case EActorDebuggerPropertyType::Byte:      return &FormatUnsigned<uint8>;
+    case EActorDebuggerPropertyType::UInt16:    return &FormatUnsigned<uint16>;
+    case EActorDebuggerPropertyType::UInt32:    return &FormatUnsigned<uint32>;
+    case EActorDebuggerPropertyType::UInt64:    return &FormatUnsigned<uint64>;
+    case EActorDebuggerPropertyType::Float:     return &FormatFloat<float>;
+    case EActorDebuggerPropertyType::Double:    return &FormatFloat<double>;
+    case EActorDebuggerPropertyType::Enum:      return Property->IsA<FEnumProperty>() ? &FormatEnum : &FormatByteEnum;
+    case EActorDebuggerPropertyType::Name:      return &FormatName;
+    case EActorDebuggerPropertyType::String:    return &FormatString;
+    case EActorDebuggerPropertyType::Object:    return &FormatObject;
+    case EActorDebuggerPropertyType::Struct:    return SelectStruct(CastFieldChecked<const FStructProperty>(Property));
+    default:                                    return &ExportText;
+    }
+}
+
+/*
+* The generic path: the value is exported to a temporary string and appended
+*/
+void FActorDebuggerFormatters::ExportText(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+{
+    INC_DWORD_STAT(STAT_ActorDebugger_FallbackExports);
+
+    FString ValueString;
+    Property->ExportText_Direct(ValueString, ValuePtr, ValuePtr, Owner, PPF_BlueprintDebugView);
+    Out << ValueString;
+}
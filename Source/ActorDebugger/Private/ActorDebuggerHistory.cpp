@@ -0,0 +1,367 @@
+#include "ActorDebuggerHistory.h"
+#include "ActorDebuggerValueHash.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UnrealType.h"
+#include "UObject/TextProperty.h"
+#include "UObject/ObjectKey.h"
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerHistoryFrames(
+    TEXT("ActorDebugger.HistoryFrames"),
+    1800,
+    TEXT("How many frames of history the Actor Debugger keeps while recording"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerHistoryMaxBytes(
+    TEXT("ActorDebugger.HistoryMaxBytes"),
+    8 * 1024 * 1024,
+    TEXT("The most memory an Actor Debugger recording may use, fewer frames are kept if the watched properties need more"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerHistoryMaxChannels(
+    TEXT("ActorDebugger.HistoryMaxChannels"),
+    64,
+    TEXT("How many properties the Actor Debugger can record at once"));
+
+FActorDebuggerHistoryRecorder::FActorDebuggerHistoryRecorder() = default;
+
+FActorDebuggerHistoryRecorder::~FActorDebuggerHistoryRecorder()
+{
+    Reset();
+}
+
+/*
+* Everything a recording needs is allocated here. The frame is laid out once, each channel gets a slot of a
+* fixed size that depends on how its values are encoded
+*/
+int32 FActorDebuggerHistoryRecorder::Start(TConstArrayView<FReflectedActorPropertyPtr> Items)
+{
+    check(IsInGameThread());
+
+    Reset();
+
+    const int32 MaxChannels = FMath::Max(CVarActorDebuggerHistoryMaxChannels.GetValueOnGameThread(), 1);
+
+    for (FReflectedActorPropertyPtr Item : Items)
+    {
+        if (Channels.Num() == MaxChannels)
+        {
+            break;
+        }
+
+        if (Item == nullptr || Item->Kind == EReflectedPropertyKind::Page || Item->IsValid() == false)
+        {
+            continue;
+        }
+
+        int32 ValueSize = 0;
+
+        FChannel& Channel = Channels.AddDefaulted_GetRef();
+        Channel.Item = Item;
+        Channel.Generation = Item->Generation;
+        Channel.Property = Item->Property;
+        Channel.Owner = Item->Object;
+        Channel.StableValuePtr = Item->ResolveStableValuePtr();
+        Channel.Encoding = ChooseEncoding(Item, ValueSize);
+        Channel.SlotOffset = FrameStride;
+        Channel.SlotSize = 1 + ValueSize;
+
+        FrameStride += Channel.SlotSize;
+        Item->bRecorded = true;
+    }
+
+    if (Channels.Num() == 0)
+    {
+        return 0;
+    }
+
+    // the byte budget wins over the frame count, a recording never uses more memory than it allows
+    const int64 MaxBytes = FMath::Max(CVarActorDebuggerHistoryMaxBytes.GetValueOnGameThread(), 0);
+    const int64 BytesPerFrame = FrameStride + sizeof(double);
+    Capacity = static_cast<int32>(FMath::Clamp<int64>(MaxBytes / BytesPerFrame, 2, FMath::Max(CVarActorDebuggerHistoryFrames.GetValueOnGameThread(), 2)));
+
+    Frames.SetNumZeroed(Capacity * FrameStride);
+    FrameTimes.SetNumZeroed(Capacity);
+    NumRecorded.store(0, std::memory_order_release);
+    bRecording = true;
+
+    return Channels.Num();
+}
+
+void FActorDebuggerHistoryRecorder::Stop()
+{
+    bRecording = false;
+}
+
+void FActorDebuggerHistoryRecorder::Reset()
+{
+    check(IsInGameThread());
+
+    for (const FChannel& Channel : Channels)
+    {
+        // nodes released since recording started may belong to someone else now
+        if (Channel.Item->Generation == Channel.Generation)
+        {
+            Channel.Item->bRecorded = false;
+        }
+    }
+
+    bRecording = false;
+    Channels.Empty();
+    Frames.Empty();
+    FrameTimes.Empty();
+    FrameStride = 0;
+    Capacity = 0;
+    NumRecorded.store(0, std::memory_order_release);
+}
+
+/*
+* Writes every channel's slot of the next frame and then publishes the frame. Values that don't exist this
+* frame (the owner was destroyed, the element was removed) leave their slot marked as missing
+*/
+void FActorDebuggerHistoryRecorder::RecordFrame(double Time)
+{
+    if (bRecording == false)
+    {
+        return;
+    }
+
+    const uint64 Frame = NumRecorded.load(std::memory_order_relaxed);
+    const int32 FrameIndex = static_cast<int32>(Frame % Capacity);
+    uint8* FrameData = Frames.GetData() + static_cast<int64>(FrameIndex) * FrameStride;
+
+    for (const FChannel& Channel : Channels)
+    {
+        uint8* Slot = FrameData + Channel.SlotOffset;
+        const uint8* ValuePtr = nullptr;
+
+        if (Channel.Owner.Get() != nullptr)
+        {
+            ValuePtr = Channel.StableValuePtr ? Channel.StableValuePtr : Channel.Item->ResolveValuePtr();
+        }
+
+        Slot[0] = ValuePtr != nullptr;
+        if (ValuePtr)
+        {
+            EncodeValue(Channel, ValuePtr, Slot + 1);
+        }
+    }
+
+    FrameTimes[FrameIndex] = Time;
+    NumRecorded.store(Frame + 1, std::memory_order_release);
+}
+
+/*
+* The frame the writer will overwrite next is excluded, it may be half written by the time a reader gets to it
+*/
+uint64 FActorDebuggerHistoryRecorder::GetFirstFrame() const
+{
+    const uint64 End = GetEndFrame();
+    return End >= static_cast<uint64>(Capacity) ? End - Capacity + 1 : 0;
+}
+
+bool FActorDebuggerHistoryRecorder::GetFrameTime(uint64 Frame, double& OutTime) const
+{
+    if (Capacity == 0 || Frame >= GetEndFrame())
+    {
+        return false;
+    }
+
+    OutTime = FrameTimes[static_cast<int32>(Frame % Capacity)];
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return Frame + Capacity > GetEndFrame();
+}
+
+bool FActorDebuggerHistoryRecorder::ReadSlot(const FChannel& Channel, uint64 Frame, uint8* OutSlot) const
+{
+    if (Capacity == 0 || Frame >= GetEndFrame())
+    {
+        return false;
+    }
+
+    const int32 FrameIndex = static_cast<int32>(Frame % Capacity);
+    FMemory::Memcpy(OutSlot, Frames.GetData() + static_cast<int64>(FrameIndex) * FrameStride + Channel.SlotOffset, Channel.SlotSize);
+
+    // the copy must be complete before we check whether the writer has wrapped around onto it
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return Frame + Capacity > GetEndFrame();
+}
+
+/*
+* Decoding happens only for the frame being displayed so it can afford to export text
+*/
+bool FActorDebuggerHistoryRecorder::FormatValue(int32 Channel, uint64 Frame, FText& OutText) const
+{
+    static_assert(sizeof(int32) + MaxStringChars * sizeof(TCHAR) <= MaxRawSize && sizeof(FObjectKey) <= MaxRawSize, "Every slot must fit in the largest raw slot");
+
+    const FChannel& ChannelInfo = Channels[Channel];
+
+    alignas(16) uint8 Slot[1 + MaxRawSize];
+    if (ReadSlot(ChannelInfo, Frame, Slot) == false)
+    {
+        return false;
+    }
+
+    if (Slot[0] == 0)
+    {
+        OutText = FText::FromString("Invalid Property");
+        return true;
+    }
+
+    const uint8* Payload = Slot + 1;
+
+    switch (ChannelInfo.Encoding)
+    {
+    case EActorDebuggerHistoryEncoding::Raw:
+    {
+        // copied out again so the value is aligned for its type before it is exported
+        alignas(16) uint8 Value[MaxRawSize];
+        FMemory::Memcpy(Value, Payload, ChannelInfo.Property->ElementSize);
+
+        FString ValueString;
+        ChannelInfo.Property->ExportText_Direct(ValueString, Value, Value, ChannelInfo.Owner.Get(), PPF_BlueprintDebugView);
+        OutText = FText::FromString(ValueString);
+        break;
+    }
+
+    case EActorDebuggerHistoryEncoding::Bool:
+        OutText = FText::FromString(Payload[0] ? TEXT("True") : TEXT("False"));
+        break;
+
+    case EActorDebuggerHistoryEncoding::Object:
+    {
+        FObjectKey Key;
+        FMemory::Memcpy(&Key, Payload, sizeof(FObjectKey));
+
+        const UObject* Object = Key.ResolveObjectPtr();
+        OutText = FText::FromString(Object ? Object->GetPathName() : (Key == FObjectKey() ? TEXT("None") : TEXT("Destroyed Object")));
+        break;
+    }
+
+    case EActorDebuggerHistoryEncoding::String:
+    {
+        int32 Length = 0;
+        FMemory::Memcpy(&Length, Payload, sizeof(int32));
+
+        TCHAR Chars[MaxStringChars];
+        FMemory::Memcpy(Chars, Payload + sizeof(int32), sizeof(Chars));
+
+        FString ValueString(FMath::Min(Length, MaxStringChars), Chars);
+        if (Length > MaxStringChars)
+        {
+            ValueString += TEXT("...");
+        }
+        OutText = FText::FromString(ValueString);
+        break;
+    }
+
+    case EActorDebuggerHistoryEncoding::ContainerNum:
+    {
+        int32 Num = 0;
+        FMemory::Memcpy(&Num, Payload, sizeof(int32));
+        OutText = FText::FromString(FString::Printf(TEXT("%d %s"), Num, Num == 1 ? TEXT("element") : TEXT("elements")));
+        break;
+    }
+
+    case EActorDebuggerHistoryEncoding::Hash:
+    {
+        uint64 Hash = 0;
+        FMemory::Memcpy(&Hash, Payload, sizeof(uint64));
+        OutText = FText::FromString(FString::Printf(TEXT("Value Hash %016llx"), Hash));
+        break;
+    }
+    }
+
+    return true;
+}
+
+SIZE_T FActorDebuggerHistoryRecorder::GetAllocatedSize() const
+{
+    return Channels.GetAllocatedSize() + Frames.GetAllocatedSize() + FrameTimes.GetAllocatedSize();
+}
+
+/*
+* Picks the most compact encoding that can still be displayed. Object references are checked before plain old
+* data since exporting a copied pointer to an object that has since been destroyed would read freed memory
+*/
+EActorDebuggerHistoryEncoding FActorDebuggerHistoryRecorder::ChooseEncoding(FReflectedActorPropertyPtr Item, int32& OutValueSize)
+{
+    const FProperty* Property = Item->Property;
+
+    if (Item->IsContainer())
+    {
+        OutValueSize = sizeof(int32);
+        return EActorDebuggerHistoryEncoding::ContainerNum;
+    }
+    if (Property->IsA<FBoolProperty>())
+    {
+        OutValueSize = 1;
+        return EActorDebuggerHistoryEncoding::Bool;
+    }
+    if (Property->IsA<FObjectProperty>() || Property->IsA<FWeakObjectProperty>())
+    {
+        OutValueSize = sizeof(FObjectKey);
+        return EActorDebuggerHistoryEncoding::Object;
+    }
+    if (Property->IsA<FStrProperty>() || Property->IsA<FTextProperty>())
+    {
+        OutValueSize = sizeof(int32) + MaxStringChars * sizeof(TCHAR);
+        return EActorDebuggerHistoryEncoding::String;
+    }
+    if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData) && Property->IsA<FObjectPropertyBase>() == false && Property->ElementSize <= MaxRawSize)
+    {
+        OutValueSize = Property->ElementSize;
+        return EActorDebuggerHistoryEncoding::Raw;
+    }
+
+    OutValueSize = sizeof(uint64);
+    return EActorDebuggerHistoryEncoding::Hash;
+}
+
+/*
+* Runs for every channel every frame, nothing here allocates
+*/
+void FActorDebuggerHistoryRecorder::EncodeValue(const FChannel& Channel, const uint8* ValuePtr, uint8* Slot)
+{
+    switch (Channel.Encoding)
+    {
+    case EActorDebuggerHistoryEncoding::Raw:
+        FMemory::Memcpy(Slot, ValuePtr, Channel.Property->ElementSize);
+        break;
+
+    case EActorDebuggerHistoryEncoding::Bool:
+        Slot[0] = CastFieldChecked<FBoolProperty>(Channel.Property)->GetPropertyValue(ValuePtr) ? 1 : 0;
+        break;
+
+    case EActorDebuggerHistoryEncoding::Object:
+    {
+        const FObjectKey Key(CastFieldChecked<FObjectPropertyBase>(Channel.Property)->GetObjectPropertyValue(ValuePtr));
+        FMemory::Memcpy(Slot, &Key, sizeof(FObjectKey));
+        break;
+    }
+
+    case EActorDebuggerHistoryEncoding::String:
+    {
+        const FString& String = Channel.Property->IsA<FStrProperty>()
+            ? *reinterpret_cast<const FString*>(ValuePtr)
+            : reinterpret_cast<const FText*>(ValuePtr)->ToString();
+
+        const int32 Length = String.Len();
+        FMemory::Memcpy(Slot, &Length, sizeof(int32));
+        FMemory::Memcpy(Slot + sizeof(int32), *String, FMath::Min(Length, MaxStringChars) * sizeof(TCHAR));
+        break;
+    }
+
+    case EActorDebuggerHistoryEncoding::ContainerNum:
+    {
+        const int32 Num = Channel.Item->GetContainerNum(ValuePtr);
+        FMemory::Memcpy(Slot, &Num, sizeof(int32));
+        break;
+    }
+
+    case EActorDebuggerHistoryEncoding::Hash:
+    {
+        const uint64 Hash = ActorDebugger::HashPropertyElement(Channel.Property, ValuePtr);
+        FMemory::Memcpy(Slot, &Hash, sizeof(uint64));
+        break;
+    }
+    }
+}
@@ -0,0 +1,872 @@
+#include "ActorDebuggerInspection.h"
+#include "ActorDebugger.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "UObject/UObjectGlobals.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UnrealType.h"
+#include "ActorDebuggerValueHash.h"
+#include "ActorDebuggerStats.h"
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerMaxDepth(
+    TEXT("ActorDebugger.MaxDepth"),
+    12,
+    TEXT("How many levels of objects, structs and containers the Actor Debugger will expand below the inspected object"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerMaxNodes(
+    TEXT("ActorDebugger.MaxNodes"),
+    100000,
+    TEXT("The maximum number of property nodes a single Actor Debugger inspection may create"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerContainerPageSize(
+    TEXT("ActorDebugger.ContainerPageSize"),
+    1000,
+    TEXT("Containers with more elements than this are displayed as pages of this many elements"));
+
+/*
+* Walks up to the parent to find the memory this node's value lives in. Script container elements are bounds
+* checked against the container as it is now, so an element that has been removed resolves to nullptr.
+* Elements of a page resolve through the page to the container above it
+*/
+const uint8* FReflectedActorProperty::ResolveValuePtr() const
+{
+    if (Handle == nullptr || Handle->bAlive == false)
+    {
+        return nullptr;
+    }
+
+    if (Kind == EReflectedPropertyKind::ObjectMember)
+    {
+        return Entry->GetValuePtr(Object);
+    }
+
+    const FReflectedActorProperty* ContainerItem = Parent && Parent->Kind == EReflectedPropertyKind::Page ? Parent->Parent : Parent;
+    const uint8* ParentValue = ContainerItem ? ContainerItem->ResolveValuePtr() : nullptr;
+
+    if (ParentValue == nullptr)
+    {
+        return nullptr;
+    }
+
+    switch (Kind)
+    {
+    case EReflectedPropertyKind::StructMember:
+        return Entry->GetValuePtr(ParentValue);
+
+    case EReflectedPropertyKind::StaticArrayElement:
+        return Index < ContainerItem->Property->ArrayDim ? ParentValue + Index * Property->ElementSize : nullptr;
+
+    case EReflectedPropertyKind::ArrayElement:
+    {
+        FScriptArrayHelper Helper(CastFieldChecked<FArrayProperty>(ContainerItem->Property), ParentValue);
+        return Helper.IsValidIndex(Index) ? Helper.GetRawPtr(Index) : nullptr;
+    }
+
+    case EReflectedPropertyKind::SetElement:
+    {
+        FScriptSetHelper Helper(CastFieldChecked<FSetProperty>(ContainerItem->Property), ParentValue);
+        return Helper.IsValidIndex(Index) ? Helper.GetElementPtr(Index) : nullptr;
+    }
+
+    case EReflectedPropertyKind::MapPair:
+    {
+        FScriptMapHelper Helper(CastFieldChecked<FMapProperty>(ContainerItem->Property), ParentValue);
+        return Helper.IsValidIndex(Index) ? Helper.GetValuePtr(Index) : nullptr;
+    }
+
+    case EReflectedPropertyKind::Page:
+        // pages have no value of their own, they resolve to the container they are a page of
+        return ParentValue;
+
+    default:
+        return nullptr;
+    }
+}
+
+/*
+* Members of an object, and members and elements of structs and C style arrays inside it, stay at the same
+* address for as long as the object lives. Anything inside a script container can move whenever it reallocates
+*/
+const uint8* FReflectedActorProperty::ResolveStableValuePtr() const
+{
+    for (const FReflectedActorProperty* Node = this; Node; Node = Node->Parent)
+    {
+        switch (Node->Kind)
+        {
+        case EReflectedPropertyKind::ObjectMember:
+            return ResolveValuePtr();
+
+        case EReflectedPropertyKind::StructMember:
+        case EReflectedPropertyKind::StaticArrayElement:
+            continue;
+
+        default:
+            return nullptr;
+        }
+    }
+
+    return nullptr;
+}
+
+const uint8* FReflectedActorProperty::ResolveMapKeyPtr() const
+{
+    const FReflectedActorProperty* ContainerItem = Parent && Parent->Kind == EReflectedPropertyKind::Page ? Parent->Parent : Parent;
+    const uint8* ParentValue = ContainerItem ? ContainerItem->ResolveValuePtr() : nullptr;
+
+    if (Kind != EReflectedPropertyKind::MapPair || ParentValue == nullptr)
+    {
+        return nullptr;
+    }
+
+    FScriptMapHelper Helper(CastFieldChecked<FMapProperty>(ContainerItem->Property), ParentValue);
+    return Helper.IsValidIndex(Index) ? Helper.GetKeyPtr(Index) : nullptr;
+}
+
+bool FReflectedActorProperty::IsContainer() const
+{
+    if (Property == nullptr)
+    {
+        return false;
+    }
+
+    const bool bIsMember = Kind == EReflectedPropertyKind::ObjectMember || Kind == EReflectedPropertyKind::StructMember;
+    return (bIsMember && Property->ArrayDim > 1) || Property->IsA<FArrayProperty>() || Property->IsA<FSetProperty>() || Property->IsA<FMapProperty>();
+}
+
+/*
+* Reads the element count straight from the container header, nothing is formatted or iterated
+*/
+int32 FReflectedActorProperty::GetContainerNum(const uint8* ValuePtr) const
+{
+    return GetContainerNum(Property, ValuePtr);
+}
+
+int32 FReflectedActorProperty::GetContainerNum(const FProperty* ContainerProperty, const uint8* ValuePtr)
+{
+    if (ValuePtr == nullptr || ContainerProperty == nullptr)
+    {
+        return 0;
+    }
+
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(ContainerProperty))
+    {
+        return FScriptArrayHelper(ArrayProperty, ValuePtr).Num();
+    }
+    if (const FSetProperty* SetProperty = CastField<FSetProperty>(ContainerProperty))
+    {
+        return FScriptSetHelper(SetProperty, ValuePtr).Num();
+    }
+    if (const FMapProperty* MapProperty = CastField<FMapProperty>(ContainerProperty))
+    {
+        return FScriptMapHelper(MapProperty, ValuePtr).Num();
+    }
+
+    return ContainerProperty->ArrayDim;
+}
+
+uint64 FReflectedActorProperty::HashValue() const
+{
+    if (Kind == EReflectedPropertyKind::Page)
+    {
+        return 0;
+    }
+
+    const uint8* ValuePtr = ResolveValuePtr();
+
+    if (IsContainer())
+    {
+        return static_cast<uint64>(GetContainerNum(ValuePtr));
+    }
+
+    return ActorDebugger::HashPropertyElement(Property, ValuePtr);
+}
+
+FText FReflectedActorProperty::GetDisplayName() const
+{
+    switch (Kind)
+    {
+    case EReflectedPropertyKind::ObjectMember:
+    case EReflectedPropertyKind::StructMember:
+        return FText::FromName(Entry->Name);
+
+    case EReflectedPropertyKind::MapPair:
+    {
+        const uint8* KeyPtr = ResolveMapKeyPtr();
+        if (KeyPtr == nullptr)
+        {
+            return FText::FromString("Invalid Key");
+        }
+
+        const FReflectedActorProperty* ContainerItem = Parent->Kind == EReflectedPropertyKind::Page ? Parent->Parent : Parent;
+
+        FString KeyString;
+        CastFieldChecked<FMapProperty>(ContainerItem->Property)->KeyProp->ExportText_Direct(KeyString, KeyPtr, KeyPtr, Object, PPF_BlueprintDebugView);
+        return FText::FromString(KeyString);
+    }
+
+    case EReflectedPropertyKind::Page:
+        return FText::FromString(FString::Printf(TEXT("[%d..%d]"), Index, PageEnd - 1));
+
+    default:
+        return FText::FromString(FString::Printf(TEXT("[%d]"), LogicalIndex));
+    }
+}
+
+/*
+* Hands out the next node, adding a page when the current ones are full. Nodes are reset to their defaults
+* since pages are reused between inspections
+*/
+FReflectedActorPropertyPtr FActorDebuggerNodeArena::Allocate()
+{
+    static_assert(std::is_trivially_destructible_v<FReflectedActorProperty>, "Arena nodes are released without being destructed");
+
+    const int32 PageIndex = NumNodes / NodesPerPage;
+    if (PageIndex == Pages.Num())
+    {
+        Pages.Add(MakeUnique<FReflectedActorProperty[]>(NodesPerPage));
+    }
+
+    FReflectedActorPropertyPtr Node = &Pages[PageIndex][NumNodes % NodesPerPage];
+    *Node = FReflectedActorProperty();
+    Node->Generation = Generation;
+    Node->NodeIndex = NumNodes;
+
+    ++NumNodes;
+    INC_DWORD_STAT(STAT_ActorDebugger_Nodes);
+    return Node;
+}
+
+FActorDebuggerNodeArena::~FActorDebuggerNodeArena()
+{
+    DEC_DWORD_STAT_BY(STAT_ActorDebugger_Nodes, NumNodes);
+}
+
+void FActorDebuggerNodeArena::Reset()
+{
+    DEC_DWORD_STAT_BY(STAT_ActorDebugger_Nodes, NumNodes);
+    NumNodes = 0;
+    ++Generation;
+}
+
+void FActorDebuggerNodeArena::Empty()
+{
+    Reset();
+    Pages.Empty();
+}
+
+FActorDebuggerInspection::~FActorDebuggerInspection()
+{
+    UnregisterDelegates();
+}
+
+/*
+* Starts a new inspection. Only the object's own properties are gathered here, anything below them is
+* gathered when the tree asks for it
+*/
+void FActorDebuggerInspection::SetObject(UObject* Object)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_BuildTree);
+
+    Reset();
+
+    RootObject = Object;
+    MaxDepth = FMath::Max(CVarActorDebuggerMaxDepth.GetValueOnGameThread(), 0);
+    MaxNodes = FMath::Max(CVarActorDebuggerMaxNodes.GetValueOnGameThread(), 0);
+    PageSize = FMath::Max(CVarActorDebuggerContainerPageSize.GetValueOnGameThread(), 1);
+
+    if (IsValid(Object) == false)
+    {
+        return;
+    }
+
+    RegisterDelegates();
+
+    VisitedObjects.Add(Object);
+    RootHandle = AddHandle(Object, nullptr);
+    GatherProperties(nullptr, RootHandle);
+}
+
+/*
+* Releases the whole tree in one go. The arena keeps its pages and the handles are kept for the next inspection
+*/
+void FActorDebuggerInspection::Reset()
+{
+    UnregisterDelegates();
+
+    for (int32 HandleIndex = 0; HandleIndex < NumHandles; ++HandleIndex)
+    {
+        *Handles[HandleIndex] = FActorDebuggerObjectHandle();
+    }
+    NumHandles = 0;
+    RootHandle = nullptr;
+
+    RootObject = nullptr;
+    RootItems.Reset();
+    Arena.Reset();
+    HeldSchemas.Reset();
+    VisitedObjects.Reset();
+}
+
+SIZE_T FActorDebuggerInspection::GetAllocatedSize() const
+{
+    return Arena.GetAllocatedSize() + RootItems.GetAllocatedSize() + HeldSchemas.GetAllocatedSize() + VisitedObjects.GetAllocatedSize()
+        + Handles.GetAllocatedSize() + Handles.Num() * sizeof(FActorDebuggerObjectHandle);
+}
+
+/*
+* Called for every event that may have taken objects of the tree with it. The handles are few, one per expanded
+* object, so checking all of them is cheap compared to checking every node. The subtree an invalidated object was
+* expanded into is unlinked at once and its owner node shows the reference as a plain value from then on
+*/
+int32 FActorDebuggerInspection::InvalidateObjects(TFunctionRef<bool(const FActorDebuggerObjectHandle&)> Predicate, UObject* RootReplacement)
+{
+    int32 NumInvalidated = 0;
+
+    for (int32 HandleIndex = 0; HandleIndex < NumHandles; ++HandleIndex)
+    {
+        FActorDebuggerObjectHandle& ObjectHandle = *Handles[HandleIndex];
+        if (ObjectHandle.bAlive == false || Predicate(ObjectHandle) == false)
+        {
+            continue;
+        }
+
+        ObjectHandle.bAlive = false;
+        VisitedObjects.Remove(ObjectHandle.Object);
+        ++NumInvalidated;
+
+        if (FReflectedActorPropertyPtr OwnerItem = ObjectHandle.OwnerItem)
+        {
+            UnlinkChildren(OwnerItem);
+            OwnerItem->ChildObject = nullptr;
+            OwnerItem->ChildHandle = nullptr;
+            OwnerItem->bMayHaveChildren = false;
+            OwnerItem->bChildrenResolved = true;
+        }
+    }
+
+    if (NumInvalidated > 0)
+    {
+        OnObjectsInvalidated.Broadcast(IsObjectAlive() == false, RootReplacement);
+    }
+
+    return NumInvalidated;
+}
+
+void FActorDebuggerInspection::GetChildren(FReflectedActorPropertyPtr Item, TArray<FReflectedActorPropertyPtr>& OutChildren)
+{
+    if (Item->bChildrenResolved == false && Item->bMayHaveChildren)
+    {
+        Item->bChildrenResolved = true;
+        ResolveChildren(Item);
+    }
+
+    OutChildren.Reset(Item->NumChildren);
+    for (FReflectedActorPropertyPtr Child = Item->FirstChild; Child; Child = Child->NextSibling)
+    {
+        OutChildren.Add(Child);
+    }
+}
+
+/*
+* Gathers the children of an item. What the children are depends on the item's value: the properties of the
+* object it points to, the members of a struct, or the elements (or pages of elements) of a container. Items
+* whose value no longer exists get no children
+*/
+void FActorDebuggerInspection::ResolveChildren(FReflectedActorPropertyPtr Item)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_GatherChildren);
+
+    if (Item->Kind == EReflectedPropertyKind::Page)
+    {
+        GatherContainerElements(Item->Parent, Item, Item->Parent->ResolveValuePtr(), Item->Index, Item->PageEnd);
+        return;
+    }
+
+    if (Item->ChildHandle != nullptr)
+    {
+        if (Item->ChildHandle->bAlive)
+        {
+            GatherProperties(Item, Item->ChildHandle);
+        }
+        return;
+    }
+
+    const uint8* ValuePtr = Item->ResolveValuePtr();
+    if (ValuePtr == nullptr)
+    {
+        return;
+    }
+
+    const bool bIsMember = Item->Kind == EReflectedPropertyKind::ObjectMember || Item->Kind == EReflectedPropertyKind::StructMember;
+
+    if (bIsMember && Item->Property->ArrayDim > 1)
+    {
+        GatherStaticArrayElements(Item);
+    }
+    else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Item->Property))
+    {
+        GatherStructMembers(Item, StructProperty->Struct);
+    }
+    else
+    {
+        GatherContainerChildren(Item, ValuePtr);
+    }
+}
+
+/*
+* Containers resolve their children against the element count they had at the time. When that count changes the
+* children are unlinked so that the next request gathers them again. The unlinked nodes stay in the arena until
+* the inspection is reset, which keeps any pointers to them that are still held safe to read
+*/
+bool FActorDebuggerInspection::RefreshContainerChildren(FReflectedActorPropertyPtr Item)
+{
+    if (Item->IsContainer() == false || Item->Property->ArrayDim > 1)
+    {
+        return false;
+    }
+
+    const int32 Num = Item->GetContainerNum(Item->ResolveValuePtr());
+    Item->bMayHaveChildren = Num > 0 && Item->Depth < MaxDepth;
+
+    if (Item->bChildrenResolved == false || Num == Item->ResolvedNum)
+    {
+        return false;
+    }
+
+    UnlinkChildren(Item);
+    Item->bChildrenResolved = false;
+    return true;
+}
+
+/*
+* The unlinked nodes stay in the arena until the inspection is reset, which keeps any pointers to them that are
+* still held safe to read
+*/
+void FActorDebuggerInspection::UnlinkChildren(FReflectedActorPropertyPtr Item)
+{
+    for (FReflectedActorPropertyPtr Child = Item->FirstChild; Child; Child = Child->NextSibling)
+    {
+        Child->bDetached = true;
+    }
+
+    Item->FirstChild = nullptr;
+    Item->LastChild = nullptr;
+    Item->NumChildren = 0;
+}
+
+/*
+* Gathers the properties of ContainerObject as children of ParentItem, or as the root items if there is no
+* parent. Object references are not followed here, the first node to reference an object claims it in the
+* visited set and will expand it when asked. Later references to the same object, including references back
+* up the tree, are shown as plain values
+*/
+void FActorDebuggerInspection::GatherProperties(FReflectedActorPropertyPtr ParentItem, FActorDebuggerObjectHandle* ObjectHandle)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_GatherProperties);
+
+    if (!ObjectHandle || !ObjectHandle->Object)
+    {
+        return;
+    }
+
+    // The schema cache has already filtered the class down to the properties worth displaying
+    FActorDebuggerClassSchemaPtr Schema = FindOrBuildSchema(ObjectHandle->Object->GetClass());
+
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+    {
+        FReflectedActorPropertyPtr ReflectedProperty = MakeNode(ObjectHandle, ParentItem, ParentItem, EReflectedPropertyKind::ObjectMember, Entry.Property);
+        if (ReflectedProperty == nullptr)
+        {
+            return;
+        }
+
+        ReflectedProperty->Entry = &Entry;
+        ReflectedProperty->Formatter = Entry.Formatter;
+        InitializeChildState(*ReflectedProperty);
+    }
+}
+
+/*
+* Struct members live inside the parent's value, they are resolved through the parent each time
+*/
+void FActorDebuggerInspection::GatherStructMembers(FReflectedActorPropertyPtr ParentItem, const UScriptStruct* Struct)
+{
+    FActorDebuggerClassSchemaPtr Schema = FindOrBuildSchema(Struct);
+
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+    {
+        FReflectedActorPropertyPtr Member = MakeNode(ParentItem->Handle, ParentItem, ParentItem, EReflectedPropertyKind::StructMember, Entry.Property);
+        if (Member == nullptr)
+        {
+            return;
+        }
+
+        Member->Entry = &Entry;
+        Member->Formatter = Entry.Formatter;
+        InitializeChildState(*Member);
+    }
+}
+
+void FActorDebuggerInspection::GatherStaticArrayElements(FReflectedActorPropertyPtr ParentItem)
+{
+    for (int32 ElementIndex = 0; ElementIndex < ParentItem->Property->ArrayDim; ++ElementIndex)
+    {
+        FReflectedActorPropertyPtr Element = MakeNode(ParentItem->Handle, ParentItem, ParentItem, EReflectedPropertyKind::StaticArrayElement, ParentItem->Property);
+        if (Element == nullptr)
+        {
+            return;
+        }
+
+        Element->Index = ElementIndex;
+        Element->LogicalIndex = ElementIndex;
+        Element->Formatter = ParentItem->Formatter;
+        InitializeChildState(*Element);
+    }
+}
+
+/*
+* Small containers list their elements directly. Large ones are split into pages and a page only creates its
+* elements when it is expanded
+*/
+void FActorDebuggerInspection::GatherContainerChildren(FReflectedActorPropertyPtr ParentItem, const uint8* ContainerPtr)
+{
+    const int32 Num = ParentItem->GetContainerNum(ContainerPtr);
+    ParentItem->ResolvedNum = Num;
+
+    if (Num <= PageSize)
+    {
+        GatherContainerElements(ParentItem, ParentItem, ContainerPtr, 0, Num);
+        return;
+    }
+
+    for (int32 PageStart = 0; PageStart < Num; PageStart += PageSize)
+    {
+        FReflectedActorPropertyPtr Page = MakeNode(ParentItem->Handle, ParentItem, ParentItem, EReflectedPropertyKind::Page, nullptr);
+        if (Page == nullptr)
+        {
+            return;
+        }
+
+        Page->Index = PageStart;
+        Page->PageEnd = FMath::Min(PageStart + PageSize, Num);
+        Page->bMayHaveChildren = true;
+    }
+}
+
+/*
+* Creates nodes for the elements with logical indices [Start, End) of a container, as children of ListItem
+* (the container itself or one of its pages). Sets and maps are sparse so their nodes record the sparse index
+* of the element, which can be looked up directly when they are resolved
+*/
+void FActorDebuggerInspection::GatherContainerElements(FReflectedActorPropertyPtr ContainerItem, FReflectedActorPropertyPtr ListItem, const uint8* ContainerPtr, int32 Start, int32 End)
+{
+    if (ContainerPtr == nullptr)
+    {
+        return;
+    }
+
+    auto AddElement = [this, ContainerItem, ListItem](EReflectedPropertyKind Kind, FProperty* ElementProperty, int32 Index, int32 LogicalIndex)
+    {
+        FReflectedActorPropertyPtr Element = MakeNode(ContainerItem->Handle, ListItem, ListItem, Kind, ElementProperty);
+        if (Element == nullptr)
+        {
+            return false;
+        }
+
+        Element->Index = Index;
+        Element->LogicalIndex = LogicalIndex;
+        Element->Formatter = ContainerItem->Formatter;
+        InitializeChildState(*Element);
+        return true;
+    };
+
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(ContainerItem->Property))
+    {
+        End = FMath::Min(End, FScriptArrayHelper(ArrayProperty, ContainerPtr).Num());
+        for (int32 ElementIndex = Start; ElementIndex < End; ++ElementIndex)
+        {
+            if (AddElement(EReflectedPropertyKind::ArrayElement, ArrayProperty->Inner, ElementIndex, ElementIndex) == false)
+            {
+                return;
+            }
+        }
+    }
+    else if (const FSetProperty* SetProperty = CastField<FSetProperty>(ContainerItem->Property))
+    {
+        FScriptSetHelper Helper(SetProperty, ContainerPtr);
+        for (FScriptSetHelper::FIterator It(Helper); It && It.GetLogicalIndex() < End; ++It)
+        {
+            if (It.GetLogicalIndex() >= Start && AddElement(EReflectedPropertyKind::SetElement, SetProperty->ElementProp, It.GetInternalIndex(), It.GetLogicalIndex()) == false)
+            {
+                return;
+            }
+        }
+    }
+    else if (const FMapProperty* MapProperty = CastField<FMapProperty>(ContainerItem->Property))
+    {
+        FScriptMapHelper Helper(MapProperty, ContainerPtr);
+        for (FScriptMapHelper::FIterator It(Helper); It && It.GetLogicalIndex() < End; ++It)
+        {
+            if (It.GetLogicalIndex() >= Start && AddElement(EReflectedPropertyKind::MapPair, MapProperty->ValueProp, It.GetInternalIndex(), It.GetLogicalIndex()) == false)
+            {
+                return;
+            }
+        }
+    }
+}
+
+FReflectedActorPropertyPtr FActorDebuggerInspection::MakeNode(FActorDebuggerObjectHandle* ObjectHandle, FReflectedActorPropertyPtr ParentItem, FReflectedActorPropertyPtr ListItem, EReflectedPropertyKind Kind, FProperty* Property)
+{
+    if (Arena.Num() >= MaxNodes)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: node budget of %d reached while inspecting %s, see ActorDebugger.MaxNodes"), MaxNodes, *GetNameSafe(RootObject));
+        return nullptr;
+    }
+
+    FReflectedActorPropertyPtr Node = Arena.Allocate();
+    Node->Object = ObjectHandle->Object;
+    Node->Handle = ObjectHandle;
+    Node->Parent = ParentItem;
+    Node->Kind = Kind;
+    Node->Property = Property;
+    Node->Depth = ParentItem ? ParentItem->Depth + 1 : 0;
+
+    if (ListItem == nullptr)
+    {
+        RootItems.Add(Node);
+    }
+    else
+    {
+        if (ListItem->LastChild)
+        {
+            ListItem->LastChild->NextSibling = Node;
+        }
+        else
+        {
+            ListItem->FirstChild = Node;
+        }
+
+        ListItem->LastChild = Node;
+        ++ListItem->NumChildren;
+    }
+
+    return Node;
+}
+
+/*
+* Decides whether a new node can be expanded without gathering anything below it. References to objects are
+* claimed in the visited set here, so the first node to see an object is the one that expands it
+*/
+void FActorDebuggerInspection::InitializeChildState(FReflectedActorProperty& Node)
+{
+    if (Node.Depth >= MaxDepth)
+    {
+        return;
+    }
+
+    const uint8* ValuePtr = Node.ResolveValuePtr();
+    if (ValuePtr == nullptr)
+    {
+        return;
+    }
+
+    if (Node.IsContainer())
+    {
+        Node.bMayHaveChildren = Node.GetContainerNum(ValuePtr) > 0;
+    }
+    else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Node.Property))
+    {
+        Node.bMayHaveChildren = FindOrBuildSchema(StructProperty->Struct)->Entries.Num() > 0;
+    }
+    else if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Node.Property))
+    {
+        UObject* ChildContainerObject = ObjectProperty->GetObjectPropertyValue(ValuePtr);
+
+        if (ChildContainerObject && IsUObjectOfInterest(ChildContainerObject))
+        {
+            bool bAlreadyVisited = false;
+            VisitedObjects.Add(ChildContainerObject, &bAlreadyVisited);
+
+            if (bAlreadyVisited == false)
+            {
+                Node.ChildObject = ChildContainerObject;
+                Node.ChildHandle = AddHandle(ChildContainerObject, &Node);
+                Node.bMayHaveChildren = true;
+            }
+        }
+    }
+}
+
+/*
+* Handles are claimed along with the object, before its properties are gathered, so an object collected before its
+* node is expanded is never gathered
+*/
+FActorDebuggerObjectHandle* FActorDebuggerInspection::AddHandle(UObject* Object, FReflectedActorPropertyPtr OwnerItem)
+{
+    if (NumHandles == Handles.Num())
+    {
+        Handles.Add(MakeUnique<FActorDebuggerObjectHandle>());
+    }
+
+    FActorDebuggerObjectHandle* ObjectHandle = Handles[NumHandles++].Get();
+    ObjectHandle->Object = Object;
+    ObjectHandle->WeakObject = Object;
+    ObjectHandle->OwnerItem = OwnerItem;
+    ObjectHandle->bAlive = true;
+    return ObjectHandle;
+}
+
+/*
+* Nodes point at schema entries without owning them, the inspection holds one reference per schema instead
+*/
+FActorDebuggerClassSchemaPtr FActorDebuggerInspection::FindOrBuildSchema(const UStruct* Struct)
+{
+    if (const FActorDebuggerClassSchemaPtr* Held = HeldSchemas.Find(Struct))
+    {
+        return *Held;
+    }
+
+    FActorDebuggerClassSchemaPtr Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(Struct);
+    HeldSchemas.Add(Struct, Schema);
+    return Schema;
+}
+
+/*
+* Returns a boolean that indicates if we want to iterate over the properties of this UObject
+*/
+bool FActorDebuggerInspection::IsUObjectOfInterest(UObject* Object)
+{
+    // don't iterate over AActor properties, this opens us up to circular dependencies
+    if (Object->IsA(AActor::StaticClass()))
+    {
+        return false;
+    }
+
+    // don't iterate over Asset properties, probably not useful
+    if (IsAssetObject(Object))
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/*
+* Checks for some object flags that are intended to check if an object is an asset type or not
+* UE does not have a UAsset class which would be a preferred method but this method appears to work
+* correctly
+*/
+bool FActorDebuggerInspection::IsAssetObject(UObject* Object)
+{
+    if (!Object)
+    {
+        return false;
+    }
+    
+    // Assets typically have these flags
+    bool bHasAssetFlags = Object->HasAnyFlags(RF_Public | RF_Standalone);
+    
+    // Assets should not have these flags
+    bool bHasNonAssetFlags = Object->HasAnyFlags(RF_Transient | RF_ArchetypeObject | RF_ClassDefaultObject);
+    
+    return bHasAssetFlags && !bHasNonAssetFlags;
+}
+
+/*
+* Bound for as long as an object is inspected. Actors are only reported destroyed by their own world, that handler
+* is bound to the inspected object's world
+*/
+void FActorDebuggerInspection::RegisterDelegates()
+{
+    PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FActorDebuggerInspection::HandlePostGarbageCollect);
+    ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddRaw(this, &FActorDebuggerInspection::HandleObjectsReinstanced);
+    LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FActorDebuggerInspection::HandleLevelRemoved);
+    WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FActorDebuggerInspection::HandleWorldCleanup);
+
+    if (UWorld* World = RootObject ? RootObject->GetWorld() : nullptr)
+    {
+        ActorDestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateRaw(this, &FActorDebuggerInspection::HandleActorDestroyed));
+        ActorDestroyedWorld = World;
+    }
+}
+
+void FActorDebuggerInspection::UnregisterDelegates()
+{
+    FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+    FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+    FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+    FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+
+    if (UWorld* World = ActorDestroyedWorld.Get())
+    {
+        // sic, the engine spells it this way
+        World->RemoveOnActorDestroyededHandler(ActorDestroyedHandle);
+    }
+
+    PostGarbageCollectHandle.Reset();
+    ObjectsReinstancedHandle.Reset();
+    LevelRemovedHandle.Reset();
+    WorldCleanupHandle.Reset();
+    ActorDestroyedHandle.Reset();
+    ActorDestroyedWorld.Reset();
+}
+
+/*
+* Collected objects can no longer be reached through their weak pointers. Objects that were marked as garbage but
+* are still referenced are invalidated too, they are on their way out
+*/
+void FActorDebuggerInspection::HandlePostGarbageCollect()
+{
+    InvalidateObjects([](const FActorDebuggerObjectHandle& ObjectHandle)
+    {
+        return ObjectHandle.WeakObject.IsValid() == false;
+    });
+}
+
+/*
+* A destroyed actor takes its components and other subobjects with it
+*/
+void FActorDebuggerInspection::HandleActorDestroyed(AActor* Actor)
+{
+    InvalidateObjects([Actor](const FActorDebuggerObjectHandle& ObjectHandle)
+    {
+        const UObject* Object = ObjectHandle.WeakObject.Get(true);
+        return Object == nullptr || Object == Actor || Object->IsIn(Actor);
+    });
+}
+
+void FActorDebuggerInspection::HandleObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap)
+{
+    InvalidateObjects([&OldToNewInstanceMap](const FActorDebuggerObjectHandle& ObjectHandle)
+    {
+        return OldToNewInstanceMap.Contains(ObjectHandle.Object);
+    }, OldToNewInstanceMap.FindRef(RootObject));
+}
+
+/*
+* A null level means every level of the world is being removed
+*/
+void FActorDebuggerInspection::HandleLevelRemoved(ULevel* Level, UWorld* World)
+{
+    const UObject* Outer = Level ? static_cast<UObject*>(Level) : static_cast<UObject*>(World);
+    if (Outer == nullptr)
+    {
+        return;
+    }
+
+    InvalidateObjects([Outer](const FActorDebuggerObjectHandle& ObjectHandle)
+    {
+        const UObject* Object = ObjectHandle.WeakObject.Get(true);
+        return Object == nullptr || Object->IsIn(Outer);
+    });
+}
+
+void FActorDebuggerInspection::HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    InvalidateObjects([World](const FActorDebuggerObjectHandle& ObjectHandle)
+    {
+        const UObject* Object = ObjectHandle.WeakObject.Get(true);
+        return Object == nullptr || Object == World || Object->IsIn(World);
+    });
+}
@@ -4,43 +4,821 @@
 #include "ActorDebuggerLibrary.h"
 
 #include "ActorDebuggerWidget.h"
+#include "ActorDebuggerQuery.h"
+#include "ActorDebuggerQueryWidget.h"
+#include "ActorDebuggerColumnsWidget.h"
+#include "ActorDebuggerSnapshot.h"
+#include "ActorDebuggerCallTracer.h"
+#include "ActorDebuggerDump.h"
+#include "ActorDebuggerServer.h"
+#include "ActorDebuggerRemote.h"
+#include "ActorDebuggerMemory.h"
+#include "ActorDebugger.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
 #include "Widgets/SWindow.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Misc/Paths.h"
 
-TSharedPtr<SWindow> UActorDebuggerLibrary::Window;
+TArray<TSharedRef<SWindow>> UActorDebuggerLibrary::Windows;
+TWeakPtr<SWindow> UActorDebuggerLibrary::ActiveWindow;
+
+TSharedRef<SActorDebuggerWidget> UActorDebuggerLibrary::GetWidget(const TSharedRef<SWindow>& Window)
+{
+    return StaticCastSharedRef<SActorDebuggerWidget>(Window->GetContent());
+}
+
+/*
+ * Windows need a running Slate application, which dedicated servers and commandlets don't have. Dumps don't
+ */
+bool UActorDebuggerLibrary::CanOpenWindows()
+{
+    if (FSlateApplication::IsInitialized())
+    {
+        return true;
+    }
+
+    UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: this process has no UI, use ActorDebugger.Dump, ActorDebugger.StartDumpStream or ActorDebugger.StartServer instead"));
+    return false;
+}
+
+/*
+ * Opens an empty debugger window. The window leaves the list when the widget asks to be closed (its object was
+ * destroyed) or when the user closes it, whichever happens first.
+ */
+TSharedRef<SWindow> UActorDebuggerLibrary::CreateWindow()
+{
+    TSharedPtr<SActorDebuggerWidget> DebuggerWidget;
+
+    TSharedRef<SWindow> Window = SNew(SWindow).Title(FText::FromString("Actor Debugger")).ClientSize(FVector2D{250,250}).IsTopmostWindow(true)
+    [
+        SAssignNew(DebuggerWidget, SActorDebuggerWidget)
+    ];
+
+    Window->SetOnWindowClosed(FOnWindowClosed::CreateLambda(
+        [](const TSharedRef<SWindow>& ClosedWindow)
+        {
+            Windows.Remove(ClosedWindow);
+        }));
+
+    DebuggerWidget->RequestClose.AddLambda(
+        [WeakWindow = TWeakPtr<SWindow>(Window)]
+        {
+            if (TSharedPtr<SWindow> PinnedWindow = WeakWindow.Pin())
+            {
+                CloseWindow(PinnedWindow.ToSharedRef());
+            }
+        });
+
+    Windows.Add(Window);
+    ActiveWindow = Window;
+    FSlateApplication::Get().AddWindow(Window);
+    return Window;
+}
+
+/*
+ * The widget keeps asking to be closed every tick until its window is destroyed, which Slate defers, so the
+ * window is only destroyed the first time.
+ */
+void UActorDebuggerLibrary::CloseWindow(const TSharedRef<SWindow>& Window)
+{
+    if (Windows.Remove(Window) > 0)
+    {
+        FSlateApplication::Get().RequestDestroyWindow(Window);
+    }
+}
+
+/*
+ * The most recently used window, or the most recently opened one if that has been closed.
+ */
+TSharedPtr<SWindow> UActorDebuggerLibrary::FindActiveWindow()
+{
+    if (TSharedPtr<SWindow> Window = ActiveWindow.Pin(); Window && Windows.Contains(Window.ToSharedRef()))
+    {
+        return Window;
+    }
+
+    return Windows.Num() > 0 ? TSharedPtr<SWindow>(Windows.Last()) : nullptr;
+}
+
+TSharedRef<SWindow> UActorDebuggerLibrary::FindOrCreateWindow()
+{
+    if (TSharedPtr<SWindow> Window = FindActiveWindow())
+    {
+        return Window.ToSharedRef();
+    }
+
+    return CreateWindow();
+}
+
+TSharedPtr<SWindow> UActorDebuggerLibrary::FindWindow(const UObject* Object)
+{
+    for (const TSharedRef<SWindow>& Window : Windows)
+    {
+        if (GetWidget(Window)->GetObject() == Object)
+        {
+            return Window;
+        }
+    }
+
+    return nullptr;
+}
+
+/*
+ * Inspects the object in the given window and names the window after it, so windows can be told apart.
+ */
+void UActorDebuggerLibrary::SetWindowObject(const TSharedRef<SWindow>& Window, UObject* Object)
+{
+    GetWidget(Window)->SetObject(Object);
+
+    if (IsValid(Object))
+    {
+        Window->SetTitle(FText::FromString(FString::Printf(TEXT("Actor Debugger - %s"), *Object->GetName())));
+    }
+
+    ActiveWindow = Window;
+}
 
 /*
  * Selects the specified actor in the Actor Debugger window.
  *
- * If the debugger window is already open, updates its content to display the given actor.
- * Otherwise, creates a new debugger window, sets its content to display the actor, and adds it to the Slate application.
- * Also binds a lambda to the widget's RequestClose event to properly destroy and reset the window when closed.
+ * If the actor is already inspected its window is brought to the front. Otherwise the most recently used window
+ * shows the actor instead of what it showed before, a window is created if none is open.
  *
  * @param ActorToSelect The actor to be selected and displayed in the debugger window.
  * @return true if the actor was successfully selected and the window updated or created; false otherwise.
  */
 bool UActorDebuggerLibrary::SelectActor(AActor* ActorToSelect)
 {
-    if (Window)
+    if (CanOpenWindows() == false)
     {
-        TSharedRef<SActorDebuggerWidget> DebuggerWidget = StaticCastSharedRef<SActorDebuggerWidget>(Window->GetContent());
-        DebuggerWidget.Get().SetObject(ActorToSelect);
+        return false;
+    }
+
+    if (TSharedPtr<SWindow> Window = IsValid(ActorToSelect) ? FindWindow(ActorToSelect) : nullptr)
+    {
+        Window->BringToFront();
+        ActiveWindow = Window;
         return true;
     }
 
-    TSharedPtr<SActorDebuggerWidget> DebuggerWidget;
+    SetWindowObject(FindOrCreateWindow(), ActorToSelect);
+    return true;
+}
+
+/*
+ * Inspects the object in a window of its own, next to whatever the other windows are inspecting.
+ */
+bool UActorDebuggerLibrary::AddInspectedObject(UObject* Object)
+{
+    if (IsValid(Object) == false || CanOpenWindows() == false)
+    {
+        return false;
+    }
+
+    if (TSharedPtr<SWindow> Window = FindWindow(Object))
+    {
+        Window->BringToFront();
+        ActiveWindow = Window;
+        return true;
+    }
+
+    SetWindowObject(CreateWindow(), Object);
+    return true;
+}
 
-    Window = SNew(SWindow).ClientSize(FVector2D{250,250}).IsTopmostWindow(true)
+bool UActorDebuggerLibrary::RemoveInspectedObject(UObject* Object)
+{
+    bool bRemoved = false;
+
+    // closing removes the window from the list
+    for (const TSharedRef<SWindow>& Window : TArray<TSharedRef<SWindow>>(Windows))
+    {
+        if (GetWidget(Window)->GetObject() == Object)
+        {
+            CloseWindow(Window);
+            bRemoved = true;
+        }
+    }
+
+    return bRemoved;
+}
+
+TArray<UObject*> UActorDebuggerLibrary::GetInspectedObjects()
+{
+    TArray<UObject*> Objects;
+
+    for (const TSharedRef<SWindow>& Window : Windows)
+    {
+        if (UObject* Object = GetWidget(Window)->GetObject(); IsValid(Object))
+        {
+            Objects.Add(Object);
+        }
+    }
+
+    return Objects;
+}
+
+void UActorDebuggerLibrary::RemoveAllInspectedObjects()
+{
+    for (const TSharedRef<SWindow>& Window : TArray<TSharedRef<SWindow>>(Windows))
+    {
+        CloseWindow(Window);
+    }
+}
+
+/*
+ * Captures the actor selected in the most recently used window. Fails if no window is open, there is nothing to capture.
+ */
+bool UActorDebuggerLibrary::StartCapture(const FString& Filename)
+{
+    TSharedPtr<SWindow> Window = FindActiveWindow();
+    if (Window.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: select an actor to capture first"));
+        return false;
+    }
+
+    return GetWidget(Window.ToSharedRef())->StartCapture(Filename.IsEmpty() ? FActorDebuggerCaptureWriter::GetDefaultFilename() : Filename);
+}
+
+void UActorDebuggerLibrary::StopCapture()
+{
+    if (TSharedPtr<SWindow> Window = FindActiveWindow())
+    {
+        GetWidget(Window.ToSharedRef())->StopCapture();
+    }
+}
+
+/*
+ * Replays open in a window of their own, so a replay can be compared with the live objects.
+ */
+bool UActorDebuggerLibrary::OpenCapture(const FString& Filename)
+{
+    if (CanOpenWindows() == false)
+    {
+        return false;
+    }
+
+    TSharedRef<SWindow> Window = CreateWindow();
+    TSharedRef<SActorDebuggerWidget> DebuggerWidget = GetWidget(Window);
+
+    if (DebuggerWidget->OpenCapture(Filename))
+    {
+        Window->SetTitle(FText::FromString(FString::Printf(TEXT("Actor Debugger - %s"), *FPaths::GetCleanFilename(Filename))));
+        return true;
+    }
+
+    // don't leave an empty window behind
+    CloseWindow(Window);
+    return false;
+}
+
+bool UActorDebuggerLibrary::QueryObjects(UObject* WorldContextObject, UClass* Class, const TArray<FString>& Predicates, TArray<UObject*>& OutMatches)
+{
+    OutMatches.Reset();
+
+    if (Class == nullptr)
+    {
+        return false;
+    }
+
+    FActorDebuggerQuery Query;
+    FText Error;
+    if (Query.Compile(Class, Predicates, Error) == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %s"), *Error.ToString());
+        return false;
+    }
+
+    const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+    OutMatches = Query.Run(World).Matches;
+    return true;
+}
+
+/*
+ * Query windows aren't debugger windows, they aren't tracked and close on their own.
+ */
+bool UActorDebuggerLibrary::ShowQuery(UObject* WorldContextObject, const FString& Query)
+{
+    if (CanOpenWindows() == false)
+    {
+        return false;
+    }
+
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+
+    TSharedRef<SActorDebuggerQueryWidget> QueryWidget = SNew(SActorDebuggerQueryWidget)
+        .Query(Query)
+        .World(World);
+
+    FText Error;
+    if (QueryWidget->RunQuery(Error) == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %s"), *Error.ToString());
+        return false;
+    }
+
+    TSharedRef<SWindow> Window = SNew(SWindow).Title(FText::FromString(FString::Printf(TEXT("Actor Debugger Query - %s"), *Query))).ClientSize(FVector2D{400,300}).IsTopmostWindow(true)
     [
-        SAssignNew(DebuggerWidget, SActorDebuggerWidget)
+        QueryWidget
     ];
 
-	FSlateApplication::Get().AddWindow(Window.ToSharedRef());
-    DebuggerWidget->SetObject(ActorToSelect);
-    DebuggerWidget->RequestClose.AddLambda(
-        []
-        { 
-	        FSlateApplication::Get().RequestDestroyWindow(Window.ToSharedRef());
-            Window.Reset();
+    FSlateApplication::Get().AddWindow(Window);
+    return true;
+}
+
+bool UActorDebuggerLibrary::ShowClassTable(UObject* WorldContextObject, UClass* Class, const TArray<FString>& Columns)
+{
+    if (Class == nullptr || CanOpenWindows() == false)
+    {
+        return false;
+    }
+
+    UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+
+    TSharedRef<SWindow> Window = SNew(SWindow).Title(FText::FromString(FString::Printf(TEXT("Actor Debugger Table - %s"), *Class->GetName()))).ClientSize(FVector2D{600,400}).IsTopmostWindow(true)
+    [
+        SNew(SActorDebuggerColumnsWidget)
+            .Class(Class)
+            .Columns(Columns)
+            .World(World)
+    ];
+
+    FSlateApplication::Get().AddWindow(Window);
+    return true;
+}
+
+bool UActorDebuggerLibrary::TakeSnapshot(UObject* Object, const FString& Name)
+{
+    if (Object == nullptr)
+    {
+        TSharedPtr<SWindow> Window = FindActiveWindow();
+        if (Window.IsValid() == false)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: select an object to take a snapshot of first"));
+            return false;
+        }
+        return GetWidget(Window.ToSharedRef())->TakeSnapshot(Name).IsValid();
+    }
+
+    return FActorDebuggerSnapshots::Get().Take(Object, Name).IsValid();
+}
+
+bool UActorDebuggerLibrary::DiffSnapshots(const FString& OldName, const FString& NewName, TArray<FString>& OutChangedPaths)
+{
+    OutChangedPaths.Reset();
+
+    FActorDebuggerSnapshots& Snapshots = FActorDebuggerSnapshots::Get();
+    FActorDebuggerSnapshotPtr OldSnapshot = Snapshots.Find(OldName);
+    FActorDebuggerSnapshotPtr NewSnapshot = Snapshots.Find(NewName);
+    if (OldSnapshot.IsValid() == false || NewSnapshot.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: there is no snapshot named %s"), OldSnapshot.IsValid() ? *NewName : *OldName);
+        return false;
+    }
+
+    FActorDebuggerSnapshotDiff Diff;
+    FActorDebuggerSnapshots::Diff(*OldSnapshot, *NewSnapshot, Diff);
+
+    for (const FActorDebuggerDiffEntry& Entry : Diff.Entries)
+    {
+        OutChangedPaths.Add(Entry.Path);
+    }
+    return true;
+}
+
+bool UActorDebuggerLibrary::ShowDiff(const FString& Target)
+{
+    TSharedPtr<SWindow> Window = FindActiveWindow();
+    if (Window.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: select an object to compare first"));
+        return false;
+    }
+
+    TSharedRef<SActorDebuggerWidget> DebuggerWidget = GetWidget(Window.ToSharedRef());
+    if (Target.IsEmpty())
+    {
+        DebuggerWidget->ClearDiff();
+        return true;
+    }
+
+    FText Error;
+    if (DebuggerWidget->ShowDiff(Target, Error) == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %s"), *Error.ToString());
+        return false;
+    }
+    return true;
+}
+
+bool UActorDebuggerLibrary::StartCallTrace()
+{
+    TSharedPtr<SWindow> Window = FindActiveWindow();
+    if (Window.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: select an object to trace first"));
+        return false;
+    }
+
+    return GetWidget(Window.ToSharedRef())->StartCallTrace();
+}
+
+/*
+* The trace may have been started by any window, it is stopped wherever it runs. The window that started it still
+* collects the calls recorded before it stopped
+*/
+void UActorDebuggerLibrary::StopCallTrace()
+{
+    FActorDebuggerCallTracer::Get().Stop();
+}
+
+bool UActorDebuggerLibrary::DumpObjects(const TArray<UObject*>& Objects, const FString& Target, bool bBinary)
+{
+    FActorDebuggerDumpSession::FOptions Options;
+    Options.Format = bBinary ? EActorDebuggerDumpFormat::Binary : EActorDebuggerDumpFormat::Json;
+    return FActorDebuggerDumps::Get().Start(Objects, Options, Target);
+}
+
+bool UActorDebuggerLibrary::StartDumpStream(const TArray<UObject*>& Objects, const FString& Target, bool bBinary, float Interval)
+{
+    FActorDebuggerDumpSession::FOptions Options;
+    Options.Format = bBinary ? EActorDebuggerDumpFormat::Binary : EActorDebuggerDumpFormat::Json;
+    Options.bDeltas = true;
+    // a stream with no interval would be a single pass
+    Options.Interval = FMath::Max(Interval, 0.001f);
+    return FActorDebuggerDumps::Get().Start(Objects, Options, Target);
+}
+
+void UActorDebuggerLibrary::StopDumps()
+{
+    FActorDebuggerDumps::Get().StopAll();
+}
+
+bool UActorDebuggerLibrary::StartServer(int32 Port)
+{
+    return FActorDebuggerServer::Get().Open(Port);
+}
+
+void UActorDebuggerLibrary::StopServer()
+{
+    FActorDebuggerServer::Get().Close();
+}
+
+/*
+* The window inspects the replay object of the served object, which the viewer keeps up to date like a capture
+* replay keeps its replay objects
+*/
+bool UActorDebuggerLibrary::ConnectToServer(const FString& Selector, int32 Port)
+{
+    if (CanOpenWindows() == false)
+    {
+        return false;
+    }
+
+    FActorDebuggerRemote& Remote = FActorDebuggerRemote::Get();
+    if (Remote.IsConnected() == false && Remote.Connect(Port) == false)
+    {
+        return false;
+    }
+
+    static FDelegateHandle SubscribedHandle;
+    if (SubscribedHandle.IsValid() == false)
+    {
+        SubscribedHandle = Remote.OnSubscribed.AddLambda([](int32 Request, UObject* ReplayObject)
+        {
+            if (ReplayObject == nullptr)
+            {
+                UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: the debug server has nothing to show for request %d"), Request);
+                return;
+            }
+            AddInspectedObject(ReplayObject);
         });
+    }
+
+    return Remote.Subscribe(Selector) != INDEX_NONE;
+}
+
+/*
+* Measures with an instance of its own so the results of any window showing the object are left alone
+*/
+int64 UActorDebuggerLibrary::LogMemory(UObject* Object, int32 NumContributors)
+{
+    if (Object == nullptr)
+    {
+        if (TSharedPtr<SWindow> Window = FindActiveWindow())
+        {
+            Object = GetWidget(Window.ToSharedRef())->GetObject();
+        }
+    }
+
+    if (IsValid(Object) == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: there is no object to measure"));
+        return 0;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    FActorDebuggerMemory Memory;
+    Memory.Update(Object);
+    const double Milliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: %s retains %s in %d objects%s, measured in %.2f ms"), *Object->GetName(),
+        *FActorDebuggerMemory::FormatBytes(Memory.GetRetained()), Memory.GetObjects().Num(), Memory.IsTruncated() ? TEXT(" (truncated)") : TEXT(""), Milliseconds);
+
+    TArray<int32> Contributors;
+    Memory.GetLargestContributors(NumContributors, Contributors);
+    for (int32 Index : Contributors)
+    {
+        const FActorDebuggerObjectFootprint& Footprint = Memory.GetObjects()[Index];
+        const UObject* Owner = Footprint.Owner != INDEX_NONE ? Memory.GetObjects()[Footprint.Owner].Object.Get() : nullptr;
+        UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger:   %-10s own, %-10s resource, %-10s retained  %s (%s)%s%s"),
+            *FActorDebuggerMemory::FormatBytes(Footprint.Exclusive), *FActorDebuggerMemory::FormatBytes(Footprint.ResourceSize),
+            *FActorDebuggerMemory::FormatBytes(Footprint.Retained), *GetNameSafe(Footprint.Object.Get()),
+            Footprint.Object.IsValid() ? *Footprint.Object->GetClass()->GetName() : TEXT("None"),
+            Owner ? TEXT(" in ") : TEXT(""), Owner ? *Owner->GetName() : TEXT(""));
+    }
+
+    return Memory.GetRetained();
+}
+
+bool UActorDebuggerLibrary::ShowMemory(bool bLargestFirst)
+{
+    TSharedPtr<SWindow> Window = FindActiveWindow();
+    if (Window.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: select an object to measure first"));
+        return false;
+    }
+
+    TSharedRef<SActorDebuggerWidget> DebuggerWidget = GetWidget(Window.ToSharedRef());
+    DebuggerWidget->SetMemoryShown(true);
+    DebuggerWidget->SetSortByMemory(bLargestFirst);
+    return true;
+}
+
+bool UActorDebuggerLibrary::CompilePropertyAccessor(UClass* Class, const FString& Path, FActorDebuggerPropertyAccessor& OutAccessor)
+{
+    FText Error;
+    OutAccessor = FActorDebuggerPropertyAccessor::Compile(Class, Path, Error);
+    if (OutAccessor.IsValid() == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %s"), *Error.ToString());
+        return false;
+    }
     return true;
-}
\ No newline at end of file
+}
+
+bool UActorDebuggerLibrary::ReadNumberProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, double& OutValue)
+{
+    OutValue = 0.0;
+    return Accessor.ReadNumber(Object, OutValue);
+}
+
+bool UActorDebuggerLibrary::ReadIntegerProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, int64& OutValue)
+{
+    OutValue = 0;
+    return Accessor.ReadInteger(Object, OutValue);
+}
+
+bool UActorDebuggerLibrary::ReadBoolProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, bool& OutValue)
+{
+    OutValue = false;
+    return Accessor.ReadBool(Object, OutValue);
+}
+
+bool UActorDebuggerLibrary::ReadVectorProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, FVector& OutValue)
+{
+    OutValue = FVector::ZeroVector;
+    return Accessor.ReadVector(Object, OutValue);
+}
+
+bool UActorDebuggerLibrary::ReadRotatorProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, FRotator& OutValue)
+{
+    OutValue = FRotator::ZeroRotator;
+    return Accessor.ReadRotator(Object, OutValue);
+}
+
+bool UActorDebuggerLibrary::ReadObjectProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, UObject*& OutValue)
+{
+    OutValue = nullptr;
+    return Accessor.ReadObject(Object, OutValue);
+}
+
+bool UActorDebuggerLibrary::ReadStringProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, FString& OutValue)
+{
+    OutValue.Reset();
+    return Accessor.ReadString(Object, OutValue);
+}
+
+int32 UActorDebuggerLibrary::ReadNumberPropertyBatch(const FActorDebuggerPropertyAccessor& Accessor, const TArray<UObject*>& Objects, TArray<double>& OutValues, TArray<bool>& OutResolved)
+{
+    return Accessor.ReadNumbers(Objects, OutValues, OutResolved);
+}
+
+int32 UActorDebuggerLibrary::ReadVectorPropertyBatch(const FActorDebuggerPropertyAccessor& Accessor, const TArray<UObject*>& Objects, TArray<FVector>& OutValues, TArray<bool>& OutResolved)
+{
+    return Accessor.ReadVectors(Objects, OutValues, OutResolved);
+}
+
+static FAutoConsoleCommand ActorDebuggerStartCaptureCommand(
+    TEXT("ActorDebugger.StartCapture"),
+    TEXT("Captures the actor selected in the Actor Debugger to a file. Usage: ActorDebugger.StartCapture [Filename]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        UActorDebuggerLibrary::StartCapture(Args.Num() > 0 ? Args[0] : FString());
+    }));
+
+static FAutoConsoleCommand ActorDebuggerStopCaptureCommand(
+    TEXT("ActorDebugger.StopCapture"),
+    TEXT("Stops the Actor Debugger capture in progress"),
+    FConsoleCommandDelegate::CreateStatic(&UActorDebuggerLibrary::StopCapture));
+
+static FAutoConsoleCommand ActorDebuggerOpenCaptureCommand(
+    TEXT("ActorDebugger.OpenCapture"),
+    TEXT("Opens an Actor Debugger capture for replay. Usage: ActorDebugger.OpenCapture Filename"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.Num() == 0)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Usage: ActorDebugger.OpenCapture Filename"));
+            return;
+        }
+        UActorDebuggerLibrary::OpenCapture(Args[0]);
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs ActorDebuggerQueryCommand(
+    TEXT("ActorDebugger.Query"),
+    TEXT("Lists the objects of a class whose properties meet every predicate. Usage: ActorDebugger.Query Class Predicate [&& Predicate...], e.g. ActorDebugger.Query Pawn Health < 10 && Controller != None"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        if (Args.Num() == 0)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Usage: ActorDebugger.Query Class Predicate [&& Predicate...]"));
+            return;
+        }
+        // the console splits the query at spaces, the query parser expects it whole
+        UActorDebuggerLibrary::ShowQuery(World, FString::Join(Args, TEXT(" ")));
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs ActorDebuggerTableCommand(
+    TEXT("ActorDebugger.Table"),
+    TEXT("Shows properties of every instance of a class, one row per object. Usage: ActorDebugger.Table Class Path [Path...], e.g. ActorDebugger.Table Pawn Health Controller"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        UClass* Class = Args.Num() > 0 ? FActorDebuggerQuery::FindClass(Args[0]) : nullptr;
+        if (Class == nullptr)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Usage: ActorDebugger.Table Class Path [Path...]"));
+            return;
+        }
+        UActorDebuggerLibrary::ShowClassTable(World, Class, TArray<FString>(Args.GetData() + 1, Args.Num() - 1));
+    }));
+
+static FAutoConsoleCommand ActorDebuggerSnapshotCommand(
+    TEXT("ActorDebugger.Snapshot"),
+    TEXT("Takes a snapshot of the object in the active Actor Debugger window. Usage: ActorDebugger.Snapshot [Name]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        UActorDebuggerLibrary::TakeSnapshot(nullptr, Args.Num() > 0 ? Args[0] : FString());
+    }));
+
+static FAutoConsoleCommand ActorDebuggerDiffCommand(
+    TEXT("ActorDebugger.Diff"),
+    TEXT("Colors the rows of the active Actor Debugger window that differ from a snapshot or another object, or between two snapshots. Usage: ActorDebugger.Diff Target [Target], no arguments clears the diff"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        UActorDebuggerLibrary::ShowDiff(FString::Join(Args, TEXT(" ")));
+    }));
+
+static FAutoConsoleCommand ActorDebuggerStartCallTraceCommand(
+    TEXT("ActorDebugger.StartCallTrace"),
+    TEXT("Lists the functions called on the object in the active Actor Debugger window and its subobjects as they are called"),
+    FConsoleCommandDelegate::CreateLambda([]
+    {
+        UActorDebuggerLibrary::StartCallTrace();
+    }));
+
+static FAutoConsoleCommand ActorDebuggerStopCallTraceCommand(
+    TEXT("ActorDebugger.StopCallTrace"),
+    TEXT("Stops the Actor Debugger call trace in progress"),
+    FConsoleCommandDelegate::CreateStatic(&UActorDebuggerLibrary::StopCallTrace));
+
+/*
+* The arguments after the selector are the format, the interval and the target, in any order
+*/
+static bool RunDumpCommand(const TArray<FString>& Args, UWorld* World, bool bStream)
+{
+    const TCHAR* Usage = bStream
+        ? TEXT("Usage: ActorDebugger.StartDumpStream Selector [Json|Binary] [stdout|Filename] [Interval=Seconds]")
+        : TEXT("Usage: ActorDebugger.Dump Selector [Json|Binary] [stdout|Filename]");
+
+    if (Args.Num() == 0)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("%s"), Usage);
+        return false;
+    }
+
+    bool bBinary = false;
+    float Interval = 1.0f;
+    FString Target;
+    for (int32 Index = 1; Index < Args.Num(); ++Index)
+    {
+        if (Args[Index] == TEXT("Json") || Args[Index] == TEXT("Binary"))
+        {
+            bBinary = Args[Index] == TEXT("Binary");
+        }
+        else if (FParse::Value(*Args[Index], TEXT("Interval="), Interval) == false)
+        {
+            Target = Args[Index];
+        }
+    }
+
+    TArray<UObject*> Actors;
+    FActorDebuggerDumps::FindActors(World, Args[0], Actors);
+    if (Actors.Num() == 0)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: no actor is named %s or is of a class named %s"), *Args[0], *Args[0]);
+        return false;
+    }
+
+    return bStream ? UActorDebuggerLibrary::StartDumpStream(Actors, Target, bBinary, Interval) : UActorDebuggerLibrary::DumpObjects(Actors, Target, bBinary);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs ActorDebuggerDumpCommand(
+    TEXT("ActorDebugger.Dump"),
+    TEXT("Writes every property of an actor, or of every actor of a class, to a file or stdout. Usage: ActorDebugger.Dump Selector [Json|Binary] [stdout|Filename]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        RunDumpCommand(Args, World, false);
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs ActorDebuggerStartDumpStreamCommand(
+    TEXT("ActorDebugger.StartDumpStream"),
+    TEXT("Writes the properties of an actor, or of every actor of a class, that changed every interval to a file or stdout. Usage: ActorDebugger.StartDumpStream Selector [Json|Binary] [stdout|Filename] [Interval=Seconds]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        RunDumpCommand(Args, World, true);
+    }));
+
+static FAutoConsoleCommand ActorDebuggerStopDumpsCommand(
+    TEXT("ActorDebugger.StopDumps"),
+    TEXT("Closes every Actor Debugger dump in progress"),
+    FConsoleCommandDelegate::CreateStatic(&UActorDebuggerLibrary::StopDumps));
+
+static FAutoConsoleCommand ActorDebuggerStartServerCommand(
+    TEXT("ActorDebugger.StartServer"),
+    TEXT("Serves objects to Actor Debugger windows in other processes on this machine. Usage: ActorDebugger.StartServer [Port]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        UActorDebuggerLibrary::StartServer(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : ActorDebuggerServer::DefaultPort);
+    }));
+
+static FAutoConsoleCommand ActorDebuggerStopServerCommand(
+    TEXT("ActorDebugger.StopServer"),
+    TEXT("Stops the Actor Debugger server and disconnects its viewers"),
+    FConsoleCommandDelegate::CreateStatic(&UActorDebuggerLibrary::StopServer));
+
+static FAutoConsoleCommand ActorDebuggerConnectCommand(
+    TEXT("ActorDebugger.Connect"),
+    TEXT("Opens an Actor Debugger window on an object served by another process on this machine. Usage: ActorDebugger.Connect Selector [Port], the selector is an object path, or an actor or class name"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        if (Args.Num() == 0)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Usage: ActorDebugger.Connect Selector [Port]"));
+            return;
+        }
+        UActorDebuggerLibrary::ConnectToServer(Args[0], Args.Num() > 1 ? FCString::Atoi(*Args[1]) : ActorDebuggerServer::DefaultPort);
+    }));
+
+static FAutoConsoleCommandWithWorldAndArgs ActorDebuggerMemoryCommand(
+    TEXT("ActorDebugger.Memory"),
+    TEXT("Logs the largest memory contributors below an actor, or every actor of a class. Without a selector the active Actor Debugger window shows its memory columns, largest first. Usage: ActorDebugger.Memory [Selector] [Count]"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+    {
+        const int32 NumContributors = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 10;
+
+        if (Args.Num() == 0)
+        {
+            if (UActorDebuggerLibrary::ShowMemory(true))
+            {
+                UActorDebuggerLibrary::LogMemory(nullptr, NumContributors);
+            }
+            return;
+        }
+
+        TArray<UObject*> Actors;
+        FActorDebuggerDumps::FindActors(World, Args[0], Actors);
+        if (Actors.Num() == 0)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: no actor is named %s or is of a class named %s"), *Args[0], *Args[0]);
+            return;
+        }
+
+        for (UObject* Actor : Actors)
+        {
+            UActorDebuggerLibrary::LogMemory(Actor, NumContributors);
+        }
+    }));
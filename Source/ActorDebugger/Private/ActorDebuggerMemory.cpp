@@ -0,0 +1,577 @@
+#include "ActorDebuggerMemory.h"
+#include "ActorDebuggerStats.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
+#include "UObject/ResourceSize.h"
+#include "UObject/UnrealType.h"
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerMemoryMaxDepth(
+    TEXT("ActorDebugger.MemoryMaxDepth"),
+    8,
+    TEXT("How many levels of referenced objects the Actor Debugger measures below the inspected object"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerMemoryMaxObjects(
+    TEXT("ActorDebugger.MemoryMaxObjects"),
+    20000,
+    TEXT("The maximum number of objects a single Actor Debugger memory measurement may include"));
+
+static TAutoConsoleVariable<float> CVarActorDebuggerMemoryResourceRefreshSeconds(
+    TEXT("ActorDebugger.MemoryResourceRefreshSeconds"),
+    5.0f,
+    TEXT("Seconds an unchanged object keeps the resource size the Actor Debugger took, render resources can grow without its properties changing. 0 takes them on every update"));
+
+namespace ActorDebuggerMemory
+{
+    /* Levels with fewer objects than this are measured on the game thread, it would cost less than waking the workers */
+    static constexpr int32 MinParallelObjects = 32;
+
+    static uint64 CombineHashes(uint64 A, uint64 B)
+    {
+        return CityHash128to64(Uint128_64(A, B));
+    }
+
+    /* Only object references and structs that may hold them lead to further objects */
+    static bool MayHoldReferences(const FProperty* Property)
+    {
+        return Property->IsA<FObjectProperty>() || Property->IsA<FStructProperty>();
+    }
+
+    static void MeasureElementHeap(const FProperty* Property, const uint8* ValuePtr, FActorDebuggerMemorySize& OutSize);
+
+    static void MeasureHeap(const FProperty* Property, const uint8* ValuePtr, FActorDebuggerMemorySize& OutSize)
+    {
+        if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+        {
+            return;
+        }
+
+        for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+        {
+            MeasureElementHeap(Property, ValuePtr + Index * Property->ElementSize, OutSize);
+        }
+    }
+
+    /*
+    * Strings and script containers own heap memory, structs own whatever their members own. Sets and maps are
+    * counted by their element storage, the hash buckets beside it are left out. Text is shared between its copies
+    * and isn't counted as owned by any of them
+    */
+    static void MeasureElementHeap(const FProperty* Property, const uint8* ValuePtr, FActorDebuggerMemorySize& OutSize)
+    {
+        if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+        {
+            return;
+        }
+
+        if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+        {
+            const FString& Value = StrProperty->GetPropertyValue(ValuePtr);
+            OutSize.Allocated += Value.GetAllocatedSize();
+            OutSize.Used += Value.IsEmpty() ? 0 : (Value.Len() + 1) * sizeof(TCHAR);
+        }
+        else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            for (const FProperty* Member = StructProperty->Struct->PropertyLink; Member; Member = Member->PropertyLinkNext)
+            {
+                MeasureHeap(Member, Member->ContainerPtrToValuePtr<uint8>(ValuePtr), OutSize);
+            }
+        }
+        else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+        {
+            FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+            const int64 Stride = ArrayProperty->Inner->ElementSize;
+
+            // arrays using the memory image allocator have no slack to read
+            const bool bHeapArray = EnumHasAnyFlags(ArrayProperty->ArrayFlags, EArrayPropertyFlags::UsesMemoryImageAllocator) == false;
+            const int32 Slack = bHeapArray ? reinterpret_cast<const FScriptArray*>(ValuePtr)->GetSlack() : 0;
+
+            OutSize.Allocated += (Helper.Num() + Slack) * Stride;
+            OutSize.Used += Helper.Num() * Stride;
+
+            if (ArrayProperty->Inner->HasAnyPropertyFlags(CPF_IsPlainOldData) == false)
+            {
+                for (int32 Index = 0; Index < Helper.Num(); ++Index)
+                {
+                    MeasureElementHeap(ArrayProperty->Inner, Helper.GetRawPtr(Index), OutSize);
+                }
+            }
+        }
+        else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+        {
+            FScriptSetHelper Helper(SetProperty, ValuePtr);
+            const int64 Stride = SetProperty->SetLayout.Size;
+            OutSize.Allocated += Helper.GetMaxIndex() * Stride;
+            OutSize.Used += Helper.Num() * Stride;
+
+            if (SetProperty->ElementProp->HasAnyPropertyFlags(CPF_IsPlainOldData) == false)
+            {
+                for (FScriptSetHelper::FIterator It(Helper); It; ++It)
+                {
+                    MeasureElementHeap(SetProperty->ElementProp, Helper.GetElementPtr(It), OutSize);
+                }
+            }
+        }
+        else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+        {
+            FScriptMapHelper Helper(MapProperty, ValuePtr);
+            const int64 Stride = MapProperty->MapLayout.SetLayout.Size;
+            OutSize.Allocated += Helper.GetMaxIndex() * Stride;
+            OutSize.Used += Helper.Num() * Stride;
+
+            const bool bPlainKeys = MapProperty->KeyProp->HasAnyPropertyFlags(CPF_IsPlainOldData);
+            const bool bPlainValues = MapProperty->ValueProp->HasAnyPropertyFlags(CPF_IsPlainOldData);
+            if (bPlainKeys == false || bPlainValues == false)
+            {
+                for (FScriptMapHelper::FIterator It(Helper); It; ++It)
+                {
+                    MeasureElementHeap(MapProperty->KeyProp, Helper.GetKeyPtr(It), OutSize);
+                    MeasureElementHeap(MapProperty->ValueProp, Helper.GetValuePtr(It), OutSize);
+                }
+            }
+        }
+    }
+}
+
+using namespace ActorDebuggerMemory;
+
+/*
+* Measures the graph a level at a time. The game thread builds the schemas a level needs and claims the objects it
+* references for the next one, the workers only read. The references are claimed in the order the objects and
+* their schemas were walked in, so every update attributes an object to the same reference. The whole graph is
+* walked every time, only resource sizes are reused. They are taken on the game thread once the walk is done,
+* GetResourceSizeEx isn't safe to call from the workers. Owners
+* always come before what is attributed to them, so walking the objects backwards sums the retained sizes bottom up
+*/
+bool FActorDebuggerMemory::Update(UObject* Root)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_MeasureMemory);
+    check(IsInGameThread());
+
+    const int32 MaxDepth = FMath::Max(CVarActorDebuggerMemoryMaxDepth.GetValueOnGameThread(), 0);
+    const int32 MaxObjects = FMath::Max(CVarActorDebuggerMemoryMaxObjects.GetValueOnGameThread(), 1);
+    const double ResourceRefreshSeconds = CVarActorDebuggerMemoryResourceRefreshSeconds.GetValueOnGameThread();
+
+    TArray<FActorDebuggerObjectFootprint> NewObjects;
+    TMap<const UObject*, int32> NewIndices;
+    TArray<UObject*> Walked;
+    TArray<TArray<FReference>> References;
+    bool bNewTruncated = false;
+
+    // schemas may have been rebuilt since the last update, the cache hands out the current ones
+    Schemas.Reset();
+
+    if (IsValid(Root))
+    {
+        NewIndices.Add(Root, 0);
+        Walked.Add(Root);
+        NewObjects.AddDefaulted_GetRef().Object = Root;
+    }
+
+    for (int32 LevelStart = 0; LevelStart < Walked.Num();)
+    {
+        const int32 LevelEnd = Walked.Num();
+        for (int32 ObjectIndex = LevelStart; ObjectIndex < LevelEnd; ++ObjectIndex)
+        {
+            PrepareSchemas(Walked[ObjectIndex]->GetClass());
+        }
+
+        References.SetNum(LevelEnd);
+
+        const int32 NumInLevel = LevelEnd - LevelStart;
+        ParallelFor(NumInLevel, [this, LevelStart, MaxDepth, &Walked, &NewObjects, &References](int32 LevelIndex)
+        {
+            const int32 ObjectIndex = LevelStart + LevelIndex;
+            FActorDebuggerObjectFootprint& Footprint = NewObjects[ObjectIndex];
+            MeasureObject(Walked[ObjectIndex], Footprint.Depth < MaxDepth, Footprint, References[ObjectIndex]);
+        }, NumInLevel < MinParallelObjects ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+        for (int32 ObjectIndex = LevelStart; ObjectIndex < LevelEnd && bNewTruncated == false; ++ObjectIndex)
+        {
+            const int32 ChildDepth = NewObjects[ObjectIndex].Depth + 1;
+
+            for (const FReference& Reference : References[ObjectIndex])
+            {
+                if (NewIndices.Contains(Reference.Object))
+                {
+                    continue;
+                }
+
+                if (Walked.Num() >= MaxObjects)
+                {
+                    bNewTruncated = true;
+                    break;
+                }
+
+                NewIndices.Add(Reference.Object, Walked.Num());
+                Walked.Add(Reference.Object);
+
+                FActorDebuggerObjectFootprint& Footprint = NewObjects.AddDefaulted_GetRef();
+                Footprint.Object = Reference.Object;
+                Footprint.Owner = ObjectIndex;
+                Footprint.OwnerSlot = Reference.Slot;
+                Footprint.Depth = ChildDepth;
+            }
+        }
+
+        LevelStart = LevelEnd;
+    }
+
+    // an object keeps its resource size while its shape holds, until the resource size is old enough to take again
+    const double Now = FPlatformTime::Seconds();
+    int32 NumTaken = 0;
+    for (int32 ObjectIndex = 0; ObjectIndex < NewObjects.Num(); ++ObjectIndex)
+    {
+        FActorDebuggerObjectFootprint& Footprint = NewObjects[ObjectIndex];
+
+        const int32* PreviousIndex = Indices.Find(Walked[ObjectIndex]);
+        const FActorDebuggerObjectFootprint* Previous = PreviousIndex ? &Objects[*PreviousIndex] : nullptr;
+        if (Previous && Previous->ShapeHash == Footprint.ShapeHash && Now - Previous->ResourceSizeTime < ResourceRefreshSeconds)
+        {
+            Footprint.ResourceSize = Previous->ResourceSize;
+            Footprint.ResourceSizeTime = Previous->ResourceSizeTime;
+        }
+        else
+        {
+            FResourceSizeEx ResourceSize(EResourceSizeMode::Exclusive);
+            Walked[ObjectIndex]->GetResourceSizeEx(ResourceSize);
+            Footprint.ResourceSize = static_cast<int64>(ResourceSize.GetTotalMemoryBytes());
+            Footprint.ResourceSizeTime = Now;
+            ++NumTaken;
+        }
+
+        Footprint.Exclusive = Footprint.Size.GetTotal() + Footprint.ResourceSize;
+        Footprint.Retained = Footprint.Exclusive;
+    }
+
+    for (int32 ObjectIndex = NewObjects.Num() - 1; ObjectIndex > 0; --ObjectIndex)
+    {
+        NewObjects[NewObjects[ObjectIndex].Owner].Retained += NewObjects[ObjectIndex].Retained;
+    }
+
+    // the retained sizes follow from the rest, so equal objects, shapes and attributions mean equal results
+    bool bChanged = NewObjects.Num() != Objects.Num() || bNewTruncated != bTruncated;
+    for (int32 ObjectIndex = 0; ObjectIndex < NewObjects.Num() && bChanged == false; ++ObjectIndex)
+    {
+        const FActorDebuggerObjectFootprint& New = NewObjects[ObjectIndex];
+        const FActorDebuggerObjectFootprint& Old = Objects[ObjectIndex];
+        bChanged = New.Object != Old.Object || New.ShapeHash != Old.ShapeHash || New.ResourceSize != Old.ResourceSize || New.OwnerSlot != Old.OwnerSlot;
+    }
+
+    Objects = MoveTemp(NewObjects);
+    Indices = MoveTemp(NewIndices);
+    bTruncated = bNewTruncated;
+    NumResourceSizesTaken = NumTaken;
+    INC_DWORD_STAT_BY(STAT_ActorDebugger_ResourceSizes, NumResourceSizesTaken);
+
+    if (bTruncated)
+    {
+        UE_LOG(LogActorDebugger, Verbose, TEXT("Actor Debugger: measured the first %d objects below %s, see ActorDebugger.MemoryMaxObjects"), MaxObjects, *GetNameSafe(Root));
+    }
+
+    if (bChanged)
+    {
+        ++Generation;
+    }
+    return bChanged;
+}
+
+void FActorDebuggerMemory::Reset()
+{
+    if (Objects.Num() > 0)
+    {
+        ++Generation;
+    }
+
+    Objects.Reset();
+    Indices.Reset();
+    Schemas.Reset();
+    NumResourceSizesTaken = 0;
+    bTruncated = false;
+}
+
+const FActorDebuggerObjectFootprint* FActorDebuggerMemory::Find(const UObject* Object) const
+{
+    const int32* Index = Indices.Find(Object);
+    return Index ? &Objects[*Index] : nullptr;
+}
+
+/*
+* A row's value is measured the way its kind stores it: members with every element of a C style array, elements
+* and map pairs on their own and pages as their range of the container. Elements are part of their container's
+* allocation, so a row is never smaller than the rows below it
+*/
+bool FActorDebuggerMemory::MeasureNode(const FReflectedActorProperty& Node, FActorDebuggerNodeMemory& OutMemory) const
+{
+    OutMemory = FActorDebuggerNodeMemory();
+
+    if (Node.IsValid() == false || Indices.Contains(Node.Object) == false)
+    {
+        return false;
+    }
+
+    const uint8* ValuePtr = Node.ResolveValuePtr();
+    if (ValuePtr == nullptr)
+    {
+        return false;
+    }
+
+    TArray<FReference> References;
+
+    if (Node.Kind == EReflectedPropertyKind::Page)
+    {
+        MeasureElements(Node.Parent->Property, ValuePtr, Node.Index, Node.PageEnd, OutMemory.Value, References);
+    }
+    else if (Node.Kind == EReflectedPropertyKind::ObjectMember || Node.Kind == EReflectedPropertyKind::StructMember)
+    {
+        MeasureValue(Node.Property, ValuePtr, OutMemory.Value);
+        GatherReferences(Node.Property, ValuePtr, References);
+    }
+    else
+    {
+        OutMemory.Value.Inline += Node.Property->ElementSize;
+        MeasureElementHeap(Node.Property, ValuePtr, OutMemory.Value);
+        GatherElementReferences(Node.Property, ValuePtr, References);
+
+        const FReflectedActorProperty* ContainerItem = Node.Parent && Node.Parent->Kind == EReflectedPropertyKind::Page ? Node.Parent->Parent : Node.Parent;
+        const FMapProperty* MapProperty = ContainerItem ? CastField<FMapProperty>(ContainerItem->Property) : nullptr;
+        const uint8* KeyPtr = Node.ResolveMapKeyPtr();
+        if (MapProperty && KeyPtr)
+        {
+            OutMemory.Value.Inline += MapProperty->KeyProp->ElementSize;
+            MeasureElementHeap(MapProperty->KeyProp, KeyPtr, OutMemory.Value);
+        }
+    }
+
+    // a row that is itself the reference an object was first reached through shows the object's own bytes too
+    if (References.Num() == 1 && References[0].Slot == ValuePtr && Node.IsContainer() == false)
+    {
+        const FActorDebuggerObjectFootprint* Footprint = Find(References[0].Object);
+        if (Footprint && Footprint->OwnerSlot == ValuePtr)
+        {
+            OutMemory.ObjectExclusive = Footprint->Exclusive;
+            OutMemory.ObjectResourceSize = Footprint->ResourceSize;
+        }
+    }
+
+    OutMemory.Retained = OutMemory.Value.GetTotal() + SumOwnedRetained(References);
+    return true;
+}
+
+void FActorDebuggerMemory::GetLargestContributors(int32 Num, TArray<int32>& OutIndices) const
+{
+    OutIndices.Reset(Objects.Num());
+    for (int32 ObjectIndex = 0; ObjectIndex < Objects.Num(); ++ObjectIndex)
+    {
+        OutIndices.Add(ObjectIndex);
+    }
+
+    OutIndices.StableSort([this](int32 A, int32 B) { return Objects[A].Exclusive > Objects[B].Exclusive; });
+    OutIndices.SetNum(FMath::Clamp(Num, 0, OutIndices.Num()));
+}
+
+SIZE_T FActorDebuggerMemory::GetAllocatedSize() const
+{
+    return Objects.GetAllocatedSize() + Indices.GetAllocatedSize() + Schemas.GetAllocatedSize();
+}
+
+void FActorDebuggerMemory::MeasureValue(const FProperty* Property, const uint8* ValuePtr, FActorDebuggerMemorySize& OutSize)
+{
+    if (Property == nullptr || ValuePtr == nullptr)
+    {
+        return;
+    }
+
+    OutSize.Inline += static_cast<int64>(Property->ElementSize) * Property->ArrayDim;
+    MeasureHeap(Property, ValuePtr, OutSize);
+}
+
+FString FActorDebuggerMemory::FormatBytes(int64 Bytes)
+{
+    if (Bytes < 1024)
+    {
+        return FString::Printf(TEXT("%lld B"), Bytes);
+    }
+    if (Bytes < 1024 * 1024)
+    {
+        return FString::Printf(TEXT("%.1f KB"), Bytes / 1024.0);
+    }
+    return FString::Printf(TEXT("%.1f MB"), Bytes / (1024.0 * 1024.0));
+}
+
+void FActorDebuggerMemory::PrepareSchemas(const UStruct* Struct)
+{
+    if (Struct == nullptr || Schemas.Contains(Struct))
+    {
+        return;
+    }
+
+    const FActorDebuggerClassSchemaPtr Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(Struct);
+    Schemas.Add(Struct, Schema);
+
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+    {
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(FActorDebuggerSchemaCache::GetElementProperty(Entry.Property)))
+        {
+            PrepareSchemas(StructProperty->Struct);
+        }
+    }
+}
+
+/*
+* The class size covers the object's inline members, every property is followed for the heap it owns. Only the
+* schema entries are followed for references, those are what the tree expands. The resource size is left to Update
+*/
+void FActorDebuggerMemory::MeasureObject(UObject* Object, bool bGatherReferences, FActorDebuggerObjectFootprint& OutFootprint, TArray<FReference>& OutReferences) const
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_MeasureObject);
+
+    const UClass* Class = Object->GetClass();
+    const uint8* Container = reinterpret_cast<const uint8*>(Object);
+
+    OutFootprint.Size.Inline = Class->GetStructureSize();
+    for (const FProperty* Property = Class->PropertyLink; Property; Property = Property->PropertyLinkNext)
+    {
+        MeasureHeap(Property, Property->ContainerPtrToValuePtr<uint8>(Container), OutFootprint.Size);
+    }
+
+    const FActorDebuggerClassSchemaPtr* Schema = bGatherReferences ? Schemas.Find(Class) : nullptr;
+    if (Schema)
+    {
+        for (const FActorDebuggerPropertySchemaEntry& Entry : (*Schema)->Entries)
+        {
+            GatherReferences(Entry.Property, Entry.GetValuePtr(Container), OutReferences);
+        }
+    }
+
+    uint64 Hash = CombineHashes(reinterpret_cast<UPTRINT>(Class), CombineHashes(OutFootprint.Size.Allocated, OutFootprint.Size.Used));
+    for (const FReference& Reference : OutReferences)
+    {
+        Hash = CombineHashes(Hash, CombineHashes(reinterpret_cast<UPTRINT>(Reference.Slot), reinterpret_cast<UPTRINT>(Reference.Object)));
+    }
+    OutFootprint.ShapeHash = Hash;
+}
+
+void FActorDebuggerMemory::GatherReferences(const FProperty* Property, const uint8* ValuePtr, TArray<FReference>& OutReferences) const
+{
+    for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+    {
+        GatherElementReferences(Property, ValuePtr + Index * Property->ElementSize, OutReferences);
+    }
+}
+
+/*
+* Follows the same references the tree expands: object references the tree is interested in, the members of
+* structs in their schema and the elements of containers, the values of maps
+*/
+void FActorDebuggerMemory::GatherElementReferences(const FProperty* Property, const uint8* ValuePtr, TArray<FReference>& OutReferences) const
+{
+    if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+    {
+        UObject* Object = ObjectProperty->GetObjectPropertyValue(ValuePtr);
+        if (Object && FActorDebuggerInspection::IsUObjectOfInterest(Object))
+        {
+            OutReferences.Add({ValuePtr, Object});
+        }
+    }
+    else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+    {
+        if (const FActorDebuggerClassSchemaPtr* Schema = Schemas.Find(StructProperty->Struct))
+        {
+            for (const FActorDebuggerPropertySchemaEntry& Entry : (*Schema)->Entries)
+            {
+                GatherReferences(Entry.Property, Entry.GetValuePtr(ValuePtr), OutReferences);
+            }
+        }
+    }
+    else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+    {
+        if (MayHoldReferences(ArrayProperty->Inner))
+        {
+            FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+            for (int32 Index = 0; Index < Helper.Num(); ++Index)
+            {
+                GatherElementReferences(ArrayProperty->Inner, Helper.GetRawPtr(Index), OutReferences);
+            }
+        }
+    }
+    else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+    {
+        if (MayHoldReferences(SetProperty->ElementProp))
+        {
+            FScriptSetHelper Helper(SetProperty, ValuePtr);
+            for (FScriptSetHelper::FIterator It(Helper); It; ++It)
+            {
+                GatherElementReferences(SetProperty->ElementProp, Helper.GetElementPtr(It), OutReferences);
+            }
+        }
+    }
+    else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+    {
+        if (MayHoldReferences(MapProperty->ValueProp))
+        {
+            FScriptMapHelper Helper(MapProperty, ValuePtr);
+            for (FScriptMapHelper::FIterator It(Helper); It; ++It)
+            {
+                GatherElementReferences(MapProperty->ValueProp, Helper.GetValuePtr(It), OutReferences);
+            }
+        }
+    }
+}
+
+void FActorDebuggerMemory::MeasureElements(const FProperty* ContainerProperty, const uint8* ContainerPtr, int32 Start, int32 End, FActorDebuggerMemorySize& OutSize, TArray<FReference>& OutReferences) const
+{
+    auto AddElement = [this, &OutSize, &OutReferences](const FProperty* ElementProperty, const uint8* ElementPtr)
+    {
+        OutSize.Inline += ElementProperty->ElementSize;
+        MeasureElementHeap(ElementProperty, ElementPtr, OutSize);
+        GatherElementReferences(ElementProperty, ElementPtr, OutReferences);
+    };
+
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(ContainerProperty))
+    {
+        FScriptArrayHelper Helper(ArrayProperty, ContainerPtr);
+        for (int32 Index = Start; Index < FMath::Min(End, Helper.Num()); ++Index)
+        {
+            AddElement(ArrayProperty->Inner, Helper.GetRawPtr(Index));
+        }
+    }
+    else if (const FSetProperty* SetProperty = CastField<FSetProperty>(ContainerProperty))
+    {
+        FScriptSetHelper Helper(SetProperty, ContainerPtr);
+        for (FScriptSetHelper::FIterator It(Helper); It && It.GetLogicalIndex() < End; ++It)
+        {
+            if (It.GetLogicalIndex() >= Start)
+            {
+                AddElement(SetProperty->ElementProp, Helper.GetElementPtr(It));
+            }
+        }
+    }
+    else if (const FMapProperty* MapProperty = CastField<FMapProperty>(ContainerProperty))
+    {
+        FScriptMapHelper Helper(MapProperty, ContainerPtr);
+        for (FScriptMapHelper::FIterator It(Helper); It && It.GetLogicalIndex() < End; ++It)
+        {
+            if (It.GetLogicalIndex() >= Start)
+            {
+                OutSize.Inline += MapProperty->KeyProp->ElementSize;
+                MeasureElementHeap(MapProperty->KeyProp, Helper.GetKeyPtr(It), OutSize);
+                AddElement(MapProperty->ValueProp, Helper.GetValuePtr(It));
+            }
+        }
+    }
+}
+
+int64 FActorDebuggerMemory::SumOwnedRetained(const TArray<FReference>& References) const
+{
+    int64 Retained = 0;
+    for (const FReference& Reference : References)
+    {
+        const FActorDebuggerObjectFootprint* Footprint = Find(Reference.Object);
+        if (Footprint && Footprint->OwnerSlot == Reference.Slot)
+        {
+            Retained += Footprint->Retained;
+        }
+    }
+    return Retained;
+}
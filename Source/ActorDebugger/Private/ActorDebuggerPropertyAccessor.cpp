@@ -0,0 +1,297 @@
+#include "ActorDebuggerPropertyAccessor.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerSchemaCache.h"
+#include "Async/ParallelFor.h"
+#include "UObject/UnrealType.h"
+#include "UObject/EnumProperty.h"
+#include <atomic>
+
+namespace ActorDebuggerPropertyAccessor
+{
+    /* Fewer objects than this are read on the calling thread, the reads would cost less than waking the workers */
+    static constexpr int32 MinParallelObjects = 1024;
+
+    typedef TSharedPtr<const FActorDebuggerCompiledAccessor, ESPMode::ThreadSafe> FCompiledAccessorPtr;
+
+    /* Every accessor compiled so far, by class and path. Only used on the game thread */
+    static TMap<TPair<const UClass*, FString>, FCompiledAccessorPtr> Cache;
+    static bool bCacheRegistered = false;
+
+    static EActorDebuggerAccessorType GetAccessorType(const FActorDebuggerPropertyPath& Path, const FNumericProperty*& OutNumericProperty)
+    {
+        const FProperty* Property = Path.GetLeafProperty();
+        OutNumericProperty = nullptr;
+
+        if (Path.IsLeafContainer())
+        {
+            return EActorDebuggerAccessorType::Count;
+        }
+        if (Property->IsA<FBoolProperty>())
+        {
+            return EActorDebuggerAccessorType::Bool;
+        }
+        if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+        {
+            OutNumericProperty = EnumProperty->GetUnderlyingProperty();
+            return EActorDebuggerAccessorType::Number;
+        }
+        if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+        {
+            OutNumericProperty = NumericProperty;
+            return EActorDebuggerAccessorType::Number;
+        }
+        if (Property->IsA<FObjectPropertyBase>())
+        {
+            return EActorDebuggerAccessorType::Object;
+        }
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            if (StructProperty->Struct == TBaseStructure<FVector>::Get())
+            {
+                return EActorDebuggerAccessorType::Vector;
+            }
+            if (StructProperty->Struct == TBaseStructure<FRotator>::Get())
+            {
+                return EActorDebuggerAccessorType::Rotator;
+            }
+        }
+        return EActorDebuggerAccessorType::Other;
+    }
+
+    /* Sizes the batch outputs and reads every object, in parallel if there are enough of them */
+    template <typename ValueType, typename ReadFunctionType>
+    static int32 ReadBatch(TConstArrayView<UObject*> Objects, TArray<ValueType>& OutValues, TArray<bool>& OutResolved, ReadFunctionType ReadFunction)
+    {
+        const int32 NumObjects = Objects.Num();
+        OutValues.SetNumUninitialized(NumObjects);
+        OutResolved.SetNumUninitialized(NumObjects);
+
+        std::atomic<int32> NumResolved {0};
+        ParallelFor(NumObjects, [&](int32 Index)
+        {
+            const bool bResolved = ReadFunction(Objects[Index], OutValues[Index]);
+            if (bResolved == false)
+            {
+                OutValues[Index] = ValueType(0);
+            }
+            OutResolved[Index] = bResolved;
+            if (bResolved)
+            {
+                NumResolved.fetch_add(1, std::memory_order_relaxed);
+            }
+        }, NumObjects < MinParallelObjects ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+        return NumResolved.load();
+    }
+}
+
+using namespace ActorDebuggerPropertyAccessor;
+
+/*
+* Accessors compiled for a class that has since been replaced are compiled again against the class asked for.
+* The cache is emptied with the schema cache, which is when classes are reinstanced or reloaded
+*/
+FActorDebuggerPropertyAccessor FActorDebuggerPropertyAccessor::Compile(UClass* InClass, const FString& InPath, FText& OutError)
+{
+    check(IsInGameThread());
+
+    FActorDebuggerPropertyAccessor Accessor;
+    Accessor.Class = InClass;
+    Accessor.Path = InPath.TrimStartAndEnd();
+
+    if (InClass == nullptr)
+    {
+        OutError = FText::FromString("Choose a class first");
+        return Accessor;
+    }
+
+    if (bCacheRegistered == false)
+    {
+        FActorDebuggerSchemaCache::Get().OnSchemasInvalidated.AddStatic(&FActorDebuggerPropertyAccessor::ResetCache);
+        bCacheRegistered = true;
+    }
+
+    const TPair<const UClass*, FString> Key(InClass, Accessor.Path);
+    if (const FCompiledAccessorPtr* Found = Cache.Find(Key); Found && (*Found)->Class.Get() == InClass)
+    {
+        Accessor.Compiled = *Found;
+        return Accessor;
+    }
+
+    TSharedRef<FActorDebuggerCompiledAccessor, ESPMode::ThreadSafe> Compiled = MakeShared<FActorDebuggerCompiledAccessor, ESPMode::ThreadSafe>();
+    if (Compiled->Path.Compile(InClass, Accessor.Path, OutError) == false)
+    {
+        return Accessor;
+    }
+
+    Compiled->Class = InClass;
+    Compiled->Type = GetAccessorType(Compiled->Path, Compiled->NumericProperty);
+    Compiled->Formatter = FActorDebuggerFormatters::Select(Compiled->Path.GetLeafProperty());
+
+    Accessor.Compiled = Compiled;
+    Cache.Add(Key, Accessor.Compiled);
+    return Accessor;
+}
+
+void FActorDebuggerPropertyAccessor::ResetCache()
+{
+    Cache.Reset();
+}
+
+const uint8* FActorDebuggerPropertyAccessor::Resolve(const UObject* Object) const
+{
+    if (Compiled.IsValid() == false || Object == nullptr)
+    {
+        return nullptr;
+    }
+
+    const UClass* CompiledClass = Compiled->Class.Get();
+    return CompiledClass && Object->IsA(CompiledClass) ? ResolveUnchecked(Object) : nullptr;
+}
+
+bool FActorDebuggerPropertyAccessor::ConvertNumber(const uint8* ValuePtr, double& OutValue) const
+{
+    switch (Compiled->Type)
+    {
+    case EActorDebuggerAccessorType::Number:
+        OutValue = Compiled->NumericProperty->IsFloatingPoint()
+            ? Compiled->NumericProperty->GetFloatingPointPropertyValue(ValuePtr)
+            : static_cast<double>(Compiled->NumericProperty->GetSignedIntPropertyValue(ValuePtr));
+        return true;
+    case EActorDebuggerAccessorType::Bool:
+        OutValue = static_cast<const FBoolProperty*>(Compiled->Path.GetLeafProperty())->GetPropertyValue(ValuePtr) ? 1.0 : 0.0;
+        return true;
+    case EActorDebuggerAccessorType::Count:
+        OutValue = FReflectedActorProperty::GetContainerNum(Compiled->Path.GetLeafProperty(), ValuePtr);
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool FActorDebuggerPropertyAccessor::ReadNumber(const UObject* Object, double& OutValue) const
+{
+    const uint8* ValuePtr = Resolve(Object);
+    return ValuePtr && ConvertNumber(ValuePtr, OutValue);
+}
+
+/*
+* Integers are read without going through a double, so 64 bit values keep every bit. Floating point values are
+* truncated
+*/
+bool FActorDebuggerPropertyAccessor::ReadInteger(const UObject* Object, int64& OutValue) const
+{
+    const uint8* ValuePtr = Resolve(Object);
+    if (ValuePtr == nullptr)
+    {
+        return false;
+    }
+
+    if (Compiled->Type == EActorDebuggerAccessorType::Number && Compiled->NumericProperty->IsInteger())
+    {
+        OutValue = Compiled->NumericProperty->GetSignedIntPropertyValue(ValuePtr);
+        return true;
+    }
+
+    double Value = 0.0;
+    if (ConvertNumber(ValuePtr, Value) == false)
+    {
+        return false;
+    }
+    OutValue = static_cast<int64>(Value);
+    return true;
+}
+
+bool FActorDebuggerPropertyAccessor::ReadBool(const UObject* Object, bool& OutValue) const
+{
+    double Value = 0.0;
+    if (ReadNumber(Object, Value) == false)
+    {
+        return false;
+    }
+    OutValue = Value != 0.0;
+    return true;
+}
+
+bool FActorDebuggerPropertyAccessor::ReadVector(const UObject* Object, FVector& OutValue) const
+{
+    const uint8* ValuePtr = Resolve(Object);
+    if (ValuePtr == nullptr || Compiled->Type != EActorDebuggerAccessorType::Vector)
+    {
+        return false;
+    }
+    OutValue = *reinterpret_cast<const FVector*>(ValuePtr);
+    return true;
+}
+
+bool FActorDebuggerPropertyAccessor::ReadRotator(const UObject* Object, FRotator& OutValue) const
+{
+    const uint8* ValuePtr = Resolve(Object);
+    if (ValuePtr == nullptr || Compiled->Type != EActorDebuggerAccessorType::Rotator)
+    {
+        return false;
+    }
+    OutValue = *reinterpret_cast<const FRotator*>(ValuePtr);
+    return true;
+}
+
+bool FActorDebuggerPropertyAccessor::ReadObject(const UObject* Object, UObject*& OutValue) const
+{
+    const uint8* ValuePtr = Resolve(Object);
+    if (ValuePtr == nullptr || Compiled->Type != EActorDebuggerAccessorType::Object)
+    {
+        return false;
+    }
+    OutValue = static_cast<const FObjectPropertyBase*>(Compiled->Path.GetLeafProperty())->GetObjectPropertyValue(ValuePtr);
+    return true;
+}
+
+/*
+* Containers are shown as their element count, as in the tree
+*/
+bool FActorDebuggerPropertyAccessor::ReadString(const UObject* Object, FString& OutValue) const
+{
+    const uint8* ValuePtr = Resolve(Object);
+    if (ValuePtr == nullptr)
+    {
+        return false;
+    }
+
+    if (Compiled->Type == EActorDebuggerAccessorType::Count)
+    {
+        OutValue = FString::Printf(TEXT("%d"), FReflectedActorProperty::GetContainerNum(Compiled->Path.GetLeafProperty(), ValuePtr));
+        return true;
+    }
+
+    TStringBuilder<256> Builder;
+    Compiled->Formatter(Compiled->Path.GetLeafProperty(), ValuePtr, const_cast<UObject*>(Object), Builder);
+    OutValue = Builder.ToString();
+    return true;
+}
+
+/*
+* The class is resolved once for the whole batch, each object then costs an IsA check and the path's offsets
+*/
+int32 FActorDebuggerPropertyAccessor::ReadNumbers(TConstArrayView<UObject*> Objects, TArray<double>& OutValues, TArray<bool>& OutResolved) const
+{
+    const UClass* CompiledClass = Compiled.IsValid() ? Compiled->Class.Get() : nullptr;
+    return ReadBatch(Objects, OutValues, OutResolved, [this, CompiledClass](const UObject* Object, double& OutValue)
+    {
+        const uint8* ValuePtr = CompiledClass && Object && Object->IsA(CompiledClass) ? ResolveUnchecked(Object) : nullptr;
+        return ValuePtr && ConvertNumber(ValuePtr, OutValue);
+    });
+}
+
+int32 FActorDebuggerPropertyAccessor::ReadVectors(TConstArrayView<UObject*> Objects, TArray<FVector>& OutValues, TArray<bool>& OutResolved) const
+{
+    const UClass* CompiledClass = Compiled.IsValid() && Compiled->Type == EActorDebuggerAccessorType::Vector ? Compiled->Class.Get() : nullptr;
+    return ReadBatch(Objects, OutValues, OutResolved, [this, CompiledClass](const UObject* Object, FVector& OutValue)
+    {
+        const uint8* ValuePtr = CompiledClass && Object && Object->IsA(CompiledClass) ? ResolveUnchecked(Object) : nullptr;
+        if (ValuePtr)
+        {
+            OutValue = *reinterpret_cast<const FVector*>(ValuePtr);
+        }
+        return ValuePtr != nullptr;
+    });
+}
@@ -0,0 +1,195 @@
+#include "ActorDebuggerPropertyPath.h"
+#include "UObject/UnrealType.h"
+
+namespace ActorDebuggerPropertyPath
+{
+    /*
+    * Splits "Ammo[2]" into the name and the index, the index is INDEX_NONE if there is none
+    */
+    static bool ParseName(const FString& Text, FString& OutName, int32& OutIndex)
+    {
+        OutIndex = INDEX_NONE;
+
+        int32 BracketIndex = INDEX_NONE;
+        if (Text.FindChar(TEXT('['), BracketIndex) == false)
+        {
+            OutName = Text.TrimStartAndEnd();
+            return OutName.IsEmpty() == false;
+        }
+
+        const FString IndexText = Text.Mid(BracketIndex + 1).TrimEnd();
+        if (IndexText.EndsWith(TEXT("]")) == false)
+        {
+            return false;
+        }
+
+        const FString Digits = IndexText.LeftChop(1).TrimStartAndEnd();
+        if (Digits.IsEmpty() || FCString::IsNumeric(*Digits) == false || Digits.Contains(TEXT(".")) || Digits.StartsWith(TEXT("-")))
+        {
+            return false;
+        }
+
+        OutName = Text.Left(BracketIndex).TrimStartAndEnd();
+        OutIndex = FCString::Atoi(*Digits);
+        return OutName.IsEmpty() == false;
+    }
+}
+
+using namespace ActorDebuggerPropertyPath;
+
+/*
+* Members of structs are laid out inline, so stepping into a struct only adds to the pending offset
+*/
+void FActorDebuggerPropertyPath::AddOffset(int32 Offset)
+{
+    if (Steps.Num() > 0 && Steps.Last().Kind == EStepKind::Offset)
+    {
+        Steps.Last().Offset += Offset;
+        return;
+    }
+
+    FStep Step;
+    Step.Kind = EStepKind::Offset;
+    Step.Offset = Offset;
+    Steps.Add(Step);
+}
+
+bool FActorDebuggerPropertyPath::Compile(const UStruct* Struct, const FString& InPath, FText& OutError)
+{
+    check(Struct);
+
+    Steps.Reset();
+    LeafProperty = nullptr;
+    bLeafContainer = false;
+    Path = InPath.TrimStartAndEnd();
+
+    TArray<FString> Names;
+    Path.ParseIntoArray(Names, TEXT("."), false);
+    if (Names.Num() == 0)
+    {
+        OutError = FText::FromString("The property path is empty");
+        return false;
+    }
+
+    const UStruct* CurrentStruct = Struct;
+    const FProperty* ValueProperty = nullptr;
+    bool bIndexed = false;
+
+    for (const FString& Text : Names)
+    {
+        // step into the value named so far
+        if (ValueProperty)
+        {
+            if (const FStructProperty* StructProperty = CastField<FStructProperty>(ValueProperty))
+            {
+                CurrentStruct = StructProperty->Struct;
+            }
+            else if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(ValueProperty))
+            {
+                FStep Step;
+                Step.Kind = EStepKind::Object;
+                Step.Property = ObjectProperty;
+                Steps.Add(Step);
+                CurrentStruct = ObjectProperty->PropertyClass;
+            }
+            else
+            {
+                OutError = FText::FromString(FString::Printf(TEXT("%s isn't a struct or an object reference"), *ValueProperty->GetName()));
+                return false;
+            }
+        }
+
+        FString Name;
+        int32 Index = INDEX_NONE;
+        if (ParseName(Text, Name, Index) == false)
+        {
+            OutError = FText::FromString(FString::Printf(TEXT("\"%s\" isn't a property name, names may be followed by an index such as [2]"), *Text));
+            return false;
+        }
+
+        const FProperty* Property = FindFProperty<FProperty>(CurrentStruct, *Name);
+        if (Property == nullptr)
+        {
+            OutError = FText::FromString(FString::Printf(TEXT("%s has no property named %s"), *CurrentStruct->GetName(), *Name));
+            return false;
+        }
+
+        AddOffset(Property->GetOffset_ForInternal());
+        ValueProperty = Property;
+        bIndexed = Index != INDEX_NONE;
+
+        if (bIndexed == false)
+        {
+            continue;
+        }
+
+        if (Property->ArrayDim > 1)
+        {
+            // C style arrays are inline as well, out of range indices are caught here rather than on every resolve
+            if (Index >= Property->ArrayDim)
+            {
+                OutError = FText::FromString(FString::Printf(TEXT("%s only has %d elements"), *Name, Property->ArrayDim));
+                return false;
+            }
+            AddOffset(Index * Property->ElementSize);
+        }
+        else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+        {
+            FStep Step;
+            Step.Kind = EStepKind::ArrayElement;
+            Step.Index = Index;
+            Step.Property = ArrayProperty;
+            Steps.Add(Step);
+            ValueProperty = ArrayProperty->Inner;
+        }
+        else
+        {
+            OutError = FText::FromString(FString::Printf(TEXT("%s isn't an array, only arrays can be indexed"), *Name));
+            return false;
+        }
+    }
+
+    LeafProperty = ValueProperty;
+    bLeafContainer = (bIndexed == false && LeafProperty->ArrayDim > 1)
+        || LeafProperty->IsA<FArrayProperty>() || LeafProperty->IsA<FSetProperty>() || LeafProperty->IsA<FMapProperty>();
+    return true;
+}
+
+const uint8* FActorDebuggerPropertyPath::Resolve(const void* Container) const
+{
+    const uint8* ValuePtr = static_cast<const uint8*>(Container);
+
+    for (const FStep& Step : Steps)
+    {
+        switch (Step.Kind)
+        {
+        case EStepKind::Offset:
+            ValuePtr += Step.Offset;
+            break;
+
+        case EStepKind::Object:
+        {
+            const UObject* Object = static_cast<const FObjectProperty*>(Step.Property)->GetObjectPropertyValue(ValuePtr);
+            if (IsValid(Object) == false)
+            {
+                return nullptr;
+            }
+            ValuePtr = reinterpret_cast<const uint8*>(Object);
+            break;
+        }
+
+        case EStepKind::ArrayElement:
+        {
+            FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(Step.Property), ValuePtr);
+            if (ArrayHelper.IsValidIndex(Step.Index) == false)
+            {
+                return nullptr;
+            }
+            ValuePtr = ArrayHelper.GetRawPtr(Step.Index);
+            break;
+        }
+        }
+    }
+
+    return ValuePtr;
+}
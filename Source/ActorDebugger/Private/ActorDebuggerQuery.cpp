@@ -0,0 +1,211 @@
+#include "ActorDebuggerQuery.h"
+#include "ActorDebuggerStats.h"
+#include "Async/ParallelFor.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/Class.h"
+#include "Engine/World.h"
+
+namespace ActorDebuggerQuery
+{
+    /* Fewer objects than this are scanned on the game thread, the scan would cost less than waking the workers */
+    static constexpr int32 MinParallelObjects = 256;
+}
+
+using namespace ActorDebuggerQuery;
+
+TArray<FString> FActorDebuggerQuery::SplitPredicates(const FString& Text)
+{
+    TArray<FString> Predicates;
+    Text.ParseIntoArray(Predicates, TEXT("&&"), true);
+
+    for (FString& Predicate : Predicates)
+    {
+        Predicate.TrimStartAndEndInline();
+    }
+    Predicates.RemoveAll([](const FString& Predicate) { return Predicate.IsEmpty(); });
+
+    return Predicates;
+}
+
+/*
+* Native classes are registered without their prefix and Blueprint classes with a _C suffix, neither of which
+* users tend to type
+*/
+UClass* FActorDebuggerQuery::FindClass(const FString& Name)
+{
+    if (Name.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    if (Name.Contains(TEXT("/")))
+    {
+        return FindObject<UClass>(nullptr, *Name);
+    }
+
+    TArray<FString, TInlineAllocator<3>> Candidates;
+    Candidates.Add(Name);
+    if (Name.Len() > 1 && (Name[0] == TEXT('A') || Name[0] == TEXT('U')) && FChar::IsUpper(Name[1]))
+    {
+        Candidates.Add(Name.Mid(1));
+    }
+    if (Name.EndsWith(TEXT("_C")) == false)
+    {
+        Candidates.Add(Name + TEXT("_C"));
+    }
+
+    for (const FString& Candidate : Candidates)
+    {
+        if (UClass* FoundClass = FindFirstObject<UClass>(*Candidate, EFindFirstObjectOptions::NativeFirst))
+        {
+            return FoundClass;
+        }
+    }
+
+    return nullptr;
+}
+
+bool FActorDebuggerQuery::Compile(const FString& Query, FText& OutError)
+{
+    FString ClassName;
+    FString PredicateText;
+    const FString TrimmedQuery = Query.TrimStartAndEnd();
+    if (TrimmedQuery.Split(TEXT(" "), &ClassName, &PredicateText) == false)
+    {
+        ClassName = TrimmedQuery;
+    }
+
+    UClass* QueryClass = FindClass(ClassName);
+    if (QueryClass == nullptr)
+    {
+        OutError = FText::FromString(FString::Printf(TEXT("There is no class named \"%s\", queries look like \"Pawn Health < 10 && Controller != None\""), *ClassName));
+        return false;
+    }
+
+    return Compile(QueryClass, SplitPredicates(PredicateText), OutError);
+}
+
+/*
+* Each predicate names a property path and compares its value, the condition is compiled for the property at the
+* end of the path. Predicates without an operator are rejected, a query has nothing to compare "changed" with
+*/
+bool FActorDebuggerQuery::Compile(UClass* InClass, const TArray<FString>& InPredicates, FText& OutError)
+{
+    check(InClass);
+
+    Class = nullptr;
+    Predicates.Reset();
+
+    for (const FString& Text : InPredicates)
+    {
+        FPredicate Predicate;
+        Predicate.Text = Text.TrimStartAndEnd();
+
+        FString PathText;
+        FString Operand;
+        EActorDebuggerConditionOp Op;
+        if (FActorDebuggerCondition::Parse(Predicate.Text, PathText, Op, Operand) == false || Op == EActorDebuggerConditionOp::Changed || PathText.IsEmpty())
+        {
+            OutError = FText::FromString(FString::Printf(TEXT("\"%s\" isn't a predicate, predicates look like \"Health < 10\" or \"Weapon.Ammo[0] >= 3\""), *Predicate.Text));
+            return false;
+        }
+
+        if (Predicate.Path.Compile(InClass, PathText, OutError) == false)
+        {
+            return false;
+        }
+
+        if (Predicate.Condition.Compile(Predicate.Path.GetLeafProperty(), Op, Operand, Predicate.Path.IsLeafContainer(), OutError) == false)
+        {
+            return false;
+        }
+
+        Predicates.Add(MoveTemp(Predicate));
+    }
+
+    Class = InClass;
+    return true;
+}
+
+bool FActorDebuggerQuery::Matches(const UObject* Object) const
+{
+    checkSlow(Object->IsA(Class));
+
+    for (const FPredicate& Predicate : Predicates)
+    {
+        const uint8* ValuePtr = Predicate.Path.Resolve(Object);
+        if (ValuePtr == nullptr || Predicate.Condition.Evaluate(ValuePtr) == false)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+* Class default objects and templates aren't instances anyone would look for
+*/
+void FActorDebuggerQuery::GatherObjects(const UClass* ObjectClass, const UWorld* World, TArray<UObject*>& OutObjects)
+{
+    check(IsInGameThread());
+
+    ForEachObjectOfClass(ObjectClass, [World, &OutObjects](UObject* Object)
+    {
+        if (World == nullptr || Object->IsIn(World))
+        {
+            OutObjects.Add(Object);
+        }
+    }, true, RF_ClassDefaultObject | RF_ArchetypeObject, EInternalObjectFlags::Garbage);
+}
+
+/*
+* Gathering touches the object hash and world membership, so it stays on the game thread. The scan only reads
+* property memory through the compiled paths, each worker writes its own objects' flags and the matches are
+* collected afterwards in gathering order
+*/
+FActorDebuggerQueryResult FActorDebuggerQuery::Run(const UWorld* World) const
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_Query);
+    check(IsInGameThread());
+    check(Class);
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    FActorDebuggerQueryResult Result;
+
+    TArray<UObject*> Objects;
+    GatherObjects(Class, World, Objects);
+
+    TArray<bool> Matched;
+    Matched.SetNumZeroed(Objects.Num());
+
+    ParallelFor(Objects.Num(), [this, &Objects, &Matched](int32 ObjectIndex)
+    {
+        Matched[ObjectIndex] = Matches(Objects[ObjectIndex]);
+    }, Objects.Num() < MinParallelObjects ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+    for (int32 ObjectIndex = 0; ObjectIndex < Objects.Num(); ++ObjectIndex)
+    {
+        if (Matched[ObjectIndex])
+        {
+            Result.Matches.Add(Objects[ObjectIndex]);
+        }
+    }
+
+    Result.NumScanned = Objects.Num();
+    Result.Milliseconds = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+    return Result;
+}
+
+FString FActorDebuggerQuery::ToString() const
+{
+    FString Text = Class ? Class->GetName() : FString();
+
+    for (int32 PredicateIndex = 0; PredicateIndex < Predicates.Num(); ++PredicateIndex)
+    {
+        Text += PredicateIndex == 0 ? TEXT(" ") : TEXT(" && ");
+        Text += Predicates[PredicateIndex].Text;
+    }
+
+    return Text;
+}
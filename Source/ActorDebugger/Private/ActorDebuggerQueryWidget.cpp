@@ -0,0 +1,152 @@
+#include "ActorDebuggerQueryWidget.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Views/STableRow.h"
+#include "GameFramework/Actor.h"
+#include "Engine/World.h"
+#include "ActorDebuggerQuery.h"
+#include "ActorDebuggerLibrary.h"
+#include "ActorDebugger.h"
+
+BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
+
+/*
+* Constructs the summary line with the refresh button above the list of matches. The list stays empty until the query runs
+*/
+void SActorDebuggerQueryWidget::Construct(const FArguments& InArgs)
+{
+    QueryText = InArgs._Query;
+    World = InArgs._World;
+    bSearchAllWorlds = InArgs._World.IsExplicitlyNull();
+
+    ChildSlot
+    [
+        SNew(SVerticalBox)
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 2))
+            [
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .VAlign(VAlign_Center)
+                [
+                    SAssignNew(SummaryTextBlock, STextBlock)
+                        .ColorAndOpacity(FLinearColor::White)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                        .Text(FText::FromString("Refresh"))
+                        .ToolTipText(FText::FromString("Runs the query again"))
+                        .OnClicked(this, &SActorDebuggerQueryWidget::HandleRefreshClicked)
+                ]
+            ]
+            + SVerticalBox::Slot()
+            .FillHeight(1.0f)
+            [
+                SAssignNew(MatchesView, SListView<FQueryMatchPtr>)
+                    .ListItemsSource(&Matches)
+                    .SelectionMode(ESelectionMode::Single)
+                    .OnGenerateRow(this, &SActorDebuggerQueryWidget::HandleGenerateRow)
+                    .OnMouseButtonClick(this, &SActorDebuggerQueryWidget::HandleMatchClicked)
+            ]
+    ];
+}
+
+/*
+* Matches are labelled once, a destroyed match keeps its label so the list doesn't change under the user
+*/
+bool SActorDebuggerQueryWidget::RunQuery(FText& OutError)
+{
+    FActorDebuggerQuery Query;
+    if (Query.Compile(QueryText, OutError) == false)
+    {
+        SummaryTextBlock->SetText(OutError);
+        return false;
+    }
+
+    const UWorld* QueryWorld = World.Get();
+    if (bSearchAllWorlds == false && QueryWorld == nullptr)
+    {
+        OutError = FText::FromString("The world the query searched is gone");
+        SummaryTextBlock->SetText(OutError);
+        return false;
+    }
+
+    const FActorDebuggerQueryResult Result = Query.Run(QueryWorld);
+
+    Matches.Reset(Result.Matches.Num());
+    for (UObject* Object : Result.Matches)
+    {
+        FQueryMatchPtr Match = MakeShared<FActorDebuggerQueryMatch>();
+        Match->Object = Object;
+        Match->ClassName = Object->GetClass()->GetName();
+
+        // actors show the label they have in the outliner
+        const AActor* Actor = Cast<AActor>(Object);
+        Match->Name = Actor ? Actor->GetActorNameOrLabel() : Object->GetName();
+        Matches.Add(Match);
+    }
+    MatchesView->RequestListRefresh();
+
+    const FString Summary = FString::Printf(TEXT("%s: %d of %d objects matched in %.2f ms"), *Query.ToString(), Result.Matches.Num(), Result.NumScanned, Result.Milliseconds);
+    SummaryTextBlock->SetText(FText::FromString(Summary));
+
+    UE_LOG(LogActorDebugger, Display, TEXT("Actor Debugger: query %s"), *Summary);
+    for (const FQueryMatchPtr& Match : Matches)
+    {
+        UE_LOG(LogActorDebugger, Display, TEXT("    %s (%s)"), *Match->Name, *Match->ClassName);
+    }
+
+    return true;
+}
+
+TSharedRef<ITableRow> SActorDebuggerQueryWidget::HandleGenerateRow(FQueryMatchPtr Match, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(STableRow<FQueryMatchPtr>, OwnerTable)
+        .Padding(FMargin(0, 2))
+        [
+            SNew(SHorizontalBox)
+            + SHorizontalBox::Slot()
+            .FillWidth(1.0f)
+            [
+                SNew(STextBlock)
+                    .Text_Lambda([Match]
+                    {
+                        return FText::FromString(Match->Object.IsValid() ? Match->Name : Match->Name + TEXT(" (destroyed)"));
+                    })
+                    .ColorAndOpacity(FLinearColor::Yellow)
+            ]
+            + SHorizontalBox::Slot()
+            .AutoWidth()
+            .Padding(FMargin(8, 0, 0, 0))
+            [
+                SNew(STextBlock)
+                    .Text(FText::FromString(Match->ClassName))
+                    .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f))
+            ]
+        ];
+}
+
+void SActorDebuggerQueryWidget::HandleMatchClicked(FQueryMatchPtr Match)
+{
+    if (UObject* Object = Match.IsValid() ? Match->Object.Get() : nullptr)
+    {
+        UActorDebuggerLibrary::AddInspectedObject(Object);
+    }
+}
+
+FReply SActorDebuggerQueryWidget::HandleRefreshClicked()
+{
+    FText Error;
+    if (RunQuery(Error) == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: %s"), *Error.ToString());
+    }
+    return FReply::Handled();
+}
+
+END_SLATE_FUNCTION_BUILD_OPTIMIZATION
@@ -0,0 +1,171 @@
+#include "ActorDebuggerRefreshScheduler.h"
+#include "HAL/IConsoleManager.h"
+#include "ActorDebuggerStats.h"
+
+static TAutoConsoleVariable<float> CVarActorDebuggerRefreshBudgetUs(
+    TEXT("ActorDebugger.RefreshBudgetUs"),
+    500.0f,
+    TEXT("Microseconds per frame the Actor Debugger may spend checking displayed values for changes"));
+
+static TAutoConsoleVariable<float> CVarActorDebuggerMaxStalenessMs(
+    TEXT("ActorDebugger.MaxStalenessMs"),
+    500.0f,
+    TEXT("The longest, in milliseconds, a displayed value may go without being checked for changes"));
+
+static TAutoConsoleVariable<float> CVarActorDebuggerHotRowSeconds(
+    TEXT("ActorDebugger.HotRowSeconds"),
+    1.0f,
+    TEXT("How long after its value changed a row is checked at the full refresh rate"));
+
+/*
+* Only a weak reference is kept here, the widgets own the scheduler between them
+*/
+TSharedRef<FActorDebuggerRefreshScheduler> FActorDebuggerRefreshScheduler::GetShared()
+{
+    static TWeakPtr<FActorDebuggerRefreshScheduler> SharedScheduler;
+
+    if (TSharedPtr<FActorDebuggerRefreshScheduler> Scheduler = SharedScheduler.Pin())
+    {
+        return Scheduler.ToSharedRef();
+    }
+
+    TSharedRef<FActorDebuggerRefreshScheduler> Scheduler = MakeShared<FActorDebuggerRefreshScheduler>();
+    SharedScheduler = Scheduler;
+    return Scheduler;
+}
+
+int32 FActorDebuggerRefreshScheduler::AddClient(float RefreshRate, const FSampleItem& SampleItem)
+{
+    FClient Client;
+    Client.SampleItem = SampleItem;
+    Client.HotInterval = 1.0 / FMath::Max(RefreshRate, 1.0f);
+    return Clients.Add(MoveTemp(Client));
+}
+
+void FActorDebuggerRefreshScheduler::RemoveClient(int32 ClientId)
+{
+    ResetClient(ClientId);
+    Clients.RemoveAt(ClientId);
+}
+
+/*
+* New items are made due immediately
+*/
+void FActorDebuggerRefreshScheduler::AddItem(int32 ClientId, const FReflectedActorPropertyPtr& Item)
+{
+    check(Clients.IsValidIndex(ClientId));
+
+    Item->LastSampleTime = 0.0;
+    if (Items.ContainsByPredicate([Item](const FScheduledItem& Scheduled) { return Scheduled.Item == Item; }) == false)
+    {
+        Items.Add({ Item, ClientId });
+    }
+}
+
+void FActorDebuggerRefreshScheduler::RemoveItem(const FReflectedActorPropertyPtr& Item)
+{
+    const int32 Index = Items.IndexOfByPredicate([Item](const FScheduledItem& Scheduled) { return Scheduled.Item == Item; });
+    if (Index != INDEX_NONE)
+    {
+        Items.RemoveAtSwap(Index);
+    }
+}
+
+void FActorDebuggerRefreshScheduler::ResetClient(int32 ClientId)
+{
+    Items.RemoveAllSwap([ClientId](const FScheduledItem& Scheduled) { return Scheduled.ClientId == ClientId; });
+    DueItems.Reset();
+}
+
+void FActorDebuggerRefreshScheduler::TickOncePerFrame()
+{
+    if (LastTickFrame == GFrameCounter)
+    {
+        return;
+    }
+
+    LastTickFrame = GFrameCounter;
+    Tick(FPlatformTime::Seconds());
+}
+
+void FActorDebuggerRefreshScheduler::Tick(double CurrentTime)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_SampleRows);
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    const double BudgetMicroseconds = FMath::Max(CVarActorDebuggerRefreshBudgetUs.GetValueOnGameThread(), 0.0f);
+    const double StalenessBound = FMath::Max(CVarActorDebuggerMaxStalenessMs.GetValueOnGameThread(), 1.0f) / 1000.0;
+    const double HotDuration = CVarActorDebuggerHotRowSeconds.GetValueOnGameThread();
+
+    Stats.BudgetMicroseconds = BudgetMicroseconds;
+    Stats.NumItems = Items.Num();
+    Stats.NumSampled = 0;
+    Stats.NumChanged = 0;
+    Stats.NumOverdue = 0;
+
+    auto IsHot = [CurrentTime, HotDuration](const FReflectedActorProperty& Item)
+    {
+        return CurrentTime - Item.LastChangeTime < HotDuration;
+    };
+
+    DueItems.Reset();
+    for (int32 Index = 0; Index < Items.Num(); ++Index)
+    {
+        const FReflectedActorProperty& Item = *Items[Index].Item;
+        const double Age = CurrentTime - Item.LastSampleTime;
+
+        if (Age >= StalenessBound || (IsHot(Item) && Age >= Clients[Items[Index].ClientId].HotInterval))
+        {
+            Stats.NumOverdue += Age > StalenessBound ? 1 : 0;
+            DueItems.Add(Index);
+        }
+    }
+
+    // overdue rows first, then hot rows, then whichever was sampled longest ago
+    DueItems.Sort([this, CurrentTime, StalenessBound, &IsHot](int32 A, int32 B)
+    {
+        const FReflectedActorProperty& ItemA = *Items[A].Item;
+        const FReflectedActorProperty& ItemB = *Items[B].Item;
+
+        const bool bOverdueA = CurrentTime - ItemA.LastSampleTime > StalenessBound;
+        const bool bOverdueB = CurrentTime - ItemB.LastSampleTime > StalenessBound;
+        if (bOverdueA != bOverdueB)
+        {
+            return bOverdueA;
+        }
+
+        const bool bHotA = IsHot(ItemA);
+        const bool bHotB = IsHot(ItemB);
+        if (bHotA != bHotB)
+        {
+            return bHotA;
+        }
+
+        return ItemA.LastSampleTime < ItemB.LastSampleTime;
+    });
+
+    for (int32 DueIndex = 0; DueIndex < DueItems.Num(); ++DueIndex)
+    {
+        // always sample at least one item so a tiny budget still makes progress
+        if (DueIndex > 0 && FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0 >= BudgetMicroseconds)
+        {
+            break;
+        }
+
+        const FScheduledItem& Scheduled = Items[DueItems[DueIndex]];
+        const FReflectedActorPropertyPtr Item = Scheduled.Item;
+        Item->LastSampleTime = CurrentTime;
+
+        if (Clients[Scheduled.ClientId].SampleItem.Execute(Item))
+        {
+            Item->LastChangeTime = CurrentTime;
+            ++Stats.NumChanged;
+        }
+
+        ++Stats.NumSampled;
+    }
+
+    Stats.NumDeferred = DueItems.Num() - Stats.NumSampled;
+    Stats.LastTickMicroseconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0;
+    Stats.AverageTickMicroseconds = FMath::Lerp(Stats.AverageTickMicroseconds, Stats.LastTickMicroseconds, 0.05);
+}
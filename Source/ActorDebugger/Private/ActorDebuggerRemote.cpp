@@ -0,0 +1,476 @@
+#include "ActorDebuggerRemote.h"
+#include "ActorDebuggerStats.h"
+#include "ActorDebugger.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "UObject/Package.h"
+#include "UObject/SoftObjectPath.h"
+#include "UObject/UnrealType.h"
+
+namespace ActorDebuggerRemote
+{
+    static constexpr int32 ReceiveChunkSize = 64 * 1024;
+}
+
+using namespace ActorDebuggerServer;
+
+FActorDebuggerRemote& FActorDebuggerRemote::Get()
+{
+    static FActorDebuggerRemote Instance;
+    return Instance;
+}
+
+FActorDebuggerRemote::~FActorDebuggerRemote()
+{
+    Disconnect();
+}
+
+/*
+* Connecting blocks, which is fine on the loopback address: it either succeeds or is refused straight away
+*/
+bool FActorDebuggerRemote::Connect(int32 Port)
+{
+    check(IsInGameThread());
+
+    Disconnect();
+
+    Socket = FTcpSocketBuilder(TEXT("ActorDebuggerRemote")).AsBlocking().Build();
+    const TSharedRef<FInternetAddr> Address = FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port).ToInternetAddr();
+
+    if (Socket == nullptr || Socket->Connect(*Address) == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: no debug server is listening on port %d"), Port);
+        Disconnect();
+        return false;
+    }
+
+    Socket->SetNonBlocking(true);
+    Socket->SetNoDelay(true);
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FActorDebuggerRemote::HandleTicker));
+
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: connected to the debug server on port %d"), Port);
+    return true;
+}
+
+void FActorDebuggerRemote::Disconnect()
+{
+    if (Socket)
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    Received.Reset();
+    Outgoing.Reset();
+    Schemas.Reset();
+    Objects.Reset();
+    ObjectsByPath.Reset();
+    LastFrame = 0;
+}
+
+int32 FActorDebuggerRemote::Subscribe(const FString& Selector)
+{
+    if (IsConnected() == false)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 Request = NextRequest++;
+    SendMessage(EMessage::Subscribe, [Request, Selector = FString(Selector)](FArchive& Ar) mutable
+    {
+        Ar << Request << Selector;
+    });
+    return Request;
+}
+
+void FActorDebuggerRemote::Unsubscribe(int32 Request)
+{
+    if (IsConnected())
+    {
+        SendMessage(EMessage::Unsubscribe, [Request](FArchive& Ar) mutable
+        {
+            Ar << Request;
+        });
+    }
+}
+
+void FActorDebuggerRemote::SetUpdateRate(float UpdatesPerSecond)
+{
+    if (IsConnected())
+    {
+        SendMessage(EMessage::SetUpdateRate, [UpdatesPerSecond](FArchive& Ar) mutable
+        {
+            Ar << UpdatesPerSecond;
+        });
+    }
+}
+
+bool FActorDebuggerRemote::HandleTicker(float DeltaTime)
+{
+    Tick();
+    return true;
+}
+
+/*
+* A server that went away or sent something unreadable ends the connection, the replay objects go with it
+*/
+void FActorDebuggerRemote::Tick()
+{
+    check(IsInGameThread());
+
+    if (Socket == nullptr)
+    {
+        return;
+    }
+
+    bool bConnected = true;
+
+    int32 Offset = 0;
+    while (bConnected && Offset < Outgoing.Num())
+    {
+        int32 BytesSent = 0;
+        if (Socket->Send(Outgoing.GetData() + Offset, Outgoing.Num() - Offset, BytesSent) == false)
+        {
+            bConnected = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() == SE_EWOULDBLOCK;
+            break;
+        }
+        if (BytesSent <= 0)
+        {
+            break;
+        }
+        Offset += BytesSent;
+    }
+    Outgoing.RemoveAt(0, Offset, EAllowShrinking::No);
+
+    while (bConnected)
+    {
+        const int32 Start = Received.Num();
+        Received.AddUninitialized(ActorDebuggerRemote::ReceiveChunkSize);
+
+        int32 BytesRead = 0;
+        bConnected = Socket->Recv(Received.GetData() + Start, ActorDebuggerRemote::ReceiveChunkSize, BytesRead);
+        Received.SetNum(Start + BytesRead, EAllowShrinking::No);
+
+        if (BytesRead == 0)
+        {
+            break;
+        }
+    }
+
+    Offset = 0;
+    EMessage Type;
+    FMemoryView Payload;
+    bool bError = false;
+
+    while (bError == false && ActorDebuggerServer::ReadMessage(MakeMemoryView(Received), Offset, Type, Payload, bError))
+    {
+        bError = ReadMessage(Type, Payload) == false;
+    }
+    Received.RemoveAt(0, Offset, EAllowShrinking::No);
+
+    if (bConnected == false || bError)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: lost the connection to the debug server"));
+        Disconnect();
+    }
+}
+
+UObject* FActorDebuggerRemote::GetReplayObject(int32 ObjectId) const
+{
+    const FObject* Object = Objects.Find(ObjectId);
+    return Object ? Object->ReplayObject.Get() : nullptr;
+}
+
+void FActorDebuggerRemote::SendMessage(EMessage Type, TFunctionRef<void(FArchive&)> WritePayload)
+{
+    const int32 Start = BeginMessage(Outgoing, Type);
+    FMemoryWriter Ar(Outgoing, false, true);
+    WritePayload(Ar);
+    EndMessage(Outgoing, Start);
+}
+
+bool FActorDebuggerRemote::ReadMessage(EMessage Type, FMemoryView Payload)
+{
+    switch (Type)
+    {
+    case EMessage::Hello:
+    {
+        FMemoryReaderView Ar(Payload);
+        uint32 ServerVersion = 0;
+        Ar << ServerVersion;
+
+        if (ServerVersion != Version)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: the debug server speaks version %u, this viewer version %u"), ServerVersion, Version);
+            return false;
+        }
+        return true;
+    }
+
+    case EMessage::Schema:
+        return ReadSchema(Payload);
+
+    case EMessage::Object:
+        return ReadObject(Payload);
+
+    case EMessage::Subscribed:
+        return ReadSubscribed(Payload);
+
+    case EMessage::Update:
+        return ReadUpdate(Payload);
+
+    case EMessage::Removed:
+        return ReadRemoved(Payload);
+
+    default:
+        // newer servers may send more, what isn't understood is skipped
+        return true;
+    }
+}
+
+/*
+* Matches the properties against the class loaded by the viewer, as capture replays do
+*/
+bool FActorDebuggerRemote::ReadSchema(FMemoryView Payload)
+{
+    FMemoryReaderView Ar(Payload);
+
+    int32 SchemaId = INDEX_NONE;
+    FString ClassPath;
+    int32 NumProperties = 0;
+    Ar << SchemaId << ClassPath << NumProperties;
+
+    if (Ar.IsError() || NumProperties < 0 || NumProperties > Payload.GetSize())
+    {
+        return false;
+    }
+
+    FSchema& Schema = Schemas.FindOrAdd(SchemaId);
+    Schema.ClassPath = MoveTemp(ClassPath);
+    Schema.LiveClass = FSoftClassPath(Schema.ClassPath).TryLoadClass<UObject>();
+    Schema.Properties.SetNum(NumProperties);
+
+    for (FSchemaProperty& Property : Schema.Properties)
+    {
+        FString Name;
+        FString CPPType;
+        uint8 Encoding = 0;
+        int32 ElementSize = 0;
+        int32 ArrayDim = 1;
+        Ar << Name << CPPType << Encoding << ElementSize << ArrayDim;
+
+        Property.Encoding = static_cast<EActorDebuggerCaptureEncoding>(Encoding);
+        Property.LiveProperty = FActorDebuggerCaptureReader::FindLiveProperty(Schema.LiveClass, Name, CPPType, Property.Encoding, ElementSize, ArrayDim);
+    }
+
+    return Ar.IsError() == false;
+}
+
+/*
+* An object described again has a new schema. Its replay object is kept unless the class changed
+*/
+bool FActorDebuggerRemote::ReadObject(FMemoryView Payload)
+{
+    FMemoryReaderView Ar(Payload);
+
+    int32 ObjectId = INDEX_NONE;
+    int32 SchemaId = INDEX_NONE;
+    FString Name;
+    FString PathName;
+    Ar << ObjectId << SchemaId << Name << PathName;
+
+    const FSchema* Schema = Schemas.Find(SchemaId);
+    if (Ar.IsError() || Schema == nullptr)
+    {
+        return false;
+    }
+
+    FObject& Object = Objects.FindOrAdd(ObjectId);
+    if (Object.ReplayObject.IsValid() && Object.ReplayObject->GetClass() != Schema->LiveClass)
+    {
+        Object.ReplayObject.Reset();
+    }
+
+    Object.SchemaId = SchemaId;
+    Object.Name = MoveTemp(Name);
+    Object.PathName = MoveTemp(PathName);
+    ObjectsByPath.Add(Object.PathName, ObjectId);
+    return true;
+}
+
+bool FActorDebuggerRemote::ReadSubscribed(FMemoryView Payload)
+{
+    FMemoryReaderView Ar(Payload);
+
+    int32 Request = INDEX_NONE;
+    int32 NumObjects = 0;
+    Ar << Request << NumObjects;
+
+    if (Ar.IsError() || NumObjects < 0 || NumObjects > Payload.GetSize() / sizeof(int32))
+    {
+        return false;
+    }
+
+    UObject* SelectedObject = nullptr;
+    for (int32 Index = 0; Index < NumObjects; ++Index)
+    {
+        int32 ObjectId = INDEX_NONE;
+        Ar << ObjectId;
+
+        UObject* ReplayObject = FindOrCreateReplayObject(ObjectId);
+        if (Index == 0)
+        {
+            SelectedObject = ReplayObject;
+        }
+    }
+
+    if (Ar.IsError())
+    {
+        return false;
+    }
+
+    OnSubscribed.Broadcast(Request, SelectedObject);
+    return true;
+}
+
+/*
+* Values of objects or properties this viewer can't replay are skipped, their bytes are never looked at
+*/
+bool FActorDebuggerRemote::ReadUpdate(FMemoryView Payload)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_ReplayFrame);
+
+    FMemoryReaderView Ar(Payload);
+
+    uint64 Frame = 0;
+    int32 NumValues = 0;
+    Ar << Frame << NumValues;
+
+    if (Ar.IsError() || NumValues < 0)
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < NumValues; ++Index)
+    {
+        int32 ObjectId = INDEX_NONE;
+        int32 PropertyIndex = 0;
+        int32 Size = 0;
+        Ar << ObjectId << PropertyIndex << Size;
+
+        if (Ar.IsError() || Size < 0 || Ar.Tell() + Size > static_cast<int64>(Payload.GetSize()))
+        {
+            return false;
+        }
+
+        const FMemoryView Bytes = Payload.Mid(Ar.Tell(), Size);
+        Ar.Seek(Ar.Tell() + Size);
+
+        const FObject* Object = Objects.Find(ObjectId);
+        const FSchema* Schema = Object ? Schemas.Find(Object->SchemaId) : nullptr;
+        if (Object == nullptr || Object->ReplayObject.IsValid() == false || Schema == nullptr || Schema->Properties.IsValidIndex(PropertyIndex) == false)
+        {
+            continue;
+        }
+
+        const FSchemaProperty& Property = Schema->Properties[PropertyIndex];
+        if (Property.LiveProperty)
+        {
+            FActorDebuggerCaptureReader::ApplyValue(Property.LiveProperty, Property.Encoding, Object->ReplayObject.Get(), Bytes, [this](FArchive& RefAr)
+            {
+                return DecodeObjectRef(RefAr);
+            });
+        }
+    }
+
+    LastFrame = Frame;
+    return true;
+}
+
+bool FActorDebuggerRemote::ReadRemoved(FMemoryView Payload)
+{
+    FMemoryReaderView Ar(Payload);
+
+    int32 NumObjects = 0;
+    Ar << NumObjects;
+
+    if (Ar.IsError() || NumObjects < 0 || NumObjects > Payload.GetSize() / sizeof(int32))
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < NumObjects; ++Index)
+    {
+        int32 ObjectId = INDEX_NONE;
+        Ar << ObjectId;
+
+        FObject Object;
+        if (Objects.RemoveAndCopyValue(ObjectId, Object))
+        {
+            ObjectsByPath.Remove(Object.PathName);
+        }
+    }
+
+    return Ar.IsError() == false;
+}
+
+UObject* FActorDebuggerRemote::FindOrCreateReplayObject(int32 ObjectId)
+{
+    FObject* Object = Objects.Find(ObjectId);
+    if (Object == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (Object->ReplayObject.IsValid())
+    {
+        return Object->ReplayObject.Get();
+    }
+
+    const FSchema& Schema = Schemas.FindChecked(Object->SchemaId);
+    if (Schema.LiveClass == nullptr || Schema.LiveClass->HasAnyClassFlags(CLASS_Abstract))
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: can't show %s, its class %s is not loaded"), *Object->PathName, *Schema.ClassPath);
+        return nullptr;
+    }
+
+    const FName ReplayName = MakeUniqueObjectName(GetTransientPackage(), Schema.LiveClass, FName(*(Object->Name + TEXT("_Remote"))));
+    Object->ReplayObject.Reset(NewObject<UObject>(GetTransientPackage(), Schema.LiveClass, ReplayName, RF_Transient));
+    return Object->ReplayObject.Get();
+}
+
+UObject* FActorDebuggerRemote::DecodeObjectRef(FArchive& Ar)
+{
+    int32 ObjectId = INDEX_NONE;
+    Ar << ObjectId;
+
+    if (ObjectId != INDEX_NONE)
+    {
+        return FindOrCreateReplayObject(ObjectId);
+    }
+
+    FString PathName;
+    Ar << PathName;
+
+    if (PathName.IsEmpty() || Ar.IsError())
+    {
+        return nullptr;
+    }
+
+    if (const int32* ServedId = ObjectsByPath.Find(PathName))
+    {
+        return FindOrCreateReplayObject(*ServedId);
+    }
+    return StaticFindObject(UObject::StaticClass(), nullptr, *PathName);
+}
@@ -0,0 +1,216 @@
+#include "ActorDebuggerSchemaCache.h"
+#include "UObject/UnrealType.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/TextProperty.h"
+#include "UObject/EnumProperty.h"
+#include "Misc/CoreDelegates.h"
+
+/*
+* Returns the single cache shared by every debugger widget
+*/
+FActorDebuggerSchemaCache& FActorDebuggerSchemaCache::Get()
+{
+    static FActorDebuggerSchemaCache Instance;
+    return Instance;
+}
+
+/*
+* Looks up the schema for the given class, compiling it if it has not been seen before.
+* The weak pointer check protects against a new class being allocated at the address of a collected one
+*/
+FActorDebuggerClassSchemaPtr FActorDebuggerSchemaCache::FindOrBuild(const UStruct* Struct)
+{
+    check(IsInGameThread());
+
+    if (Struct == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (const FActorDebuggerClassSchemaPtr* Existing = Schemas.Find(Struct))
+    {
+        if ((*Existing)->Struct.Get() == Struct)
+        {
+            return *Existing;
+        }
+    }
+
+    FActorDebuggerClassSchemaPtr Schema = BuildSchema(Struct);
+    Schemas.Add(Struct, Schema);
+    return Schema;
+}
+
+/*
+* Compiles the flat list of properties that the debugger displays for a class or struct.
+* This is the only place that walks the class with a TFieldIterator
+*/
+FActorDebuggerClassSchemaPtr FActorDebuggerSchemaCache::BuildSchema(const UStruct* Struct) const
+{
+    TSharedRef<FActorDebuggerClassSchema, ESPMode::ThreadSafe> Schema = MakeShared<FActorDebuggerClassSchema, ESPMode::ThreadSafe>();
+    Schema->Struct = Struct;
+
+    // Blueprint visible properties are likely to be the most useful ones to display on a class. Members of
+    // native structs are often plain UPROPERTY()s, so every member of a struct is displayed
+    const bool bBlueprintVisibleOnly = Struct->IsA<UClass>();
+
+    for (TFieldIterator<FProperty> PropIt(Struct); PropIt; ++PropIt)
+    {
+        FProperty* Property = *PropIt;
+
+        if (Property == nullptr || (bBlueprintVisibleOnly && Property->HasAnyPropertyFlags(CPF_BlueprintVisible) == false))
+        {
+            continue;
+        }
+
+        FActorDebuggerPropertySchemaEntry& Entry = Schema->Entries.AddDefaulted_GetRef();
+        Entry.Property = Property;
+        Entry.Name = Property->GetFName();
+        Entry.Offset = Property->GetOffset_ForInternal();
+        Entry.ElementSize = Property->ElementSize;
+        Entry.ArrayDim = Property->ArrayDim;
+        Entry.TypeTag = GetPropertyType(Property);
+        Entry.ContainerKind = GetContainerKind(Property);
+        Entry.Formatter = FActorDebuggerFormatters::Select(GetElementProperty(Property));
+    }
+
+    return Schema;
+}
+
+/*
+* Maps a property to the type tag of its value. Containers are tagged with the type of their elements
+* (the value type for maps) so callers can pick a formatter without casting again
+*/
+EActorDebuggerPropertyType FActorDebuggerSchemaCache::GetPropertyType(const FProperty* Property)
+{
+    if (Property == nullptr)
+    {
+        return EActorDebuggerPropertyType::Unknown;
+    }
+
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+    {
+        return GetPropertyType(ArrayProperty->Inner);
+    }
+    if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+    {
+        return GetPropertyType(SetProperty->ElementProp);
+    }
+    if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+    {
+        return GetPropertyType(MapProperty->ValueProp);
+    }
+
+    if (Property->IsA<FBoolProperty>())             return EActorDebuggerPropertyType::Bool;
+    if (Property->IsA<FInt8Property>())             return EActorDebuggerPropertyType::Int8;
+    if (Property->IsA<FInt16Property>())            return EActorDebuggerPropertyType::Int16;
+    if (Property->IsA<FIntProperty>())              return EActorDebuggerPropertyType::Int32;
+    if (Property->IsA<FInt64Property>())            return EActorDebuggerPropertyType::Int64;
+    if (Property->IsA<FUInt16Property>())           return EActorDebuggerPropertyType::UInt16;
+    if (Property->IsA<FUInt32Property>())           return EActorDebuggerPropertyType::UInt32;
+    if (Property->IsA<FUInt64Property>())           return EActorDebuggerPropertyType::UInt64;
+    if (Property->IsA<FFloatProperty>())            return EActorDebuggerPropertyType::Float;
+    if (Property->IsA<FDoubleProperty>())           return EActorDebuggerPropertyType::Double;
+    if (Property->IsA<FEnumProperty>())             return EActorDebuggerPropertyType::Enum;
+    if (Property->IsA<FNameProperty>())             return EActorDebuggerPropertyType::Name;
+    if (Property->IsA<FStrProperty>())              return EActorDebuggerPropertyType::String;
+    if (Property->IsA<FTextProperty>())             return EActorDebuggerPropertyType::Text;
+    if (Property->IsA<FWeakObjectProperty>())       return EActorDebuggerPropertyType::WeakObject;
+    if (Property->IsA<FSoftObjectProperty>())       return EActorDebuggerPropertyType::SoftObject;
+    if (Property->IsA<FLazyObjectProperty>())       return EActorDebuggerPropertyType::SoftObject;
+    if (Property->IsA<FObjectPropertyBase>())       return EActorDebuggerPropertyType::Object;
+    if (Property->IsA<FInterfaceProperty>())        return EActorDebuggerPropertyType::Interface;
+    if (Property->IsA<FStructProperty>())           return EActorDebuggerPropertyType::Struct;
+    if (Property->IsA<FDelegateProperty>())         return EActorDebuggerPropertyType::Delegate;
+    if (Property->IsA<FMulticastDelegateProperty>()) return EActorDebuggerPropertyType::Delegate;
+
+    if (const FByteProperty* ByteProperty = CastField<FByteProperty>(Property))
+    {
+        return ByteProperty->Enum ? EActorDebuggerPropertyType::Enum : EActorDebuggerPropertyType::Byte;
+    }
+
+    return EActorDebuggerPropertyType::Unknown;
+}
+
+/*
+* Describes how the value of a property is laid out in memory
+*/
+EActorDebuggerContainerKind FActorDebuggerSchemaCache::GetContainerKind(const FProperty* Property)
+{
+    if (Property == nullptr)
+    {
+        return EActorDebuggerContainerKind::None;
+    }
+
+    if (Property->IsA<FArrayProperty>())
+    {
+        return EActorDebuggerContainerKind::Array;
+    }
+    if (Property->IsA<FMapProperty>())
+    {
+        return EActorDebuggerContainerKind::Map;
+    }
+    if (Property->IsA<FSetProperty>())
+    {
+        return EActorDebuggerContainerKind::Set;
+    }
+
+    return Property->ArrayDim > 1 ? EActorDebuggerContainerKind::StaticArray : EActorDebuggerContainerKind::None;
+}
+
+/*
+* The elements of a container are displayed by their own nodes, these are the properties those nodes format
+*/
+const FProperty* FActorDebuggerSchemaCache::GetElementProperty(const FProperty* Property)
+{
+    if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+    {
+        return ArrayProperty->Inner;
+    }
+    if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+    {
+        return SetProperty->ElementProp;
+    }
+    if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+    {
+        return MapProperty->ValueProp;
+    }
+
+    return Property;
+}
+
+/*
+* Throws away every cached schema. Widgets are told to rebuild since the FProperty pointers they hold
+* may belong to a class layout that no longer exists
+*/
+void FActorDebuggerSchemaCache::InvalidateAll()
+{
+    Schemas.Reset();
+    OnSchemasInvalidated.Broadcast();
+}
+
+/*
+* Hot reload and Blueprint recompilation both regenerate the property chain of a class, so we listen for
+* both and drop the cache when either happens
+*/
+void FActorDebuggerSchemaCache::RegisterDelegates()
+{
+    ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FActorDebuggerSchemaCache::HandleReloadComplete);
+    ObjectsReinstancedHandle = FCoreUObjectDelegates::OnObjectsReinstanced.AddRaw(this, &FActorDebuggerSchemaCache::HandleObjectsReinstanced);
+}
+
+void FActorDebuggerSchemaCache::UnregisterDelegates()
+{
+    FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+    FCoreUObjectDelegates::OnObjectsReinstanced.Remove(ObjectsReinstancedHandle);
+    Schemas.Reset();
+}
+
+void FActorDebuggerSchemaCache::HandleReloadComplete(EReloadCompleteReason Reason)
+{
+    InvalidateAll();
+}
+
+void FActorDebuggerSchemaCache::HandleObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap)
+{
+    InvalidateAll();
+}
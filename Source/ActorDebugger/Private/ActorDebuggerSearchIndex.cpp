@@ -0,0 +1,275 @@
+#include "ActorDebuggerSearchIndex.h"
+#include "ActorPropertyWidget.h"
+#include "ActorDebuggerStats.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarActorDebuggerSearchBudgetMs(
+    TEXT("ActorDebugger.SearchBudgetMs"),
+    2.0f,
+    TEXT("How many milliseconds per frame the Actor Debugger search index may spend gathering the tree and refreshing values"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerSearchMaxResults(
+    TEXT("ActorDebugger.SearchMaxResults"),
+    2000,
+    TEXT("The most matches an Actor Debugger search returns, matches beyond this are not shown"));
+
+void FActorDebuggerSearchIndex::Reset()
+{
+    Entries.Reset();
+    Trigrams.Reset();
+    NumPostings = 0;
+    NumStalePostings = 0;
+    Generation = 0;
+    CrawlCursor = 0;
+    ValueCursor = 0;
+}
+
+/*
+* New nodes are indexed first so that what was gathered last frame can be found this frame. The crawl gathers
+* children in arena order, and since children are allocated after their parents the cursor reaches every node
+* eventually without keeping a queue of its own
+*/
+bool FActorDebuggerSearchIndex::Tick(FActorDebuggerInspection& Inspection)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_SearchIndex);
+
+    if (Generation != Inspection.GetGeneration())
+    {
+        Reset();
+        Generation = Inspection.GetGeneration();
+    }
+
+    const double EndTime = FPlatformTime::Seconds() + FMath::Max(CVarActorDebuggerSearchBudgetMs.GetValueOnGameThread(), 0.0f) / 1000.0;
+    const FActorDebuggerNodeArena& Arena = Inspection.GetArena();
+    bool bChanged = false;
+
+    while (Entries.Num() < Arena.Num() && FPlatformTime::Seconds() < EndTime)
+    {
+        const int32 EntryIndex = Entries.Num();
+
+        FEntry& Entry = Entries.AddDefaulted_GetRef();
+        Entry.Item = Arena.Get(EntryIndex);
+        Entry.Name = Entry.Item->GetDisplayName().ToString().ToLower();
+        AddTrigrams(EntryIndex, Entry.Name);
+        bChanged = true;
+    }
+
+    TArray<FReflectedActorPropertyPtr> Children;
+    while (CrawlCursor < Arena.Num() && Inspection.IsNodeBudgetExhausted() == false && FPlatformTime::Seconds() < EndTime)
+    {
+        FReflectedActorPropertyPtr Item = Arena.Get(CrawlCursor++);
+
+        if (Item->bMayHaveChildren && Item->bChildrenResolved == false && Item->IsDetached() == false)
+        {
+            Inspection.GetChildren(Item, Children);
+        }
+    }
+
+    // values are checked round robin, a value is only formatted again if its bytes changed
+    for (int32 NumChecked = 0; NumChecked < Entries.Num() && FPlatformTime::Seconds() < EndTime; ++NumChecked)
+    {
+        if (ValueCursor >= Entries.Num())
+        {
+            ValueCursor = 0;
+        }
+
+        const int32 EntryIndex = ValueCursor++;
+        FReflectedActorPropertyPtr Item = Entries[EntryIndex].Item;
+
+        if (Item->Kind == EReflectedPropertyKind::Page || Item->IsValid() == false || Item->IsDetached())
+        {
+            continue;
+        }
+
+        const uint64 ValueHash = Item->HashValue();
+        if (Entries[EntryIndex].bHasValue && Entries[EntryIndex].ValueHash == ValueHash)
+        {
+            continue;
+        }
+
+        SetEntryValue(EntryIndex, SActorPropertyWidget::PropertyValueToText(Item).ToString(), ValueHash);
+        bChanged = true;
+    }
+
+    return bChanged;
+}
+
+bool FActorDebuggerSearchIndex::IsComplete(const FActorDebuggerInspection& Inspection) const
+{
+    const int32 NumNodes = Inspection.GetArena().Num();
+    return Entries.Num() == NumNodes && (CrawlCursor >= NumNodes || Inspection.IsNodeBudgetExhausted());
+}
+
+void FActorDebuggerSearchIndex::SetValue(FReflectedActorPropertyPtr Item, const FString& ValueText)
+{
+    if (Item->Generation == Generation && Entries.IsValidIndex(Item->NodeIndex))
+    {
+        SetEntryValue(Item->NodeIndex, ValueText, Item->ValueHash);
+    }
+}
+
+/*
+* The entry stays in the lists of its old value's trigrams. Those postings are counted as stale and the lists
+* are rebuilt once they outnumber the live ones
+*/
+void FActorDebuggerSearchIndex::SetEntryValue(int32 EntryIndex, const FString& ValueText, uint64 ValueHash)
+{
+    FEntry& Entry = Entries[EntryIndex];
+    Entry.ValueHash = ValueHash;
+
+    FString Value = ValueText.ToLower();
+    if (Entry.bHasValue && Entry.Value == Value)
+    {
+        return;
+    }
+
+    NumStalePostings += FMath::Max(Entry.Value.Len() - 2, 0);
+    Entry.Value = MoveTemp(Value);
+    Entry.bHasValue = true;
+    AddTrigrams(EntryIndex, Entry.Value);
+
+    if (NumStalePostings > 4096 && NumStalePostings > NumPostings / 2)
+    {
+        Compact();
+    }
+}
+
+void FActorDebuggerSearchIndex::AddTrigrams(int32 EntryIndex, const FString& Text)
+{
+    for (int32 CharIndex = 0; CharIndex + 3 <= Text.Len(); ++CharIndex)
+    {
+        TArray<int32>& Postings = Trigrams.FindOrAdd(MakeTrigram(*Text + CharIndex));
+
+        // repeated trigrams within a text land next to each other
+        if (Postings.Num() == 0 || Postings.Last() != EntryIndex)
+        {
+            Postings.Add(EntryIndex);
+            ++NumPostings;
+        }
+    }
+}
+
+void FActorDebuggerSearchIndex::Compact()
+{
+    Trigrams.Reset();
+    NumPostings = 0;
+    NumStalePostings = 0;
+
+    for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+    {
+        AddTrigrams(EntryIndex, Entries[EntryIndex].Name);
+        AddTrigrams(EntryIndex, Entries[EntryIndex].Value);
+    }
+}
+
+/*
+* Collisions between trigrams only cost a few extra candidates, every candidate is checked against its text
+*/
+uint32 FActorDebuggerSearchIndex::MakeTrigram(const TCHAR* Chars)
+{
+    return (static_cast<uint32>(Chars[0]) << 20) ^ (static_cast<uint32>(Chars[1]) << 10) ^ static_cast<uint32>(Chars[2]);
+}
+
+/*
+* Only the shortest list among the query's trigrams is walked. Lists can hold an entry more than once (its name
+* and value may share a trigram, or a value may have changed) so matches are collected in a bit array, which also
+* puts them back in gathering order
+*/
+void FActorDebuggerSearchIndex::Search(const FString& Query, TArray<FReflectedActorPropertyPtr>& OutMatches) const
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_Search);
+
+    OutMatches.Reset();
+
+    TArray<FString> Terms;
+    Query.TrimStartAndEnd().ToLower().ParseIntoArray(Terms, TEXT("."), true);
+    if (Terms.Num() == 0)
+    {
+        return;
+    }
+
+    const FString Term = Terms.Pop();
+    const TArray<int32>* Candidates = nullptr;
+
+    for (int32 CharIndex = 0; CharIndex + 3 <= Term.Len(); ++CharIndex)
+    {
+        const TArray<int32>* Postings = Trigrams.Find(MakeTrigram(*Term + CharIndex));
+        if (Postings == nullptr)
+        {
+            // nothing contains this trigram so nothing contains the term
+            return;
+        }
+
+        if (Candidates == nullptr || Postings->Num() < Candidates->Num())
+        {
+            Candidates = Postings;
+        }
+    }
+
+    TBitArray<> Matched(false, Entries.Num());
+
+    if (Candidates)
+    {
+        for (const int32 EntryIndex : *Candidates)
+        {
+            if (Matched[EntryIndex] == false && Matches(Entries[EntryIndex], Term, Terms))
+            {
+                Matched[EntryIndex] = true;
+            }
+        }
+    }
+    else
+    {
+        // too short to have a trigram of its own
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+        {
+            Matched[EntryIndex] = Matches(Entries[EntryIndex], Term, Terms);
+        }
+    }
+
+    const int32 MaxResults = FMath::Max(CVarActorDebuggerSearchMaxResults.GetValueOnGameThread(), 1);
+    for (TConstSetBitIterator<> It(Matched); It && OutMatches.Num() < MaxResults; ++It)
+    {
+        OutMatches.Add(Entries[It.GetIndex()].Item);
+    }
+}
+
+/*
+* Ancestor terms are matched from the nearest ancestor outwards, skipping ancestors that don't match, so a path
+* doesn't have to name every level in between
+*/
+bool FActorDebuggerSearchIndex::Matches(const FEntry& Entry, const FString& Term, TConstArrayView<FString> AncestorTerms) const
+{
+    const bool bTermMatches = Entry.Name.Contains(Term, ESearchCase::CaseSensitive)
+        || (Entry.bHasValue && Entry.Value.Contains(Term, ESearchCase::CaseSensitive));
+
+    if (bTermMatches == false || Entry.Item->IsDetached())
+    {
+        return false;
+    }
+
+    int32 TermIndex = AncestorTerms.Num() - 1;
+
+    // parents are always gathered before their children, so every ancestor already has an entry
+    for (FReflectedActorPropertyPtr Ancestor = Entry.Item->Parent; Ancestor && TermIndex >= 0; Ancestor = Ancestor->Parent)
+    {
+        if (Ancestor->Kind != EReflectedPropertyKind::Page && Entries[Ancestor->NodeIndex].Name.Contains(AncestorTerms[TermIndex], ESearchCase::CaseSensitive))
+        {
+            --TermIndex;
+        }
+    }
+
+    return TermIndex < 0;
+}
+
+SIZE_T FActorDebuggerSearchIndex::GetAllocatedSize() const
+{
+    SIZE_T Size = Entries.GetAllocatedSize() + Trigrams.GetAllocatedSize() + NumPostings * sizeof(int32);
+
+    for (const FEntry& Entry : Entries)
+    {
+        Size += Entry.Name.GetAllocatedSize() + Entry.Value.GetAllocatedSize();
+    }
+
+    return Size;
+}
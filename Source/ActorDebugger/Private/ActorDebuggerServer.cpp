@@ -0,0 +1,1192 @@
+#include "ActorDebuggerServer.h"
+#include "ActorDebuggerDump.h"
+#include "ActorDebuggerFormatPipeline.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerValueHash.h"
+#include "ActorDebuggerStats.h"
+#include "ActorDebugger.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/Event.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/UnrealType.h"
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerServerDepth(
+    TEXT("ActorDebugger.ServerDepth"),
+    2,
+    TEXT("How many levels of referenced objects the Actor Debugger server serves along with a subscribed object"));
+
+static TAutoConsoleVariable<float> CVarActorDebuggerServerUpdateRate(
+    TEXT("ActorDebugger.ServerUpdateRate"),
+    30.0f,
+    TEXT("Updates per second the Actor Debugger server sends to a viewer that hasn't asked for another rate, 0 sends one every frame"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerServerBacklogKB(
+    TEXT("ActorDebugger.ServerBacklogKB"),
+    256,
+    TEXT("How many KB sent to a viewer the Actor Debugger server lets wait in its socket before holding the viewer's updates back"));
+
+namespace ActorDebuggerServer
+{
+    /* The network thread checks the sockets at least this often, frames wake it earlier */
+    static constexpr uint32 PollMilliseconds = 5;
+
+    static constexpr int32 ReceiveChunkSize = 4096;
+
+    int32 BeginMessage(TArray<uint8>& Out, EMessage Type)
+    {
+        const int32 Start = Out.AddZeroed(HeaderSize);
+        Out[Start + sizeof(uint32)] = static_cast<uint8>(Type);
+        return Start;
+    }
+
+    void EndMessage(TArray<uint8>& Out, int32 Start)
+    {
+        const uint32 Size = Out.Num() - Start - sizeof(uint32);
+        FMemory::Memcpy(Out.GetData() + Start, &Size, sizeof(Size));
+    }
+
+    bool ReadMessage(FMemoryView Data, int32& InOutOffset, EMessage& OutType, FMemoryView& OutPayload, bool& bOutError)
+    {
+        bOutError = false;
+
+        const uint64 Available = Data.GetSize() - InOutOffset;
+        if (Available < HeaderSize)
+        {
+            return false;
+        }
+
+        const uint8* Header = static_cast<const uint8*>(Data.GetData()) + InOutOffset;
+        uint32 Size = 0;
+        FMemory::Memcpy(&Size, Header, sizeof(Size));
+
+        if (Size == 0 || Size > MaxMessageSize)
+        {
+            bOutError = true;
+            return false;
+        }
+        if (Available < sizeof(uint32) + Size)
+        {
+            return false;
+        }
+
+        OutType = static_cast<EMessage>(Header[sizeof(uint32)]);
+        OutPayload = MakeMemoryView(Header + HeaderSize, Size - 1);
+        InOutOffset += sizeof(uint32) + Size;
+        return true;
+    }
+
+    static uint64 MakeValueKey(int32 ObjectId, int32 PropertyIndex)
+    {
+        return (static_cast<uint64>(static_cast<uint32>(ObjectId)) << 32) | static_cast<uint32>(PropertyIndex);
+    }
+}
+
+using namespace ActorDebuggerServer;
+
+bool FActorDebuggerServer::FBatch::IsEmpty() const
+{
+    return Values.Num() == 0 && Schemas.Num() == 0 && Objects.Num() == 0 && Subscriptions.Num() == 0 && Unsubscribed.Num() == 0 && Removed.Num() == 0;
+}
+
+/*
+* The arrays keep their allocations, the next batch is usually about as large
+*/
+void FActorDebuggerServer::FBatch::Reset()
+{
+    Buffer.Reset();
+    Values.Reset();
+    Schemas.Reset();
+    Objects.Reset();
+    Subscriptions.Reset();
+    Unsubscribed.Reset();
+    Removed.Reset();
+    References.Reset();
+    Skipped.Reset();
+}
+
+FActorDebuggerServer& FActorDebuggerServer::Get()
+{
+    static FActorDebuggerServer Instance;
+    return Instance;
+}
+
+/*
+* Only the staging batch holds references before it is dispatched, the in flight one until it is encoded. The task
+* holds a GC scope guard while it encodes, so this never runs while it reads the references
+*/
+void FActorDebuggerServer::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    Collector.AddReferencedObjects(Staging.References);
+    Collector.AddReferencedObjects(InFlight.References);
+}
+
+/*
+* Port 0 binds any free port, GetPort returns the one that was bound
+*/
+bool FActorDebuggerServer::Open(int32 Port)
+{
+    check(IsInGameThread());
+
+    Close();
+
+    Listener = FTcpSocketBuilder(TEXT("ActorDebuggerServer"))
+        .AsNonBlocking()
+        .AsReusable()
+        .BoundToEndpoint(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port))
+        .Listening(8)
+        .Build();
+
+    if (Listener == nullptr)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: could not listen on port %d"), Port);
+        return false;
+    }
+
+    BoundPort = Listener->GetPortNo();
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    bStopping = false;
+
+    TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FActorDebuggerServer::HandleTicker));
+    SchemasInvalidatedHandle = FActorDebuggerSchemaCache::Get().OnSchemasInvalidated.AddRaw(this, &FActorDebuggerServer::HandleSchemasInvalidated);
+
+    Thread = FRunnableThread::Create(this, TEXT("ActorDebuggerServer"), 0, TPri_BelowNormal);
+
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: serving on 127.0.0.1:%d"), BoundPort);
+    return true;
+}
+
+/*
+* The network thread closes the viewers' sockets on its way out, everything else is dropped here once it has
+*/
+void FActorDebuggerServer::Close()
+{
+    check(IsInGameThread());
+
+    if (Thread == nullptr)
+    {
+        return;
+    }
+
+    Thread->Kill(true);
+    delete Thread;
+    Thread = nullptr;
+
+    ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Listener);
+    Listener = nullptr;
+
+    WaitForTask();
+    Staging.Reset();
+    Commands.Empty();
+    Frames.Empty();
+
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    TickerHandle.Reset();
+    FActorDebuggerSchemaCache::Get().OnSchemasInvalidated.Remove(SchemasInvalidatedHandle);
+    SchemasInvalidatedHandle.Reset();
+
+    Objects.Reset();
+    ObjectIds.Reset();
+    FreeObjectIds.Reset();
+    SchemaIds.Reset();
+    NumSchemas = 0;
+    Subscriptions.Reset();
+    ClientIntervals.Reset();
+    bIntervalsDirty = false;
+
+    Clients.Reset();
+    SchemaDescriptions.Reset();
+    ObjectDescriptions.Reset();
+    ClientSubscriptions.Reset();
+    NumClients = 0;
+    BoundPort = 0;
+
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: stopped serving"));
+}
+
+bool FActorDebuggerServer::HandleTicker(float DeltaTime)
+{
+    Tick();
+    return true;
+}
+
+/*
+* Values are only sampled once the previous batch has been encoded. Changes made meanwhile are found by their hash
+* in the next sample, values the task skipped are copied again by forgetting their hash
+*/
+void FActorDebuggerServer::Tick()
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_Serve);
+    check(IsInGameThread());
+
+    if (bInFlight && Task.IsCompleted())
+    {
+        for (const TPair<int32, int32>& Skipped : InFlight.Skipped)
+        {
+            FServedObject& Served = Objects[Skipped.Key];
+            if (Served.Hashes.IsValidIndex(Skipped.Value))
+            {
+                Served.Hashes[Skipped.Value] = 0;
+            }
+        }
+
+        InFlight.Reset();
+        bInFlight = false;
+    }
+
+    ExecuteCommands();
+
+    if (bInFlight == false)
+    {
+        StageChanges();
+        Dispatch();
+    }
+}
+
+/*
+* Schema ids are never reused, so the objects are described again with the schemas looked up in the next sample. The
+* values the batch in flight skipped don't need sampling again, every object is written whole with its new schema
+*/
+void FActorDebuggerServer::HandleSchemasInvalidated()
+{
+    // the batch being encoded holds the properties of the old schemas, it is finished before they are let go
+    WaitForTask();
+
+    SchemaIds.Reset();
+
+    for (FServedObject& Served : Objects)
+    {
+        Served.Schema.Reset();
+    }
+}
+
+void FActorDebuggerServer::ExecuteCommands()
+{
+    FCommand Command;
+    while (Commands.Dequeue(Command))
+    {
+        switch (Command.Type)
+        {
+        case FCommand::EType::Subscribe:
+            Subscribe(Command.ClientId, Command.Request, Command.Selector);
+            break;
+
+        case FCommand::EType::SetUpdateRate:
+            ClientIntervals.Add(Command.ClientId, Command.UpdateInterval);
+            bIntervalsDirty = true;
+            break;
+
+        case FCommand::EType::Unsubscribe:
+        case FCommand::EType::Disconnected:
+            for (int32 Index = Subscriptions.Num() - 1; Index >= 0; --Index)
+            {
+                FSubscription& Subscription = Subscriptions[Index];
+                if (Subscription.ClientId == Command.ClientId && (Command.Type == FCommand::EType::Disconnected || Subscription.Request == Command.Request))
+                {
+                    Release(Subscription.ObjectIds);
+                    Staging.Unsubscribed.Emplace(Subscription.ClientId, Subscription.Request);
+                    Subscriptions.RemoveAtSwap(Index);
+                }
+            }
+
+            if (Command.Type == FCommand::EType::Disconnected)
+            {
+                ClientIntervals.Remove(Command.ClientId);
+            }
+            bIntervalsDirty = true;
+            break;
+        }
+    }
+}
+
+/*
+* A selector holding a path names one object, anything else selects actors in the game worlds the way dumps do. A
+* subscription that matches nothing is still answered, with no objects
+*/
+void FActorDebuggerServer::Subscribe(uint32 ClientId, int32 Request, const FString& Selector)
+{
+    TArray<UObject*> Roots;
+
+    if (Selector.Contains(TEXT("/")))
+    {
+        if (UObject* Object = StaticFindObject(UObject::StaticClass(), nullptr, *Selector))
+        {
+            Roots.Add(Object);
+        }
+    }
+    else if (GEngine)
+    {
+        for (const FWorldContext& Context : GEngine->GetWorldContexts())
+        {
+            if (Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE)
+            {
+                FActorDebuggerDumps::FindActors(Context.World(), Selector, Roots);
+            }
+        }
+    }
+
+    FSubscription& Subscription = Subscriptions.AddDefaulted_GetRef();
+    Subscription.ClientId = ClientId;
+    Subscription.Request = Request;
+
+    const int32 Depth = FMath::Max(CVarActorDebuggerServerDepth.GetValueOnGameThread(), 0);
+    for (UObject* Root : Roots)
+    {
+        AddObjectGraph(Root, Depth, Subscription.ObjectIds);
+    }
+
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: viewer %u subscribed to %s, %d objects"), ClientId, *Selector, Subscription.ObjectIds.Num());
+    Staging.Subscriptions.Add(Subscription);
+    bIntervalsDirty = true;
+}
+
+/*
+* Objects no subscription includes any more stop being sampled and their ids are retired. The ids are reused once
+* the batch that tells the viewers has been dispatched, so a viewer never sees an id described again before it was
+* removed
+*/
+void FActorDebuggerServer::Release(const TArray<int32>& SubscriptionObjectIds)
+{
+    for (int32 ObjectId : SubscriptionObjectIds)
+    {
+        FServedObject& Served = Objects[ObjectId];
+        if (--Served.NumSubscriptions > 0)
+        {
+            continue;
+        }
+
+        ObjectIds.Remove(Served.Key);
+        Served = FServedObject();
+        Staging.Removed.Add(ObjectId);
+    }
+}
+
+/*
+* Follows the same references as captures. Every object of the subscription is written whole in the next sample,
+* viewers already served the object are sent the same values again, which costs them nothing but bandwidth
+*/
+int32 FActorDebuggerServer::AddObjectGraph(UObject* Object, int32 RemainingDepth, TArray<int32>& OutObjectIds)
+{
+    if (IsValid(Object) == false)
+    {
+        return INDEX_NONE;
+    }
+
+    int32 ObjectId = INDEX_NONE;
+    if (const int32* ExistingId = ObjectIds.Find(Object))
+    {
+        ObjectId = *ExistingId;
+    }
+    else
+    {
+        if (FreeObjectIds.Num() > 0)
+        {
+            ObjectId = FreeObjectIds.Pop(EAllowShrinking::No);
+        }
+        else
+        {
+            ObjectId = Objects.AddDefaulted();
+        }
+
+        FServedObject& Served = Objects[ObjectId];
+        Served.Object = Object;
+        Served.Key = Object;
+        ObjectIds.Add(Object, ObjectId);
+        UpdateSchema(ObjectId);
+    }
+
+    if (OutObjectIds.Contains(ObjectId))
+    {
+        return ObjectId;
+    }
+
+    OutObjectIds.Add(ObjectId);
+    ++Objects[ObjectId].NumSubscriptions;
+    Objects[ObjectId].bWriteAll = true;
+
+    if (RemainingDepth == 0 || Objects[ObjectId].Schema.IsValid() == false)
+    {
+        return ObjectId;
+    }
+
+    // the schema is held, adding to Objects may move the entry
+    const FActorDebuggerClassSchemaPtr Schema = Objects[ObjectId].Schema;
+    TArray<UObject*, TInlineAllocator<16>> References;
+
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+    {
+        const uint8* ValuePtr = Entry.GetValuePtr(Object);
+        const EActorDebuggerCaptureEncoding Encoding = FActorDebuggerCaptureWriter::ChooseEncoding(Entry.Property);
+
+        if (Encoding == EActorDebuggerCaptureEncoding::ObjectRef)
+        {
+            References.Add(CastFieldChecked<FObjectPropertyBase>(Entry.Property)->GetObjectPropertyValue(ValuePtr));
+        }
+        else if (Encoding == EActorDebuggerCaptureEncoding::ObjectRefArray)
+        {
+            const FArrayProperty* ArrayProperty = CastFieldChecked<FArrayProperty>(Entry.Property);
+            const FObjectPropertyBase* Inner = CastFieldChecked<FObjectPropertyBase>(ArrayProperty->Inner);
+            FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+
+            for (int32 Index = 0; Index < Helper.Num(); ++Index)
+            {
+                References.Add(Inner->GetObjectPropertyValue(Helper.GetRawPtr(Index)));
+            }
+        }
+    }
+
+    for (UObject* Reference : References)
+    {
+        if (IsValid(Reference) && FActorDebuggerInspection::IsUObjectOfInterest(Reference))
+        {
+            AddObjectGraph(Reference, RemainingDepth - 1, OutObjectIds);
+        }
+    }
+
+    return ObjectId;
+}
+
+/*
+* Looks the object's schema up and stages its description, along with the schema if its class has no id yet
+*/
+bool FActorDebuggerServer::UpdateSchema(int32 ObjectId)
+{
+    FServedObject& Served = Objects[ObjectId];
+    UObject* Object = Served.Object.Get();
+
+    Served.Schema = Object ? FActorDebuggerSchemaCache::Get().FindOrBuild(Object->GetClass()) : nullptr;
+    if (Served.Schema.IsValid() == false)
+    {
+        return false;
+    }
+
+    if (const int32* ExistingId = SchemaIds.Find(Object->GetClass()))
+    {
+        Served.SchemaId = *ExistingId;
+    }
+    else
+    {
+        Served.SchemaId = NumSchemas++;
+        SchemaIds.Add(Object->GetClass(), Served.SchemaId);
+
+        FStagedSchema& Staged = Staging.Schemas.AddDefaulted_GetRef();
+        Staged.SchemaId = Served.SchemaId;
+        Staged.ClassPath = Object->GetClass()->GetPathName();
+        Staged.Schema = Served.Schema;
+    }
+
+    Served.Encodings.Reset(Served.Schema->Entries.Num());
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Served.Schema->Entries)
+    {
+        Served.Encodings.Add(FActorDebuggerCaptureWriter::ChooseEncoding(Entry.Property));
+    }
+    Served.Hashes.SetNumZeroed(Served.Schema->Entries.Num());
+    Served.bWriteAll = true;
+
+    FStagedObject& Staged = Staging.Objects.AddDefaulted_GetRef();
+    Staged.ObjectId = ObjectId;
+    Staged.SchemaId = Served.SchemaId;
+    Staged.Name = Object->GetName();
+    Staged.PathName = Object->GetPathName();
+    return true;
+}
+
+/*
+* An object is sampled as often as the viewer subscribed to it that asks for the most updates, the same however many
+* viewers there are. Only values whose hash changed are copied
+*/
+void FActorDebuggerServer::StageChanges()
+{
+    if (bIntervalsDirty)
+    {
+        UpdateIntervals();
+    }
+
+    const double CurrentTime = FPlatformTime::Seconds();
+    for (const TPair<TObjectKey<UObject>, int32>& Pair : ObjectIds)
+    {
+        const int32 ObjectId = Pair.Value;
+        FServedObject& Served = Objects[ObjectId];
+
+        UObject* Object = Served.Object.Get();
+        if (IsValid(Object) == false)
+        {
+            continue;
+        }
+
+        if (Served.bWriteAll == false && CurrentTime - Served.SampleTime < Served.UpdateInterval)
+        {
+            continue;
+        }
+        Served.SampleTime = CurrentTime;
+
+        if (Served.Schema.IsValid() == false && UpdateSchema(ObjectId) == false)
+        {
+            continue;
+        }
+
+        const TArray<FActorDebuggerPropertySchemaEntry>& Entries = Served.Schema->Entries;
+        for (int32 Index = 0; Index < Entries.Num(); ++Index)
+        {
+            if (Served.Encodings[Index] == EActorDebuggerCaptureEncoding::None)
+            {
+                continue;
+            }
+
+            const uint64 Hash = ActorDebugger::HashPropertyValue(Entries[Index].Property, Entries[Index].GetValuePtr(Object));
+            if (Served.bWriteAll == false && Hash == Served.Hashes[Index])
+            {
+                continue;
+            }
+
+            Served.Hashes[Index] = Hash;
+            StageValue(ObjectId, Index, Entries[Index], Object);
+        }
+
+        Served.bWriteAll = false;
+    }
+}
+
+/*
+* The shortest interval of the viewers subscribed to each object. Viewers the network thread hasn't reported yet are
+* taken to want every frame
+*/
+void FActorDebuggerServer::UpdateIntervals()
+{
+    for (const TPair<TObjectKey<UObject>, int32>& Pair : ObjectIds)
+    {
+        Objects[Pair.Value].UpdateInterval = TNumericLimits<double>::Max();
+    }
+
+    for (const FSubscription& Subscription : Subscriptions)
+    {
+        const double* ClientInterval = ClientIntervals.Find(Subscription.ClientId);
+        for (int32 ObjectId : Subscription.ObjectIds)
+        {
+            FServedObject& Served = Objects[ObjectId];
+            Served.UpdateInterval = FMath::Min(Served.UpdateInterval, ClientInterval ? *ClientInterval : 0.0);
+        }
+    }
+
+    bIntervalsDirty = false;
+}
+
+/*
+* Copies the whole value, every element of a static array. Plain old data is a memcpy, anything else is copy
+* constructed like the format pipeline does
+*/
+void FActorDebuggerServer::StageValue(int32 ObjectId, int32 PropertyIndex, const FActorDebuggerPropertySchemaEntry& Entry, UObject* Object)
+{
+    FProperty* Property = Entry.Property;
+    const int32 Alignment = FMath::Max(Property->GetMinAlignment(), 1);
+    const int32 Offset = Align(Staging.Buffer.Num(), Alignment);
+    const int32 Size = Property->GetSize();
+    Staging.Buffer.AddUninitialized(Offset + Size - Staging.Buffer.Num());
+
+    uint8* Dest = Staging.Buffer.GetData() + Offset;
+    if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+    {
+        FMemory::Memcpy(Dest, Entry.GetValuePtr(Object), Size);
+    }
+    else
+    {
+        Property->InitializeValue(Dest);
+        Property->CopyCompleteValue(Dest, Entry.GetValuePtr(Object));
+    }
+
+    FStagedValue& Value = Staging.Values.AddDefaulted_GetRef();
+    Value.ObjectId = ObjectId;
+    Value.PropertyIndex = PropertyIndex;
+    Value.Property = Property;
+    Value.Encoding = Objects[ObjectId].Encodings[PropertyIndex];
+    Value.Owner = Object;
+    Value.Offset = Offset;
+
+    Value.FirstReference = Staging.References.Num();
+    Staging.References.Add(Object);
+    FActorDebuggerFormatPipeline::GatherObjectReferences(Property, Dest, Staging.References);
+    Value.NumReferences = Staging.References.Num() - Value.FirstReference;
+
+    INC_DWORD_STAT_BY(STAT_ActorDebugger_ServedBytes, Size);
+}
+
+/*
+* Swaps the staging batch with the empty in flight one and encodes it on a worker, which hands the encoded frame
+* straight to the network thread
+*/
+void FActorDebuggerServer::Dispatch()
+{
+    if (bInFlight || Staging.IsEmpty())
+    {
+        return;
+    }
+
+    Staging.Frame = ++FrameCounter;
+    Swap(Staging, InFlight);
+    bInFlight = true;
+
+    // frames reach the network thread in order, any later description of these ids comes after their removal
+    FreeObjectIds.Append(InFlight.Removed);
+
+    FBatch* Batch = &InFlight;
+    Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Batch]
+    {
+        // the copies may reference objects and text values are exported with their owner
+        FGCScopeGuard GCGuard;
+        Frames.Enqueue(EncodeBatch(*Batch));
+        WakeEvent->Trigger();
+    });
+}
+
+void FActorDebuggerServer::WaitForTask()
+{
+    if (bInFlight)
+    {
+        Task.Wait();
+        InFlight.Reset();
+        bInFlight = false;
+    }
+}
+
+/*
+* Runs on a worker thread. Object references are written as paths rather than ids since viewers see the objects
+* of their own subscriptions only, they resolve the paths to the replay objects they have. Values that lost a
+* reference to a collection before the task took its GC guard are skipped
+*/
+FActorDebuggerServer::FEncodedFramePtr FActorDebuggerServer::EncodeBatch(FBatch& Batch)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_EncodeUpdates);
+
+    TSharedRef<FEncodedFrame, ESPMode::ThreadSafe> Frame = MakeShared<FEncodedFrame, ESPMode::ThreadSafe>();
+    Frame->Frame = Batch.Frame;
+
+    for (FStagedSchema& Staged : Batch.Schemas)
+    {
+        FDescription& Description = Frame->Schemas.AddDefaulted_GetRef();
+        Description.Id = Staged.SchemaId;
+
+        const int32 Start = BeginMessage(Description.Message, EMessage::Schema);
+        FMemoryWriter Ar(Description.Message, false, true);
+        int32 NumProperties = Staged.Schema->Entries.Num();
+        Ar << Staged.SchemaId << Staged.ClassPath << NumProperties;
+
+        for (const FActorDebuggerPropertySchemaEntry& Entry : Staged.Schema->Entries)
+        {
+            FString Name = Entry.Name.ToString();
+            FString CPPType = Entry.Property->GetCPPType();
+            uint8 Encoding = static_cast<uint8>(FActorDebuggerCaptureWriter::ChooseEncoding(Entry.Property));
+            int32 ElementSize = Entry.ElementSize;
+            int32 ArrayDim = Entry.ArrayDim;
+            Ar << Name << CPPType << Encoding << ElementSize << ArrayDim;
+        }
+        EndMessage(Description.Message, Start);
+    }
+
+    for (FStagedObject& Staged : Batch.Objects)
+    {
+        FDescription& Description = Frame->Objects.AddDefaulted_GetRef();
+        Description.Id = Staged.ObjectId;
+        Description.SchemaId = Staged.SchemaId;
+
+        const int32 Start = BeginMessage(Description.Message, EMessage::Object);
+        FMemoryWriter Ar(Description.Message, false, true);
+        Ar << Staged.ObjectId << Staged.SchemaId << Staged.Name << Staged.PathName;
+        EndMessage(Description.Message, Start);
+    }
+
+    TArray<uint8> ValueBytes;
+    Frame->Values.Reserve(Batch.Values.Num());
+
+    for (const FStagedValue& Staged : Batch.Values)
+    {
+        bool bCollected = false;
+        for (int32 Index = Staged.FirstReference; Index < Staged.FirstReference + Staged.NumReferences; ++Index)
+        {
+            bCollected |= Batch.References[Index] == nullptr;
+        }
+        if (bCollected)
+        {
+            Batch.Skipped.Emplace(Staged.ObjectId, Staged.PropertyIndex);
+            continue;
+        }
+
+        FActorDebuggerCaptureWriter::EncodeValue(Staged.Property, Staged.Encoding, Batch.Buffer.GetData() + Staged.Offset, Staged.Owner, ValueBytes, [](UObject*)
+        {
+            return INDEX_NONE;
+        });
+
+        FEncodedFrame::FValue& Value = Frame->Values.AddDefaulted_GetRef();
+        Value.ObjectId = Staged.ObjectId;
+        Value.PropertyIndex = Staged.PropertyIndex;
+        Value.Offset = Frame->Bytes.Num();
+        Value.Size = ValueBytes.Num();
+        Frame->Bytes.Append(ValueBytes);
+    }
+
+    DestroyValues(Batch);
+
+    Frame->Subscriptions = MoveTemp(Batch.Subscriptions);
+    Frame->Unsubscribed = MoveTemp(Batch.Unsubscribed);
+    Frame->Removed = MoveTemp(Batch.Removed);
+    return Frame;
+}
+
+void FActorDebuggerServer::DestroyValues(FBatch& Batch)
+{
+    for (const FStagedValue& Value : Batch.Values)
+    {
+        if (Value.Property->HasAnyPropertyFlags(CPF_IsPlainOldData | CPF_NoDestructor) == false)
+        {
+            Value.Property->DestroyValue(Batch.Buffer.GetData() + Value.Offset);
+        }
+    }
+    Batch.Values.Reset();
+}
+
+/*
+* The network thread owns the viewers. It never touches UObjects, only encoded frames and sockets
+*/
+uint32 FActorDebuggerServer::Run()
+{
+    while (bStopping == false)
+    {
+        AcceptClients();
+
+        FEncodedFramePtr Frame;
+        while (Frames.Dequeue(Frame))
+        {
+            ApplyFrame(Frame);
+        }
+
+        const double CurrentTime = FPlatformTime::Seconds();
+        for (int32 Index = Clients.Num() - 1; Index >= 0; --Index)
+        {
+            FClient& Client = *Clients[Index];
+            ReceiveCommands(Client);
+            SendUpdate(Client, CurrentTime);
+            SendOutgoing(Client);
+
+            if (Client.bClosed)
+            {
+                CloseClient(Client);
+                Clients.RemoveAtSwap(Index);
+            }
+        }
+
+        WakeEvent->Wait(PollMilliseconds);
+    }
+
+    for (const TUniquePtr<FClient>& Client : Clients)
+    {
+        CloseClient(*Client);
+    }
+    Clients.Reset();
+    return 0;
+}
+
+void FActorDebuggerServer::Stop()
+{
+    bStopping = true;
+    WakeEvent->Trigger();
+}
+
+void FActorDebuggerServer::AcceptClients()
+{
+    bool bPending = false;
+    while (Listener->HasPendingConnection(bPending) && bPending)
+    {
+        FSocket* Socket = Listener->Accept(TEXT("ActorDebuggerViewer"));
+        if (Socket == nullptr)
+        {
+            break;
+        }
+
+        Socket->SetNonBlocking(true);
+        Socket->SetNoDelay(true);
+
+        FClient& Client = *Clients.Add_GetRef(MakeUnique<FClient>());
+        Client.Id = NextClientId++;
+        Client.Socket = Socket;
+
+        const float UpdateRate = CVarActorDebuggerServerUpdateRate.GetValueOnAnyThread();
+        Client.UpdateInterval = UpdateRate > 0.0f ? 1.0 / UpdateRate : 0.0;
+
+        FCommand Command;
+        Command.Type = FCommand::EType::SetUpdateRate;
+        Command.ClientId = Client.Id;
+        Command.UpdateInterval = Client.UpdateInterval;
+        Commands.Enqueue(MoveTemp(Command));
+
+        const int32 Start = BeginMessage(Client.Outgoing, EMessage::Hello);
+        FMemoryWriter Ar(Client.Outgoing, false, true);
+        uint32 ServerVersion = Version;
+        Ar << ServerVersion;
+        EndMessage(Client.Outgoing, Start);
+
+        ++NumClients;
+        UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: viewer %u connected"), Client.Id);
+    }
+}
+
+/*
+* Everything a frame holds is applied to the viewers in the order the game thread staged it. Values are only queued,
+* each viewer is sent the latest ones when its next update is due
+*/
+void FActorDebuggerServer::ApplyFrame(const FEncodedFramePtr& Frame)
+{
+    for (const FDescription& Description : Frame->Schemas)
+    {
+        SchemaDescriptions.Add(Description.Id, Description);
+    }
+
+    for (const FDescription& Description : Frame->Objects)
+    {
+        ObjectDescriptions.Add(Description.Id, Description);
+
+        // described again with another schema, what is queued for the viewers already holding it is stale
+        for (const TUniquePtr<FClient>& Client : Clients)
+        {
+            if (Client->SentObjects.Contains(Description.Id))
+            {
+                Describe(*Client, Description.Id);
+                for (auto It = Client->Pending.CreateIterator(); It; ++It)
+                {
+                    if (static_cast<int32>(It->Key >> 32) == Description.Id)
+                    {
+                        It.RemoveCurrent();
+                    }
+                }
+            }
+        }
+    }
+
+    for (const FSubscription& Subscription : Frame->Subscriptions)
+    {
+        FClient* Client = FindClient(Subscription.ClientId);
+        if (Client == nullptr)
+        {
+            continue;
+        }
+
+        for (int32 ObjectId : Subscription.ObjectIds)
+        {
+            if (Client->SentObjects.Contains(ObjectId) == false)
+            {
+                Describe(*Client, ObjectId);
+            }
+            ++Client->Subscribed.FindOrAdd(ObjectId);
+        }
+        ClientSubscriptions.Add(MakeTuple(Subscription.ClientId, Subscription.Request), Subscription.ObjectIds);
+
+        const int32 Start = BeginMessage(Client->Outgoing, EMessage::Subscribed);
+        FMemoryWriter Ar(Client->Outgoing, false, true);
+        int32 Request = Subscription.Request;
+        int32 NumObjects = Subscription.ObjectIds.Num();
+        Ar << Request << NumObjects;
+        for (int32 ObjectId : Subscription.ObjectIds)
+        {
+            Ar << ObjectId;
+        }
+        EndMessage(Client->Outgoing, Start);
+    }
+
+    for (const TPair<uint32, int32>& Unsubscribed : Frame->Unsubscribed)
+    {
+        TArray<int32> SubscriptionObjectIds;
+        FClient* Client = FindClient(Unsubscribed.Key);
+        if (ClientSubscriptions.RemoveAndCopyValue(Unsubscribed, SubscriptionObjectIds) == false || Client == nullptr)
+        {
+            continue;
+        }
+
+        for (int32 ObjectId : SubscriptionObjectIds)
+        {
+            int32* Count = Client->Subscribed.Find(ObjectId);
+            if (Count && --*Count == 0)
+            {
+                Client->Subscribed.Remove(ObjectId);
+            }
+        }
+    }
+
+    if (Frame->Removed.Num() > 0)
+    {
+        for (const TUniquePtr<FClient>& Client : Clients)
+        {
+            TArray<int32, TInlineAllocator<16>> ClientRemoved;
+            for (int32 ObjectId : Frame->Removed)
+            {
+                if (Client->SentObjects.Remove(ObjectId) > 0)
+                {
+                    ClientRemoved.Add(ObjectId);
+                }
+            }
+
+            // the ids are reused, values still queued for them belong to the removed objects
+            if (ClientRemoved.Num() > 0)
+            {
+                for (auto It = Client->Pending.CreateIterator(); It; ++It)
+                {
+                    if (ClientRemoved.Contains(static_cast<int32>(It->Key >> 32)))
+                    {
+                        It.RemoveCurrent();
+                    }
+                }
+            }
+
+            if (ClientRemoved.Num() > 0)
+            {
+                const int32 Start = BeginMessage(Client->Outgoing, EMessage::Removed);
+                FMemoryWriter Ar(Client->Outgoing, false, true);
+                int32 NumRemoved = ClientRemoved.Num();
+                Ar << NumRemoved;
+                for (int32 ObjectId : ClientRemoved)
+                {
+                    Ar << ObjectId;
+                }
+                EndMessage(Client->Outgoing, Start);
+            }
+        }
+
+        for (int32 ObjectId : Frame->Removed)
+        {
+            ObjectDescriptions.Remove(ObjectId);
+        }
+    }
+
+    for (int32 Index = 0; Index < Frame->Values.Num(); ++Index)
+    {
+        const FEncodedFrame::FValue& Value = Frame->Values[Index];
+        for (const TUniquePtr<FClient>& Client : Clients)
+        {
+            if (Client->Subscribed.Contains(Value.ObjectId))
+            {
+                Client->Pending.Add(MakeValueKey(Value.ObjectId, Value.PropertyIndex), MakeTuple(Frame, Index));
+            }
+        }
+    }
+
+    LastFrame = Frame->Frame;
+}
+
+FActorDebuggerServer::FClient* FActorDebuggerServer::FindClient(uint32 ClientId) const
+{
+    const TUniquePtr<FClient>* Client = Clients.FindByPredicate([ClientId](const TUniquePtr<FClient>& Candidate)
+    {
+        return Candidate->Id == ClientId;
+    });
+    return Client ? Client->Get() : nullptr;
+}
+
+/*
+* Queues the object's description, preceded by its schema's if the viewer doesn't have it yet
+*/
+void FActorDebuggerServer::Describe(FClient& Client, int32 ObjectId)
+{
+    const FDescription* Object = ObjectDescriptions.Find(ObjectId);
+    if (Object == nullptr)
+    {
+        return;
+    }
+
+    if (Client.SentSchemas.Contains(Object->SchemaId) == false)
+    {
+        if (const FDescription* Schema = SchemaDescriptions.Find(Object->SchemaId))
+        {
+            Client.Outgoing.Append(Schema->Message);
+            Client.SentSchemas.Add(Object->SchemaId);
+        }
+    }
+
+    Client.Outgoing.Append(Object->Message);
+    Client.SentObjects.Add(ObjectId);
+}
+
+/*
+* Subscriptions are resolved on the game thread, the update rate is the network thread's own business
+*/
+void FActorDebuggerServer::ReceiveCommands(FClient& Client)
+{
+    for (;;)
+    {
+        const int32 Start = Client.Received.Num();
+        Client.Received.AddUninitialized(ReceiveChunkSize);
+
+        int32 BytesRead = 0;
+        const bool bConnected = Client.Socket->Recv(Client.Received.GetData() + Start, ReceiveChunkSize, BytesRead);
+        Client.Received.SetNum(Start + BytesRead, EAllowShrinking::No);
+
+        if (bConnected == false)
+        {
+            Client.bClosed = true;
+            return;
+        }
+        if (BytesRead == 0)
+        {
+            break;
+        }
+    }
+
+    int32 Offset = 0;
+    EMessage Type;
+    FMemoryView Payload;
+    bool bError = false;
+
+    while (ReadMessage(MakeMemoryView(Client.Received), Offset, Type, Payload, bError))
+    {
+        FMemoryReaderView Ar(Payload);
+        FCommand Command;
+        Command.ClientId = Client.Id;
+
+        switch (Type)
+        {
+        case EMessage::Subscribe:
+            Command.Type = FCommand::EType::Subscribe;
+            Ar << Command.Request << Command.Selector;
+            break;
+
+        case EMessage::Unsubscribe:
+            Command.Type = FCommand::EType::Unsubscribe;
+            Ar << Command.Request;
+            break;
+
+        case EMessage::SetUpdateRate:
+        {
+            float UpdateRate = 0.0f;
+            Ar << UpdateRate;
+            Client.UpdateInterval = UpdateRate > 0.0f ? 1.0 / UpdateRate : 0.0;
+
+            // the game thread samples the viewer's objects as often as it takes updates
+            Command.Type = FCommand::EType::SetUpdateRate;
+            Command.UpdateInterval = Client.UpdateInterval;
+            break;
+        }
+
+        default:
+            continue;
+        }
+
+        if (Ar.IsError() == false)
+        {
+            Commands.Enqueue(MoveTemp(Command));
+        }
+    }
+
+    Client.Received.RemoveAt(0, Offset, EAllowShrinking::No);
+    Client.bClosed |= bError;
+}
+
+/*
+* A viewer gets at most one update per interval, holding the latest value of everything that changed since its
+* previous one. Nothing is added while the viewer hasn't taken what it was already sent
+*/
+void FActorDebuggerServer::SendUpdate(FClient& Client, double CurrentTime)
+{
+    const int32 Backlog = Client.Outgoing.Num() - Client.OutgoingOffset;
+    if (Client.Pending.Num() == 0 || CurrentTime < Client.NextUpdateTime || Backlog >= CVarActorDebuggerServerBacklogKB.GetValueOnAnyThread() * 1024)
+    {
+        return;
+    }
+
+    const int32 Start = BeginMessage(Client.Outgoing, EMessage::Update);
+    FMemoryWriter Ar(Client.Outgoing, false, true);
+    uint64 Frame = LastFrame;
+    int32 NumValues = 0;
+    Ar << Frame;
+    const int64 NumValuesOffset = Ar.Tell();
+    Ar << NumValues;
+
+    for (TPair<uint64, TPair<FEncodedFramePtr, int32>>& Pair : Client.Pending)
+    {
+        const FEncodedFrame::FValue& Value = Pair.Value.Key->Values[Pair.Value.Value];
+
+        // unsubscribed since the value was queued
+        if (Client.Subscribed.Contains(Value.ObjectId) == false)
+        {
+            continue;
+        }
+
+        int32 ObjectId = Value.ObjectId;
+        int32 PropertyIndex = Value.PropertyIndex;
+        int32 Size = Value.Size;
+        Ar << ObjectId << PropertyIndex << Size;
+        Ar.Serialize(const_cast<uint8*>(Pair.Value.Key->Bytes.GetData()) + Value.Offset, Size);
+        ++NumValues;
+    }
+
+    Ar.Seek(NumValuesOffset);
+    Ar << NumValues;
+    EndMessage(Client.Outgoing, Start);
+
+    Client.Pending.Reset();
+    Client.NextUpdateTime = CurrentTime + Client.UpdateInterval;
+}
+
+/*
+* Sends as much as the socket takes without blocking, the rest waits for the next loop
+*/
+void FActorDebuggerServer::SendOutgoing(FClient& Client)
+{
+    while (Client.OutgoingOffset < Client.Outgoing.Num())
+    {
+        int32 BytesSent = 0;
+        if (Client.Socket->Send(Client.Outgoing.GetData() + Client.OutgoingOffset, Client.Outgoing.Num() - Client.OutgoingOffset, BytesSent) == false)
+        {
+            Client.bClosed |= ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() != SE_EWOULDBLOCK;
+            break;
+        }
+        if (BytesSent <= 0)
+        {
+            break;
+        }
+        Client.OutgoingOffset += BytesSent;
+    }
+
+    if (Client.OutgoingOffset == Client.Outgoing.Num())
+    {
+        Client.Outgoing.Reset();
+        Client.OutgoingOffset = 0;
+    }
+    else if (Client.OutgoingOffset > Client.Outgoing.Num() / 2)
+    {
+        Client.Outgoing.RemoveAt(0, Client.OutgoingOffset, EAllowShrinking::No);
+        Client.OutgoingOffset = 0;
+    }
+}
+
+/*
+* The game thread releases the viewer's subscriptions when it hears of the disconnect
+*/
+void FActorDebuggerServer::CloseClient(FClient& Client)
+{
+    Client.Socket->Close();
+    ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Client.Socket);
+    Client.Socket = nullptr;
+
+    for (auto It = ClientSubscriptions.CreateIterator(); It; ++It)
+    {
+        if (It->Key.Key == Client.Id)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    FCommand Command;
+    Command.Type = FCommand::EType::Disconnected;
+    Command.ClientId = Client.Id;
+    Commands.Enqueue(MoveTemp(Command));
+
+    --NumClients;
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: viewer %u disconnected"), Client.Id);
+}
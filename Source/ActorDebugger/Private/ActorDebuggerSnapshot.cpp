@@ -0,0 +1,615 @@
+#include "ActorDebuggerSnapshot.h"
+#include "ActorDebugger.h"
+#include "ActorDebuggerSchemaCache.h"
+#include "ActorDebuggerFormatters.h"
+#include "ActorDebuggerValueHash.h"
+#include "ActorDebuggerStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Hash/CityHash.h"
+#include "UObject/UnrealType.h"
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerSnapshotMaxDepth(
+    TEXT("ActorDebugger.SnapshotMaxDepth"),
+    12,
+    TEXT("How many levels of objects, structs and containers an Actor Debugger snapshot records below its object"));
+
+static TAutoConsoleVariable<int32> CVarActorDebuggerSnapshotMaxNodes(
+    TEXT("ActorDebugger.SnapshotMaxNodes"),
+    1000000,
+    TEXT("The maximum number of nodes a single Actor Debugger snapshot may record"));
+
+namespace ActorDebuggerSnapshot
+{
+    /* Seeds the value hash of references to objects that were already expanded, so they can't equal a raw value */
+    static constexpr uint64 VisitedSeed = 0x9e3779b97f4a7c15ull;
+
+    /* The table keeps expired entries until it has grown this much past its size after the last prune */
+    static constexpr int32 MinPruneGrowth = 1024;
+
+    static uint64 CombineHashes(uint64 A, uint64 B)
+    {
+        return CityHash128to64(Uint128_64(A, B));
+    }
+
+    static void AppendKeyName(FString& OutName, const FProperty* KeyProperty, const uint8* KeyPtr, UObject* Owner)
+    {
+        TStringBuilder<128> KeyString;
+        FActorDebuggerFormatters::Format(KeyProperty, KeyPtr, Owner, KeyString);
+
+        OutName += TEXT('[');
+        OutName.Append(KeyString.GetData(), KeyString.Len());
+        OutName += TEXT(']');
+    }
+
+    static FString MakeIndexName(int32 Index)
+    {
+        return FString::Printf(TEXT("[%d]"), Index);
+    }
+
+    static FString MakeCountValue(int32 Num)
+    {
+        return FString::Printf(TEXT("%d %s"), Num, Num == 1 ? TEXT("element") : TEXT("elements"));
+    }
+
+    static bool HaveSameNames(const TArray<FActorDebuggerSnapshotNodePtr>& A, const TArray<FActorDebuggerSnapshotNodePtr>& B)
+    {
+        if (A.Num() != B.Num())
+        {
+            return false;
+        }
+
+        for (int32 Index = 0; Index < A.Num(); ++Index)
+        {
+            if (A[Index]->Name.Equals(B[Index]->Name, ESearchCase::CaseSensitive) == false)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static void AddEntry(FActorDebuggerSnapshotDiff& OutDiff, const FString& Path, EActorDebuggerDiffKind Kind, const FString& OldValue, const FString& NewValue)
+    {
+        FActorDebuggerDiffEntry& Entry = OutDiff.Entries.AddDefaulted_GetRef();
+        Entry.Path = Path;
+        Entry.Kind = Kind;
+        Entry.OldValue = OldValue;
+        Entry.NewValue = NewValue;
+        OutDiff.Paths.Add(Path, Kind);
+    }
+
+    /*
+    * Returns true if the subtrees differ. A node shared by both snapshots ends the walk, so only the paths down to
+    * what changed are visited. Children are matched by position while both nodes have the same children, which they
+    * do unless a container's elements were added or removed
+    */
+    static bool DiffNodes(const FActorDebuggerSnapshotNode& Old, const FActorDebuggerSnapshotNode& New, FString& Path, FActorDebuggerSnapshotDiff& OutDiff)
+    {
+        ++OutDiff.NumCompared;
+
+        if (&Old == &New)
+        {
+            return false;
+        }
+
+        const bool bValueChanged = Old.ValueHash != New.ValueHash;
+        if (bValueChanged && Path.Len() > 0)
+        {
+            AddEntry(OutDiff, Path, EActorDebuggerDiffKind::Changed, Old.Value, New.Value);
+        }
+
+        const int32 PathLen = Path.Len();
+        auto DiffChild = [&Path, PathLen, &OutDiff](const FActorDebuggerSnapshotNode& OldChild, const FActorDebuggerSnapshotNode& NewChild)
+        {
+            FActorDebuggerSnapshots::AppendPath(Path, NewChild.Name);
+            const bool bChildChanged = DiffNodes(OldChild, NewChild, Path, OutDiff);
+            Path.LeftInline(PathLen, EAllowShrinking::No);
+            return bChildChanged;
+        };
+
+        bool bChildrenChanged = false;
+
+        if (HaveSameNames(Old.Children, New.Children))
+        {
+            for (int32 Index = 0; Index < New.Children.Num(); ++Index)
+            {
+                bChildrenChanged |= DiffChild(*Old.Children[Index], *New.Children[Index]);
+            }
+        }
+        else
+        {
+            TMap<FString, int32> OldIndices;
+            OldIndices.Reserve(Old.Children.Num());
+            for (int32 Index = 0; Index < Old.Children.Num(); ++Index)
+            {
+                OldIndices.Add(Old.Children[Index]->Name, Index);
+            }
+
+            TBitArray<> Matched(false, Old.Children.Num());
+            for (const FActorDebuggerSnapshotNodePtr& NewChild : New.Children)
+            {
+                if (const int32* OldIndex = OldIndices.Find(NewChild->Name))
+                {
+                    Matched[*OldIndex] = true;
+                    bChildrenChanged |= DiffChild(*Old.Children[*OldIndex], *NewChild);
+                    continue;
+                }
+
+                FActorDebuggerSnapshots::AppendPath(Path, NewChild->Name);
+                AddEntry(OutDiff, Path, EActorDebuggerDiffKind::Added, FString(), NewChild->Value);
+                Path.LeftInline(PathLen, EAllowShrinking::No);
+                bChildrenChanged = true;
+            }
+
+            for (int32 Index = 0; Index < Old.Children.Num(); ++Index)
+            {
+                if (Matched[Index] == false)
+                {
+                    FActorDebuggerSnapshots::AppendPath(Path, Old.Children[Index]->Name);
+                    AddEntry(OutDiff, Path, EActorDebuggerDiffKind::Removed, Old.Children[Index]->Value, FString());
+                    Path.LeftInline(PathLen, EAllowShrinking::No);
+                    bChildrenChanged = true;
+                }
+            }
+        }
+
+        if (bChildrenChanged && bValueChanged == false && Path.Len() > 0)
+        {
+            OutDiff.Paths.Add(Path, EActorDebuggerDiffKind::ContainsChanges);
+        }
+
+        return true;
+    }
+}
+
+using namespace ActorDebuggerSnapshot;
+
+/**
+ * Walks an object graph for one snapshot. Every node is built bottom up: its children first, then its hash, and
+ * only if no node with that hash is held already is the node itself allocated and its value formatted
+ */
+class FActorDebuggerSnapshotBuilder
+{
+public:
+    explicit FActorDebuggerSnapshotBuilder(FActorDebuggerSnapshots& InSnapshots)
+        : Snapshots(InSnapshots)
+        , MaxDepth(FMath::Max(CVarActorDebuggerSnapshotMaxDepth.GetValueOnGameThread(), 0))
+        , MaxNodes(FMath::Max(CVarActorDebuggerSnapshotMaxNodes.GetValueOnGameThread(), 1))
+    {
+    }
+
+    FActorDebuggerSnapshotNodePtr BuildRoot(UObject* Object)
+    {
+        Visited.Add(Object, 0);
+        ++NumNodes;
+
+        TArray<FActorDebuggerSnapshotNodePtr> Children;
+        AddMembers(Object->GetClass(), reinterpret_cast<const uint8*>(Object), Object, 0, Children);
+
+        const UClass* Class = Object->GetClass();
+        return MakeNode(FString(), CityHash64(reinterpret_cast<const char*>(&Class), sizeof(Class)), MoveTemp(Children), [Object](FStringBuilderBase& Out)
+        {
+            Out << Object->GetClass()->GetName();
+        });
+    }
+
+    int32 NumNodes {0};
+    bool bTruncated {false};
+
+private:
+    bool HasBudget()
+    {
+        bTruncated |= NumNodes >= MaxNodes;
+        return bTruncated == false;
+    }
+
+    /*
+    * The members of an object or struct, in the order of its schema. Class schemas only hold the Blueprint visible
+    * properties, the same ones the tree shows
+    */
+    void AddMembers(const UStruct* Struct, const uint8* Container, UObject* Owner, int32 Depth, TArray<FActorDebuggerSnapshotNodePtr>& OutChildren)
+    {
+        FActorDebuggerClassSchemaPtr& Schema = Schemas.FindOrAdd(Struct);
+        if (Schema.IsValid() == false)
+        {
+            Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(Struct);
+        }
+
+        OutChildren.Reserve(Schema->Entries.Num());
+        for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+        {
+            if (HasBudget() == false)
+            {
+                return;
+            }
+
+            OutChildren.Add(BuildProperty(Entry.Name.ToString(), Entry.Property, Entry.GetValuePtr(Container), Owner, Depth, Entry.Formatter));
+        }
+    }
+
+    /*
+    * A whole property: static arrays and script containers become a node per element below a node showing the
+    * element count, anything else is a single value. Formatter formats the elements
+    */
+    FActorDebuggerSnapshotNodePtr BuildProperty(FString&& Name, const FProperty* Property, const uint8* ValuePtr, UObject* Owner, int32 Depth, FActorDebuggerFormatFunction Formatter)
+    {
+        const EActorDebuggerContainerKind ContainerKind = FActorDebuggerSchemaCache::GetContainerKind(Property);
+        if (ContainerKind == EActorDebuggerContainerKind::None)
+        {
+            return BuildValue(MoveTemp(Name), Property, ValuePtr, Owner, Depth, Formatter);
+        }
+
+        ++NumNodes;
+        const int32 Num = FReflectedActorProperty::GetContainerNum(Property, ValuePtr);
+
+        TArray<FActorDebuggerSnapshotNodePtr> Children;
+        if (Depth < MaxDepth)
+        {
+            Children.Reserve(Num);
+            AddElements(Property, ValuePtr, Owner, Depth + 1, Formatter, Children);
+        }
+
+        return MakeNode(MoveTemp(Name), static_cast<uint64>(Num), MoveTemp(Children), [Num](FStringBuilderBase& Out)
+        {
+            Out << MakeCountValue(Num);
+        });
+    }
+
+    void AddElements(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, int32 Depth, FActorDebuggerFormatFunction Formatter, TArray<FActorDebuggerSnapshotNodePtr>& OutChildren)
+    {
+        if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+        {
+            FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+            for (int32 Index = 0; Index < Helper.Num() && HasBudget(); ++Index)
+            {
+                OutChildren.Add(BuildValue(MakeIndexName(Index), ArrayProperty->Inner, Helper.GetRawPtr(Index), Owner, Depth, Formatter));
+            }
+        }
+        else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+        {
+            FScriptSetHelper Helper(SetProperty, ValuePtr);
+            int32 LogicalIndex = 0;
+            for (FScriptSetHelper::FIterator It(Helper); It && HasBudget(); ++It)
+            {
+                OutChildren.Add(BuildValue(MakeIndexName(LogicalIndex++), SetProperty->ElementProp, Helper.GetElementPtr(It), Owner, Depth, Formatter));
+            }
+        }
+        else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+        {
+            FScriptMapHelper Helper(MapProperty, ValuePtr);
+            for (FScriptMapHelper::FIterator It(Helper); It && HasBudget(); ++It)
+            {
+                FString KeyName;
+                AppendKeyName(KeyName, MapProperty->KeyProp, Helper.GetKeyPtr(It), Owner);
+                OutChildren.Add(BuildValue(MoveTemp(KeyName), MapProperty->ValueProp, Helper.GetValuePtr(It), Owner, Depth, Formatter));
+            }
+        }
+        else
+        {
+            for (int32 Index = 0; Index < Property->ArrayDim && HasBudget(); ++Index)
+            {
+                OutChildren.Add(BuildValue(MakeIndexName(Index), Property, ValuePtr + Index * Property->ElementSize, Owner, Depth, Formatter));
+            }
+        }
+    }
+
+    /*
+    * A single value. Structs are their members. References to objects the tree would expand are their class and
+    * members the first time they are reached, and the order they were reached in after that. Anything else is
+    * hashed from its value
+    */
+    FActorDebuggerSnapshotNodePtr BuildValue(FString&& Name, const FProperty* Property, const uint8* ValuePtr, UObject* Owner, int32 Depth, FActorDebuggerFormatFunction Formatter)
+    {
+        ++NumNodes;
+
+        auto FormatValue = [Property, ValuePtr, Owner, Formatter](FStringBuilderBase& Out)
+        {
+            Formatter(Property, ValuePtr, Owner, Out);
+        };
+
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            // past the depth limit the struct is a single value
+            if (Depth >= MaxDepth)
+            {
+                return MakeNode(MoveTemp(Name), ActorDebugger::HashPropertyElement(Property, ValuePtr), TArray<FActorDebuggerSnapshotNodePtr>(), FormatValue);
+            }
+
+            TArray<FActorDebuggerSnapshotNodePtr> Children;
+            AddMembers(StructProperty->Struct, ValuePtr, Owner, Depth + 1, Children);
+            return MakeNode(MoveTemp(Name), 0, MoveTemp(Children), [](FStringBuilderBase& Out) {});
+        }
+
+        if (const FObjectProperty* ObjectProperty = CastField<FObjectProperty>(Property))
+        {
+            UObject* Object = ObjectProperty->GetObjectPropertyValue(ValuePtr);
+
+            if (Object && FActorDebuggerInspection::IsUObjectOfInterest(Object))
+            {
+                if (const int32* VisitIndex = Visited.Find(Object))
+                {
+                    return MakeNode(MoveTemp(Name), CombineHashes(VisitedSeed, *VisitIndex), TArray<FActorDebuggerSnapshotNodePtr>(), FormatValue);
+                }
+
+                if (Depth < MaxDepth)
+                {
+                    Visited.Add(Object, Visited.Num());
+
+                    TArray<FActorDebuggerSnapshotNodePtr> Children;
+                    AddMembers(Object->GetClass(), reinterpret_cast<const uint8*>(Object), Object, Depth + 1, Children);
+
+                    const UClass* Class = Object->GetClass();
+                    return MakeNode(MoveTemp(Name), CityHash64(reinterpret_cast<const char*>(&Class), sizeof(Class)), MoveTemp(Children), FormatValue);
+                }
+            }
+        }
+
+        return MakeNode(MoveTemp(Name), ActorDebugger::HashPropertyElement(Property, ValuePtr), TArray<FActorDebuggerSnapshotNodePtr>(), FormatValue);
+    }
+
+    /*
+    * Hashes the node and returns the node already held with that hash if it has the same name, value hash and
+    * children. Otherwise the value is formatted and the node is added to the table, unless another node holds its
+    * hash, in which case the node is kept by this snapshot alone
+    */
+    FActorDebuggerSnapshotNodePtr MakeNode(FString&& Name, uint64 ValueHash, TArray<FActorDebuggerSnapshotNodePtr>&& Children, TFunctionRef<void(FStringBuilderBase&)> FormatValue)
+    {
+        uint64 Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Name), Name.Len() * sizeof(TCHAR), ValueHash);
+        for (const FActorDebuggerSnapshotNodePtr& Child : Children)
+        {
+            Hash = CombineHashes(Hash, Child->Hash);
+        }
+
+        FActorDebuggerSnapshotNodePtr Existing = Snapshots.FindNode(Hash);
+        if (Existing && Existing->ValueHash == ValueHash && Existing->Name.Equals(Name, ESearchCase::CaseSensitive) && Existing->Children == Children)
+        {
+            return Existing;
+        }
+
+        TStringBuilder<256> ValueString;
+        FormatValue(ValueString);
+
+        TSharedRef<FActorDebuggerSnapshotNode, ESPMode::ThreadSafe> Node = MakeShared<FActorDebuggerSnapshotNode, ESPMode::ThreadSafe>();
+        Node->Name = MoveTemp(Name);
+        Node->Value = FString(ValueString.Len(), ValueString.GetData());
+        Node->ValueHash = ValueHash;
+        Node->Hash = Hash;
+        Node->Children = MoveTemp(Children);
+        return Existing ? Node : Snapshots.AddNode(Node);
+    }
+
+    FActorDebuggerSnapshots& Snapshots;
+    int32 MaxDepth {0};
+    int32 MaxNodes {0};
+
+    /* The objects expanded so far and the order they were reached in */
+    TMap<const UObject*, int32> Visited;
+
+    /* Keeps the schemas alive while their entries are in use */
+    TMap<const UStruct*, FActorDebuggerClassSchemaPtr> Schemas;
+};
+
+FActorDebuggerSnapshots& FActorDebuggerSnapshots::Get()
+{
+    static FActorDebuggerSnapshots Instance;
+    return Instance;
+}
+
+/*
+* Walks the whole graph, hashing every value. Only the values of nodes that aren't held by another snapshot are
+* formatted
+*/
+FActorDebuggerSnapshotPtr FActorDebuggerSnapshots::Capture(UObject* Object, const FString& Name)
+{
+    check(IsInGameThread());
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_Snapshot);
+
+    if (IsValid(Object) == false)
+    {
+        return nullptr;
+    }
+
+    FActorDebuggerSnapshotBuilder Builder(*this);
+
+    TSharedRef<FActorDebuggerSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FActorDebuggerSnapshot, ESPMode::ThreadSafe>();
+    Snapshot->Name = Name;
+    Snapshot->Object = Object;
+    Snapshot->ObjectName = Object->GetName();
+    Snapshot->Time = FPlatformTime::Seconds();
+    Snapshot->Root = Builder.BuildRoot(Object);
+    Snapshot->NumNodes = Builder.NumNodes;
+    Snapshot->bTruncated = Builder.bTruncated;
+
+    if (Builder.bTruncated)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: the snapshot of %s stopped at %d nodes, see ActorDebugger.SnapshotMaxNodes"), *Object->GetName(), Builder.NumNodes);
+    }
+
+    // captures that are thrown away leave expired entries behind, they are cleared out once there are enough
+    if (Nodes.Num() > NumNodesAfterPrune * 2 + MinPruneGrowth)
+    {
+        PruneNodes();
+    }
+
+    return Snapshot;
+}
+
+FActorDebuggerSnapshotPtr FActorDebuggerSnapshots::Take(UObject* Object, const FString& Name)
+{
+    const FString SnapshotName = Name.IsEmpty() ? FString::Printf(TEXT("Snapshot%d"), NumTaken + 1) : Name;
+
+    FActorDebuggerSnapshotPtr Snapshot = Capture(Object, SnapshotName);
+    if (Snapshot.IsValid())
+    {
+        ++NumTaken;
+        Remove(SnapshotName);
+        Snapshots.Add(Snapshot);
+    }
+    return Snapshot;
+}
+
+FActorDebuggerSnapshotPtr FActorDebuggerSnapshots::Find(const FString& Name) const
+{
+    const FActorDebuggerSnapshotPtr* Snapshot = Snapshots.FindByPredicate([&Name](const FActorDebuggerSnapshotPtr& Existing) { return Existing->Name == Name; });
+    return Snapshot ? *Snapshot : nullptr;
+}
+
+bool FActorDebuggerSnapshots::Remove(const FString& Name)
+{
+    if (Snapshots.RemoveAll([&Name](const FActorDebuggerSnapshotPtr& Existing) { return Existing->Name == Name; }) == 0)
+    {
+        return false;
+    }
+
+    PruneNodes();
+    return true;
+}
+
+void FActorDebuggerSnapshots::Reset()
+{
+    Snapshots.Reset();
+    PruneNodes();
+}
+
+TArray<FString> FActorDebuggerSnapshots::GetNames() const
+{
+    TArray<FString> Names;
+    for (const FActorDebuggerSnapshotPtr& Snapshot : Snapshots)
+    {
+        Names.Add(Snapshot->Name);
+    }
+    return Names;
+}
+
+int32 FActorDebuggerSnapshots::GetNumUniqueNodes() const
+{
+    int32 NumUnique = 0;
+    for (const TPair<uint64, TWeakPtr<const FActorDebuggerSnapshotNode, ESPMode::ThreadSafe>>& Pair : Nodes)
+    {
+        NumUnique += Pair.Value.IsValid() ? 1 : 0;
+    }
+    return NumUnique;
+}
+
+/*
+* Every node is in the table once however many snapshots share it, so this counts shared memory once
+*/
+SIZE_T FActorDebuggerSnapshots::GetAllocatedSize() const
+{
+    SIZE_T Size = Nodes.GetAllocatedSize() + Snapshots.GetAllocatedSize() + Snapshots.Num() * sizeof(FActorDebuggerSnapshot);
+
+    for (const TPair<uint64, TWeakPtr<const FActorDebuggerSnapshotNode, ESPMode::ThreadSafe>>& Pair : Nodes)
+    {
+        if (FActorDebuggerSnapshotNodePtr Node = Pair.Value.Pin())
+        {
+            Size += sizeof(FActorDebuggerSnapshotNode) + Node->Name.GetAllocatedSize() + Node->Value.GetAllocatedSize() + Node->Children.GetAllocatedSize();
+        }
+    }
+
+    return Size;
+}
+
+/*
+* The diff is reported from the point of view of New: values only New has were added, values only Old has were removed
+*/
+void FActorDebuggerSnapshots::Diff(const FActorDebuggerSnapshot& Old, const FActorDebuggerSnapshot& New, FActorDebuggerSnapshotDiff& OutDiff)
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_Diff);
+
+    OutDiff.Reset();
+
+    if (Old.Root.IsValid() == false || New.Root.IsValid() == false)
+    {
+        return;
+    }
+
+    FString Path;
+    DiffNodes(*Old.Root, *New.Root, Path, OutDiff);
+}
+
+/*
+* Pages are left out, they only group the elements of a large container and snapshots don't have them
+*/
+FString FActorDebuggerSnapshots::GetItemPath(FReflectedActorPropertyPtr Item)
+{
+    TArray<FReflectedActorPropertyPtr, TInlineAllocator<16>> Chain;
+    for (FReflectedActorPropertyPtr Node = Item; Node; Node = Node->Parent)
+    {
+        if (Node->Kind != EReflectedPropertyKind::Page)
+        {
+            Chain.Add(Node);
+        }
+    }
+
+    FString Path;
+    for (int32 Index = Chain.Num() - 1; Index >= 0; --Index)
+    {
+        const FReflectedActorProperty& Node = *Chain[Index];
+
+        switch (Node.Kind)
+        {
+        case EReflectedPropertyKind::ObjectMember:
+        case EReflectedPropertyKind::StructMember:
+            AppendPath(Path, Node.Entry->Name.ToString());
+            break;
+
+        case EReflectedPropertyKind::MapPair:
+        {
+            const FReflectedActorProperty* ContainerItem = Node.Parent->Kind == EReflectedPropertyKind::Page ? Node.Parent->Parent : Node.Parent;
+            const uint8* KeyPtr = Node.ResolveMapKeyPtr();
+
+            FString KeyName;
+            if (KeyPtr)
+            {
+                AppendKeyName(KeyName, CastFieldChecked<FMapProperty>(ContainerItem->Property)->KeyProp, KeyPtr, Node.Object);
+            }
+            AppendPath(Path, KeyName);
+            break;
+        }
+
+        default:
+            AppendPath(Path, MakeIndexName(Node.LogicalIndex));
+            break;
+        }
+    }
+
+    return Path;
+}
+
+void FActorDebuggerSnapshots::AppendPath(FString& Path, const FString& Name)
+{
+    if (Path.Len() > 0 && Name.StartsWith(TEXT("[")) == false)
+    {
+        Path += TEXT('.');
+    }
+    Path += Name;
+}
+
+FActorDebuggerSnapshotNodePtr FActorDebuggerSnapshots::FindNode(uint64 Hash) const
+{
+    const TWeakPtr<const FActorDebuggerSnapshotNode, ESPMode::ThreadSafe>* Node = Nodes.Find(Hash);
+    return Node ? Node->Pin() : nullptr;
+}
+
+FActorDebuggerSnapshotNodePtr FActorDebuggerSnapshots::AddNode(const FActorDebuggerSnapshotNodePtr& Node)
+{
+    Nodes.Add(Node->Hash, Node);
+    return Node;
+}
+
+/*
+* Drops the entries of nodes no snapshot holds anymore
+*/
+void FActorDebuggerSnapshots::PruneNodes()
+{
+    for (auto It = Nodes.CreateIterator(); It; ++It)
+    {
+        if (It->Value.IsValid() == false)
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    Nodes.Compact();
+    NumNodesAfterPrune = Nodes.Num();
+}
@@ -0,0 +1,35 @@
+#include "ActorDebuggerStats.h"
+
+DEFINE_STAT(STAT_ActorDebugger_Tick);
+DEFINE_STAT(STAT_ActorDebugger_BuildTree);
+DEFINE_STAT(STAT_ActorDebugger_GatherChildren);
+DEFINE_STAT(STAT_ActorDebugger_GatherProperties);
+DEFINE_STAT(STAT_ActorDebugger_SampleRows);
+DEFINE_STAT(STAT_ActorDebugger_ExportValue);
+DEFINE_STAT(STAT_ActorDebugger_FormatBatch);
+DEFINE_STAT(STAT_ActorDebugger_GenerateRow);
+DEFINE_STAT(STAT_ActorDebugger_CaptureFrame);
+DEFINE_STAT(STAT_ActorDebugger_ReplayFrame);
+DEFINE_STAT(STAT_ActorDebugger_SearchIndex);
+DEFINE_STAT(STAT_ActorDebugger_Search);
+DEFINE_STAT(STAT_ActorDebugger_Watchpoints);
+DEFINE_STAT(STAT_ActorDebugger_Query);
+DEFINE_STAT(STAT_ActorDebugger_SampleColumns);
+DEFINE_STAT(STAT_ActorDebugger_Snapshot);
+DEFINE_STAT(STAT_ActorDebugger_Diff);
+DEFINE_STAT(STAT_ActorDebugger_CollectCalls);
+DEFINE_STAT(STAT_ActorDebugger_Dump);
+DEFINE_STAT(STAT_ActorDebugger_Serve);
+DEFINE_STAT(STAT_ActorDebugger_EncodeUpdates);
+DEFINE_STAT(STAT_ActorDebugger_MeasureMemory);
+DEFINE_STAT(STAT_ActorDebugger_MeasureObject);
+
+DEFINE_STAT(STAT_ActorDebugger_Nodes);
+DEFINE_STAT(STAT_ActorDebugger_Rows);
+DEFINE_STAT(STAT_ActorDebugger_ExportedBytes);
+DEFINE_STAT(STAT_ActorDebugger_FallbackExports);
+DEFINE_STAT(STAT_ActorDebugger_TracedCalls);
+DEFINE_STAT(STAT_ActorDebugger_DumpedBytes);
+DEFINE_STAT(STAT_ActorDebugger_ServedBytes);
+DEFINE_STAT(STAT_ActorDebugger_ResourceSizes);
+DEFINE_STAT(STAT_ActorDebugger_MemoryHeld);
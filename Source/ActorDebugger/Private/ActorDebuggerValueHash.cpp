@@ -0,0 +1,140 @@
+#include "ActorDebuggerValueHash.h"
+#include "UObject/UnrealType.h"
+#include "UObject/TextProperty.h"
+#include "Hash/CityHash.h"
+
+namespace ActorDebugger
+{
+    static uint64 HashBytes(const void* Data, int32 NumBytes, uint64 Seed)
+    {
+        return CityHash64WithSeed(static_cast<const char*>(Data), NumBytes, Seed);
+    }
+
+    /*
+    * Struct members are walked through the property link chain, which is a plain linked list and avoids
+    * setting up a field iterator for every struct we hash
+    */
+    static uint64 HashStructValue(const UScriptStruct* Struct, const void* ValuePtr, uint64 Seed)
+    {
+        if ((Struct->StructFlags & STRUCT_IsPlainOldData) != 0)
+        {
+            return HashBytes(ValuePtr, Struct->GetStructureSize(), Seed);
+        }
+
+        for (const FProperty* Member = Struct->PropertyLink; Member; Member = Member->PropertyLinkNext)
+        {
+            Seed = HashPropertyValue(Member, Member->ContainerPtrToValuePtr<void>(ValuePtr), Seed);
+        }
+
+        return Seed;
+    }
+
+    uint64 HashPropertyElement(const FProperty* Property, const void* ValuePtr, uint64 Seed)
+    {
+        if (Property == nullptr || ValuePtr == nullptr)
+        {
+            return Seed;
+        }
+
+        // bitfield bools share their byte with other bools so only the masked bit is hashed
+        if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+        {
+            const uint8 Value = BoolProperty->GetPropertyValue(ValuePtr) ? 1 : 0;
+            return HashBytes(&Value, sizeof(Value), Seed);
+        }
+
+        if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData))
+        {
+            return HashBytes(ValuePtr, Property->ElementSize, Seed);
+        }
+
+        if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+        {
+            const FString& Value = StrProperty->GetPropertyValue(ValuePtr);
+            return HashBytes(*Value, Value.Len() * sizeof(TCHAR), Seed);
+        }
+
+        if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+        {
+            const FString& Value = TextProperty->GetPropertyValue(ValuePtr).ToString();
+            return HashBytes(*Value, Value.Len() * sizeof(TCHAR), Seed);
+        }
+
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            return HashStructValue(StructProperty->Struct, ValuePtr, Seed);
+        }
+
+        if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+        {
+            FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+            const int32 Num = Helper.Num();
+            Seed = HashBytes(&Num, sizeof(Num), Seed);
+
+            if (ArrayProperty->Inner->HasAnyPropertyFlags(CPF_IsPlainOldData))
+            {
+                return Num > 0 ? HashBytes(Helper.GetRawPtr(0), Num * ArrayProperty->Inner->ElementSize, Seed) : Seed;
+            }
+
+            for (int32 Index = 0; Index < Num; ++Index)
+            {
+                Seed = HashPropertyElement(ArrayProperty->Inner, Helper.GetRawPtr(Index), Seed);
+            }
+            return Seed;
+        }
+
+        if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+        {
+            FScriptSetHelper Helper(SetProperty, ValuePtr);
+            const int32 Num = Helper.Num();
+            Seed = HashBytes(&Num, sizeof(Num), Seed);
+
+            for (FScriptSetHelper::FIterator It(Helper); It; ++It)
+            {
+                Seed = HashPropertyElement(SetProperty->ElementProp, Helper.GetElementPtr(It), Seed);
+            }
+            return Seed;
+        }
+
+        if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+        {
+            FScriptMapHelper Helper(MapProperty, ValuePtr);
+            const int32 Num = Helper.Num();
+            Seed = HashBytes(&Num, sizeof(Num), Seed);
+
+            for (FScriptMapHelper::FIterator It(Helper); It; ++It)
+            {
+                Seed = HashPropertyElement(MapProperty->KeyProp, Helper.GetKeyPtr(It), Seed);
+                Seed = HashPropertyElement(MapProperty->ValueProp, Helper.GetValuePtr(It), Seed);
+            }
+            return Seed;
+        }
+
+        // object references, names, delegates and anything else are identified by their raw bytes
+        return HashBytes(ValuePtr, Property->ElementSize, Seed);
+    }
+
+    /*
+    * Hashes every element of a (possibly static array) property. Static arrays of plain old data are
+    * hashed in one go
+    */
+    uint64 HashPropertyValue(const FProperty* Property, const void* ValuePtr, uint64 Seed)
+    {
+        if (Property == nullptr || ValuePtr == nullptr)
+        {
+            return Seed;
+        }
+
+        if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData) && !Property->IsA<FBoolProperty>())
+        {
+            return HashBytes(ValuePtr, Property->ElementSize * Property->ArrayDim, Seed);
+        }
+
+        for (int32 Index = 0; Index < Property->ArrayDim; ++Index)
+        {
+            Seed = HashPropertyElement(Property, static_cast<const uint8*>(ValuePtr) + Index * Property->ElementSize, Seed);
+        }
+
+        return Seed;
+    }
+}
@@ -0,0 +1,386 @@
+#include "ActorDebuggerWatchpoints.h"
+#include "ActorDebuggerValueHash.h"
+#include "ActorPropertyWidget.h"
+#include "ActorDebuggerStats.h"
+#include "ActorDebugger.h"
+#include "UObject/UnrealType.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#if WITH_EDITOR
+#include "Editor.h"
+#endif
+
+namespace ActorDebuggerWatchpoints
+{
+    /* Plain old data up to this size is compared byte for byte by "on change" watchpoints, bigger values are hashed */
+    static constexpr int32 MaxCompareBytes = 64;
+
+    static bool TestChangedBytes(FActorDebuggerWatchpoint& Watchpoint, const uint8* ValuePtr)
+    {
+        if (FMemory::Memcmp(Watchpoint.LastValue.GetData(), ValuePtr, Watchpoint.LastValue.Num()) == 0)
+        {
+            return false;
+        }
+
+        FMemory::Memcpy(Watchpoint.LastValue.GetData(), ValuePtr, Watchpoint.LastValue.Num());
+        return true;
+    }
+
+    static bool TestChangedBool(FActorDebuggerWatchpoint& Watchpoint, const uint8* ValuePtr)
+    {
+        const uint8 Value = static_cast<const FBoolProperty*>(Watchpoint.Property)->GetPropertyValue(ValuePtr) ? 1 : 0;
+        if (Watchpoint.LastValue[0] == Value)
+        {
+            return false;
+        }
+
+        Watchpoint.LastValue[0] = Value;
+        return true;
+    }
+
+    static bool TestChangedHash(FActorDebuggerWatchpoint& Watchpoint, uint64 Hash)
+    {
+        if (FMemory::Memcmp(Watchpoint.LastValue.GetData(), &Hash, sizeof(Hash)) == 0)
+        {
+            return false;
+        }
+
+        FMemory::Memcpy(Watchpoint.LastValue.GetData(), &Hash, sizeof(Hash));
+        return true;
+    }
+
+    static bool TestChangedElementHash(FActorDebuggerWatchpoint& Watchpoint, const uint8* ValuePtr)
+    {
+        return TestChangedHash(Watchpoint, ActorDebugger::HashPropertyElement(Watchpoint.Property, ValuePtr));
+    }
+
+    /* C style arrays hash every element, script containers are followed to their elements */
+    static bool TestChangedValueHash(FActorDebuggerWatchpoint& Watchpoint, const uint8* ValuePtr)
+    {
+        return TestChangedHash(Watchpoint, ActorDebugger::HashPropertyValue(Watchpoint.Property, ValuePtr));
+    }
+
+    /* "Objects[0].Struct.Int32", pages are left out since they aren't part of the value's address */
+    static FString MakePath(FReflectedActorPropertyPtr Item)
+    {
+        TArray<FReflectedActorPropertyPtr, TInlineAllocator<16>> Nodes;
+        for (FReflectedActorPropertyPtr Node = Item; Node; Node = Node->Parent)
+        {
+            if (Node->Kind != EReflectedPropertyKind::Page)
+            {
+                Nodes.Add(Node);
+            }
+        }
+
+        FString Path;
+        for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+        {
+            const FReflectedActorPropertyPtr Node = Nodes[NodeIndex];
+            const FString Name = Node->GetDisplayName().ToString();
+
+            if (Node->Kind == EReflectedPropertyKind::ObjectMember || Node->Kind == EReflectedPropertyKind::StructMember)
+            {
+                Path += Path.IsEmpty() ? Name : TEXT(".") + Name;
+            }
+            else if (Node->Kind == EReflectedPropertyKind::MapPair)
+            {
+                Path += TEXT("[") + Name + TEXT("]");
+            }
+            else
+            {
+                Path += Name;
+            }
+        }
+
+        return Path;
+    }
+}
+
+using namespace ActorDebuggerWatchpoints;
+
+FActorDebuggerWatchpoints::~FActorDebuggerWatchpoints()
+{
+    Reset();
+}
+
+/*
+* The watchpoint is compiled and primed with the current value before it replaces the node's previous one, so a
+* condition that doesn't fit leaves the previous watchpoint in place
+*/
+bool FActorDebuggerWatchpoints::Add(FReflectedActorPropertyPtr Item, const FString& Condition, EActorDebuggerWatchAction Actions, FText& OutError)
+{
+    check(IsInGameThread());
+
+    if (Item == nullptr || Item->Kind == EReflectedPropertyKind::Page || Item->IsValid() == false)
+    {
+        OutError = FText::FromString("Only values can be watched");
+        return false;
+    }
+
+    FActorDebuggerWatchpoint Watchpoint;
+    Watchpoint.Item = Item;
+    Watchpoint.Generation = Item->Generation;
+    Watchpoint.Property = Item->Property;
+    Watchpoint.Owner = Item->Object;
+    Watchpoint.StableValuePtr = Item->ResolveStableValuePtr();
+    Watchpoint.Actions = Actions;
+    Watchpoint.Path = MakePath(Item);
+    Watchpoint.ConditionText = Condition.TrimStartAndEnd();
+
+    if (Compile(Watchpoint, Watchpoint.ConditionText, OutError) == false)
+    {
+        return false;
+    }
+
+    if (const uint8* ValuePtr = ResolveValue(Watchpoint))
+    {
+        Watchpoint.bLastResult = Watchpoint.Op == EActorDebuggerConditionOp::Changed ? Watchpoint.ChangeTest(Watchpoint, ValuePtr) : Watchpoint.Condition.Evaluate(ValuePtr);
+    }
+
+    Remove(Item);
+    Watchpoints.Add(MoveTemp(Watchpoint));
+    Item->bWatched = true;
+    return true;
+}
+
+bool FActorDebuggerWatchpoints::Remove(FReflectedActorPropertyPtr Item)
+{
+    const int32 Index = IndexOf(Item);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    Item->bWatched = false;
+    Watchpoints.RemoveAt(Index);
+    return true;
+}
+
+bool FActorDebuggerWatchpoints::SetActions(FReflectedActorPropertyPtr Item, EActorDebuggerWatchAction Actions)
+{
+    const int32 Index = IndexOf(Item);
+    if (Index == INDEX_NONE)
+    {
+        return false;
+    }
+
+    Watchpoints[Index].Actions = Actions;
+    return true;
+}
+
+const FActorDebuggerWatchpoint* FActorDebuggerWatchpoints::Find(FReflectedActorPropertyPtr Item) const
+{
+    const int32 Index = IndexOf(Item);
+    return Index != INDEX_NONE ? &Watchpoints[Index] : nullptr;
+}
+
+/*
+* Nodes carry a flag while they are watched, so rows that aren't watched never search the list
+*/
+int32 FActorDebuggerWatchpoints::IndexOf(FReflectedActorPropertyPtr Item) const
+{
+    if (Item == nullptr || Item->bWatched == false)
+    {
+        return INDEX_NONE;
+    }
+
+    return Watchpoints.IndexOfByPredicate([Item](const FActorDebuggerWatchpoint& Watchpoint)
+    {
+        return Watchpoint.Item == Item && Watchpoint.Generation == Item->Generation;
+    });
+}
+
+void FActorDebuggerWatchpoints::Reset()
+{
+    check(IsInGameThread());
+
+    for (const FActorDebuggerWatchpoint& Watchpoint : Watchpoints)
+    {
+        // nodes released since the watchpoint was added may belong to someone else now
+        if (Watchpoint.Item->Generation == Watchpoint.Generation)
+        {
+            Watchpoint.Item->bWatched = false;
+        }
+    }
+
+    Watchpoints.Empty();
+}
+
+/*
+* Picks the "on change" test for the node's type, or compiles the condition for the node's property
+*/
+bool FActorDebuggerWatchpoints::Compile(FActorDebuggerWatchpoint& Watchpoint, const FString& Condition, FText& OutError) const
+{
+    FString Name;
+    FString Operand;
+    if (FActorDebuggerCondition::Parse(Condition, Name, Watchpoint.Op, Operand) == false)
+    {
+        OutError = FText::FromString("Conditions look like \"Health < 10\", \"== true\" or \"changed\"");
+        return false;
+    }
+
+    FReflectedActorPropertyPtr Item = Watchpoint.Item;
+    const FProperty* Property = Watchpoint.Property;
+
+    if (Name.IsEmpty() == false && Name.Equals(Item->GetDisplayName().ToString(), ESearchCase::IgnoreCase) == false)
+    {
+        OutError = FText::FromString(FString::Printf(TEXT("The condition names %s but this is %s"), *Name, *Item->GetDisplayName().ToString()));
+        return false;
+    }
+
+    if (Watchpoint.Op == EActorDebuggerConditionOp::Changed)
+    {
+        if (Item->IsContainer())
+        {
+            Watchpoint.LastValue.SetNumZeroed(sizeof(uint64));
+            Watchpoint.ChangeTest = &TestChangedValueHash;
+        }
+        else if (Property->IsA<FBoolProperty>())
+        {
+            Watchpoint.LastValue.SetNumZeroed(1);
+            Watchpoint.ChangeTest = &TestChangedBool;
+        }
+        else if (Property->HasAnyPropertyFlags(CPF_IsPlainOldData) && Property->ElementSize <= MaxCompareBytes)
+        {
+            Watchpoint.LastValue.SetNumZeroed(Property->ElementSize);
+            Watchpoint.ChangeTest = &TestChangedBytes;
+        }
+        else
+        {
+            Watchpoint.LastValue.SetNumZeroed(sizeof(uint64));
+            Watchpoint.ChangeTest = &TestChangedElementHash;
+        }
+        return true;
+    }
+
+    return Watchpoint.Condition.Compile(Property, Watchpoint.Op, Operand, Item->IsContainer(), OutError);
+}
+
+/*
+* Mirrors the history recorder: values that can't move are read through the address taken when the watchpoint was
+* added, values inside script containers are found again every frame
+*/
+const uint8* FActorDebuggerWatchpoints::ResolveValue(const FActorDebuggerWatchpoint& Watchpoint)
+{
+    if (Watchpoint.Item->Generation != Watchpoint.Generation || Watchpoint.Owner.Get() == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (Watchpoint.StableValuePtr)
+    {
+        return Watchpoint.StableValuePtr;
+    }
+
+    return Watchpoint.Item->IsDetached() ? nullptr : Watchpoint.Item->ResolveValuePtr();
+}
+
+/*
+* Evaluating is one indirect call per watchpoint on memory that was resolved without a lookup. The game is paused
+* once at the end, however many watchpoints asked for it
+*/
+int32 FActorDebuggerWatchpoints::Evaluate()
+{
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_Watchpoints);
+
+    int32 NumTriggered = 0;
+    bool bPause = false;
+
+    for (FActorDebuggerWatchpoint& Watchpoint : Watchpoints)
+    {
+        const uint8* ValuePtr = ResolveValue(Watchpoint);
+        if (ValuePtr == nullptr)
+        {
+            // a condition that holds when its value comes back triggers again
+            Watchpoint.bLastResult = false;
+            continue;
+        }
+
+        const bool bChangeTest = Watchpoint.Op == EActorDebuggerConditionOp::Changed;
+        const bool bResult = bChangeTest ? Watchpoint.ChangeTest(Watchpoint, ValuePtr) : Watchpoint.Condition.Evaluate(ValuePtr);
+        const bool bTriggered = bChangeTest ? bResult : bResult && Watchpoint.bLastResult == false;
+        Watchpoint.bLastResult = bResult;
+
+        if (bTriggered)
+        {
+            ++NumTriggered;
+            Trigger(Watchpoint, ValuePtr, bPause);
+        }
+    }
+
+    if (bPause)
+    {
+        PausePlay();
+    }
+
+    return NumTriggered;
+}
+
+/*
+* Only a triggered watchpoint exports its value to text. A pausing watchpoint always logs why it paused
+*/
+void FActorDebuggerWatchpoints::Trigger(FActorDebuggerWatchpoint& Watchpoint, const uint8* ValuePtr, bool& bOutPause) const
+{
+    ++Watchpoint.NumTriggers;
+
+    if (EnumHasAnyFlags(Watchpoint.Actions, EActorDebuggerWatchAction::Log | EActorDebuggerWatchAction::Pause))
+    {
+        const FString ValueText = SActorPropertyWidget::PropertyValueToText(Watchpoint.Item).ToString();
+        const FString Condition = Watchpoint.Op == EActorDebuggerConditionOp::Changed ? TEXT("changed") : Watchpoint.ConditionText;
+
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: watchpoint %s (%s) triggered, value is %s"), *Watchpoint.Path, *Condition, *ValueText);
+    }
+
+    if (EnumHasAnyFlags(Watchpoint.Actions, EActorDebuggerWatchAction::Callstack))
+    {
+        FDebug::DumpStackTraceToLog(*FString::Printf(TEXT("Actor Debugger: watchpoint %s"), *Watchpoint.Path), ELogVerbosity::Warning);
+    }
+
+    bOutPause |= EnumHasAnyFlags(Watchpoint.Actions, EActorDebuggerWatchAction::Pause);
+}
+
+/*
+* In the editor this is the same as pressing Pause on the play toolbar, so play can be resumed or stepped from
+* there. Outside the editor the game worlds are paused
+*/
+void FActorDebuggerWatchpoints::PausePlay()
+{
+#if WITH_EDITOR
+    if (GEditor && GEditor->PlayWorld)
+    {
+        if (GEditor->PlayWorld->bDebugPauseExecution == false)
+        {
+            GEditor->PlayWorld->bDebugPauseExecution = true;
+            GEditor->SetPIEWorldsPaused(true);
+        }
+        return;
+    }
+#endif
+
+    if (GEngine == nullptr)
+    {
+        return;
+    }
+
+    for (const FWorldContext& Context : GEngine->GetWorldContexts())
+    {
+        if (Context.WorldType == EWorldType::Game && Context.World())
+        {
+            UGameplayStatics::SetGamePaused(Context.World(), true);
+        }
+    }
+}
+
+SIZE_T FActorDebuggerWatchpoints::GetAllocatedSize() const
+{
+    SIZE_T Size = Watchpoints.GetAllocatedSize();
+
+    for (const FActorDebuggerWatchpoint& Watchpoint : Watchpoints)
+    {
+        Size += Watchpoint.LastValue.GetAllocatedSize() + Watchpoint.Condition.OperandString.GetAllocatedSize()
+            + Watchpoint.Path.GetAllocatedSize() + Watchpoint.ConditionText.GetAllocatedSize();
+    }
+
+    return Size;
+}
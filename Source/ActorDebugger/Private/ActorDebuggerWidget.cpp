@@ -2,9 +2,21 @@
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Images/SImage.h"
 #include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SBox.h"
 #include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSlider.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Framework/MultiBox/MultiBoxBuilder.h"
+#include "Framework/Application/SlateApplication.h"
 #include "Widgets/Views/SListView.h"
 #include "ReflectedPropertyTableRow.h"
+#include "ActorDebuggerSchemaCache.h"
+#include "ActorDebuggerFormatPipeline.h"
+#include "ActorDebuggerQuery.h"
+#include "ActorDebuggerCallTimelineWidget.h"
+#include "ActorDebuggerStats.h"
+#include "ActorDebugger.h"
 
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
@@ -13,8 +25,12 @@ BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 */
 void SActorDebuggerWidget::Construct(const FArguments& InArgs)
 {
-    // define the header row
-    TSharedRef<SHeaderRow> HeaderRow 
+    FormatPipeline = MakeShared<FActorDebuggerFormatPipeline>();
+    RefreshScheduler = FActorDebuggerRefreshScheduler::GetShared();
+    SchedulerClientId = RefreshScheduler->AddClient(InArgs._RefreshRate, FActorDebuggerRefreshScheduler::FSampleItem::CreateSP(this, &SActorDebuggerWidget::SampleItem));
+
+    // define the header row, the memory columns are added to it when they are shown
+    HeaderRow
     = SNew(SHeaderRow)
         + SHeaderRow::Column("PropertyName")
         .DefaultLabel(FText::FromString("Name"))
@@ -40,41 +56,206 @@ void SActorDebuggerWidget::Construct(const FArguments& InArgs)
                     SAssignNew(ActorNameTextBlock, STextBlock)
                         .ColorAndOpacity(FLinearColor::Yellow)
                 ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .HAlign(HAlign_Right)
+                [
+                    SAssignNew(OverheadTextBlock, STextBlock)
+                        .ColorAndOpacity(FLinearColor(0.5f, 0.5f, 0.5f))
+                        .ToolTipText(FText::FromString("What the debugger costs per frame: the last tick, the average tick, the nodes and rows it holds and their memory. See \"stat ActorDebugger\" for a breakdown"))
+                ]
             ]
             + SVerticalBox::Slot()
-            .FillHeight(1.0f)
+            .AutoHeight()
+            .Padding(FMargin(0, 2))
+            [
+                // recording controls and the timeline used to scrub back through what was recorded
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                        .Text(this, &SActorDebuggerWidget::GetRecordButtonText)
+                        .ToolTipText(FText::FromString("Records the selected properties every frame so that you can scrub back through them"))
+                        .OnClicked(this, &SActorDebuggerWidget::HandleRecordClicked)
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .VAlign(VAlign_Center)
+                .Padding(FMargin(4, 0))
+                [
+                    SNew(SSlider)
+                        .IsEnabled(this, &SActorDebuggerWidget::IsTimelineEnabled)
+                        .Value(this, &SActorDebuggerWidget::GetTimelineValue)
+                        .OnValueChanged(this, &SActorDebuggerWidget::HandleTimelineChanged)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                [
+                    SNew(STextBlock)
+                        .Text(this, &SActorDebuggerWidget::GetTimelineText)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(FMargin(4, 0, 0, 0))
+                [
+                    SNew(SButton)
+                        .Text(FText::FromString("Live"))
+                        .IsEnabled_Lambda([this] { return bScrubbing; })
+                        .OnClicked(this, &SActorDebuggerWidget::HandleLiveClicked)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(FMargin(4, 0, 0, 0))
+                [
+                    SNew(SButton)
+                        .Text_Lambda([this] { return FText::FromString(IsCallTracing() ? "Stop Trace" : "Trace Calls"); })
+                        .ToolTipText(FText::FromString("Lists the functions called on the object and its components as they are called, with how long each took"))
+                        .OnClicked(this, &SActorDebuggerWidget::HandleCallTraceClicked)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(FMargin(4, 0, 0, 0))
+                [
+                    SNew(SButton)
+                        .Text_Lambda([this] { return FText::FromString(bShowMemory ? "Hide Memory" : "Memory"); })
+                        .ToolTipText(FText::FromString("Shows what each property and the objects below it cost in memory. Sort by Retained to find the largest contributors"))
+                        .OnClicked_Lambda([this] { SetMemoryShown(bShowMemory == false); return FReply::Handled(); })
+                ]
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 2))
             [
-                SNew(SScrollBox)
-                + SScrollBox::Slot()
+                // snapshots and the diff the rows are colored by
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                [
+                    SNew(SButton)
+                        .Text(FText::FromString("Snapshot"))
+                        .ToolTipText(FText::FromString("Records every value below the object so it can be compared with later"))
+                        .OnClicked(this, &SActorDebuggerWidget::HandleSnapshotClicked)
+                ]
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                .Padding(FMargin(4, 0))
+                [
+                    SAssignNew(DiffTextBox, SEditableTextBox)
+                        .HintText(FText::FromString("Compare with a snapshot, two snapshots or another object"))
+                        .OnTextCommitted(this, &SActorDebuggerWidget::HandleDiffTextCommitted)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                [
+                    SAssignNew(DiffSummaryTextBlock, STextBlock)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .Padding(FMargin(4, 0, 0, 0))
                 [
-                    SAssignNew(PropertiesView, STreeView<FReflectedActorPropertyPtr>)
-                        .TreeItemsSource(&RootItems)
-                        .HeaderRow(HeaderRow)
-                        .OnGenerateRow_Lambda([](FReflectedActorPropertyPtr Item, const TSharedRef<STableViewBase>& OwnerTree)
-                        {
-                            return SNew(SReflectedPropertyTableRow, OwnerTree)
-                                .ReflectedProperty(Item);
-                        })
-                        .OnGetChildren_Lambda([](FReflectedActorPropertyPtr Item, TArray<FReflectedActorPropertyPtr>& OutArray)
-                        {
-                            OutArray = Item->Children;
-                        })
+                    SNew(SButton)
+                        .Text(FText::FromString("Clear"))
+                        .IsEnabled_Lambda([this] { return bDiffActive; })
+                        .OnClicked_Lambda([this] { ClearDiff(); return FReply::Handled(); })
                 ]
             ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 0, 0, 2))
+            [
+                SAssignNew(SearchBox, SSearchBox)
+                    .HintText(FText::FromString("Search names and values, e.g. Health or Weapon.Ammo"))
+                    .OnTextChanged(this, &SActorDebuggerWidget::HandleSearchTextChanged)
+            ]
+            + SVerticalBox::Slot()
+            .FillHeight(1.0f)
+            [
+                // the tree view must not be placed in a scroll box, it needs a bounded height to virtualize its
+                // rows so that only the rows in view are ever generated
+                SAssignNew(PropertiesView, STreeView<FReflectedActorPropertyPtr>)
+                    .TreeItemsSource(&Inspection.GetRootItems())
+                    .HeaderRow(HeaderRow.ToSharedRef())
+                    .SelectionMode(ESelectionMode::Multi)
+                    .OnGenerateRow(this, &SActorDebuggerWidget::HandleGenerateRow)
+                    .OnRowReleased(this, &SActorDebuggerWidget::HandleRowReleased)
+                    .OnGetChildren(this, &SActorDebuggerWidget::HandleGetChildren)
+                    .OnContextMenuOpening(this, &SActorDebuggerWidget::HandleContextMenuOpening)
+            ]
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .Padding(FMargin(0, 2, 0, 0))
+            [
+                SNew(SBox)
+                    .HeightOverride(200.0f)
+                    .Visibility_Lambda([this] { return CallTraceId != INDEX_NONE ? EVisibility::Visible : EVisibility::Collapsed; })
+                    [
+                        SAssignNew(CallTimeline, SActorDebuggerCallTimeline)
+                    ]
+            ]
     ];
 
+    // ticked every frame, the scheduler decides how much work is done in each one
     TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
-        FTickerDelegate::CreateSP(this, &SActorDebuggerWidget::HandleTicker),
-        0.25f
+        FTickerDelegate::CreateSP(this, &SActorDebuggerWidget::HandleTicker)
     );
+
+    FActorDebuggerSchemaCache::Get().OnSchemasInvalidated.AddSP(this, &SActorDebuggerWidget::HandleSchemasInvalidated);
+    Inspection.OnObjectsInvalidated.AddSP(this, &SActorDebuggerWidget::HandleObjectsInvalidated);
+}
+
+/*
+* Removes the ticker, it holds a weak reference to us but there is no reason to keep it firing once we are gone
+*/
+SActorDebuggerWidget::~SActorDebuggerWidget()
+{
+    if (IsCallTracing())
+    {
+        FActorDebuggerCallTracer::Get().Stop();
+    }
+    FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+    FActorDebuggerSchemaCache::Get().OnSchemasInvalidated.RemoveAll(this);
+    RefreshScheduler->RemoveClient(SchedulerClientId);
+
+    DEC_DWORD_STAT_BY(STAT_ActorDebugger_Rows, VisibleRows.Num());
+    DEC_MEMORY_STAT_BY(STAT_ActorDebugger_MemoryHeld, ReportedMemory);
 }
 
 /*
-* Selects an actor to display in the widget
+* Selects an actor to display in the widget. The new tree reuses the arena of the old one, so node addresses are
+* reused too. Everything keyed by node (rows, expansion, selection, queued work) is dropped before it is built
 */
 void SActorDebuggerWidget::SetObject(UObject* Object)
 {
+    StopCapture();
+    StopCallTrace();
+    CallTraceId = INDEX_NONE;
+    CallTimeline->Reset();
+    CaptureReader.Reset();
+    HistoryRecorder.Reset();
+    Watchpoints.Reset();
+    ClearDiff();
+    bScrubbing = false;
+    FormatPipeline->Reset();
+    PropertiesView->ClearExpandedItems();
+    PropertiesView->ClearSelection();
+    PropertiesView->RebuildList();
+    DEC_DWORD_STAT_BY(STAT_ActorDebugger_Rows, VisibleRows.Num());
+    VisibleRows.Reset();
+    RefreshScheduler->ResetClient(SchedulerClientId);
+    SearchIndex.Reset();
+    Memory.Reset();
+    NodeMemory.Reset();
+    SortedRootItems.Reset();
+    LastMemoryTime = 0.0;
+    ClearFilter();
+    SearchBox->SetText(FText::GetEmpty());
+
     CurrentObject = Object;
+    Inspection.SetObject(Object);
+    RefreshRootItems();
 
     if (IsValid(Object) == false)
     {
@@ -85,124 +266,1116 @@ void SActorDebuggerWidget::SetObject(UObject* Object)
 
     ActorNameTextBlock->SetText(FText::FromString(Object->GetName()));
     ActorClassNameTextBlock->SetText(FText::FromString(Object->GetClass()->GetName()));
-    
-    GatherProperties(RootItems, CurrentObject);
 
     PropertiesView->RequestListRefresh();
 }
 
 /*
-* Gathers the properties of the currently selected actor. 
-* Places them in the ItemsToFill TArray
-* ContainerObject is the UObject that should be reflected
+* Slate widgets don't typically implement a Tick method so we create a FTSTicker which calls this method
+* every frame. The inspection tells us when the selected object goes away, until the window that owns this
+* widget is destroyed we keep asking the library to destroy it. Otherwise it picks up the values formatted
+* since the last tick and lets the scheduler sample as many rows as fit in this frame's budget. The tick times
+* itself for the overhead readout
 */
-void SActorDebuggerWidget::GatherProperties(TArray<FReflectedActorPropertyPtr>& ItemsToFill, UObject* ContainerObject)
+bool SActorDebuggerWidget::HandleTicker(float DeltaTime)
 {
-    if (!ContainerObject)
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_Tick);
+
+    if (Inspection.IsObjectAlive() == false)
     {
-        return;
+        RequestClose.Broadcast();
     }
-
-    // Iterate through all properties of the actor
-    for (TFieldIterator<FProperty> PropIt(ContainerObject->GetClass()); PropIt; ++PropIt)
+    else
     {
-        FProperty* Property = *PropIt;
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+
+        HistoryRecorder.RecordFrame(FPlatformTime::Seconds());
+        Watchpoints.Evaluate();
+
+        // diffs of live objects capture the whole graph, they are refreshed about once a second rather than every frame
+        if (bDiffActive && IsDiffLive() && FPlatformTime::Seconds() - LastDiffTime >= 1.0)
+        {
+            RefreshDiff();
+        }
+
+        if (CaptureWriter.IsValid())
+        {
+            CaptureWriter->CaptureFrame(FPlatformTime::Seconds());
+        }
+
+        if (CallTraceId != INDEX_NONE)
+        {
+            CollectCalls();
+        }
+
+        // measuring walks the whole graph, like live diffs it is refreshed about once a second
+        if (bShowMemory && FPlatformTime::Seconds() - LastMemoryTime >= 1.0)
+        {
+            UpdateMemory();
+        }
 
-        // Blueprint visible properties are likely to be the most useful ones to display
-        if (Property && Property->HasAnyPropertyFlags(CPF_BlueprintVisible))
+        // the frame being viewed may have been overwritten by frames recorded since
+        if (bScrubbing && ScrubFrame < HistoryRecorder.GetFirstFrame())
         {
-            auto ReflectedProperty = MakeShared<FReflectedActorProperty>(ContainerObject, Property->GetName() );
+            ScrubTo(HistoryRecorder.GetFirstFrame());
+        }
+
+        TArray<TPair<FReflectedActorPropertyPtr, FText>> FormattedValues;
+        FormatPipeline->CollectResults(FormattedValues);
 
-            if (UObject* ChildContainerObject = TryGetUObjectValue(ContainerObject, Property); 
-                ChildContainerObject && IsUObjectOfInterest(ChildContainerObject))
+        for (const TPair<FReflectedActorPropertyPtr, FText>& FormattedValue : FormattedValues)
+        {
+            if (const TWeakPtr<SReflectedPropertyTableRow>* Row = VisibleRows.Find(FormattedValue.Key); Row && Row->IsValid())
             {
-                GatherProperties(ReflectedProperty->Children, ChildContainerObject);
+                Row->Pin()->SetValueText(FormattedValue.Value);
             }
 
-            ItemsToFill.Add(ReflectedProperty);
+            SearchIndex.SetValue(FormattedValue.Key, FormattedValue.Value.ToString());
+        }
+
+        // the first debugger to tick this frame samples the rows of every debugger
+        RefreshScheduler->TickOncePerFrame();
+        FormatPipeline->Dispatch();
+
+        // the filter is applied again whenever the index found new nodes or values, results fill in as it crawls
+        if (FilterText.IsEmpty() == false && SearchIndex.Tick(Inspection))
+        {
+            ApplyFilter();
+        }
+
+        if (bContainersChanged)
+        {
+            // the nodes of the old elements may have been reused for others
+            bContainersChanged = false;
+            NodeMemory.Reset();
+            PropertiesView->RequestTreeRefresh();
         }
+
+        LastTickMicroseconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles) * 1000000.0;
+        AverageTickMicroseconds = FMath::Lerp(AverageTickMicroseconds, LastTickMicroseconds, 0.05);
+        UpdateOverheadReadout();
     }
+
+    return true;
 }
 
 /*
-* If the given property is a FObjectProperty then this will return any UObject that it points to
-* If not, returns nullptr
-* 'ParentContainer' is the UObject that owns the property
+* Called by the inspection during the engine event that took objects of the tree with it, so nothing is sampled
+* in between. The inspection has already unlinked the subtrees of those objects and the tree only needs
+* refreshing, their rows are released when it rebuilds. Losing the selected object closes the window, unless it
+* was reinstanced, in which case its replacement is selected instead
 */
-UObject* SActorDebuggerWidget::TryGetUObjectValue(UObject* ParentContainer, FProperty* Property)
+void SActorDebuggerWidget::HandleObjectsInvalidated(bool bRootInvalidated, UObject* RootReplacement)
 {
-    auto* ObjectProperty = CastField<FObjectProperty>(Property);
+    if (bRootInvalidated == false)
+    {
+        NodeMemory.Reset();
+        PropertiesView->RequestTreeRefresh();
+        return;
+    }
 
-    if (ObjectProperty == nullptr)
+    if (IsValid(RootReplacement))
     {
-        return nullptr;
+        SetObject(RootReplacement);
+        return;
+    }
+
+    StopCapture();
+    StopCallTrace();
+    FormatPipeline->Reset();
+    RequestClose.Broadcast();
+}
+
+/*
+* Refreshes the readout a few times a second, setting the text every frame would invalidate the header for no
+* benefit. The memory counter is updated with the change since the last readout so that several widgets can
+* report into it at once
+*/
+void SActorDebuggerWidget::UpdateOverheadReadout()
+{
+    const double CurrentTime = FPlatformTime::Seconds();
+    if (CurrentTime - LastReadoutTime < 0.25)
+    {
+        return;
     }
+    LastReadoutTime = CurrentTime;
 
-    TObjectPtr<UObject> ChildObject;
-    ObjectProperty->GetValue_InContainer(ParentContainer, &ChildObject);
+    const int64 MemoryHeld = Inspection.GetAllocatedSize() + FormatPipeline->GetAllocatedSize() + VisibleRows.GetAllocatedSize() + HistoryRecorder.GetAllocatedSize()
+        + SearchIndex.GetAllocatedSize() + Watchpoints.GetAllocatedSize() + Memory.GetAllocatedSize() + NodeMemory.GetAllocatedSize() + SortedRootItems.GetAllocatedSize();
+    INC_MEMORY_STAT_BY(STAT_ActorDebugger_MemoryHeld, MemoryHeld - ReportedMemory);
+    ReportedMemory = MemoryHeld;
 
-    return ChildObject;
+    OverheadTextBlock->SetText(FText::FromString(FString::Printf(TEXT("%.2f ms (avg %.2f ms) | %d nodes | %d rows | %.1f KB"),
+        LastTickMicroseconds / 1000.0, AverageTickMicroseconds / 1000.0, Inspection.GetNumNodes(), VisibleRows.Num(), MemoryHeld / 1024.0)));
 }
 
 /*
-* Returns a boolean that indicates if we want to iterate over the properties of this UObject
+* Compares the value bytes of a row's property against the hash taken when it was last exported. Changed
+* values are queued for formatting and their rows are refreshed when the text comes back. Rows that scroll
+* back into view are checked when they are generated
 */
-bool SActorDebuggerWidget::IsUObjectOfInterest(UObject* Object)
+bool SActorDebuggerWidget::SampleItem(const FReflectedActorPropertyPtr& Item)
 {
-    // don't iterate over AActor properties, this opens us up to circular dependencies
-    if (Object->IsA(AActor::StaticClass()))
+    // recorded rows display the frame being scrubbed, not the live value
+    if (bScrubbing && Item->bRecorded)
     {
         return false;
     }
 
-    // don't iterate over Asset properties, probably not useful
-    if (IsAssetObject(Object))
+    const uint64 PreviousHash = Item->ValueHash;
+
+    // values that are queued on the pipeline report no change now, their rows are refreshed once formatted
+    FText ValueText;
+    if (SActorPropertyWidget::UpdateValue(Item, FormatPipeline.Get(), ValueText))
     {
-        return false;
+        if (const TWeakPtr<SReflectedPropertyTableRow>* Row = VisibleRows.Find(Item); Row && Row->IsValid())
+        {
+            Row->Pin()->SetValueText(ValueText);
+        }
+
+        SearchIndex.SetValue(Item, ValueText.ToString());
+
+        // a container's value only changes when its element count does, its elements need gathering again
+        bContainersChanged |= Inspection.RefreshContainerChildren(Item);
     }
 
-    return true;
+    return Item->ValueHash != PreviousHash;
 }
 
 /*
-* Checks for some object flags that are intended to check if an object is an asset type or not
-* UE does not have a UAsset class which would be a preferred method but this method appears to work
-* correctly
+* The tree view only asks for rows that are in view, we keep track of them so that refreshes can be
+* restricted to those rows
 */
-bool SActorDebuggerWidget::IsAssetObject(UObject* Object)
+TSharedRef<ITableRow> SActorDebuggerWidget::HandleGenerateRow(FReflectedActorPropertyPtr Item, const TSharedRef<STableViewBase>& OwnerTree)
 {
-    if (!Object)
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_GenerateRow);
+
+    TSharedRef<SReflectedPropertyTableRow> Row = SNew(SReflectedPropertyTableRow, OwnerTree)
+        .ReflectedProperty(Item)
+        .FormatPipeline(FormatPipeline);
+
+    if (VisibleRows.Contains(Item) == false)
     {
-        return false;
+        INC_DWORD_STAT(STAT_ActorDebugger_Rows);
+    }
+
+    VisibleRows.Add(Item, Row);
+    RefreshScheduler->AddItem(SchedulerClientId, Item);
+
+    Item->DiffKind = bDiffActive ? Diff.Find(FActorDebuggerSnapshots::GetItemPath(Item)) : EActorDebuggerDiffKind::None;
+
+    if (bScrubbing && Item->bRecorded)
+    {
+        ApplyScrubbedValues();
+    }
+
+    if (bShowMemory)
+    {
+        UpdateRowMemory(Item, *Row);
+    }
+
+    return Row;
+}
+
+void SActorDebuggerWidget::HandleRowReleased(const TSharedRef<ITableRow>& Row)
+{
+    const FReflectedActorPropertyPtr Item = StaticCastSharedRef<SReflectedPropertyTableRow>(Row)->GetReflectedProperty();
+
+    if (VisibleRows.Remove(Item) > 0)
+    {
+        DEC_DWORD_STAT(STAT_ActorDebugger_Rows);
     }
-    
-    // Assets typically have these flags
-    bool bHasAssetFlags = Object->HasAnyFlags(RF_Public | RF_Standalone);
-    
-    // Assets should not have these flags
-    bool bHasNonAssetFlags = Object->HasAnyFlags(RF_Transient | RF_ArchetypeObject | RF_ClassDefaultObject);
-    
-    return bHasAssetFlags && !bHasNonAssetFlags;
+    RefreshScheduler->RemoveItem(Item);
 }
 
 /*
-* Slate widgets don't typically implement a Tick method so we create a FTSTicker which calls this method
-* periodically. It checks if the selected actor has been destroyed and prompts the library to destroy the
-* window that owns this widget if so. If not, it will request a refresh of the Tree View which will]
-* update the currently rendered widgets
+* Children are only gathered once the tree reaches an item. While filtering, the ancestors of matches only show the
+* children that lead to a match, while the matches themselves show all of their children. Sorting by memory orders
+* every level the tree asks for, the inspection keeps its own order
 */
-bool SActorDebuggerWidget::HandleTicker(float DeltaTime)
+void SActorDebuggerWidget::HandleGetChildren(FReflectedActorPropertyPtr Item, TArray<FReflectedActorPropertyPtr>& OutChildren)
 {
-    if (IsValid(CurrentObject) == false)
+    Inspection.GetChildren(Item, OutChildren);
+
+    if (FilterText.IsEmpty() == false && FilterVisibleItems.Contains(Item) && FilterMatches.Contains(Item) == false)
     {
-        RequestClose.Broadcast();
+        OutChildren.RemoveAll([this](FReflectedActorPropertyPtr Child) { return FilterVisibleItems.Contains(Child) == false; });
+    }
+
+    if (bShowMemory && bSortByMemory)
+    {
+        SortByMemory(OutChildren);
+    }
+}
+
+/*
+* The index is ticked once straight away so the first results don't wait for the next frame
+*/
+void SActorDebuggerWidget::HandleSearchTextChanged(const FText& Text)
+{
+    const FString NewFilterText = Text.ToString().TrimStartAndEnd();
+    if (NewFilterText == FilterText)
+    {
+        return;
+    }
+
+    if (NewFilterText.IsEmpty())
+    {
+        ClearFilter();
+        PropertiesView->RequestTreeRefresh();
+        return;
+    }
+
+    if (FilterText.IsEmpty())
+    {
+        PropertiesView->SetTreeItemsSource(&FilteredRootItems);
+    }
+
+    FilterText = NewFilterText;
+    SearchIndex.Tick(Inspection);
+    ApplyFilter();
+}
+
+/*
+* Every ancestor of a match is made visible and expanded. Ancestors that were already visible keep whatever
+* expansion the user gave them
+*/
+void SActorDebuggerWidget::ApplyFilter()
+{
+    TArray<FReflectedActorPropertyPtr> Matches;
+    SearchIndex.Search(FilterText, Matches);
+
+    TSet<FReflectedActorPropertyPtr> VisibleItems;
+    VisibleItems.Reserve(Matches.Num() * 2);
+
+    for (FReflectedActorPropertyPtr Match : Matches)
+    {
+        for (FReflectedActorPropertyPtr Item = Match; Item; Item = Item->Parent)
+        {
+            bool bAlreadyVisible = false;
+            VisibleItems.Add(Item, &bAlreadyVisible);
+
+            // its ancestors were added along with it
+            if (bAlreadyVisible)
+            {
+                break;
+            }
+
+            if (Item != Match && FilterVisibleItems.Contains(Item) == false)
+            {
+                PropertiesView->SetItemExpansion(Item, true);
+            }
+        }
+    }
+
+    FilteredRootItems.Reset();
+    for (FReflectedActorPropertyPtr RootItem : Inspection.GetRootItems())
+    {
+        if (VisibleItems.Contains(RootItem))
+        {
+            FilteredRootItems.Add(RootItem);
+        }
+    }
+
+    if (bShowMemory && bSortByMemory)
+    {
+        SortByMemory(FilteredRootItems);
+    }
+
+    FilterVisibleItems = MoveTemp(VisibleItems);
+    FilterMatches = TSet<FReflectedActorPropertyPtr>(Matches);
+    PropertiesView->RequestTreeRefresh();
+}
+
+void SActorDebuggerWidget::ClearFilter()
+{
+    FilterText.Reset();
+    FilteredRootItems.Reset();
+    FilterVisibleItems.Reset();
+    FilterMatches.Reset();
+    RefreshRootItems();
+}
+
+/*
+* Without a filter the tree shows the inspection's root items, or a sorted copy of them while sorting by memory.
+* With one the filter is applied again, it sorts what it finds
+*/
+void SActorDebuggerWidget::RefreshRootItems()
+{
+    if (FilterText.IsEmpty() == false)
+    {
+        ApplyFilter();
+        return;
+    }
+
+    if (bShowMemory && bSortByMemory)
+    {
+        SortedRootItems = Inspection.GetRootItems();
+        SortByMemory(SortedRootItems);
+        PropertiesView->SetTreeItemsSource(&SortedRootItems);
     }
     else
     {
-        PropertiesView->RequestListRefresh();
+        SortedRootItems.Reset();
+        PropertiesView->SetTreeItemsSource(&Inspection.GetRootItems());
     }
+    PropertiesView->RequestTreeRefresh();
+}
 
-    return true;
+/*
+* The schema entries held by the tree items point at FProperty objects that may have been regenerated by a
+* hot reload or a Blueprint compile, so the whole tree is gathered again from fresh schemas
+*/
+void SActorDebuggerWidget::HandleSchemasInvalidated()
+{
+    SetObject(CurrentObject);
+}
+
+/*
+* Right clicking a row selects it, so the menu acts on the selection. The condition box applies its condition to
+* every selected row when Enter is pressed and keeps the menu open to show why a condition doesn't fit
+*/
+TSharedPtr<SWidget> SActorDebuggerWidget::HandleContextMenuOpening()
+{
+    const TArray<FReflectedActorPropertyPtr> SelectedItems = PropertiesView->GetSelectedItems();
+    if (SelectedItems.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    const bool bAnyWatched = SelectedItems.ContainsByPredicate([](FReflectedActorPropertyPtr Item) { return Item->bWatched; });
+
+    FMenuBuilder MenuBuilder(true, nullptr);
+    MenuBuilder.BeginSection(NAME_None, FText::FromString("Watchpoint"));
+
+    MenuBuilder.AddMenuEntry(
+        FText::FromString("Break on change"),
+        FText::FromString("Pauses play and logs the value whenever it changes"),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateLambda([this]
+        {
+            FText Error;
+            AddWatchpoints(FString(), EActorDebuggerWatchAction::Log | EActorDebuggerWatchAction::Pause, Error);
+        })));
+
+    MenuBuilder.AddMenuEntry(
+        FText::FromString("Log changes"),
+        FText::FromString("Logs the value whenever it changes"),
+        FSlateIcon(),
+        FUIAction(FExecuteAction::CreateLambda([this]
+        {
+            FText Error;
+            AddWatchpoints(FString(), EActorDebuggerWatchAction::Log, Error);
+        })));
+
+    TSharedPtr<SEditableTextBox> ConditionTextBox;
+    MenuBuilder.AddWidget(
+        SAssignNew(ConditionTextBox, SEditableTextBox)
+            .MinDesiredWidth(160.0f)
+            .HintText(FText::FromString("e.g. < 10 or == true"))
+            .ToolTipText(FText::FromString("Pauses play and logs the value when the condition becomes true"))
+            .OnTextCommitted_Lambda([this, WeakTextBox = TWeakPtr<SEditableTextBox>(ConditionTextBox)](const FText& Text, ETextCommit::Type CommitType)
+            {
+                TSharedPtr<SEditableTextBox> TextBox = WeakTextBox.Pin();
+                if (CommitType != ETextCommit::OnEnter || TextBox.IsValid() == false)
+                {
+                    return;
+                }
+
+                FText Error;
+                if (AddWatchpoints(Text.ToString(), EActorDebuggerWatchAction::Log | EActorDebuggerWatchAction::Pause, Error))
+                {
+                    FSlateApplication::Get().DismissAllMenus();
+                }
+                else
+                {
+                    TextBox->SetError(Error);
+                }
+            }),
+        FText::FromString("Break when"));
+
+    if (bAnyWatched)
+    {
+        MenuBuilder.AddMenuEntry(
+            FText::FromString("Capture callstack"),
+            FText::FromString("Also dumps the callstack to the log when the watchpoint triggers"),
+            FSlateIcon(),
+            FUIAction(
+                FExecuteAction::CreateSP(this, &SActorDebuggerWidget::ToggleWatchpointCallstack),
+                FCanExecuteAction(),
+                FIsActionChecked::CreateSP(this, &SActorDebuggerWidget::IsWatchpointCallstackEnabled)),
+            NAME_None,
+            EUserInterfaceActionType::ToggleButton);
+
+        MenuBuilder.AddMenuEntry(
+            FText::FromString("Remove watchpoint"),
+            FText::GetEmpty(),
+            FSlateIcon(),
+            FUIAction(FExecuteAction::CreateSP(this, &SActorDebuggerWidget::RemoveWatchpoints)));
+    }
+
+    MenuBuilder.EndSection();
+    return MenuBuilder.MakeWidget();
+}
+
+/*
+* Watches every selected row, keeping the callstack option of rows that were already watched. Returns false if
+* the condition doesn't fit one of the rows, the rows it does fit are watched anyway
+*/
+bool SActorDebuggerWidget::AddWatchpoints(const FString& Condition, EActorDebuggerWatchAction Actions, FText& OutError)
+{
+    bool bAllAdded = true;
+
+    for (FReflectedActorPropertyPtr Item : PropertiesView->GetSelectedItems())
+    {
+        EActorDebuggerWatchAction ItemActions = Actions;
+        if (const FActorDebuggerWatchpoint* Existing = Watchpoints.Find(Item))
+        {
+            ItemActions |= Existing->Actions & EActorDebuggerWatchAction::Callstack;
+        }
+
+        FText Error;
+        if (Watchpoints.Add(Item, Condition, ItemActions, Error) == false)
+        {
+            UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: can't watch %s: %s"), *Item->GetDisplayName().ToString(), *Error.ToString());
+            OutError = Error;
+            bAllAdded = false;
+        }
+    }
+
+    return bAllAdded;
+}
+
+void SActorDebuggerWidget::RemoveWatchpoints()
+{
+    for (FReflectedActorPropertyPtr Item : PropertiesView->GetSelectedItems())
+    {
+        Watchpoints.Remove(Item);
+    }
+}
+
+void SActorDebuggerWidget::ToggleWatchpointCallstack()
+{
+    const bool bEnable = IsWatchpointCallstackEnabled() == false;
+
+    for (FReflectedActorPropertyPtr Item : PropertiesView->GetSelectedItems())
+    {
+        if (const FActorDebuggerWatchpoint* Watchpoint = Watchpoints.Find(Item))
+        {
+            Watchpoints.SetActions(Item, bEnable ? Watchpoint->Actions | EActorDebuggerWatchAction::Callstack : Watchpoint->Actions & ~EActorDebuggerWatchAction::Callstack);
+        }
+    }
+}
+
+bool SActorDebuggerWidget::IsWatchpointCallstackEnabled() const
+{
+    for (FReflectedActorPropertyPtr Item : PropertiesView->GetSelectedItems())
+    {
+        if (const FActorDebuggerWatchpoint* Watchpoint = Watchpoints.Find(Item))
+        {
+            return EnumHasAnyFlags(Watchpoint->Actions, EActorDebuggerWatchAction::Callstack);
+        }
+    }
+    return false;
+}
+
+/*
+* Starts recording the selected rows, or stops the recording in progress. Stopping keeps the recording so it can
+* still be scrubbed, starting a new one throws the previous one away
+*/
+FReply SActorDebuggerWidget::HandleRecordClicked()
+{
+    if (HistoryRecorder.IsRecording())
+    {
+        HistoryRecorder.Stop();
+        return FReply::Handled();
+    }
+
+    HandleLiveClicked();
+
+    const int32 NumChannels = HistoryRecorder.Start(PropertiesView->GetSelectedItems());
+    if (NumChannels == 0)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: select the properties to record first"));
+    }
+
+    return FReply::Handled();
+}
+
+/*
+* Puts every recorded row back to its live value
+*/
+FReply SActorDebuggerWidget::HandleLiveClicked()
+{
+    if (bScrubbing == false)
+    {
+        return FReply::Handled();
+    }
+
+    bScrubbing = false;
+
+    for (int32 Channel = 0; Channel < HistoryRecorder.GetNumChannels(); ++Channel)
+    {
+        FReflectedActorPropertyPtr Item = HistoryRecorder.GetChannelItem(Channel);
+        Item->bHasValue = false;
+
+        FText ValueText;
+        if (SActorPropertyWidget::UpdateValue(Item, nullptr, ValueText))
+        {
+            if (const TWeakPtr<SReflectedPropertyTableRow>* Row = VisibleRows.Find(Item); Row && Row->IsValid())
+            {
+                Row->Pin()->SetValueText(ValueText);
+            }
+        }
+    }
+
+    return FReply::Handled();
+}
+
+void SActorDebuggerWidget::HandleTimelineChanged(float Value)
+{
+    if (CaptureReader.IsValid())
+    {
+        SeekCapture(FMath::RoundToInt32(Value * (CaptureReader->GetNumFrames() - 1)));
+        return;
+    }
+
+    if (HistoryRecorder.HasHistory() == false)
+    {
+        return;
+    }
+
+    const uint64 FirstFrame = HistoryRecorder.GetFirstFrame();
+    ScrubTo(FirstFrame + FMath::RoundToInt32(Value * (HistoryRecorder.GetNumFrames() - 1)));
+}
+
+void SActorDebuggerWidget::ScrubTo(uint64 Frame)
+{
+    bScrubbing = true;
+    ScrubFrame = Frame;
+    ApplyScrubbedValues();
+}
+
+/*
+* Shows the scrubbed frame's value on the rows of every recorded property that is in view. Rows that come into
+* view while scrubbing are given the scrubbed value when they are generated
+*/
+void SActorDebuggerWidget::ApplyScrubbedValues()
+{
+    for (int32 Channel = 0; Channel < HistoryRecorder.GetNumChannels(); ++Channel)
+    {
+        const TWeakPtr<SReflectedPropertyTableRow>* Row = VisibleRows.Find(HistoryRecorder.GetChannelItem(Channel));
+
+        FText ValueText;
+        if (Row && Row->IsValid() && HistoryRecorder.FormatValue(Channel, ScrubFrame, ValueText))
+        {
+            Row->Pin()->SetValueText(ValueText);
+        }
+    }
+}
+
+FText SActorDebuggerWidget::GetRecordButtonText() const
+{
+    return FText::FromString(HistoryRecorder.IsRecording() ? "Stop" : "Record");
+}
+
+float SActorDebuggerWidget::GetTimelineValue() const
+{
+    if (CaptureReader.IsValid())
+    {
+        return CaptureReader->GetNumFrames() > 1 ? static_cast<float>(CaptureFrame) / (CaptureReader->GetNumFrames() - 1) : 1.0f;
+    }
+
+    const int32 NumFrames = HistoryRecorder.GetNumFrames();
+    if (bScrubbing == false || NumFrames < 2)
+    {
+        return 1.0f;
+    }
+
+    return static_cast<float>(ScrubFrame - HistoryRecorder.GetFirstFrame()) / (NumFrames - 1);
+}
+
+/*
+* Times are shown relative to the newest recorded frame
+*/
+FText SActorDebuggerWidget::GetTimelineText() const
+{
+    if (CaptureReader.IsValid())
+    {
+        return FText::FromString(FString::Printf(TEXT("Frame %d / %d (%.3f s)"), CaptureFrame + 1, CaptureReader->GetNumFrames(),
+            CaptureReader->GetFrameTime(CaptureFrame) - CaptureReader->GetFrameTime(0)));
+    }
+
+    if (bScrubbing == false)
+    {
+        return FText::FromString(HistoryRecorder.IsRecording() ? "Recording" : "Live");
+    }
+
+    double ScrubTime = 0.0;
+    double LastTime = 0.0;
+    if (HistoryRecorder.GetFrameTime(ScrubFrame, ScrubTime) == false || HistoryRecorder.GetFrameTime(HistoryRecorder.GetEndFrame() - 1, LastTime) == false)
+    {
+        return FText::GetEmpty();
+    }
+
+    return FText::FromString(FString::Printf(TEXT("%.3f s"), ScrubTime - LastTime));
+}
+
+bool SActorDebuggerWidget::IsTimelineEnabled() const
+{
+    return CaptureReader.IsValid() || HistoryRecorder.HasHistory();
+}
+
+/*
+* Captures the inspected object along with the objects it references. The capture keeps going until it is stopped
+* or another object is selected
+*/
+bool SActorDebuggerWidget::StartCapture(const FString& Filename)
+{
+    StopCapture();
+
+    if (IsValid(CurrentObject) == false)
+    {
+        UE_LOG(LogActorDebugger, Warning, TEXT("Actor Debugger: select an object to capture first"));
+        return false;
+    }
+
+    CaptureWriter = MakeUnique<FActorDebuggerCaptureWriter>();
+    if (CaptureWriter->Open(Filename) == false)
+    {
+        CaptureWriter.Reset();
+        return false;
+    }
+
+    CaptureWriter->AddObjectGraph(CurrentObject);
+    UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: capturing %s to %s"), *CurrentObject->GetName(), *Filename);
+    return true;
+}
+
+void SActorDebuggerWidget::StopCapture()
+{
+    if (CaptureWriter.IsValid())
+    {
+        UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: captured %d frames, %.1f MB"), CaptureWriter->GetNumFrames(), CaptureWriter->GetFileSize() / (1024.0 * 1024.0));
+        CaptureWriter.Reset();
+    }
+}
+
+/*
+* The replay objects are ordinary transient objects, so the tree, the scheduler and the history recorder all work
+* on a replay exactly as they do on a live object. Seeking writes the frame's values into the replay objects and
+* the rows pick the changes up as they are sampled
+*/
+bool SActorDebuggerWidget::OpenCapture(const FString& Filename)
+{
+    TUniquePtr<FActorDebuggerCaptureReader> Reader = MakeUnique<FActorDebuggerCaptureReader>();
+    if (Reader->Open(Filename) == false)
+    {
+        return false;
+    }
+
+    UObject* ReplayObject = Reader->CreateReplayObjects();
+    if (ReplayObject == nullptr || Reader->ApplyFrame(0) == false)
+    {
+        return false;
+    }
+
+    SetObject(ReplayObject);
+
+    // set after selecting the replay object, selecting an object closes any capture being replayed
+    CaptureReader = MoveTemp(Reader);
+    CaptureFrame = 0;
+    return true;
+}
+
+void SActorDebuggerWidget::SeekCapture(int32 Frame)
+{
+    Frame = FMath::Clamp(Frame, 0, CaptureReader->GetNumFrames() - 1);
+    if (Frame != CaptureFrame && CaptureReader->ApplyFrame(Frame))
+    {
+        CaptureFrame = Frame;
+    }
+}
+
+FActorDebuggerSnapshotPtr SActorDebuggerWidget::TakeSnapshot(const FString& Name)
+{
+    FActorDebuggerSnapshotPtr Snapshot = FActorDebuggerSnapshots::Get().Take(CurrentObject, Name);
+    if (Snapshot.IsValid())
+    {
+        UE_LOG(LogActorDebugger, Log, TEXT("Actor Debugger: took snapshot %s of %s, %d nodes, %d held by every snapshot"),
+            *Snapshot->Name, *Snapshot->ObjectName, Snapshot->NumNodes, FActorDebuggerSnapshots::Get().GetNumUniqueNodes());
+    }
+    return Snapshot;
+}
+
+/*
+* A single name is looked up as a snapshot first and then as an object of the inspected object's class in its
+* world. The inspected object is always the new side of the diff unless two snapshots are compared
+*/
+bool SActorDebuggerWidget::ShowDiff(const FString& Target, FText& OutError)
+{
+    ClearDiff();
+
+    if (IsValid(CurrentObject) == false)
+    {
+        OutError = FText::FromString("Select an object to compare first");
+        return false;
+    }
+
+    TArray<FString> Names;
+    Target.ParseIntoArrayWS(Names);
+    if (Names.Num() == 0 || Names.Num() > 2)
+    {
+        OutError = FText::FromString("Enter a snapshot, two snapshots or the name of another object of the same class");
+        return false;
+    }
+
+    FActorDebuggerSnapshots& Snapshots = FActorDebuggerSnapshots::Get();
+
+    if (Names.Num() == 2)
+    {
+        DiffOldSnapshot = Snapshots.Find(Names[0]);
+        DiffNewSnapshot = Snapshots.Find(Names[1]);
+        if (DiffOldSnapshot.IsValid() == false || DiffNewSnapshot.IsValid() == false)
+        {
+            OutError = FText::FromString(FString::Printf(TEXT("There is no snapshot named %s"), DiffOldSnapshot.IsValid() ? *Names[1] : *Names[0]));
+            ClearDiff();
+            return false;
+        }
+    }
+    else if ((DiffOldSnapshot = Snapshots.Find(Names[0])).IsValid() == false)
+    {
+        TArray<UObject*> Objects;
+        FActorDebuggerQuery::GatherObjects(CurrentObject->GetClass(), CurrentObject->GetWorld(), Objects);
+
+        UObject** OtherObject = Objects.FindByPredicate([this, &Names](const UObject* Object) { return Object != CurrentObject && Object->GetName() == Names[0]; });
+        if (OtherObject == nullptr)
+        {
+            OutError = FText::FromString(FString::Printf(TEXT("There is no snapshot or %s named %s"), *CurrentObject->GetClass()->GetName(), *Names[0]));
+            return false;
+        }
+
+        DiffOtherObject = *OtherObject;
+        bDiffAgainstObject = true;
+    }
+
+    bDiffActive = true;
+    RefreshDiff();
+
+    if (bDiffActive == false)
+    {
+        OutError = FText::FromString("The objects to compare no longer exist");
+    }
+    return bDiffActive;
+}
+
+void SActorDebuggerWidget::ClearDiff()
+{
+    bDiffActive = false;
+    bDiffAgainstObject = false;
+    DiffOldSnapshot.Reset();
+    DiffNewSnapshot.Reset();
+    DiffOtherObject.Reset();
+    Diff.Reset();
+
+    DiffSummaryTextBlock->SetText(FText::GetEmpty());
+    MarkDiffRows();
+}
+
+bool SActorDebuggerWidget::IsDiffLive() const
+{
+    return bDiffAgainstObject || DiffNewSnapshot.IsValid() == false;
+}
+
+/*
+* Captures the live sides of the diff and compares them. Capturing an object that didn't change much since it was
+* last captured reuses the nodes of the previous capture, and the comparison only walks the subtrees that differ
+*/
+void SActorDebuggerWidget::RefreshDiff()
+{
+    LastDiffTime = FPlatformTime::Seconds();
+
+    FActorDebuggerSnapshots& Snapshots = FActorDebuggerSnapshots::Get();
+    FActorDebuggerSnapshotPtr Old = bDiffAgainstObject ? Snapshots.Capture(DiffOtherObject.Get()) : DiffOldSnapshot;
+    FActorDebuggerSnapshotPtr New = DiffNewSnapshot.IsValid() ? DiffNewSnapshot : Snapshots.Capture(CurrentObject);
+
+    // the other object was destroyed
+    if (Old.IsValid() == false || New.IsValid() == false)
+    {
+        ClearDiff();
+        return;
+    }
+
+    FActorDebuggerSnapshots::Diff(*Old, *New, Diff);
+
+    int32 NumChanged = 0;
+    int32 NumAdded = 0;
+    int32 NumRemoved = 0;
+    for (const FActorDebuggerDiffEntry& Entry : Diff.Entries)
+    {
+        NumChanged += Entry.Kind == EActorDebuggerDiffKind::Changed ? 1 : 0;
+        NumAdded += Entry.Kind == EActorDebuggerDiffKind::Added ? 1 : 0;
+        NumRemoved += Entry.Kind == EActorDebuggerDiffKind::Removed ? 1 : 0;
+    }
+
+    DiffSummaryTextBlock->SetText(FText::FromString(FString::Printf(TEXT("%d changed, %d added, %d removed (%d of %d nodes compared)"),
+        NumChanged, NumAdded, NumRemoved, Diff.NumCompared, New->NumNodes)));
+
+    MarkDiffRows();
+}
+
+/*
+* Only the rows in view are marked, rows are marked as they are generated
+*/
+void SActorDebuggerWidget::MarkDiffRows()
+{
+    for (const TPair<FReflectedActorPropertyPtr, TWeakPtr<SReflectedPropertyTableRow>>& Row : VisibleRows)
+    {
+        Row.Key->DiffKind = bDiffActive ? Diff.Find(FActorDebuggerSnapshots::GetItemPath(Row.Key)) : EActorDebuggerDiffKind::None;
+    }
+}
+
+FReply SActorDebuggerWidget::HandleSnapshotClicked()
+{
+    if (FActorDebuggerSnapshotPtr Snapshot = TakeSnapshot(FString()))
+    {
+        DiffSummaryTextBlock->SetText(FText::FromString(FString::Printf(TEXT("Took %s"), *Snapshot->Name)));
+    }
+    return FReply::Handled();
+}
+
+void SActorDebuggerWidget::HandleDiffTextCommitted(const FText& Text, ETextCommit::Type CommitType)
+{
+    if (CommitType != ETextCommit::OnEnter)
+    {
+        return;
+    }
+
+    if (Text.IsEmpty())
+    {
+        ClearDiff();
+        return;
+    }
+
+    FText Error;
+    if (ShowDiff(Text.ToString(), Error) == false)
+    {
+        DiffSummaryTextBlock->SetText(Error);
+    }
+}
+
+/*
+* A trace started by another window replaces ours, this widget stops collecting but keeps the calls it listed
+*/
+bool SActorDebuggerWidget::StartCallTrace()
+{
+    FActorDebuggerCallTracer& Tracer = FActorDebuggerCallTracer::Get();
+    if (Tracer.Start(CurrentObject) == false)
+    {
+        return false;
+    }
+
+    CallTraceId = Tracer.GetTraceId();
+    CallTimeline->Reset();
+    return true;
+}
+
+/*
+* The calls recorded before the trace stopped are still collected into the timeline
+*/
+void SActorDebuggerWidget::StopCallTrace()
+{
+    if (IsCallTracing())
+    {
+        FActorDebuggerCallTracer::Get().Stop();
+        CollectCalls();
+    }
+}
+
+bool SActorDebuggerWidget::IsCallTracing() const
+{
+    const FActorDebuggerCallTracer& Tracer = FActorDebuggerCallTracer::Get();
+    return CallTraceId != INDEX_NONE && CallTraceId == Tracer.GetTraceId() && Tracer.IsTracing();
+}
+
+/*
+* Runs every tick while this widget's trace is the tracer's current one, including after it stopped by itself so the
+* last calls it recorded are listed
+*/
+void SActorDebuggerWidget::CollectCalls()
+{
+    FActorDebuggerCallTracer& Tracer = FActorDebuggerCallTracer::Get();
+    if (Tracer.GetTraceId() != CallTraceId)
+    {
+        return;
+    }
+
+    CollectedCalls.Reset();
+    Tracer.Collect(CollectedCalls);
+    CallTimeline->AddCalls(CollectedCalls);
+}
+
+FReply SActorDebuggerWidget::HandleCallTraceClicked()
+{
+    if (IsCallTracing())
+    {
+        StopCallTrace();
+    }
+    else
+    {
+        StartCallTrace();
+    }
+    return FReply::Handled();
+}
+
+void SActorDebuggerWidget::SetMemoryShown(bool bShown)
+{
+    if (bShown == bShowMemory)
+    {
+        return;
+    }
+    bShowMemory = bShown;
+
+    if (bShowMemory)
+    {
+        HeaderRow->AddColumn(SHeaderRow::Column("MemorySize")
+            .DefaultLabel(FText::FromString("Size"))
+            .DefaultTooltip(FText::FromString("The bytes of the value, with the object's own bytes for a reference to an object first reached through it"))
+            .HAlignHeader(HAlign_Right)
+            .ManualWidth(130.0f));
+        HeaderRow->AddColumn(SHeaderRow::Column("MemoryRetained")
+            .DefaultLabel(FText::FromString("Retained"))
+            .DefaultTooltip(FText::FromString("Everything the property holds on to, the objects first reached through it included. Click to sort by it"))
+            .HAlignHeader(HAlign_Right)
+            .ManualWidth(90.0f)
+            .SortMode(this, &SActorDebuggerWidget::GetMemorySortMode)
+            .OnSort(this, &SActorDebuggerWidget::HandleMemorySort));
+        UpdateMemory();
+    }
+    else
+    {
+        HeaderRow->RemoveColumn("MemorySize");
+        HeaderRow->RemoveColumn("MemoryRetained");
+        Memory.Reset();
+        NodeMemory.Reset();
+    }
+
+    // rows generate their cells when they are built, the existing ones have no cells for the new columns
+    RefreshRootItems();
+    PropertiesView->RebuildList();
+}
+
+void SActorDebuggerWidget::SetSortByMemory(bool bSort)
+{
+    if (bSort == bSortByMemory)
+    {
+        return;
+    }
+    bSortByMemory = bSort;
+    RefreshRootItems();
+}
+
+/*
+* The results are only replaced when the measurement found something different, so the rows, the cache and the
+* order of the tree are left alone while nothing changes
+*/
+void SActorDebuggerWidget::UpdateMemory()
+{
+    LastMemoryTime = FPlatformTime::Seconds();
+
+    if (Memory.Update(CurrentObject) == false)
+    {
+        return;
+    }
+
+    NodeMemory.Reset();
+    for (const TPair<FReflectedActorPropertyPtr, TWeakPtr<SReflectedPropertyTableRow>>& VisibleRow : VisibleRows)
+    {
+        if (TSharedPtr<SReflectedPropertyTableRow> Row = VisibleRow.Value.Pin())
+        {
+            UpdateRowMemory(VisibleRow.Key, *Row);
+        }
+    }
+
+    if (bSortByMemory)
+    {
+        RefreshRootItems();
+    }
+}
+
+bool SActorDebuggerWidget::GetNodeMemory(const FReflectedActorPropertyPtr& Item, FActorDebuggerNodeMemory& OutMemory)
+{
+    if (const FActorDebuggerNodeMemory* Cached = NodeMemory.Find(Item))
+    {
+        OutMemory = *Cached;
+        return true;
+    }
+
+    if (Memory.MeasureNode(*Item, OutMemory) == false)
+    {
+        return false;
+    }
+
+    NodeMemory.Add(Item, OutMemory);
+    return true;
+}
+
+/*
+* The size names what most of it is when that isn't obvious: the resource size of an object, or the capacity a
+* container holds without using
+*/
+void SActorDebuggerWidget::UpdateRowMemory(const FReflectedActorPropertyPtr& Item, SReflectedPropertyTableRow& Row)
+{
+    FActorDebuggerNodeMemory ItemMemory;
+    if (GetNodeMemory(Item, ItemMemory) == false)
+    {
+        Row.SetMemoryText(FText::GetEmpty(), FText::GetEmpty());
+        return;
+    }
+
+    FString SizeText = FActorDebuggerMemory::FormatBytes(ItemMemory.GetSize());
+    if (ItemMemory.ObjectResourceSize > 0)
+    {
+        SizeText += FString::Printf(TEXT(" (%s resource)"), *FActorDebuggerMemory::FormatBytes(ItemMemory.ObjectResourceSize));
+    }
+    else if (ItemMemory.Value.GetSlack() > 0)
+    {
+        SizeText += FString::Printf(TEXT(" (%s unused)"), *FActorDebuggerMemory::FormatBytes(ItemMemory.Value.GetSlack()));
+    }
+
+    Row.SetMemoryText(FText::FromString(SizeText), FText::FromString(FActorDebuggerMemory::FormatBytes(ItemMemory.Retained)));
+}
+
+/*
+* Largest retained size first, ties keep the inspection's order. Rows that can't be measured go last
+*/
+void SActorDebuggerWidget::SortByMemory(TArray<FReflectedActorPropertyPtr>& Items)
+{
+    TMap<FReflectedActorPropertyPtr, int64> Retained;
+    Retained.Reserve(Items.Num());
+    for (const FReflectedActorPropertyPtr& Item : Items)
+    {
+        FActorDebuggerNodeMemory ItemMemory;
+        Retained.Add(Item, GetNodeMemory(Item, ItemMemory) ? ItemMemory.Retained : -1);
+    }
+
+    Items.StableSort([&Retained](const FReflectedActorPropertyPtr& A, const FReflectedActorPropertyPtr& B)
+    {
+        return Retained[A] > Retained[B];
+    });
+}
+
+EColumnSortMode::Type SActorDebuggerWidget::GetMemorySortMode() const
+{
+    return bSortByMemory ? EColumnSortMode::Descending : EColumnSortMode::None;
+}
+
+/*
+* Only the largest first order is useful, so clicking the column turns sorting on and off
+*/
+void SActorDebuggerWidget::HandleMemorySort(EColumnSortPriority::Type Priority, const FName& ColumnName, EColumnSortMode::Type Mode)
+{
+    SetSortByMemory(bSortByMemory == false);
 }
 
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
@@ -8,6 +8,9 @@
 #include "GameFramework/Actor.h"
 #include "UObject/UnrealType.h"
 #include "ActorDebuggerWidget.h"
+#include "ActorDebuggerFormatPipeline.h"
+#include "ActorDebuggerFormatters.h"
+#include "ActorDebuggerStats.h"
 
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
@@ -16,35 +19,106 @@ BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 */
 void SActorPropertyWidget::Construct(const FArguments& InArgs)
 {
+    PropertyPtr = InArgs._ReflectedProperty.Get();
+    FormatPipeline = InArgs._FormatPipeline;
+
+    // the row was (re)generated so there is no text to compare against, export the value now so the row is
+    // never displayed empty. Only rows in view are generated so this stays cheap
+    FText ValueText;
+    if (PropertyPtr)
+    {
+        PropertyPtr->bHasValue = false;
+        UpdateValue(PropertyPtr, nullptr, ValueText);
+    }
+
     ChildSlot
     [
-        SNew(STextBlock).Text(PropertyValueToText(InArgs._ReflectedProperty.Get()))
+        SAssignNew(ValueTextBlock, STextBlock).Text(ValueText)
     ];
 }
 
 /*
-* Converts the reflected property value to an FText. The method used seems to do a decent job of generically
-* converting the value to a human readable string
+* Called by the owning row when the debugger has a new value for the property.
+* Only this text block is invalidated, the rest of the tree is left alone
+*/
+void SActorPropertyWidget::SetValueText(const FText& ValueText)
+{
+    ValueTextBlock->SetText(ValueText);
+}
+
+/*
+* Hashes the raw value bytes and only exports the value to text if the hash differs from the one taken
+* when it was last exported. Element counts of containers are cheap to format so they are never queued.
+* Nothing checks whether the object is still alive here, a node whose object is gone doesn't resolve and the
+* inspection unlinks it as soon as the object goes
+*/
+bool SActorPropertyWidget::UpdateValue(FReflectedActorPropertyPtr Property, FActorDebuggerFormatPipeline* FormatPipeline, FText& OutValueText)
+{
+    if (Property == nullptr)
+    {
+        return false;
+    }
+
+    const uint64 NewHash = Property->HashValue();
+
+    if (Property->bHasValue && Property->ValueHash == NewHash)
+    {
+        return false;
+    }
+
+    Property->ValueHash = NewHash;
+    Property->bHasValue = true;
+
+    const uint8* ValuePtr = Property->ResolveValuePtr();
+    if (FormatPipeline && ValuePtr && Property->IsContainer() == false && Property->Kind != EReflectedPropertyKind::Page)
+    {
+        FormatPipeline->Enqueue(Property, ValuePtr, NewHash);
+        return false;
+    }
+
+    OutValueText = PropertyValueToText(Property);
+    return true;
+}
+
+/*
+* Converts the reflected property value to an FText with the formatter chosen for the node's schema entry. The
+* text is built on the stack, so the only allocation for the common types is the FText's own string. The property
+* comes straight from the node so there is no lookup by name here. Containers only display their element count,
+* formatting every element of a large container would produce an enormous string and the elements have rows of
+* their own
 */
-FText SActorPropertyWidget::PropertyValueToText(const FReflectedActorPropertyPtr& PropertyPtr)
+FText SActorPropertyWidget::PropertyValueToText(FReflectedActorPropertyPtr PropertyPtr)
 {
     if (PropertyPtr == nullptr || PropertyPtr->IsValid() == false)
     {
         return FText::FromString("Invalid Property");
     }
 
-    FProperty* Property {nullptr};
-    Property = PropertyPtr->Object->GetClass()->FindPropertyByName(FName(*PropertyPtr->PropertyName));
+    if (PropertyPtr->Kind == EReflectedPropertyKind::Page)
+    {
+        return FText::GetEmpty();
+    }
+
+    const uint8* ValuePtr = PropertyPtr->ResolveValuePtr();
+    if (ValuePtr == nullptr)
+    {
+        return FText::FromString("Invalid Property");
+    }
 
-    FText PropertyValue;
-    if (Property == nullptr)
+    if (PropertyPtr->IsContainer())
     {
-        return FText::FromString("Property not found");
-    }   
+        const int32 Num = PropertyPtr->GetContainerNum(ValuePtr);
+        return FText::FromString(FString::Printf(TEXT("%d %s"), Num, Num == 1 ? TEXT("element") : TEXT("elements")));
+    }
+
+    ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(STAT_ActorDebugger_ExportValue);
+
+    const FActorDebuggerFormatFunction Formatter = PropertyPtr->Formatter ? PropertyPtr->Formatter : FActorDebuggerFormatters::Select(PropertyPtr->Property);
 
-    FString ValueString;
-    Property->ExportText_InContainer(0, ValueString, PropertyPtr->Object, PropertyPtr->Object, PropertyPtr->Object, PPF_BlueprintDebugView);
-    return FText::FromString(ValueString);
+    TStringBuilder<128> ValueString;
+    Formatter(PropertyPtr->Property, ValuePtr, PropertyPtr->Object, ValueString);
+    INC_DWORD_STAT_BY(STAT_ActorDebugger_ExportedBytes, ValueString.Len() * sizeof(TCHAR));
+    return FText::FromString(FString(ValueString.Len(), ValueString.GetData()));
 }
 
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
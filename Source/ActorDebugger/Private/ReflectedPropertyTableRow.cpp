@@ -12,6 +12,7 @@ BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SReflectedPropertyTableRow::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable)
 {
     PropertyPtr = InArgs._ReflectedProperty.Get();
+    FormatPipeline = InArgs._FormatPipeline;
 
     SMultiColumnTableRow<FReflectedActorPropertyPtr>::Construct(
         FSuperRowType::FArguments()
@@ -39,21 +40,55 @@ TSharedRef<SWidget> SReflectedPropertyTableRow::GenerateWidgetForColumn(const FN
             .FillWidth(1.0f)
             [
                 SNew(STextBlock)
-                    .ColorAndOpacity(FLinearColor(0.75f, 0.75f, 0.75f))
-                    .Text(this, &SReflectedPropertyTableRow::GetPropertyNameText)
+                    .ColorAndOpacity(this, &SReflectedPropertyTableRow::GetPropertyNameColor)
+                    .Text(GetPropertyNameText())
             ];
     }
     else if (ColumnName == TEXT("PropertyValue"))
     {
-        return SNew(SActorPropertyWidget)
-            .ReflectedProperty(PropertyPtr);
+        return SAssignNew(ValueWidget, SActorPropertyWidget)
+            .ReflectedProperty(PropertyPtr)
+            .FormatPipeline(FormatPipeline);
+    }
+    else if (ColumnName == TEXT("MemorySize"))
+    {
+        return SNew(STextBlock)
+            .Justification(ETextJustify::Right)
+            .Text(this, &SReflectedPropertyTableRow::GetMemorySizeText);
+    }
+    else if (ColumnName == TEXT("MemoryRetained"))
+    {
+        return SNew(STextBlock)
+            .Justification(ETextJustify::Right)
+            .Text(this, &SReflectedPropertyTableRow::GetMemoryRetainedText);
     }
     
     return SNullWidget::NullWidget;
 }
 
 /*
-* Safely gets the name of the selected property
+* Forwards a value change to the value column widget
+*/
+void SReflectedPropertyTableRow::SetValueText(const FText& ValueText)
+{
+    if (ValueWidget.IsValid())
+    {
+        ValueWidget->SetValueText(ValueText);
+    }
+}
+
+/*
+* The memory columns are bound to the text so showing them on rows that already exist needs no new row
+*/
+void SReflectedPropertyTableRow::SetMemoryText(const FText& SizeText, const FText& RetainedText)
+{
+    MemorySizeText = SizeText;
+    MemoryRetainedText = RetainedText;
+}
+
+/*
+* Safely gets the name of the selected property. Map keys are exported to build the name so this is only done
+* once when the column is generated rather than bound to the text block
 */
 FText SReflectedPropertyTableRow::GetPropertyNameText() const
 {
@@ -62,16 +97,40 @@ FText SReflectedPropertyTableRow::GetPropertyNameText() const
         return FText::FromString("Invalid Property");
     }
     
-    return FText::FromString(PropertyPtr->PropertyName);
+    return PropertyPtr->GetDisplayName();
+}
+
+/*
+* Watched properties stand out so it's clear which rows can pause play, rows that differ in the diff being shown
+* come next. Bound rather than set so adding or removing a watchpoint or a diff doesn't need the row to be
+* generated again
+*/
+FSlateColor SReflectedPropertyTableRow::GetPropertyNameColor() const
+{
+    if (PropertyPtr && PropertyPtr->bWatched)
+    {
+        return FLinearColor(1.0f, 0.35f, 0.35f);
+    }
+
+    switch (PropertyPtr ? PropertyPtr->DiffKind : EActorDebuggerDiffKind::None)
+    {
+    case EActorDebuggerDiffKind::Changed:           return FLinearColor(1.0f, 0.65f, 0.2f);
+    case EActorDebuggerDiffKind::Added:             return FLinearColor(0.4f, 0.9f, 0.4f);
+    case EActorDebuggerDiffKind::ContainsChanges:   return FLinearColor(0.8f, 0.6f, 0.35f);
+    default:                                        break;
+    }
+
+    return FLinearColor(0.75f, 0.75f, 0.75f);
 }
 
 /*
-* This may or may not be needed for the expander arrow to be displayed if the property has child properties
+* This may or may not be needed for the expander arrow to be displayed if the property has child properties.
+* Children are gathered lazily so this answers without resolving them
 */
 bool SReflectedPropertyTableRow::HasChildren() const
 {
     // TODO: check if this method is needed
-    return PropertyPtr.IsValid() && PropertyPtr->Children.Num() > 0;
+    return PropertyPtr && PropertyPtr->CanHaveChildren();
 }
 
 /*
@@ -12,6 +12,8 @@
 
 #include "Modules/ModuleManager.h"
 
+ACTORDEBUGGER_API DECLARE_LOG_CATEGORY_EXTERN(LogActorDebugger, Log, All);
+
 class FActorDebuggerModule : public IModuleInterface
 {
 public:
@@ -0,0 +1,73 @@
+/**
+ * @file ActorDebuggerCallTimelineWidget.h
+ * @brief Declares the SActorDebuggerCallTimeline class, a Slate widget listing the calls recorded by the call tracer.
+ *
+ * The debugger widget collects the tracer's records every tick and hands them to the timeline, which keeps the most
+ * recent ones and shows them in the order they were made: the frame, the time since the trace started, the object
+ * and function indented by how deeply the call was nested, and how long it took. The list is rebuilt a few times a
+ * second rather than every frame, and can be paused to read it while calls keep being traced. The summary line
+ * shows the rate of calls and how many were dropped because the tracer's buffer filled up.
+ *
+ * Classes and Types:
+ * - SActorDebuggerCallTimeline: The summary line, the pause and clear buttons and the list of calls.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "ActorDebuggerCallTracer.h"
+
+class STextBlock;
+
+class ACTORDEBUGGER_API SActorDebuggerCallTimeline : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SActorDebuggerCallTimeline)
+		: _MaxCalls(2000)
+		, _RefreshInterval(0.25f)
+	{}
+		/* How many of the most recent calls are listed */
+		SLATE_ARGUMENT(int32, MaxCalls)
+		/* Seconds between rebuilds of the list */
+		SLATE_ARGUMENT(float, RefreshInterval)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/* Appends calls collected from the tracer, in the order they were made, dropping the oldest beyond MaxCalls */
+	void AddCalls(TConstArrayView<FActorDebuggerCallRecord> NewCalls);
+
+	/* Forgets every call, e.g. when a new trace starts */
+	void Reset();
+
+	int32 GetNumCalls() const { return Calls.Num(); }
+
+private:
+	typedef TSharedPtr<int32> FCallPtr;
+
+	void RebuildRows();
+	TSharedRef<ITableRow> HandleGenerateRow(FCallPtr Call, const TSharedRef<STableViewBase>& OwnerTable);
+	FText GetSummaryText() const;
+
+	/* The most recent calls, oldest first */
+	TArray<FActorDebuggerCallRecord> Calls;
+	int32 MaxCalls {0};
+
+	/* One item per call the list can hold, the list shows the first Calls.Num() */
+	TArray<FCallPtr> CallItems;
+	TArray<FCallPtr> VisibleCalls;
+
+	float RefreshInterval {0.0f};
+	double LastRefreshTime {0.0};
+	bool bPaused {false};
+	bool bCallsChanged {false};
+
+	/* Calls added since the rate was last measured, and the last measured rate */
+	int32 NumCallsSinceRate {0};
+	double LastRateTime {0.0};
+	double CallsPerSecond {0.0};
+
+	TSharedPtr<SListView<FCallPtr>> CallsView;
+};
@@ -0,0 +1,158 @@
+/**
+ * @file ActorDebuggerCallTracer.h
+ * @brief Declares the call tracer of the Actor Debugger, which records the UFunctions called on an object and its subobjects.
+ *
+ * Every UFunction is invoked through its native function pointer, whether it is called through ProcessEvent (events,
+ * RPCs, timers and delegates) or by a Blueprint calling a native function. While a trace runs the pointers of the
+ * functions of the traced objects' classes are swapped for hooks that time the call and record it. The hooks are
+ * shared by every instance of those classes, so they look the calling object up in the set of traced objects and
+ * pass every other call straight through. Blueprint functions calling each other within a graph don't go through
+ * the pointer and aren't recorded, the events that start them are.
+ *
+ * Only functions declared on the traced classes and their project base classes are hooked. Functions declared on
+ * classes of the engine and its plugins, whether native modules or Blueprints mounted from the engine, are shared by
+ * objects all over the game, hooking them would put the hooks in front of every actor's calls, so they are only
+ * hooked when ActorDebugger.TraceEngineFunctions is set. Modules of the project and of the plugins it brings along
+ * are the project's.
+ *
+ * When no trace runs nothing is hooked, so the tracer costs nothing at all. While a trace runs a call costs a hash
+ * lookup, or a lookup and two timestamps if it is recorded. Only calls made on the game thread are recorded, calls on
+ * other threads pass straight through without touching the tracer's state, so the set of traced objects and the
+ * ring buffer the records are written to need no synchronization. Traced objects are keyed by FObjectKey, so an
+ * object allocated where a destroyed traced object used to be isn't taken for it. Calls made while the buffer is full
+ * are dropped and counted.
+ *
+ * Each hook is generated for one slot and calls the original function kept in that slot. A function is given its slot
+ * the first time it is hooked and keeps it for the life of the process, hooking it again reuses it, so a call already
+ * inside a hook always finishes through its own function's original, even after its trace stopped and another one
+ * started. The process hooks at most MaxFunctions distinct functions.
+ *
+ * Only one trace runs at a time, starting a trace stops the one before it. The trace stops by itself when its
+ * object is destroyed or its class is reinstanced.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerCallRecord: One recorded call, which function on which object, when and for how long.
+ * - FActorDebuggerCallTracer: Hooks the functions, keeps the record buffer and collects the records.
+ *
+ * Console Variables:
+ * - ActorDebugger.TraceEngineFunctions: Whether a trace also hooks functions declared on classes of the engine and its plugins.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Script.h"
+#include "UObject/ObjectKey.h"
+
+#include <atomic>
+
+struct FFrame;
+
+struct FActorDebuggerCallRecord
+{
+	/* FPlatformTime::Cycles64 when the call was made and when it returned */
+	uint64 StartCycles {0};
+	uint64 EndCycles {0};
+
+	/* GFrameCounter when the call was made */
+	uint64 Frame {0};
+
+	/* Indices of the function and the object, see GetFunctionName and GetObjectName */
+	int32 FunctionIndex {INDEX_NONE};
+	int32 ObjectIndex {INDEX_NONE};
+
+	/* How many recorded calls this call was made from */
+	int32 Depth {0};
+};
+
+class ACTORDEBUGGER_API FActorDebuggerCallTracer
+{
+public:
+	/* The most distinct functions the process hooks, slots are never given to another function */
+	static constexpr int32 MaxFunctions = 4096;
+
+	/* The calls the buffer holds until they are collected, a power of two */
+	static constexpr int32 MaxCalls = 1 << 16;
+
+	static FActorDebuggerCallTracer& Get();
+
+	/* Traces the calls made on the object and every object it is the outer of. Returns false if the object isn't valid.
+	 * Game thread only, as are Stop and Collect */
+	bool Start(UObject* Object);
+
+	/* Unhooks every function. Calls recorded before can still be collected */
+	void Stop();
+
+	bool IsTracing() const { return bTracing; }
+	UObject* GetObject() const { return Object.Get(); }
+
+	/* Identifies the current or last trace, so a collector can tell whether the trace it started was replaced */
+	int32 GetTraceId() const { return TraceId; }
+
+	/* Appends the calls recorded since the last collect to OutRecords, in the order they were made. Records of the
+	 * last trace can still be collected after it stopped. Returns how many were appended. Game thread only */
+	int32 Collect(TArray<FActorDebuggerCallRecord>& OutRecords);
+
+	/* Names of the functions by slot, which stay valid, and of the objects of the last trace, valid until the next one starts */
+	FName GetFunctionName(int32 Index) const;
+	const FString& GetObjectName(int32 Index) const;
+	int32 GetNumFunctions() const { return HookedSlots.Num(); }
+	int32 GetNumObjects() const { return ObjectNames.Num(); }
+
+	/* FPlatformTime::Cycles64 when the last trace started */
+	uint64 GetStartCycles() const { return StartCycles; }
+
+	/* Calls of the last trace that were lost because the buffer was full */
+	uint64 GetNumDropped() const { return NumDropped; }
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FHookedFunction
+	{
+		TWeakObjectPtr<UFunction> Function;
+		std::atomic<FNativeFuncPtr> OriginalFunc {nullptr};
+	};
+
+	/* One hook per slot, each knows the function it replaced by its slot */
+	template <int32 Slot>
+	static void TraceThunk(UObject* Context, FFrame& Stack, RESULT_DECL);
+	static const FNativeFuncPtr* GetThunks();
+
+	void TraceCall(int32 Slot, UObject* Context, FFrame& Stack, RESULT_DECL);
+	void HandlePreGarbageCollect();
+	void HandleObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap);
+
+	/* Read by the hooks on any thread. A slot's function never changes once given, its original is only stored on the
+	 * game thread before the function is hooked and read with acquire */
+	TStaticArray<FHookedFunction, MaxFunctions> Functions;
+
+	/* The slot each function was given, and how many were given. Game thread only */
+	TMap<FObjectKey, int32> FunctionSlots;
+	int32 NumSlots {0};
+
+	/* Only read and written on the game thread */
+	TMap<FObjectKey, int32> TracedObjects;
+	bool bTracing {false};
+
+	/* Slots of the functions the current trace hooked */
+	TArray<int32> HookedSlots;
+	TArray<FName> FunctionNames;
+	TArray<FString> ObjectNames;
+	TWeakObjectPtr<UObject> Object;
+	int32 TraceId {0};
+	uint64 StartCycles {0};
+	uint64 NumDropped {0};
+
+	/* Ring buffer of the recorded calls, Head is where the next call is written and Tail the first not collected */
+	TArray<FActorDebuggerCallRecord> Records;
+	uint64 Head {0};
+	uint64 Tail {0};
+
+	/* Recorded calls the game thread is currently inside of */
+	int32 CallDepth {0};
+
+	FDelegateHandle PreGarbageCollectHandle;
+	FDelegateHandle ObjectsReinstancedHandle;
+};
@@ -0,0 +1,242 @@
+/**
+ * @file ActorDebuggerCapture.h
+ * @brief Declares the capture writer and reader, which record debugger sessions to disk and replay them later.
+ *
+ * A capture is an append only binary file made of records, each a small header followed by its payload:
+ *
+ * - Schema: The properties of one class, written once the first time an object of that class is captured. Each
+ *   property records its name, C++ type, size and how its values are encoded.
+ * - Object: One watched object, its name, path and schema.
+ * - Frame: The values that changed since the previous frame. Every KeyframeInterval frames a keyframe is written
+ *   instead, holding every value of every watched object, so seeking never replays more than one interval.
+ * - Index: Written when the capture is closed. Holds the offsets of every schema, object and frame record and is
+ *   found through a fixed size trailer at the end of the file. A capture that was never closed (e.g. the game
+ *   crashed) has no index, the reader then builds one by walking the record headers.
+ *
+ * Values are stored in a portable form: plain old data as its bytes, references to watched objects as the id of
+ * the object (anything else as its path) and all other values as exported text.
+ *
+ * The reader memory maps the file, so opening a capture of any size only reads its index. Frame values are views
+ * into the mapped file and are never copied. To drive the debugger tree from a capture the reader creates a
+ * transient "replay" object of each captured class and writes the values of the chosen frame into them. The tree
+ * then inspects the replay objects exactly as it would live ones. Properties whose type no longer matches the
+ * loaded class are skipped.
+ *
+ * Classes and Structures:
+ * - EActorDebuggerCaptureEncoding: How the values of a property are stored.
+ * - FActorDebuggerCaptureWriter: Streams a capture of a set of watched objects to disk.
+ * - FActorDebuggerCaptureReader: Maps a capture, seeks to frames and applies them to replay objects.
+ *
+ * Console Variables:
+ * - ActorDebugger.CaptureKeyframeInterval: How many frames apart keyframes are written.
+ * - ActorDebugger.CaptureDepth: How many levels of referenced objects are watched along with the inspected one.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Memory/MemoryView.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerSchemaCache.h"
+
+class FArchive;
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+enum class EActorDebuggerCaptureEncoding : uint8
+{
+	/* The property is not captured, e.g. a C style array of a type that can only be exported as text */
+	None,
+	/* The bytes of all ArrayDim elements */
+	Raw,
+	/* An int32 watched object id, or INDEX_NONE followed by the object's path */
+	ObjectRef,
+	/* An int32 element count followed by an ObjectRef per element */
+	ObjectRefArray,
+	/* The value exported to text, as UTF-8 */
+	Text
+};
+
+namespace ActorDebuggerCapture
+{
+	/* The file starts with a header, records follow it and a closed capture ends with a trailer */
+	static constexpr uint32 Magic = 0x50434441; // "ADCP"
+	static constexpr uint32 TrailerMagic = 0x58494441; // "ADIX"
+	static constexpr uint32 Version = 1;
+
+	enum class ERecordType : uint8
+	{
+		Schema = 1,
+		Object = 2,
+		Frame = 3,
+		Index = 4
+	};
+}
+
+class ACTORDEBUGGER_API FActorDebuggerCaptureWriter
+{
+public:
+	~FActorDebuggerCaptureWriter();
+
+	/* A new file under Saved/ActorDebugger/Captures named after the current time */
+	static FString GetDefaultFilename();
+
+	/* Creates the file and writes its header. Returns false if the file can't be created */
+	bool Open(const FString& Filename);
+
+	/* Writes the index and trailer and closes the file */
+	void Close();
+
+	bool IsOpen() const { return Writer.IsValid(); }
+
+	/* Watches an object and every object of interest it references through its properties, down to
+	 * ActorDebugger.CaptureDepth levels. Objects already watched are skipped */
+	void AddObjectGraph(UObject* Root);
+
+	/* Writes one frame holding the values that changed since the last one, or a keyframe */
+	void CaptureFrame(double Time);
+
+	int32 GetNumFrames() const { return FrameOffsets.Num(); }
+	int64 GetFileSize() const;
+
+	/* How values of the property are stored. The debug server sends values the same way */
+	static EActorDebuggerCaptureEncoding ChooseEncoding(const FProperty* Property);
+
+	/* Encodes a whole value of the property into OutBytes. FindObjectId returns the id references are stored as,
+	 * INDEX_NONE stores the path of the object instead */
+	static void EncodeValue(const FProperty* Property, EActorDebuggerCaptureEncoding Encoding, const uint8* ValuePtr, UObject* Owner, TArray<uint8>& OutBytes, TFunctionRef<int32(UObject*)> FindObjectId);
+
+private:
+	struct FWatchedProperty
+	{
+		FProperty* Property {nullptr};
+		EActorDebuggerCaptureEncoding Encoding {EActorDebuggerCaptureEncoding::None};
+		uint64 LastHash {0};
+	};
+
+	struct FWatchedObject
+	{
+		TWeakObjectPtr<UObject> Object;
+		int32 SchemaId {INDEX_NONE};
+		TArray<FWatchedProperty> Properties;
+
+		/* Set until the object's values have been written once, objects can be watched in the middle of a capture */
+		bool bWriteAll {true};
+	};
+
+	int32 AddObject(UObject* Object);
+	void AddObjectGraph(UObject* Object, int32 RemainingDepth);
+	int32 FindOrWriteSchema(const UClass* Class, const FActorDebuggerClassSchema& Schema);
+	static void EncodeObjectRef(UObject* Object, FArchive& Ar, TFunctionRef<int32(UObject*)> FindObjectId);
+	int64 WriteRecord(ActorDebuggerCapture::ERecordType Type, const TArray<uint8>& Payload);
+
+	TUniquePtr<FArchive> Writer;
+	int32 KeyframeInterval {60};
+
+	TArray<FWatchedObject> Objects;
+	TMap<TObjectKey<UObject>, int32> ObjectIds;
+	TMap<const UClass*, int32> SchemaIds;
+
+	/* Record offsets for the index */
+	TArray<int64> SchemaOffsets;
+	TArray<int64> ObjectOffsets;
+	TArray<int64> FrameOffsets;
+	TArray<double> FrameTimes;
+	TArray<bool> FrameIsKeyframe;
+
+	/* Reused between frames so capturing does not allocate once it has warmed up */
+	TArray<uint8> Payload;
+	TArray<uint8> ValueBytes;
+};
+
+class ACTORDEBUGGER_API FActorDebuggerCaptureReader
+{
+public:
+	~FActorDebuggerCaptureReader();
+
+	/* Maps the file and reads its index, or walks its records if it has none. Returns false if the file can't be
+	 * mapped or isn't a capture */
+	bool Open(const FString& Filename);
+	void Close();
+
+	int32 GetNumFrames() const { return Frames.Num(); }
+	double GetFrameTime(int32 Frame) const { return Frames[Frame].Time; }
+	int32 GetNumObjects() const { return Objects.Num(); }
+
+	/* Creates a transient object of each captured object's class to apply frames to. Objects whose class can't be
+	 * found are left null. Returns the replay object of the first captured object, the one that was inspected */
+	UObject* CreateReplayObjects();
+
+	/* Writes the values the captured objects had in the given frame into the replay objects */
+	bool ApplyFrame(int32 Frame);
+
+	UObject* GetReplayObject(int32 ObjectId) const;
+
+	/* Writes an encoded value into the object's property. DecodeObjectRef reads a reference written by
+	 * EncodeObjectRef and returns the object it stands for in this process */
+	static void ApplyValue(FProperty* LiveProperty, EActorDebuggerCaptureEncoding Encoding, UObject* Object, FMemoryView Bytes, TFunctionRef<UObject*(FArchive&)> DecodeObjectRef);
+
+	/* The property of the loaded class a recorded property is applied to, null if there is none or its type changed */
+	static FProperty* FindLiveProperty(UClass* LiveClass, const FString& Name, const FString& CPPType, EActorDebuggerCaptureEncoding Encoding, int32 ElementSize, int32 ArrayDim);
+
+private:
+	struct FSchemaProperty
+	{
+		FString Name;
+		FString CPPType;
+		EActorDebuggerCaptureEncoding Encoding {EActorDebuggerCaptureEncoding::None};
+		int32 ElementSize {0};
+		int32 ArrayDim {1};
+
+		/* The matching property of the loaded class, if its type still matches */
+		FProperty* LiveProperty {nullptr};
+	};
+
+	struct FSchema
+	{
+		FString ClassPath;
+		TArray<FSchemaProperty> Properties;
+		UClass* LiveClass {nullptr};
+	};
+
+	struct FObject
+	{
+		int32 SchemaId {INDEX_NONE};
+		FString Name;
+		FString PathName;
+		TStrongObjectPtr<UObject> ReplayObject;
+	};
+
+	struct FFrame
+	{
+		int64 Offset {0};
+		double Time {0.0};
+		bool bKeyframe {false};
+	};
+
+	bool ReadIndex();
+	bool ScanRecords();
+	bool ReadRecord(int64 Offset, ActorDebuggerCapture::ERecordType& OutType, FMemoryView& OutPayload) const;
+	bool ReadSchema(FMemoryView Payload);
+	bool ReadObject(FMemoryView Payload);
+	bool ReadFrameInfo(int64 Offset, FMemoryView Payload);
+
+	/* Fills Values with views of every value the objects had at Frame, starting from the keyframe before it */
+	bool GatherFrameValues(int32 Frame);
+	UObject* DecodeObjectRef(FArchive& Ar) const;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	const uint8* Data {nullptr};
+	int64 Size {0};
+
+	TArray<FSchema> Schemas;
+	TArray<FObject> Objects;
+	TArray<FFrame> Frames;
+
+	/* Per object, per schema property: a view of the value in the mapped file at the last gathered frame. A view
+	 * with no data means the value has not been captured yet */
+	TArray<TArray<FMemoryView>> Values;
+	int32 GatheredFrame {INDEX_NONE};
+};
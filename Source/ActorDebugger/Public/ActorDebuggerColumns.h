@@ -0,0 +1,144 @@
+/**
+ * @file ActorDebuggerColumns.h
+ * @brief Declares the FActorDebuggerColumnTable class, which samples chosen properties of every instance of a class into column buffers.
+ *
+ * Where the tree shows every property of one object, the table shows a few properties of every object of a class,
+ * one row per object and one column per property path (see FActorDebuggerPropertyPath). Values are sampled into
+ * one contiguous buffer per column: numbers, enums, bools and element counts as doubles, anything else as text.
+ *
+ * Filtering, sorting and statistics all run on those buffers. The filter and the sort produce the view, a list of
+ * row indices, and the minimum, maximum, mean and histogram of every number column are computed over the rows in
+ * the view with SIMD kernels that process four values per instruction. The widget only displays the view, it
+ * never filters or sorts rows itself.
+ *
+ * Sampling gathers the objects on the game thread and reads the number columns in parallel. Text columns are
+ * formatted on the game thread, since the ExportText fallback may look up other objects.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerColumnStats: The minimum, maximum, mean and histogram of a number column's values in the view.
+ * - FActorDebuggerColumn: A property path and the buffer of its sampled values, one per row.
+ * - FActorDebuggerColumnTable: The rows, the columns, the filter, the sort and the view.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerPropertyPath.h"
+#include "ActorDebuggerCondition.h"
+#include "ActorDebuggerFormatters.h"
+
+class FNumericProperty;
+
+struct FActorDebuggerColumnStats
+{
+	/* Rows in the view with a value */
+	int32 NumValues {0};
+	double Min {0.0};
+	double Max {0.0};
+	double Mean {0.0};
+
+	/* Bins of equal width from Min to Max */
+	TArray<int32, TInlineAllocator<16>> Histogram;
+};
+
+struct ACTORDEBUGGER_API FActorDebuggerColumn
+{
+	enum class EType : uint8
+	{
+		/* Numeric properties, read as doubles */
+		Number,
+		/* Enums, read as their underlying values and shown by name */
+		Enum,
+		Bool,
+		/* Containers, read as their element count */
+		Count,
+		/* Everything else, exported to text */
+		Text
+	};
+
+	bool IsNumber() const { return Type != EType::Text; }
+
+	/* Shows a sampled value the way the tree would */
+	FString FormatValue(int32 Row) const;
+
+	FActorDebuggerPropertyPath Path;
+	EType Type {EType::Text};
+
+	/* The property numbers are read through, the underlying property for enums */
+	const FNumericProperty* NumericProperty {nullptr};
+	const UEnum* Enum {nullptr};
+
+	/* Formats the values of text columns */
+	FActorDebuggerFormatFunction Formatter {nullptr};
+
+	/* One entry per row, only one of the buffers is used. HasValue is false for rows whose path didn't resolve */
+	TArray<double> Numbers;
+	TArray<FString> Texts;
+	TArray<bool> HasValue;
+
+	FActorDebuggerColumnStats Stats;
+};
+
+class ACTORDEBUGGER_API FActorDebuggerColumnTable
+{
+public:
+	/* Shows the instances of another class, the columns, the filter and the rows are removed */
+	void SetClass(UClass* InClass);
+
+	/* Adds a column for the property path. Returns false and describes the problem if the path doesn't compile */
+	bool AddColumn(const FString& Path, FText& OutError);
+	void RemoveColumn(int32 ColumnIndex);
+
+	/* Gathers the instances of the class in the given world, or in every world if World is nullptr, and samples
+	 * every column. The filter, the sort and the statistics are applied again. Only call this on the game thread */
+	void Sample(const UWorld* World);
+
+	/* Sorts the view by a column. Rows without a value go last */
+	void SortBy(int32 ColumnIndex, bool bAscending);
+
+	/* Filters the view with a condition on a column, such as "Health < 10" or "Name == Bob". An empty filter shows
+	 * every row. Returns false and describes the problem if the filter doesn't name a column or doesn't parse */
+	bool SetFilter(const FString& Filter, FText& OutError);
+
+	/* Row indices that pass the filter, in sort order */
+	const TArray<int32>& GetView() const { return View; }
+
+	int32 GetNumRows() const { return Objects.Num(); }
+	UObject* GetObject(int32 Row) const { return Objects[Row].Get(); }
+	const FString& GetRowName(int32 Row) const { return RowNames[Row]; }
+
+	UClass* GetClass() const { return Class; }
+	const TArray<FActorDebuggerColumn>& GetColumns() const { return Columns; }
+	int32 GetSortColumn() const { return SortColumn; }
+	bool IsSortAscending() const { return bSortAscending; }
+
+	/* Computes the minimum, maximum, mean and histogram of the values with SIMD kernels */
+	static void ComputeStats(const double* Values, int32 NumValues, int32 NumBins, FActorDebuggerColumnStats& OutStats);
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	void SampleColumn(FActorDebuggerColumn& Column, const TArray<UObject*>& SampledObjects) const;
+	void UpdateView();
+	bool PassesFilter(int32 Row) const;
+
+	UClass* Class {nullptr};
+	TArray<FActorDebuggerColumn> Columns;
+
+	/* One entry per row */
+	TArray<TWeakObjectPtr<UObject>> Objects;
+	TArray<FString> RowNames;
+
+	TArray<int32> View;
+	int32 SortColumn {INDEX_NONE};
+	bool bSortAscending {true};
+
+	int32 FilterColumn {INDEX_NONE};
+	EActorDebuggerConditionOp FilterOp {EActorDebuggerConditionOp::Equal};
+	double FilterNumber {0.0};
+	FString FilterText;
+
+	/* The values of the rows in the view, gathered contiguously for the statistics kernels */
+	TArray<double> Scratch;
+};
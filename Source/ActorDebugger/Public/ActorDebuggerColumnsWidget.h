@@ -0,0 +1,81 @@
+/**
+ * @file ActorDebuggerColumnsWidget.h
+ * @brief Declares the SActorDebuggerColumnsWidget class, a Slate widget showing chosen properties of every instance of a class.
+ *
+ * The widget displays an FActorDebuggerColumnTable: one row per object, one column per property path, with the
+ * minimum, maximum, mean and a histogram of every number column above the list. Columns are added by typing a path,
+ * the view is filtered by typing a condition such as "Health < 10" and sorted by clicking a column's header. The
+ * table does the filtering and sorting on its column buffers, the list only displays the rows of the table's view.
+ * Clicking a row opens its object in a debugger window of its own.
+ *
+ * The table is sampled again periodically while the widget is open, so it follows the objects as they change and
+ * as they are spawned or destroyed.
+ *
+ * Classes and Types:
+ * - SActorDebuggerColumnsWidget: The column editor, the filter, the statistics and the list of rows.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Containers/Ticker.h"
+#include "ActorDebuggerColumns.h"
+
+class STextBlock;
+
+class ACTORDEBUGGER_API SActorDebuggerColumnsWidget : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SActorDebuggerColumnsWidget)
+		: _Class(nullptr)
+		, _RefreshInterval(0.5f)
+	{}
+		SLATE_ARGUMENT(UClass*, Class)
+		/* Property paths of the columns to start with */
+		SLATE_ARGUMENT(TArray<FString>, Columns)
+		/* The world to show the instances of, every world is shown if it isn't set */
+		SLATE_ARGUMENT(TWeakObjectPtr<UWorld>, World)
+		/* Seconds between samples of the table */
+		SLATE_ARGUMENT(float, RefreshInterval)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	virtual ~SActorDebuggerColumnsWidget();
+
+	/* Adds a column for the property path. Returns false and describes the problem if it doesn't compile */
+	bool AddColumn(const FString& Path, FText& OutError);
+
+	const FActorDebuggerColumnTable& GetTable() const { return Table; }
+
+private:
+	typedef TSharedPtr<int32> FRowPtr;
+
+	bool HandleTicker(float DeltaTime);
+	void Refresh();
+	void RebuildColumns();
+	void RebuildRows();
+
+	TSharedRef<ITableRow> HandleGenerateRow(FRowPtr Row, const TSharedRef<STableViewBase>& OwnerTable);
+	void HandleRowClicked(FRowPtr Row);
+	void HandleSort(EColumnSortPriority::Type Priority, const FName& ColumnId, EColumnSortMode::Type SortMode);
+	EColumnSortMode::Type GetColumnSortMode(int32 ColumnIndex) const;
+	void HandleAddColumnCommitted(const FText& Text, ETextCommit::Type CommitType);
+	void HandleFilterCommitted(const FText& Text, ETextCommit::Type CommitType);
+	FText GetStatsText() const;
+	FText GetSummaryText() const;
+
+	FActorDebuggerColumnTable Table;
+	TWeakObjectPtr<UWorld> World;
+	bool bSearchAllWorlds {true};
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	/* One item per row of the table, the list shows the ones in the table's view */
+	TArray<FRowPtr> RowItems;
+	TArray<FRowPtr> VisibleRows;
+
+	TSharedPtr<SHeaderRow> HeaderRow;
+	TSharedPtr<SListView<FRowPtr>> RowsView;
+	TSharedPtr<STextBlock> ErrorTextBlock;
+};
@@ -0,0 +1,70 @@
+/**
+ * @file ActorDebuggerCondition.h
+ * @brief Declares the FActorDebuggerCondition struct, a comparison of a property's value compiled for the property's type.
+ *
+ * Conditions are written the way they would be in code: "Health < 10", "bIsDead == true", "State == EState::Dead",
+ * "Target == None". Compiling a condition parses the operand into the property's own representation and picks a
+ * comparator specialised for that type and operator, so evaluating it is a single indirect call that reads the value
+ * straight from the property's memory. Nothing is exported to text and nothing is allocated.
+ *
+ * Numbers and enums support every operator, enums compare their underlying values and accept value names as
+ * operands. Strings support every operator. Bools, names and object references (compared with None) only support
+ * == and !=. Containers can compare their element count instead of their value.
+ *
+ * A compiled condition only reads the value and its own operand, so one condition can be evaluated against many
+ * values from many threads at once.
+ *
+ * Classes and Structures:
+ * - EActorDebuggerConditionOp: The operator of a condition, or Changed for text without an operator.
+ * - FActorDebuggerCondition: The compiled comparison: the comparator and the parsed operand.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FProperty;
+
+enum class EActorDebuggerConditionOp : uint8
+{
+	/* Not a comparison. Watchpoints use it for "on change", it can't be compiled into a condition */
+	Changed,
+	Equal,
+	NotEqual,
+	Less,
+	LessEqual,
+	Greater,
+	GreaterEqual
+};
+
+struct ACTORDEBUGGER_API FActorDebuggerCondition
+{
+	typedef bool (*FTestFunction)(const FActorDebuggerCondition& Condition, const uint8* ValuePtr);
+
+	/* Splits "Health < 10" into the name, the operator and the operand, the name may be empty. Text without an
+	 * operator parses as Changed if it is empty or "changed". Returns false if the text isn't a condition */
+	static bool Parse(const FString& Text, FString& OutName, EActorDebuggerConditionOp& OutOp, FString& OutOperand);
+
+	/* Compiles a comparison of the given property's values with the operand. If bCompareNum is set the property is a
+	 * container and its element count is compared. Returns false and describes the problem if the operator or the
+	 * operand doesn't fit the property's type */
+	bool Compile(const FProperty* InProperty, EActorDebuggerConditionOp InOp, const FString& InOperand, bool bCompareNum, FText& OutError);
+
+	/* Only valid once compiled */
+	FORCEINLINE bool Evaluate(const uint8* ValuePtr) const
+	{
+		return Test(*this, ValuePtr);
+	}
+
+	bool IsCompiled() const { return Test != nullptr; }
+
+	const FProperty* Property {nullptr};
+	FTestFunction Test {nullptr};
+	EActorDebuggerConditionOp Op {EActorDebuggerConditionOp::Equal};
+
+	/* The operand in the property's own representation, numbers are stored in place */
+	alignas(8) uint8 Operand[8] {};
+	FString OperandString;
+	FName OperandName;
+};
@@ -0,0 +1,295 @@
+/**
+ * @file ActorDebuggerDump.h
+ * @brief Declares the dump writer and dump sessions, which stream the properties of selected objects to a file or stdout without any UI.
+ *
+ * Dumps are meant for processes that have no debugger window, dedicated servers in particular. They are built on the
+ * schema cache, the formatters and the value hashes only, nothing here touches Slate. They are started from the
+ * console (see UActorDebuggerLibrary) or from code through FActorDebuggerDumps.
+ *
+ * A session writes passes over its objects. A tree session writes every property of every object, following
+ * structs, containers and the subobjects of interest the tree would expand, down to ActorDebugger.DumpDepth levels.
+ * An object is expanded once per pass, the first time the pass reaches it.
+ * A delta session watches each object and the subobjects of interest it references as objects of their own, and a
+ * pass only writes the top level properties whose value hash changed since the previous pass (every property the
+ * first time an object is written). A session with no interval writes one pass and closes, otherwise it writes a
+ * pass every interval until it is stopped.
+ *
+ * Passes are spread over frames: each frame a session writes objects until ActorDebugger.DumpBudgetMs is used up
+ * and carries on from there in the next frame, so dumping thousands of actors never stalls a tick for long. Output
+ * goes through a buffer the writer reuses for the whole session and which is handed to the file every FlushSize
+ * bytes, so the memory a dump holds doesn't grow with the number of objects. Stdout shares the process with the log,
+ * so a dump to stdout holds the pass being written and prints it whole once the pass is complete, which keeps log
+ * lines out of its records at the cost of holding a pass in memory.
+ *
+ * Two encodings are written:
+ *
+ * - Json: One line per pass, {"frame":F,"time":T,"delta":B,"objects":[...]}. Each object is a JSON object holding
+ *   "@id" and, the first time the object is written, "@name", "@class" and "@path", followed by its properties.
+ *   Structs without a formatter of their own and expanded subobjects are nested JSON objects, containers are
+ *   arrays and map pairs are arrays of a key and a value. Numbers and bools are JSON numbers and bools, every other
+ *   value is the text the debugger shows.
+ * - Binary: A header (magic and version) followed by tokens, each a type byte and its operands. Counts and ids are
+ *   variable length integers and strings are a length and UTF-8. Property names are written once and referred to by
+ *   id afterwards, objects are described once and referred to by id. Numbers are their bytes, bools a byte and
+ *   every other value its text.
+ *
+ * Classes and Structures:
+ * - EActorDebuggerDumpFormat: The encoding of a dump.
+ * - FActorDebuggerDumpWriter: Encodes objects and their properties through a reusable buffer.
+ * - FActorDebuggerDumpSession: The objects of one dump, written a budgeted slice of a pass at a time.
+ * - FActorDebuggerDumps: Owns the running sessions and ticks them.
+ *
+ * Console Variables:
+ * - ActorDebugger.DumpDepth: How many levels of subobjects a dump follows below each selected object.
+ * - ActorDebugger.DumpBudgetMs: How long dumps may write for in one frame.
+ * - ActorDebugger.DumpMaxElements: Containers with more elements than this only have their first elements written.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
+#include "ActorDebuggerSchemaCache.h"
+
+class FArchive;
+class FProperty;
+class UWorld;
+
+enum class EActorDebuggerDumpFormat : uint8
+{
+	Json,
+	Binary
+};
+
+namespace ActorDebuggerDump
+{
+	static constexpr uint32 Magic = 0x50444441; // "ADDP"
+	static constexpr uint32 Version = 1;
+
+	enum class EToken : uint8
+	{
+		/* uint64 frame counter, double time, uint8 whether the pass only holds changes */
+		Frame = 1,
+		EndFrame = 2,
+		/* varint id, then the string name of the property the name id stands for */
+		Name = 3,
+		/* varint object id, then the object's name, class path and path. Written before the object is first used */
+		ObjectInfo = 4,
+		/* varint name id (0 for elements) and varint object id, the object's properties follow until EndScope */
+		Object = 5,
+		/* varint name id, the members follow until EndScope */
+		Struct = 6,
+		/* varint name id and varint element count, the elements follow until EndScope */
+		Array = 7,
+		EndScope = 8,
+		/* varint name id, uint8 EValueEncoding, varint size and the value's bytes */
+		Value = 9
+	};
+
+	enum class EValueEncoding : uint8
+	{
+		/* The bytes of a number, as laid out in memory */
+		Raw,
+		/* One byte, 0 or 1 */
+		Bool,
+		/* The value's text as UTF-8 */
+		Text
+	};
+}
+
+class ACTORDEBUGGER_API FActorDebuggerDumpWriter
+{
+public:
+	/* The buffer is handed to the output whenever it holds this many bytes */
+	static constexpr int32 FlushSize = 64 * 1024;
+
+	~FActorDebuggerDumpWriter();
+
+	/* A new file under Saved/ActorDebugger/Dumps named after the current time */
+	static FString GetDefaultFilename(EActorDebuggerDumpFormat Format);
+
+	/* Opens "stdout" or creates a file, nullptr if the file can't be created */
+	static TUniquePtr<FArchive> CreateOutput(const FString& Target);
+
+	/* Takes ownership of the output and writes the header of the format, if it has one */
+	void Open(TUniquePtr<FArchive> InOutput, EActorDebuggerDumpFormat InFormat);
+
+	/* Flushes what is buffered and closes the output */
+	void Close();
+
+	bool IsOpen() const { return Output.IsValid(); }
+
+	/* A pass is a frame record holding any number of objects */
+	void BeginFrame(bool bDelta);
+	void EndFrame();
+
+	/* Writes every property of the object, expanding subobjects of interest down to MaxDepth levels. Objects already
+	 * expanded in the current pass are written as their id or reference */
+	void WriteObjectTree(UObject* Object, int32 MaxDepth);
+
+	/* Writes the object's id, and its description the first time, then the properties passed to WriteProperty
+	 * until EndObject. Subobjects aren't expanded, references are written as the debugger shows them */
+	void BeginObject(UObject* Object);
+	void WriteProperty(const FActorDebuggerPropertySchemaEntry& Entry, UObject* Object);
+	void EndObject();
+
+	/* Hands everything buffered to the output and flushes it, which EndFrame does at the end of a pass */
+	void Flush();
+
+	int64 GetBytesWritten() const { return BytesWritten + Buffer.Num(); }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	void WritePropertyValue(FName Name, const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FActorDebuggerFormatFunction Formatter, int32 Depth);
+	void WriteElement(FName Name, const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FActorDebuggerFormatFunction Formatter, int32 Depth);
+	void WriteObjectProperties(UObject* Object, int32 Depth);
+
+	/* The structure of both encodings, Name is NAME_None inside arrays */
+	void BeginObjectScope(FName Name, UObject* Object);
+	void BeginStructScope(FName Name);
+	void BeginArrayScope(FName Name, int32 Num);
+	void EndScope(bool bArray);
+	void WriteValue(FName Name, const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FActorDebuggerFormatFunction Formatter);
+
+	/* JSON helpers: the separator before a member or element and its key */
+	void WriteJsonKey(FName Name);
+	void WriteJsonString(FStringView Text);
+	void WriteJsonObjectHeader(UObject* Object, uint32 ObjectId, bool bNew);
+
+	/* Binary helpers */
+	uint32 FindOrWriteName(FName Name);
+	void WriteVarInt(uint64 Value);
+	void WriteString(FStringView Text);
+	void WriteToken(ActorDebuggerDump::EToken Token) { WriteByte(static_cast<uint8>(Token)); }
+
+	void WriteByte(uint8 Byte) { Buffer.Add(Byte); }
+	void WriteBytes(const void* Data, int32 Num);
+	void WriteAscii(const ANSICHAR* Text);
+	void WriteUtf8(FStringView Text);
+
+	/* Returns the object's id and whether this is the first time the object is written */
+	uint32 FindOrAddObjectId(UObject* Object, bool& bOutNew);
+
+	/* Hands the buffer over once it is full, called between values. Only Flush, at the end of a pass, flushes the output */
+	void HandOver();
+	void FlushIfFull()
+	{
+		if (Buffer.Num() >= FlushSize)
+		{
+			HandOver();
+		}
+	}
+
+	TUniquePtr<FArchive> Output;
+	EActorDebuggerDumpFormat Format {EActorDebuggerDumpFormat::Json};
+	int32 MaxElements {0};
+
+	/* How many levels of subobjects the object being written expands, 0 while writing deltas */
+	int32 MaxDepth {0};
+
+	/* Reused for the whole session, handed over every FlushSize bytes */
+	TArray<uint8> Buffer;
+	int64 BytesWritten {0};
+
+	/* Reused for every value */
+	TStringBuilder<256> ValueText;
+	TStringBuilder<256> EscapedText;
+
+	/* Per JSON scope, whether a separator is needed before the next member or element */
+	TArray<bool, TInlineAllocator<16>> NeedsSeparator;
+
+	TMap<FName, uint32> NameIds;
+	TMap<TObjectKey<UObject>, uint32> ObjectIds;
+
+	/* The objects expanded by the trees of the current pass, so cycles and objects shared by trees are written once.
+	 * Keyed by FObjectKey as a pass spans frames */
+	TSet<FObjectKey> VisitedObjects;
+};
+
+class ACTORDEBUGGER_API FActorDebuggerDumpSession
+{
+public:
+	struct FOptions
+	{
+		EActorDebuggerDumpFormat Format {EActorDebuggerDumpFormat::Json};
+
+		/* Only write what changed since the previous pass, rather than whole trees */
+		bool bDeltas {false};
+
+		/* Seconds between the starts of passes, 0 writes a single pass */
+		double Interval {0.0};
+	};
+
+	/* Opens the output and selects the objects. Delta sessions also watch the subobjects of interest of each
+	 * object. Returns false if there is nothing to write */
+	bool Start(TConstArrayView<UObject*> Roots, const FOptions& InOptions, TUniquePtr<FArchive> Output);
+
+	/* Writes objects of the current pass until the budget is used up, starting a pass when one is due. Returns
+	 * false once a single pass session has written its pass and closed */
+	bool Tick(double CurrentTime, double BudgetSeconds);
+
+	void Stop() { Writer.Close(); }
+
+	/* Drops the schemas the watched objects hold, they are looked up again in the next pass */
+	void HandleSchemasInvalidated();
+
+	int32 GetNumObjects() const { return Objects.Num(); }
+	int32 GetNumPasses() const { return NumPasses; }
+	int64 GetBytesWritten() const { return Writer.GetBytesWritten(); }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FWatchedObject
+	{
+		TWeakObjectPtr<UObject> Object;
+		FActorDebuggerClassSchemaPtr Schema;
+
+		/* The value hash of each schema entry when the object was last written, delta sessions only */
+		TArray<uint64> Hashes;
+
+		/* Set until the object's values have been written once, and when its schema was looked up again */
+		bool bWriteAll {true};
+	};
+
+	void WatchObjectGraph(UObject* Object, int32 RemainingDepth, TSet<const UObject*>& Watched);
+	void WriteDelta(FWatchedObject& Watched);
+
+	FActorDebuggerDumpWriter Writer;
+	FOptions Options;
+	int32 Depth {0};
+
+	TArray<FWatchedObject> Objects;
+
+	/* The next object of the pass in progress, INDEX_NONE between passes */
+	int32 Cursor {INDEX_NONE};
+	double NextPassTime {0.0};
+	int32 NumPasses {0};
+};
+
+class ACTORDEBUGGER_API FActorDebuggerDumps
+{
+public:
+	static FActorDebuggerDumps& Get();
+
+	/* Starts a session writing to Target, "stdout" or a file name. An empty target picks a new file. Returns false
+	 * if the output can't be opened or none of the objects are valid */
+	bool Start(TConstArrayView<UObject*> Roots, const FActorDebuggerDumpSession::FOptions& Options, const FString& Target);
+
+	/* Closes every session, including single passes that haven't finished */
+	void StopAll();
+
+	int32 GetNumSessions() const { return Sessions.Num(); }
+
+	/* The actors in the world named Selector, or of the class named Selector */
+	static void FindActors(UWorld* World, const FString& Selector, TArray<UObject*>& OutActors);
+
+private:
+	bool HandleTicker(float DeltaTime);
+	void HandleSchemasInvalidated();
+
+	TArray<TUniquePtr<FActorDebuggerDumpSession>> Sessions;
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle SchemasInvalidatedHandle;
+};
@@ -0,0 +1,104 @@
+/**
+ * @file ActorDebuggerFormatPipeline.h
+ * @brief Declares the FActorDebuggerFormatPipeline class, which formats property values to text on worker threads.
+ *
+ * Exporting values to text is by far the most expensive part of displaying them, so it is kept off the game thread:
+ *
+ * 1. On the game thread the raw bytes of every property that needs formatting are copied into a staging buffer.
+ *    The buffer is reused between batches so this normally does not allocate.
+ * 2. When the batch is dispatched a worker task formats the copied bytes to strings with the formatters of their
+ *    nodes (see FActorDebuggerFormatters).
+ * 3. On the next tick the game thread collects the results and hands them to the nodes that requested them.
+ *    Jobs remember the arena generation of their node, so results for nodes released in the meantime are dropped.
+ *
+ * A batch can wait across frames, and so across a garbage collection, before a worker gets to it. The pipeline is
+ * an FGCObject that reports the owner of every job and the objects referenced by its copy, in both batches. The
+ * worker holds a GC scope guard while formatting so collection can't start under it. Objects that are collected
+ * anyway, because they were marked as garbage, are cleared from the reported references and the jobs that
+ * referenced them are skipped rather than formatted, their nodes are sampled again.
+ *
+ * Two batches are used: one being filled on the game thread and one being formatted on a worker. A batch is only
+ * dispatched once the previous one has been collected.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+#include "UObject/GCObject.h"
+#include "ActorDebuggerInspection.h"
+
+class ACTORDEBUGGER_API FActorDebuggerFormatPipeline : public FGCObject
+{
+public:
+	virtual ~FActorDebuggerFormatPipeline() override;
+
+	//~ Begin FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FActorDebuggerFormatPipeline"); }
+	//~ End FGCObject interface
+
+	/* Copies the value at ValuePtr into the staging buffer so it can be formatted for Item. Game thread only */
+	void Enqueue(FReflectedActorPropertyPtr Item, const uint8* ValuePtr, uint64 ValueHash);
+
+	/* Starts formatting everything enqueued since the last dispatch, unless a batch is still being formatted */
+	void Dispatch();
+
+	/* Returns the text of a finished batch along with the nodes that asked for it. Nodes that were released or
+	 * whose value changed again while the batch was in flight are skipped, the latter have been enqueued again */
+	void CollectResults(TArray<TPair<FReflectedActorPropertyPtr, FText>>& OutResults);
+
+	/* Waits for any batch in flight and throws away all pending work */
+	void Reset();
+
+	int32 GetNumPending() const { return Staging.Jobs.Num(); }
+
+	/* Memory held by the staging buffers of both batches */
+	SIZE_T GetAllocatedSize() const;
+
+	/* True while a dispatched batch has not been collected yet */
+	bool IsBusy() const { return bInFlight; }
+
+	/* Adds the objects the value holds strong references to, following structs and containers. Used to report
+	 * copied values to garbage collection */
+	static void GatherObjectReferences(const FProperty* Property, const uint8* ValuePtr, TArray<TObjectPtr<UObject>>& OutObjects);
+
+private:
+	struct FJob
+	{
+		FReflectedActorPropertyPtr Item {nullptr};
+		uint32 Generation {0};
+		FProperty* Property {nullptr};
+		FActorDebuggerFormatFunction Formatter {nullptr};
+		UObject* Owner {nullptr};
+		int32 Offset {0};
+
+		/* The job's range of the batch's References, the owner first */
+		int32 FirstReference {0};
+		int32 NumReferences {0};
+
+		/* Set by the worker if one of the references was collected, the job isn't formatted */
+		bool bSkipped {false};
+
+		uint64 ValueHash {0};
+		FString Result;
+	};
+
+	struct FBatch
+	{
+		TArray<uint8, TAlignedHeapAllocator<16>> Buffer;
+		TArray<FJob> Jobs;
+
+		/* Reported to garbage collection, which clears the objects it collects anyway */
+		TArray<TObjectPtr<UObject>> References;
+	};
+
+	static void FormatBatch(FBatch& Batch);
+	static void DestroyValues(FBatch& Batch);
+
+	FBatch Staging;
+	FBatch InFlight;
+	UE::Tasks::FTask Task;
+	bool bInFlight {false};
+};
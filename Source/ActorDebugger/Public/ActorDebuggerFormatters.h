@@ -0,0 +1,53 @@
+/**
+ * @file ActorDebuggerFormatters.h
+ * @brief Declares FActorDebuggerFormatters, the table of functions that format property values to text.
+ *
+ * ExportText is generic: it walks the property, builds a fresh FString and for structs exports every member through
+ * the same generic path. Most values the debugger shows are numbers, bools, enums, names, vectors, rotators,
+ * transforms, gameplay tags and object references, and these are cheap to format directly. A formatter is chosen
+ * once per schema entry (see FActorDebuggerPropertySchemaEntry), so displaying a value is a single indirect call that
+ * appends to a caller supplied string builder. Callers keep the builder on the stack or reuse it between values, so
+ * formatting the common types doesn't allocate. Every other type falls back to ExportText.
+ *
+ * The fast formatters produce the same text as ExportText with PPF_BlueprintDebugView, so the text can still be
+ * imported again. Gameplay tags are the exception: only the tag name is shown. They are recognised by the name and
+ * layout of their struct so that the plugin doesn't need to depend on the GameplayTags module.
+ *
+ * Formatters only read the value they are given, so they can run on worker threads as long as the objects the
+ * value references can't be collected meanwhile (see FActorDebuggerFormatPipeline).
+ *
+ * Classes and Structures:
+ * - FActorDebuggerFormatFunction: Appends the text of a value to a string builder.
+ * - FActorDebuggerFormatters: Chooses the formatter for a property and provides the ExportText fallback.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Misc/StringBuilder.h"
+
+class FProperty;
+
+/* Appends the text of the value at ValuePtr, which is a value of Property. Owner is the object the value belongs to,
+ * only the ExportText fallback uses it */
+typedef void(*FActorDebuggerFormatFunction)(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out);
+
+class ACTORDEBUGGER_API FActorDebuggerFormatters
+{
+public:
+	/* Returns the formatter for values of the property, never nullptr. Containers aren't looked into, pass the
+	 * element property to format their elements */
+	static FActorDebuggerFormatFunction Select(const FProperty* Property);
+
+	/* The fallback for types without a formatter of their own */
+	static void ExportText(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out);
+
+	static bool IsFallback(FActorDebuggerFormatFunction Formatter) { return Formatter == &ExportText; }
+
+	/* Selects a formatter and formats the value with it, for callers that format a property only once */
+	static void Format(const FProperty* Property, const uint8* ValuePtr, UObject* Owner, FStringBuilderBase& Out)
+	{
+		Select(Property)(Property, ValuePtr, Owner, Out);
+	}
+};
@@ -0,0 +1,136 @@
+/**
+ * @file ActorDebuggerHistory.h
+ * @brief Declares the FActorDebuggerHistoryRecorder class, which records the values of chosen properties every frame.
+ *
+ * The refresh scheduler only samples a row every few frames, so a value that is wrong for a frame or two is never
+ * seen. While recording, the recorder samples each watched property ("channel") once per frame into a ring buffer
+ * that holds the last N frames, and the widget's timeline scrubs back through them.
+ *
+ * Recording is built to cost no more than a copy per channel per frame:
+ *
+ * - Every buffer is allocated when recording starts and its size is fixed until it stops. The capacity is bounded
+ *   by ActorDebugger.HistoryFrames and by ActorDebugger.HistoryMaxBytes, whichever is smaller.
+ * - A frame is a single contiguous record with one fixed size slot per channel, so recording a frame writes one
+ *   block of memory from front to back.
+ * - Values are stored in a compact binary form chosen per channel when recording starts: plain old data is copied
+ *   as is, bools as one byte, object references as an FObjectKey, strings as their first few characters, containers
+ *   as their element count, anything else as a 64 bit hash of the value.
+ * - The address of a value is resolved once when recording starts if it can't move, e.g. a member of a struct
+ *   inside an object. Only values inside script containers are resolved every frame.
+ *
+ * The recorder is a single producer ring buffer. The game thread writes a frame and then publishes it by advancing
+ * an atomic frame count. Readers on any thread copy a slot out and then check that the writer has not wrapped
+ * around onto it in the meantime, so reading never takes a lock and never blocks recording.
+ *
+ * Classes and Structures:
+ * - EActorDebuggerHistoryEncoding: How a channel's values are stored in its slot.
+ * - FActorDebuggerHistoryRecorder: Owns the channels, the frame buffer and the frame times.
+ *
+ * Console Variables:
+ * - ActorDebugger.HistoryFrames: How many frames of history are kept.
+ * - ActorDebugger.HistoryMaxBytes: The most memory a recording may use, the number of frames is reduced to fit.
+ * - ActorDebugger.HistoryMaxChannels: How many properties can be recorded at once.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerInspection.h"
+#include <atomic>
+
+enum class EActorDebuggerHistoryEncoding : uint8
+{
+	/* The value's bytes, for plain old data up to MaxRawSize bytes */
+	Raw,
+	/* One byte, bools may be bitfields so they can't be copied */
+	Bool,
+	/* An FObjectKey, resolved safely when the value is displayed even if the object is gone */
+	Object,
+	/* The length of the string followed by its first MaxStringChars characters */
+	String,
+	/* The element count of a script container or C style array */
+	ContainerNum,
+	/* A 64 bit hash of the value, shows when a value changed but not what it changed to */
+	Hash
+};
+
+class ACTORDEBUGGER_API FActorDebuggerHistoryRecorder
+{
+public:
+	static constexpr int32 MaxRawSize = 128;
+	static constexpr int32 MaxStringChars = 24;
+
+	FActorDebuggerHistoryRecorder();
+	~FActorDebuggerHistoryRecorder();
+
+	/* Allocates the buffers for the given items and starts recording them. Items that are not values (pages) are
+	 * skipped. Returns the number of channels being recorded */
+	int32 Start(TConstArrayView<FReflectedActorPropertyPtr> Items);
+
+	/* Stops recording but keeps what was recorded so it can still be scrubbed */
+	void Stop();
+
+	/* Stops recording and frees the buffers. Must be called before the nodes being recorded are released */
+	void Reset();
+
+	/* Records one frame. Called once per frame on the game thread while recording */
+	void RecordFrame(double Time);
+
+	bool IsRecording() const { return bRecording; }
+	bool HasHistory() const { return GetNumFrames() > 0; }
+
+	/* Frames are numbered from the start of the recording. The readable ones are [GetFirstFrame(), GetEndFrame()) */
+	uint64 GetFirstFrame() const;
+	uint64 GetEndFrame() const { return NumRecorded.load(std::memory_order_acquire); }
+	int32 GetNumFrames() const { return static_cast<int32>(GetEndFrame() - GetFirstFrame()); }
+	int32 GetCapacity() const { return Capacity; }
+
+	/* The time a frame was recorded at, in platform seconds. Returns false if the frame has been overwritten */
+	bool GetFrameTime(uint64 Frame, double& OutTime) const;
+
+	int32 GetNumChannels() const { return Channels.Num(); }
+	FReflectedActorPropertyPtr GetChannelItem(int32 Channel) const { return Channels[Channel].Item; }
+
+	/* Decodes the value a channel had in the given frame. Returns false if the frame has been overwritten */
+	bool FormatValue(int32 Channel, uint64 Frame, FText& OutText) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FChannel
+	{
+		FReflectedActorPropertyPtr Item {nullptr};
+		uint32 Generation {0};
+		FProperty* Property {nullptr};
+		TWeakObjectPtr<UObject> Owner;
+
+		/* Set when the value's address can't change while its owner is alive */
+		const uint8* StableValuePtr {nullptr};
+
+		EActorDebuggerHistoryEncoding Encoding {EActorDebuggerHistoryEncoding::Hash};
+
+		/* Where the channel's slot starts within a frame and how big it is. The first byte of a slot is set if the
+		 * value existed in that frame */
+		int32 SlotOffset {0};
+		int32 SlotSize {0};
+	};
+
+	static EActorDebuggerHistoryEncoding ChooseEncoding(FReflectedActorPropertyPtr Item, int32& OutValueSize);
+	static void EncodeValue(const FChannel& Channel, const uint8* ValuePtr, uint8* Slot);
+
+	/* Copies a slot out of the ring. Returns false if the writer overwrote the frame while it was being copied */
+	bool ReadSlot(const FChannel& Channel, uint64 Frame, uint8* OutSlot) const;
+
+	TArray<FChannel> Channels;
+
+	/* Capacity frames of FrameStride bytes, oldest frames are overwritten first */
+	TArray<uint8, TAlignedHeapAllocator<16>> Frames;
+	TArray<double> FrameTimes;
+	int32 FrameStride {0};
+	int32 Capacity {0};
+
+	/* The number of frames written. Advanced by the writer only once a frame is complete */
+	std::atomic<uint64> NumRecorded {0};
+	bool bRecording {false};
+};
@@ -0,0 +1,346 @@
+/**
+ * @file ActorDebuggerInspection.h
+ * @brief Declares the FActorDebuggerInspection class, which owns the property tree of a single inspected UObject.
+ *
+ * The tree is built lazily. Selecting an object only gathers its own properties, the children of a property are
+ * gathered the first time the tree asks for them. Properties that reference a UObject expand into the properties of
+ * that object, struct properties expand into their members and TArray, TSet and TMap properties expand into their
+ * elements. Containers with more elements than the page size are split into pages of elements, and the elements of a
+ * page are only created when that page is expanded. A visited set that covers the whole inspection makes sure every
+ * object is expanded at most once, which breaks subobject cycles, and the depth and node budgets bound the cost of
+ * walking very large object graphs.
+ *
+ * Nodes don't hold pointers to their values, element pointers are invalidated whenever a container reallocates.
+ * Instead each node knows how to find its value from its parent, and the address is resolved (and bounds checked)
+ * every time it is needed.
+ *
+ * All nodes of an inspection are allocated from a paged arena and linked to each other by pointers into it. Nodes
+ * are trivially destructible, so releasing a tree of any size is a single reset of the arena and building the next
+ * one reuses its pages.
+ *
+ * Nodes reach the object their value lives in through a handle the inspection keeps per object, rather than checking
+ * the object every time they are resolved. The inspection listens for actors being destroyed, garbage collection,
+ * objects being reinstanced and levels and worlds being unloaded, and invalidates the handles of the objects
+ * affected in one pass. Invalidating a handle stops every node of the object from resolving and unlinks the subtree
+ * the object was expanded into, so a refresh never touches a collected object and never has to ask whether it might.
+ *
+ * Classes and Structures:
+ * - EReflectedPropertyKind: Describes where a node's value lives relative to its parent.
+ * - EActorDebuggerDiffKind: Describes how a node differs in a snapshot diff.
+ * - FActorDebuggerObjectHandle: An object of the tree and whether it is still alive.
+ * - FReflectedActorProperty: A node of the property tree. Holds its owning UObject, the schema entry or element
+ *   property describing it, the object it points to (if that object can be expanded) and links to its children.
+ * - FActorDebuggerNodeArena: Paged storage for the nodes of one inspection.
+ * - FActorDebuggerInspection: Owns the arena, the root items, the visited set, the object handles and the budgets of
+ *   an inspection.
+ *
+ * Console Variables:
+ * - ActorDebugger.MaxDepth: How many levels of objects, structs and containers can be expanded below the inspected object.
+ * - ActorDebugger.MaxNodes: How many property nodes a single inspection may create.
+ * - ActorDebugger.ContainerPageSize: Containers with more elements than this are split into pages of this size.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerSchemaCache.h"
+
+struct FReflectedActorProperty;
+class AActor;
+class ULevel;
+class UWorld;
+
+/* Nodes live in the inspection's arena, the tree view and rows only hold plain pointers to them */
+typedef FReflectedActorProperty* FReflectedActorPropertyPtr;
+
+enum class EReflectedPropertyKind : uint8
+{
+	/* A property of a UObject, the value lives at Object + Entry->Offset */
+	ObjectMember,
+	/* A property of a struct, the value lives at the parent's value + Entry->Offset */
+	StructMember,
+	/* An element of a C style array property, Index is the element index */
+	StaticArrayElement,
+	/* An element of a TArray, Index is the element index */
+	ArrayElement,
+	/* An element of a TSet, Index is the sparse index of the element */
+	SetElement,
+	/* A pair of a TMap, Index is the sparse index of the pair. The node's value is the pair's value */
+	MapPair,
+	/* A range of the parent container's elements, from Index up to but not including PageEnd */
+	Page
+};
+
+/* How a node differs in the snapshot diff its widget is showing, see ActorDebuggerSnapshot.h */
+enum class EActorDebuggerDiffKind : uint8
+{
+	None,
+	/* The value differs */
+	Changed,
+	/* The node only exists in the newer snapshot, or only in the older one */
+	Added,
+	Removed,
+	/* Something below the node differs */
+	ContainsChanges
+};
+
+/* An object whose properties are, or may be, gathered into the tree. Owned by the inspection, which keeps the handles
+ * of released trees for reuse so nodes never point at freed memory */
+struct FActorDebuggerObjectHandle
+{
+	UObject* Object {nullptr};
+	TWeakObjectPtr<UObject> WeakObject;
+
+	/* The node whose reference expands the object, nullptr for the inspected object */
+	FReflectedActorProperty* OwnerItem {nullptr};
+
+	/* Cleared when the object is destroyed, collected, reinstanced or unloaded */
+	bool bAlive {false};
+};
+
+/* Nodes hold nothing that needs destructing so a whole tree can be released by resetting the arena */
+struct ACTORDEBUGGER_API FReflectedActorProperty
+{
+	UObject* Object {nullptr};
+
+	/* The handle of Object. The node only resolves while the handle is alive */
+	FActorDebuggerObjectHandle* Handle {nullptr};
+	const FActorDebuggerPropertySchemaEntry* Entry {nullptr};
+
+	/* The property describing the node's value. For elements this is the container's element (or map value) property */
+	FProperty* Property {nullptr};
+
+	/* Formats the node's value, taken from the schema entry of the node or of its container */
+	FActorDebuggerFormatFunction Formatter {nullptr};
+
+	/* Links to the rest of the tree. These point into the same arena, which never moves its nodes */
+	FReflectedActorProperty* Parent {nullptr};
+	FReflectedActorProperty* FirstChild {nullptr};
+	FReflectedActorProperty* LastChild {nullptr};
+	FReflectedActorProperty* NextSibling {nullptr};
+	int32 NumChildren {0};
+
+	EReflectedPropertyKind Kind {EReflectedPropertyKind::ObjectMember};
+	int32 Index {INDEX_NONE};
+	int32 LogicalIndex {INDEX_NONE};
+	int32 PageEnd {INDEX_NONE};
+
+	/* The object this property points to, if it will be expanded. Its properties become children on demand */
+	UObject* ChildObject {nullptr};
+	FActorDebuggerObjectHandle* ChildHandle {nullptr};
+	int32 Depth {0};
+	bool bChildrenResolved {false};
+	bool bMayHaveChildren {false};
+
+	/* The number of elements a container had when its children were resolved */
+	int32 ResolvedNum {0};
+
+	/* Hash of the raw value bytes at the time the value was last formatted. Only valid once bHasValue is set */
+	uint64 ValueHash {0};
+	bool bHasValue {false};
+
+	/* Set while the history recorder has a channel for this node */
+	bool bRecorded {false};
+
+	/* Set while a watchpoint is watching this node */
+	bool bWatched {false};
+
+	/* Set while the widget shows a diff in which the node differs */
+	EActorDebuggerDiffKind DiffKind {EActorDebuggerDiffKind::None};
+
+	/* Set when the node has been unlinked from its parent, e.g. its container's element count changed */
+	bool bDetached {false};
+
+	/* When the refresh scheduler last sampled this value and when it last saw it change, in platform seconds */
+	double LastSampleTime {0.0};
+	double LastChangeTime {0.0};
+
+	/* The arena generation the node was allocated in. Lets deferred work detect that its node has been released */
+	uint32 Generation {0};
+
+	/* The node's position in the arena, nodes are numbered in the order they were gathered */
+	int32 NodeIndex {INDEX_NONE};
+
+	bool IsValid() const
+	{
+		return Handle && Handle->bAlive && (Property != nullptr || Kind == EReflectedPropertyKind::Page);
+	}
+
+	/* True if the node or one of its ancestors has been unlinked from the tree */
+	bool IsDetached() const
+	{
+		for (const FReflectedActorProperty* Node = this; Node; Node = Node->Parent)
+		{
+			if (Node->bDetached)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool CanHaveChildren() const
+	{
+		return bChildrenResolved ? NumChildren > 0 : bMayHaveChildren;
+	}
+
+	/* Returns a pointer to the node's value or nullptr if it no longer exists, e.g. the element was removed */
+	const uint8* ResolveValuePtr() const;
+
+	/* Returns the value's address if it can't move for as long as the owning object lives, or nullptr if it can */
+	const uint8* ResolveStableValuePtr() const;
+
+	/* Returns a pointer to the key of a MapPair node */
+	const uint8* ResolveMapKeyPtr() const;
+
+	/* True if the node displays its element count rather than its value: script containers and C style arrays */
+	bool IsContainer() const;
+
+	/* The number of elements of a container node, given its resolved value */
+	int32 GetContainerNum(const uint8* ValuePtr) const;
+	static int32 GetContainerNum(const FProperty* ContainerProperty, const uint8* ValuePtr);
+
+	/* Hashes the value bytes for change detection. Containers only hash their element count, their elements have
+	 * rows of their own */
+	uint64 HashValue() const;
+
+	FText GetDisplayName() const;
+};
+
+/**
+ * Stores the nodes of one inspection in fixed size pages. Nodes are never moved or freed individually, so pointers
+ * to them stay valid until the arena is reset. Resetting keeps the pages for the next inspection, so building a new
+ * tree normally allocates nothing.
+ */
+class ACTORDEBUGGER_API FActorDebuggerNodeArena
+{
+public:
+	static constexpr int32 NodesPerPage = 4096;
+
+	FActorDebuggerNodeArena() = default;
+	~FActorDebuggerNodeArena();
+
+	FReflectedActorPropertyPtr Allocate();
+
+	/* Releases every node at once. Pointers to released nodes can be recognised by their generation */
+	void Reset();
+
+	/* Releases every node and the pages holding them */
+	void Empty();
+
+	int32 Num() const { return NumNodes; }
+
+	/* Returns the node with the given NodeIndex, which must be less than Num() */
+	FReflectedActorPropertyPtr Get(int32 Index) const
+	{
+		check(Index >= 0 && Index < NumNodes);
+		return &Pages[Index / NodesPerPage][Index % NodesPerPage];
+	}
+
+	uint32 GetGeneration() const { return Generation; }
+	SIZE_T GetAllocatedSize() const { return Pages.Num() * NodesPerPage * sizeof(FReflectedActorProperty); }
+
+private:
+	TArray<TUniquePtr<FReflectedActorProperty[]>> Pages;
+	int32 NumNodes {0};
+	uint32 Generation {1};
+};
+
+class ACTORDEBUGGER_API FActorDebuggerInspection
+{
+public:
+	FActorDebuggerInspection() = default;
+	~FActorDebuggerInspection();
+
+	/* The engine delegates are bound to the inspection's address */
+	FActorDebuggerInspection(const FActorDebuggerInspection&) = delete;
+	FActorDebuggerInspection& operator=(const FActorDebuggerInspection&) = delete;
+
+	/* Discards the current tree and gathers the top level properties of the given object */
+	void SetObject(UObject* Object);
+	void Reset();
+
+	/* Fills OutChildren with the children of the given item, gathering them the first time they are asked for */
+	void GetChildren(FReflectedActorPropertyPtr Item, TArray<FReflectedActorPropertyPtr>& OutChildren);
+
+	/* Throws away the children of a container whose element count has changed so they are gathered again.
+	 * Returns true if the children were discarded */
+	bool RefreshContainerChildren(FReflectedActorPropertyPtr Item);
+
+	UObject* GetObject() const { return RootObject; }
+
+	/* False once the inspected object has been destroyed, collected, reinstanced or unloaded, or if there is none */
+	bool IsObjectAlive() const { return RootHandle && RootHandle->bAlive; }
+
+	/* Invalidates the handles of the objects for which Predicate returns true, unlinking the subtrees they were
+	 * expanded into, and broadcasts OnObjectsInvalidated if there were any. Returns the number invalidated */
+	int32 InvalidateObjects(TFunctionRef<bool(const FActorDebuggerObjectHandle&)> Predicate, UObject* RootReplacement = nullptr);
+
+	/* Broadcast after objects of the tree were invalidated, with whether the inspected object was one of them and
+	 * the object that replaces it if it was reinstanced */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnObjectsInvalidated, bool /* bRootInvalidated */, UObject* /* RootReplacement */);
+	FOnObjectsInvalidated OnObjectsInvalidated;
+	const TArray<FReflectedActorPropertyPtr>& GetRootItems() const { return RootItems; }
+	int32 GetNumNodes() const { return Arena.Num(); }
+	uint32 GetGeneration() const { return Arena.GetGeneration(); }
+	const FActorDebuggerNodeArena& GetArena() const { return Arena; }
+	bool IsNodeBudgetExhausted() const { return Arena.Num() >= MaxNodes; }
+
+	/* Memory held by the tree: the arena's pages and the bookkeeping around them */
+	SIZE_T GetAllocatedSize() const;
+
+	static bool IsUObjectOfInterest(UObject* Object);
+	static bool IsAssetObject(UObject* Object);
+
+private:
+	void ResolveChildren(FReflectedActorPropertyPtr Item);
+	void UnlinkChildren(FReflectedActorPropertyPtr Item);
+	void GatherProperties(FReflectedActorPropertyPtr ParentItem, FActorDebuggerObjectHandle* ObjectHandle);
+	void GatherStructMembers(FReflectedActorPropertyPtr ParentItem, const UScriptStruct* Struct);
+	void GatherStaticArrayElements(FReflectedActorPropertyPtr ParentItem);
+	void GatherContainerChildren(FReflectedActorPropertyPtr ParentItem, const uint8* ContainerPtr);
+	void GatherContainerElements(FReflectedActorPropertyPtr ContainerItem, FReflectedActorPropertyPtr ListItem, const uint8* ContainerPtr, int32 Start, int32 End);
+
+	/* Allocates a node, links it under ListItem (or the roots) and counts it against the budget. Returns nullptr
+	 * once the budget is exhausted */
+	FReflectedActorPropertyPtr MakeNode(FActorDebuggerObjectHandle* ObjectHandle, FReflectedActorPropertyPtr ParentItem, FReflectedActorPropertyPtr ListItem, EReflectedPropertyKind Kind, FProperty* Property);
+	void InitializeChildState(FReflectedActorProperty& Node);
+	FActorDebuggerClassSchemaPtr FindOrBuildSchema(const UStruct* Struct);
+	FActorDebuggerObjectHandle* AddHandle(UObject* Object, FReflectedActorPropertyPtr OwnerItem);
+
+	void RegisterDelegates();
+	void UnregisterDelegates();
+	void HandlePostGarbageCollect();
+	void HandleActorDestroyed(AActor* Actor);
+	void HandleObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap);
+	void HandleLevelRemoved(ULevel* Level, UWorld* World);
+	void HandleWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+
+	UObject* RootObject {nullptr};
+	TArray<FReflectedActorPropertyPtr> RootItems;
+	FActorDebuggerNodeArena Arena;
+
+	/* Keeps the schemas the nodes' entries point into alive for as long as the nodes exist */
+	TMap<const UStruct*, FActorDebuggerClassSchemaPtr> HeldSchemas;
+
+	/* Every object that has been claimed by a node for expansion during this inspection */
+	TSet<const UObject*> VisitedObjects;
+
+	/* The handles of the objects in the tree, the first NumHandles of which are in use. Kept between inspections */
+	TArray<TUniquePtr<FActorDebuggerObjectHandle>> Handles;
+	int32 NumHandles {0};
+	FActorDebuggerObjectHandle* RootHandle {nullptr};
+
+	/* Bound while an object is inspected. Actors report their destruction to the world they are in */
+	FDelegateHandle PostGarbageCollectHandle;
+	FDelegateHandle ObjectsReinstancedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle ActorDestroyedHandle;
+	TWeakObjectPtr<UWorld> ActorDestroyedWorld;
+
+	int32 MaxDepth {0};
+	int32 MaxNodes {0};
+	int32 PageSize {0};
+};
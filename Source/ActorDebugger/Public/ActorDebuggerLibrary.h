@@ -5,8 +5,10 @@
  * @brief Declares the UActorDebuggerLibrary class, providing static utility functions for actor debugging in Unreal Engine.
  *
  * This header defines the UActorDebuggerLibrary class, which extends UBlueprintFunctionLibrary to expose
- * debugging-related functionality to Blueprints. It includes methods for selecting actors and managing
- * a shared window instance for debugging purposes.
+ * debugging-related functionality to Blueprints: inspecting objects in debugger windows, captures, queries, class
+ * tables, snapshots, call traces, dumps, the debug server and memory measurements. Most of it is also available as
+ * ActorDebugger.* console commands, registered with their usage in ActorDebuggerLibrary.cpp. The functions that open
+ * windows log a warning and return false in a process without Slate.
  *
  * @copyright Copyright (c) Dan Wheeler. All rights reserved.
  */
@@ -14,16 +16,181 @@
 
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
+#include "ActorDebuggerPropertyAccessor.h"
 #include "ActorDebuggerLibrary.generated.h"
 
+class SActorDebuggerWidget;
+
 UCLASS()
 class ACTORDEBUGGER_API UActorDebuggerLibrary : public UBlueprintFunctionLibrary
 {
 	GENERATED_BODY()
 
 public:
-	static TSharedPtr<SWindow> Window;
+	/* Shows the actor in the most recently used debugger window, opening one if none is open */
 	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
 	static bool SelectActor(AActor* ActorToSelect);
 
+	/* Opens a debugger window on the object, or brings its window to the front if it is already inspected */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static bool AddInspectedObject(UObject* Object);
+
+	/* Closes the windows inspecting the object. Returns false if it isn't inspected */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static bool RemoveInspectedObject(UObject* Object);
+
+	/* The objects inspected by the open debugger windows, oldest window first */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Actor Debugger")
+	static TArray<UObject*> GetInspectedObjects();
+
+	/* Closes every debugger window */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static void RemoveAllInspectedObjects();
+
+	/* Starts capturing the selected actor to a file. A file under Saved/ActorDebugger/Captures is used if Filename is empty */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static bool StartCapture(const FString& Filename);
+
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static void StopCapture();
+
+	/* Opens the debugger window on a capture so it can be replayed */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static bool OpenCapture(const FString& Filename);
+
+	/* Finds the objects of the class in the context object's world for which every predicate, such as "Health < 10"
+	 * or "Weapon.Ammo[0] >= 3", holds. Returns false if a predicate doesn't compile */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger", meta = (WorldContext = "WorldContextObject"))
+	static bool QueryObjects(UObject* WorldContextObject, UClass* Class, const TArray<FString>& Predicates, TArray<UObject*>& OutMatches);
+
+	/* Runs a query such as "Pawn Health < 10 && Controller != None" in the context object's world, or in every world
+	 * if there is none, and lists the matches in a window. Clicking a match opens it in the debugger */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger", meta = (WorldContext = "WorldContextObject"))
+	static bool ShowQuery(UObject* WorldContextObject, const FString& Query);
+
+	/* Opens a table of every instance of the class in the context object's world, or in every world if there is
+	 * none, with a column per property path and statistics of the number columns. Clicking a row opens its object
+	 * in the debugger */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger", meta = (WorldContext = "WorldContextObject"))
+	static bool ShowClassTable(UObject* WorldContextObject, UClass* Class, const TArray<FString>& Columns);
+
+	/* Records every value below the object as a named snapshot, replacing any snapshot of the same name. The object
+	 * of the active window is used if Object is None, a name is chosen if Name is empty. Returns false if there is
+	 * nothing to take a snapshot of */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static bool TakeSnapshot(UObject* Object, const FString& Name);
+
+	/* Compares two snapshots, returning the paths of the values that differ such as "Weapon.Ammo[0]". Returns false
+	 * if either snapshot doesn't exist */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static bool DiffSnapshots(const FString& OldName, const FString& NewName, TArray<FString>& OutChangedPaths);
+
+	/* Colors the rows of the active window that differ from a snapshot or another object of the same class, or
+	 * that differ between two snapshots if Target names two. An empty Target clears the diff */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static bool ShowDiff(const FString& Target);
+
+	/* Traces the functions called on the object of the active window and its subobjects, listing them in the
+	 * window's call timeline. Only one trace runs at a time. Returns false if no object is inspected */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static bool StartCallTrace();
+
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger")
+	static void StopCallTrace();
+
+	/* Writes every property of the objects once, to Target ("stdout" or a file name, empty picks a new file under
+	 * Saved/ActorDebugger/Dumps). The dump is written over the next frames. Returns false if there is nothing to
+	 * dump or the file can't be created */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Dump")
+	static bool DumpObjects(const TArray<UObject*>& Objects, const FString& Target, bool bBinary);
+
+	/* Writes the properties of the objects and their subobjects that changed every Interval seconds, until
+	 * StopDumps is called */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Dump")
+	static bool StartDumpStream(const TArray<UObject*>& Objects, const FString& Target, bool bBinary, float Interval = 1.0f);
+
+	/* Closes every dump, streamed or not */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Dump")
+	static void StopDumps();
+
+	/* Serves objects to debugger windows in other processes, on the loopback address only. Returns false if the
+	 * port can't be bound */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Server")
+	static bool StartServer(int32 Port = 41801);
+
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Server")
+	static void StopServer();
+
+	/* Connects to the debug server of another process, unless already connected, and opens a window on the object
+	 * Selector names (an object path, or an actor or class name) once the server has answered */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Server")
+	static bool ConnectToServer(const FString& Selector, int32 Port = 41801);
+
+	/* Measures the object and the objects below it and logs what they retain in total and the NumContributors
+	 * objects taking the most memory of their own. The object of the active window is used if Object is None.
+	 * Returns the retained size in bytes */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Memory")
+	static int64 LogMemory(UObject* Object, int32 NumContributors = 10);
+
+	/* Shows the memory columns in the active window, sorted by retained size if bLargestFirst. Returns false if no
+	 * window is open */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Memory")
+	static bool ShowMemory(bool bLargestFirst = true);
+
+	/* Compiles a property path such as "Movement.Velocity" or "Weapon.Ammo[0]" against the class. Compiling the same
+	 * path again returns the same accessor. Returns false and logs the problem if the path doesn't compile */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Property Access")
+	static bool CompilePropertyAccessor(UClass* Class, const FString& Path, FActorDebuggerPropertyAccessor& OutAccessor);
+
+	/* Reads an integer, floating point, enum or bool value, or a container's element count. Returns false if the
+	 * object isn't of the accessor's class, the path doesn't resolve or the value isn't a number */
+	UFUNCTION(BlueprintPure, Category = "Actor Debugger|Property Access")
+	static bool ReadNumberProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, double& OutValue);
+
+	UFUNCTION(BlueprintPure, Category = "Actor Debugger|Property Access")
+	static bool ReadIntegerProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, int64& OutValue);
+
+	UFUNCTION(BlueprintPure, Category = "Actor Debugger|Property Access")
+	static bool ReadBoolProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, bool& OutValue);
+
+	UFUNCTION(BlueprintPure, Category = "Actor Debugger|Property Access")
+	static bool ReadVectorProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, FVector& OutValue);
+
+	UFUNCTION(BlueprintPure, Category = "Actor Debugger|Property Access")
+	static bool ReadRotatorProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, FRotator& OutValue);
+
+	UFUNCTION(BlueprintPure, Category = "Actor Debugger|Property Access")
+	static bool ReadObjectProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, UObject*& OutValue);
+
+	/* Reads any value as the debugger shows it */
+	UFUNCTION(BlueprintPure, Category = "Actor Debugger|Property Access")
+	static bool ReadStringProperty(const FActorDebuggerPropertyAccessor& Accessor, UObject* Object, FString& OutValue);
+
+	/* Reads a number from every object. OutValues and OutResolved have one entry per object, values that don't
+	 * resolve are zero. Returns how many resolved */
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Property Access")
+	static int32 ReadNumberPropertyBatch(const FActorDebuggerPropertyAccessor& Accessor, const TArray<UObject*>& Objects, TArray<double>& OutValues, TArray<bool>& OutResolved);
+
+	UFUNCTION(BlueprintCallable, Category = "Actor Debugger|Property Access")
+	static int32 ReadVectorPropertyBatch(const FActorDebuggerPropertyAccessor& Accessor, const TArray<UObject*>& Objects, TArray<FVector>& OutValues, TArray<bool>& OutResolved);
+
+private:
+	/* False, with a warning, in processes without Slate such as dedicated servers */
+	static bool CanOpenWindows();
+
+	/* Returns the most recently used window, creating one if none is open */
+	static TSharedRef<SWindow> FindOrCreateWindow();
+	static TSharedPtr<SWindow> FindActiveWindow();
+	static TSharedPtr<SWindow> FindWindow(const UObject* Object);
+	static TSharedRef<SWindow> CreateWindow();
+	static void CloseWindow(const TSharedRef<SWindow>& Window);
+	static void SetWindowObject(const TSharedRef<SWindow>& Window, UObject* Object);
+	static TSharedRef<SActorDebuggerWidget> GetWidget(const TSharedRef<SWindow>& Window);
+
+	/* Every open debugger window, in the order they were opened */
+	static TArray<TSharedRef<SWindow>> Windows;
+
+	/* The window most recently selected into, captures and SelectActor act on it */
+	static TWeakPtr<SWindow> ActiveWindow;
+
 };
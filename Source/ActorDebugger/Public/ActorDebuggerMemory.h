@@ -0,0 +1,175 @@
+/**
+ * @file ActorDebuggerMemory.h
+ * @brief Declares the FActorDebuggerMemory class, which measures what an object and the objects below it cost in memory.
+ *
+ * An object's own footprint is the size of its class, the heap memory its properties own (string buffers and the
+ * allocations of script containers, unused capacity included) and its exclusive resource size as GetResourceSizeEx
+ * reports it, e.g. the render data of a mesh. Only what reflection can see is counted, native members that aren't
+ * properties are part of the class size but their allocations are not.
+ *
+ * Every object the tree would expand is measured, following the same references through the same schemas, up to
+ * ActorDebugger.MemoryMaxDepth levels below the inspected object. The graph is walked a level at a time and each
+ * object is attributed to the reference it was first reached through, so every object is counted once. An object's
+ * retained size is its own footprint plus the retained sizes of the objects attributed to it, summed bottom up, and
+ * the retained size of the inspected object is the footprint of the whole graph.
+ *
+ * The sizes and references of a level's objects are read on worker threads while the game thread waits for them, so
+ * nothing they read can change under them. Every update walks and measures the whole graph again, any object below
+ * may have changed. Only resource sizes are kept from one update to the next: they are taken on the game thread once
+ * the graph is walked, and only when an object's sizes or references changed or its resource size is older than
+ * ActorDebugger.MemoryResourceRefreshSeconds, since render resources can grow while the properties stay the same. An
+ * update that finds every object as it was keeps its results and its generation.
+ *
+ * Rows of the tree are measured from the results on the game thread: the bytes of the row's value and the retained
+ * sizes of the objects first reached through a reference inside it. A row whose object wasn't measured has no size.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerMemorySize: The inline and heap bytes of a value.
+ * - FActorDebuggerObjectFootprint: A measured object, its own and retained bytes and the reference it was reached through.
+ * - FActorDebuggerNodeMemory: What one row of the tree costs.
+ * - FActorDebuggerMemory: Measures the graph below an object, keeping the resource sizes of objects that didn't change.
+ *
+ * Console Variables:
+ * - ActorDebugger.MemoryMaxDepth: How many levels of referenced objects are measured below the inspected object.
+ * - ActorDebugger.MemoryMaxObjects: How many objects a single measurement may include.
+ * - ActorDebugger.MemoryResourceRefreshSeconds: How long an unchanged object keeps the resource size taken for it.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerSchemaCache.h"
+
+struct FActorDebuggerMemorySize
+{
+	/* Bytes taken inside whatever holds the value */
+	int64 Inline {0};
+
+	/* Heap bytes owned by the value, including the unused capacity of its containers */
+	int64 Allocated {0};
+
+	/* The part of Allocated holding elements or characters */
+	int64 Used {0};
+
+	int64 GetTotal() const { return Inline + Allocated; }
+	int64 GetSlack() const { return Allocated - Used; }
+};
+
+struct FActorDebuggerObjectFootprint
+{
+	TWeakObjectPtr<UObject> Object;
+
+	/* The class size and the heap owned by every property of the object, not only those the tree shows */
+	FActorDebuggerMemorySize Size;
+
+	/* The exclusive resource size reported by GetResourceSizeEx and FPlatformTime::Seconds when it was taken */
+	int64 ResourceSize {0};
+	double ResourceSizeTime {0.0};
+
+	/* Size.GetTotal() plus ResourceSize */
+	int64 Exclusive {0};
+
+	/* Exclusive plus the Retained of every object attributed to this one */
+	int64 Retained {0};
+
+	/* The index of the object this one was first reached from and the address of the reference it was reached
+	 * through. INDEX_NONE and null for the measured root */
+	int32 Owner {INDEX_NONE};
+	const void* OwnerSlot {nullptr};
+
+	/* Levels of references below the root */
+	int32 Depth {0};
+
+	/* Hash of the sizes and references the object was measured with */
+	uint64 ShapeHash {0};
+};
+
+struct FActorDebuggerNodeMemory
+{
+	/* The row's value itself */
+	FActorDebuggerMemorySize Value;
+
+	/* For a reference to an object first reached through it, that object's own bytes and the resource part of them */
+	int64 ObjectExclusive {0};
+	int64 ObjectResourceSize {0};
+
+	/* Everything the row holds on to: its value and the retained sizes of the objects first reached through it */
+	int64 Retained {0};
+
+	int64 GetSize() const { return Value.GetTotal() + ObjectExclusive; }
+};
+
+class ACTORDEBUGGER_API FActorDebuggerMemory
+{
+public:
+	/* Measures the whole graph below Root again, on worker threads. Only the recent resource sizes of objects that
+	 * didn't change are reused. Returns true and advances the generation if anything differs from the last update */
+	bool Update(UObject* Root);
+	void Reset();
+
+	/* The measured objects a level at a time, the root first. An object's owner always comes before it */
+	const TArray<FActorDebuggerObjectFootprint>& GetObjects() const { return Objects; }
+	const FActorDebuggerObjectFootprint* Find(const UObject* Object) const;
+
+	/* The retained size of the root, 0 before the first update */
+	int64 GetRetained() const { return Objects.Num() > 0 ? Objects[0].Retained : 0; }
+
+	/* Advanced by every update that changed the results, so anything derived from them knows when to measure again */
+	uint32 GetGeneration() const { return Generation; }
+
+	/* Objects whose resource size the last update had to take again */
+	int32 GetNumResourceSizesTaken() const { return NumResourceSizesTaken; }
+
+	/* Set if the last update stopped at ActorDebugger.MemoryMaxObjects */
+	bool IsTruncated() const { return bTruncated; }
+
+	/* Measures one row of the tree. Returns false if its value doesn't resolve or its object wasn't measured */
+	bool MeasureNode(const FReflectedActorProperty& Node, FActorDebuggerNodeMemory& OutMemory) const;
+
+	/* The indices of up to Num objects taking the most memory of their own, largest first */
+	void GetLargestContributors(int32 Num, TArray<int32>& OutIndices) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+	/* Adds the ArrayDim elements of the property at ValuePtr, following strings and script containers to the
+	 * memory they own */
+	static void MeasureValue(const FProperty* Property, const uint8* ValuePtr, FActorDebuggerMemorySize& OutSize);
+
+	/* "812 B", "12.4 KB" or "3.1 MB" */
+	static FString FormatBytes(int64 Bytes);
+
+private:
+	struct FReference
+	{
+		const void* Slot {nullptr};
+		UObject* Object {nullptr};
+	};
+
+	/* Builds the schemas of a class and of every struct its schema entries lead to, so workers only read them */
+	void PrepareSchemas(const UStruct* Struct);
+
+	/* Measures the sizes and references of one object on a worker, everything but its resource size */
+	void MeasureObject(UObject* Object, bool bGatherReferences, FActorDebuggerObjectFootprint& OutFootprint, TArray<FReference>& OutReferences) const;
+
+	/* Adds the references to objects the tree would expand found in ArrayDim elements of the property */
+	void GatherReferences(const FProperty* Property, const uint8* ValuePtr, TArray<FReference>& OutReferences) const;
+	void GatherElementReferences(const FProperty* Property, const uint8* ValuePtr, TArray<FReference>& OutReferences) const;
+
+	/* Measures the elements with logical indices [Start, End) of a script container, for a page of the tree */
+	void MeasureElements(const FProperty* ContainerProperty, const uint8* ContainerPtr, int32 Start, int32 End, FActorDebuggerMemorySize& OutSize, TArray<FReference>& OutReferences) const;
+
+	/* Adds the Retained of every referenced object that was first reached through the reference */
+	int64 SumOwnedRetained(const TArray<FReference>& References) const;
+
+	TArray<FActorDebuggerObjectFootprint> Objects;
+	TMap<const UObject*, int32> Indices;
+
+	/* The schemas of the measured classes and their structs. Read by the workers, only changed between levels */
+	TMap<const UStruct*, FActorDebuggerClassSchemaPtr> Schemas;
+
+	uint32 Generation {0};
+	int32 NumResourceSizesTaken {0};
+	bool bTruncated {false};
+};
@@ -0,0 +1,115 @@
+/**
+ * @file ActorDebuggerPropertyAccessor.h
+ * @brief Declares FActorDebuggerPropertyAccessor, a property path compiled once against a class and read from many of its objects.
+ *
+ * An accessor wraps an FActorDebuggerPropertyPath, such as "Movement.Velocity" or "HealthComponent.Current", along
+ * with what kind of value is at its end. Reading a value checks that the object is of the accessor's class, resolves
+ * the path's offsets and converts the value to the type asked for. No names are looked up and nothing is allocated,
+ * except by ReadString which formats the value.
+ *
+ * Accessors are compiled through a cache keyed by class and path, so compiling the same path again, e.g. from a
+ * Blueprint that compiles it every tick, costs a map lookup. Copies of an accessor share the compiled path. The
+ * cache is emptied along with the schema cache when classes are reinstanced or reloaded, and accessors compiled
+ * against a class that has since been replaced stop reading anything.
+ *
+ * Number reads accept integers, floating point values, enums (their underlying value), bools (0 or 1) and
+ * containers (their element count), like the number columns of a class table. The batched reads resolve the path
+ * against every object of an array, on worker threads when there are enough of them.
+ *
+ * The reads are also exposed to Blueprint by UActorDebuggerLibrary.
+ *
+ * Classes and Structures:
+ * - EActorDebuggerAccessorType: What kind of value is at the end of a compiled path.
+ * - FActorDebuggerCompiledAccessor: The compiled path, its class and its value type, shared between copies.
+ * - FActorDebuggerPropertyAccessor: The Blueprint facing handle to a compiled accessor, with the typed reads.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerPropertyPath.h"
+#include "ActorDebuggerFormatters.h"
+#include "ActorDebuggerPropertyAccessor.generated.h"
+
+class FNumericProperty;
+
+enum class EActorDebuggerAccessorType : uint8
+{
+	/* Integers, floating point values and enums */
+	Number,
+	Bool,
+	/* Script containers and C style arrays, read as their element count */
+	Count,
+	Vector,
+	Rotator,
+	Object,
+	/* Anything else, only readable as text */
+	Other
+};
+
+struct ACTORDEBUGGER_API FActorDebuggerCompiledAccessor
+{
+	TWeakObjectPtr<const UClass> Class;
+	FActorDebuggerPropertyPath Path;
+	EActorDebuggerAccessorType Type {EActorDebuggerAccessorType::Other};
+
+	/* The numeric property of Number accessors, for enums the underlying property */
+	const FNumericProperty* NumericProperty {nullptr};
+
+	FActorDebuggerFormatFunction Formatter {nullptr};
+};
+
+USTRUCT(BlueprintType)
+struct ACTORDEBUGGER_API FActorDebuggerPropertyAccessor
+{
+	GENERATED_BODY()
+
+	/* Compiles the path against the class, or returns the accessor already compiled for them. Returns an accessor
+	 * that reads nothing and describes the problem if the path doesn't compile */
+	static FActorDebuggerPropertyAccessor Compile(UClass* Class, const FString& Path, FText& OutError);
+
+	/* Empties the cache of compiled accessors, accessors already handed out keep working */
+	static void ResetCache();
+
+	bool IsValid() const { return Compiled.IsValid(); }
+	EActorDebuggerAccessorType GetType() const { return Compiled.IsValid() ? Compiled->Type : EActorDebuggerAccessorType::Other; }
+	const FActorDebuggerPropertyPath* GetPath() const { return Compiled.IsValid() ? &Compiled->Path : nullptr; }
+
+	/* The address of the value in the object, or nullptr if the object isn't of the accessor's class or the path
+	 * doesn't resolve, e.g. through a None reference */
+	const uint8* Resolve(const UObject* Object) const;
+
+	/* Each read returns false and leaves the value alone if the path doesn't resolve or the value isn't of a type
+	 * that converts to the one asked for */
+	bool ReadNumber(const UObject* Object, double& OutValue) const;
+	bool ReadInteger(const UObject* Object, int64& OutValue) const;
+	bool ReadBool(const UObject* Object, bool& OutValue) const;
+	bool ReadVector(const UObject* Object, FVector& OutValue) const;
+	bool ReadRotator(const UObject* Object, FRotator& OutValue) const;
+	bool ReadObject(const UObject* Object, UObject*& OutValue) const;
+
+	/* Formats any value as the debugger shows it */
+	bool ReadString(const UObject* Object, FString& OutValue) const;
+
+	/* Reads the value from every object, OutValues and OutResolved get one entry per object. Values that don't
+	 * resolve are zero. Returns how many resolved */
+	int32 ReadNumbers(TConstArrayView<UObject*> Objects, TArray<double>& OutValues, TArray<bool>& OutResolved) const;
+	int32 ReadVectors(TConstArrayView<UObject*> Objects, TArray<FVector>& OutValues, TArray<bool>& OutResolved) const;
+
+	/* The class and path the accessor was compiled for */
+	UPROPERTY(BlueprintReadOnly, Category = "Actor Debugger")
+	TObjectPtr<UClass> Class;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Actor Debugger")
+	FString Path;
+
+private:
+	/* Resolves against an object already known to be of the accessor's class */
+	const uint8* ResolveUnchecked(const UObject* Object) const { return Compiled->Path.Resolve(Object); }
+
+	/* Converts the value at the end of the path, shared by the single and the batched reads */
+	bool ConvertNumber(const uint8* ValuePtr, double& OutValue) const;
+
+	TSharedPtr<const FActorDebuggerCompiledAccessor, ESPMode::ThreadSafe> Compiled;
+};
@@ -0,0 +1,70 @@
+/**
+ * @file ActorDebuggerPropertyPath.h
+ * @brief Declares the FActorDebuggerPropertyPath struct, a path such as "Weapon.Ammo[2].Count" compiled into the memory steps that resolve it.
+ *
+ * A path is a chain of property names separated by dots. Each name may be followed by an index into a C style array
+ * or a TArray. Names can step into structs and follow object references. Names are looked up once when the path is
+ * compiled against a class or struct, and consecutive struct members are merged into a single offset, so resolving
+ * a path only adds offsets, dereferences object references and bounds checks array indices.
+ *
+ * Resolving reads nothing but the memory along the path, so a compiled path can be resolved against many objects
+ * from many threads at once while none of them are being modified.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerPropertyPath: The compiled steps of a path and the property at its end.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FProperty;
+class UStruct;
+
+struct ACTORDEBUGGER_API FActorDebuggerPropertyPath
+{
+	/* Compiles the path against a class or struct. Returns false and describes the problem if a name doesn't exist,
+	 * an index is out of range or a name can't be stepped into */
+	bool Compile(const UStruct* Struct, const FString& InPath, FText& OutError);
+
+	/* Returns the address of the value at the end of the path inside the given object or struct, or nullptr if an
+	 * object reference along the way is None or an array index is out of range */
+	const uint8* Resolve(const void* Container) const;
+
+	bool IsCompiled() const { return LeafProperty != nullptr; }
+
+	/* The property of the value at the end of the path. For an indexed TArray this is the array's inner property */
+	const FProperty* GetLeafProperty() const { return LeafProperty; }
+
+	/* True if the path ends at a whole container (a script container or a C style array) rather than one value */
+	bool IsLeafContainer() const { return bLeafContainer; }
+
+	const FString& ToString() const { return Path; }
+
+private:
+	enum class EStepKind : uint8
+	{
+		/* Moves the address along by Offset bytes */
+		Offset,
+		/* Replaces the address with the object referenced there */
+		Object,
+		/* Replaces the address with the address of element Index of the TArray there */
+		ArrayElement
+	};
+
+	struct FStep
+	{
+		EStepKind Kind {EStepKind::Offset};
+		int32 Offset {0};
+		int32 Index {0};
+		const FProperty* Property {nullptr};
+	};
+
+	void AddOffset(int32 Offset);
+
+	TArray<FStep, TInlineAllocator<4>> Steps;
+	const FProperty* LeafProperty {nullptr};
+	bool bLeafContainer {false};
+	FString Path;
+};
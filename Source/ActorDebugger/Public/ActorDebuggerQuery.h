@@ -0,0 +1,84 @@
+/**
+ * @file ActorDebuggerQuery.h
+ * @brief Declares the FActorDebuggerQuery class, which finds every object of a class whose properties meet a set of predicates.
+ *
+ * A query is a class and predicates over property paths that must all hold, written as
+ * "Pawn Health < 10 && Controller != None" or "BP_Enemy_C Weapon.Ammo[0] <= 3". Each predicate is a property path
+ * (see FActorDebuggerPropertyPath) and a condition (see FActorDebuggerCondition), both compiled once against the
+ * class, so testing an object never looks up a name or exports a value to text.
+ *
+ * Running a query gathers the live objects of the class in the world on the game thread, then tests them in
+ * parallel against their raw property memory. The game thread waits for the scan, so the objects can't be changed
+ * or garbage collected while it runs.
+ *
+ * Console Commands:
+ * - ActorDebugger.Query Class Predicate [&& Predicate...]: Lists the matches in the log and in a window, clicking a
+ *   match opens it in the debugger. See UActorDebuggerLibrary.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerQueryResult: The matching objects and what the scan cost.
+ * - FActorDebuggerQuery: The compiled class and predicates.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerPropertyPath.h"
+#include "ActorDebuggerCondition.h"
+
+struct FActorDebuggerQueryResult
+{
+	/* Matching objects in the order they were gathered, valid until the next garbage collection */
+	TArray<UObject*> Matches;
+
+	/* Objects of the class that were tested */
+	int32 NumScanned {0};
+
+	double Milliseconds {0.0};
+};
+
+class ACTORDEBUGGER_API FActorDebuggerQuery
+{
+public:
+	/* Compiles "ClassName Predicate && Predicate". Classes are found by name with or without their A or U prefix,
+	 * Blueprint classes with or without their _C suffix */
+	bool Compile(const FString& Query, FText& OutError);
+
+	/* Compiles predicates such as "Health < 10" against the class. Every predicate must hold for an object to match,
+	 * an empty list matches every object of the class */
+	bool Compile(UClass* InClass, const TArray<FString>& Predicates, FText& OutError);
+
+	/* Finds the matching objects in the given world, or in every world if World is nullptr. Only call this on the
+	 * game thread once the query has compiled */
+	FActorDebuggerQueryResult Run(const UWorld* World) const;
+
+	/* Returns true if the object meets every predicate, the object must be of the query's class */
+	bool Matches(const UObject* Object) const;
+
+	UClass* GetClass() const { return Class; }
+
+	/* The query as it would be typed, "ClassName Predicate && Predicate" */
+	FString ToString() const;
+
+	/* Splits "Health < 10 && Controller != None" into its predicates */
+	static TArray<FString> SplitPredicates(const FString& Text);
+
+	/* Finds a class by the name a user would type, nullptr if there is none */
+	static UClass* FindClass(const FString& Name);
+
+	/* Gathers the live instances of the class and its subclasses in the given world, or in every world if World is
+	 * nullptr. Only call this on the game thread */
+	static void GatherObjects(const UClass* ObjectClass, const UWorld* World, TArray<UObject*>& OutObjects);
+
+private:
+	struct FPredicate
+	{
+		FActorDebuggerPropertyPath Path;
+		FActorDebuggerCondition Condition;
+		FString Text;
+	};
+
+	UClass* Class {nullptr};
+	TArray<FPredicate> Predicates;
+};
@@ -0,0 +1,60 @@
+/**
+ * @file ActorDebuggerQueryWidget.h
+ * @brief Declares the SActorDebuggerQueryWidget class, a Slate widget listing the objects matched by a query.
+ *
+ * The widget shows the query, how many of the objects it scanned matched and what the scan cost, and one row per
+ * match. Clicking a row opens the match in a debugger window of its own. Refresh runs the query again against the
+ * same world. The query is compiled again from its text every time it runs, in case its class was recompiled since.
+ * Matches are held weakly, rows of objects destroyed since the query ran say so.
+ *
+ * Classes and Types:
+ * - FActorDebuggerQueryMatch: One matching object and the label its row shows.
+ * - SActorDebuggerQueryWidget: The summary line, the refresh button and the list of matches.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class STextBlock;
+
+struct FActorDebuggerQueryMatch
+{
+	TWeakObjectPtr<UObject> Object;
+	FString Name;
+	FString ClassName;
+};
+
+class ACTORDEBUGGER_API SActorDebuggerQueryWidget : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SActorDebuggerQueryWidget)
+	{}
+		/* The query as it would be typed, "ClassName Predicate && Predicate" */
+		SLATE_ARGUMENT(FString, Query)
+		/* The world to search, every world is searched if it isn't set */
+		SLATE_ARGUMENT(TWeakObjectPtr<UWorld>, World)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/* Compiles and runs the query, replacing the listed matches, and logs what it found. Returns false and
+	 * describes the problem if the query doesn't compile */
+	bool RunQuery(FText& OutError);
+
+private:
+	typedef TSharedPtr<FActorDebuggerQueryMatch> FQueryMatchPtr;
+
+	TSharedRef<ITableRow> HandleGenerateRow(FQueryMatchPtr Match, const TSharedRef<STableViewBase>& OwnerTable);
+	void HandleMatchClicked(FQueryMatchPtr Match);
+	FReply HandleRefreshClicked();
+
+	FString QueryText;
+	TWeakObjectPtr<UWorld> World;
+	bool bSearchAllWorlds {true};
+
+	TArray<FQueryMatchPtr> Matches;
+	TSharedPtr<SListView<FQueryMatchPtr>> MatchesView;
+	TSharedPtr<STextBlock> SummaryTextBlock;
+};
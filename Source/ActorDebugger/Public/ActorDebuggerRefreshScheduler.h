@@ -0,0 +1,101 @@
+/**
+ * @file ActorDebuggerRefreshScheduler.h
+ * @brief Declares the FActorDebuggerRefreshScheduler class, which spreads value sampling across frames under a time budget.
+ *
+ * Instead of checking every row in one burst, the scheduler is ticked every frame and samples rows until the
+ * frame's budget is spent. Rows that are due are ordered so that:
+ *
+ * 1. Rows that have not been sampled within the staleness bound go first, oldest first.
+ * 2. Rows whose value changed recently ("hot" rows) are sampled at the refresh rate.
+ * 3. All other rows are sampled at the staleness bound, oldest first.
+ *
+ * Whatever doesn't fit in the budget is deferred to the next frame. At least one row is sampled every frame so
+ * that progress is made even with a tiny budget.
+ *
+ * Every debugger widget registers itself as a client of one shared scheduler, with the refresh rate of its hot rows
+ * and the function that samples its rows. The rows of every client compete for the same budget, so the cost of
+ * keeping values up to date grows with the rows in view, not with the number of open windows. Each widget calls
+ * TickOncePerFrame from its own tick and whichever gets there first samples for all of them.
+ *
+ * Console Variables:
+ * - ActorDebugger.RefreshBudgetUs: Microseconds per frame the scheduler may spend sampling rows.
+ * - ActorDebugger.MaxStalenessMs: The longest a row may go without being sampled.
+ * - ActorDebugger.HotRowSeconds: How long a row counts as recently changed after its value changes.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerInspection.h"
+
+struct FActorDebuggerRefreshStats
+{
+	/* Time spent sampling on the last tick and a moving average of it, in microseconds */
+	double LastTickMicroseconds {0.0};
+	double AverageTickMicroseconds {0.0};
+	double BudgetMicroseconds {0.0};
+
+	int32 NumItems {0};
+	int32 NumSampled {0};
+	int32 NumChanged {0};
+
+	/* Rows that were due but did not fit in the budget */
+	int32 NumDeferred {0};
+
+	/* Rows that had gone longer than the staleness bound without being sampled */
+	int32 NumOverdue {0};
+};
+
+class ACTORDEBUGGER_API FActorDebuggerRefreshScheduler
+{
+public:
+	/* Samples the item and returns true if its value changed */
+	DECLARE_DELEGATE_RetVal_OneParam(bool, FSampleItem, const FReflectedActorPropertyPtr&);
+
+	/* The scheduler shared by every debugger widget. Created for the first widget that asks for it and destroyed
+	 * with the last one holding it */
+	static TSharedRef<FActorDebuggerRefreshScheduler> GetShared();
+
+	/* Registers a source of items whose hot items are sampled RefreshRate times per second. Returns the id its
+	 * items are added under */
+	int32 AddClient(float RefreshRate, const FSampleItem& SampleItem);
+
+	/* Unregisters a client along with its items */
+	void RemoveClient(int32 ClientId);
+
+	void AddItem(int32 ClientId, const FReflectedActorPropertyPtr& Item);
+	void RemoveItem(const FReflectedActorPropertyPtr& Item);
+
+	/* Removes every item of one client, e.g. when it inspects another object */
+	void ResetClient(int32 ClientId);
+
+	/* Samples due items of every client in priority order until the frame budget is used up */
+	void Tick(double CurrentTime);
+
+	/* Ticks unless the scheduler has already been ticked this frame, for clients that tick it themselves */
+	void TickOncePerFrame();
+
+	int32 GetNumClients() const { return Clients.Num(); }
+	const FActorDebuggerRefreshStats& GetStats() const { return Stats; }
+
+private:
+	struct FClient
+	{
+		FSampleItem SampleItem;
+		double HotInterval {0.0};
+	};
+
+	struct FScheduledItem
+	{
+		FReflectedActorPropertyPtr Item {nullptr};
+		int32 ClientId {INDEX_NONE};
+	};
+
+	/* Indices are client ids, they stay stable while other clients come and go */
+	TSparseArray<FClient> Clients;
+	TArray<FScheduledItem> Items;
+	TArray<int32> DueItems;
+	uint64 LastTickFrame {MAX_uint64};
+	FActorDebuggerRefreshStats Stats;
+};
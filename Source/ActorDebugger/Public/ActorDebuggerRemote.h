@@ -0,0 +1,115 @@
+/**
+ * @file ActorDebuggerRemote.h
+ * @brief Declares the FActorDebuggerRemote class, the viewer side of the debug server.
+ *
+ * The viewer connects to a FActorDebuggerServer in another process on the same machine, a game or a dedicated
+ * server, and subscribes to objects by selector. Like a capture replay it creates a transient replay object of each
+ * served class and writes the values of every update into it, so the debugger tree inspects the replay objects
+ * exactly as it would live ones. Served properties whose type doesn't match the class loaded by the viewer are
+ * skipped, and references to objects the viewer doesn't have are null.
+ *
+ * Everything runs on the game thread of the viewer: its ticker sends what was queued, reads what arrived and applies
+ * it.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerRemote: The viewer's connection to a debug server and its replay objects.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Memory/MemoryView.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerCapture.h"
+#include "ActorDebuggerServer.h"
+
+class FArchive;
+class FSocket;
+
+class ACTORDEBUGGER_API FActorDebuggerRemote
+{
+public:
+	static FActorDebuggerRemote& Get();
+
+	~FActorDebuggerRemote();
+
+	/* Connects to a server on the loopback address. Returns false if there is none on the port */
+	bool Connect(int32 Port = ActorDebuggerServer::DefaultPort);
+
+	/* Closes the connection and releases the replay objects */
+	void Disconnect();
+
+	bool IsConnected() const { return Socket != nullptr; }
+
+	/* Asks for the objects selected by an object path, or an actor or class name. Returns the id OnSubscribed
+	 * answers with, INDEX_NONE if not connected */
+	int32 Subscribe(const FString& Selector);
+	void Unsubscribe(int32 Request);
+
+	/* How many updates per second the server sends at most */
+	void SetUpdateRate(float UpdatesPerSecond);
+
+	/* Sends what is queued, then reads and applies every message that has arrived. Called by the viewer's ticker */
+	void Tick();
+
+	UObject* GetReplayObject(int32 ObjectId) const;
+	uint64 GetLastFrame() const { return LastFrame; }
+
+	/* Broadcast when the server has resolved a subscription, with the replay object of the selected object or null
+	 * if the selector matched nothing */
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSubscribed, int32 /*Request*/, UObject* /*ReplayObject*/);
+	FOnSubscribed OnSubscribed;
+
+private:
+	struct FSchemaProperty
+	{
+		EActorDebuggerCaptureEncoding Encoding {EActorDebuggerCaptureEncoding::None};
+
+		/* The matching property of the loaded class, if its type matches */
+		FProperty* LiveProperty {nullptr};
+	};
+
+	struct FSchema
+	{
+		FString ClassPath;
+		UClass* LiveClass {nullptr};
+		TArray<FSchemaProperty> Properties;
+	};
+
+	struct FObject
+	{
+		int32 SchemaId {INDEX_NONE};
+		FString Name;
+		FString PathName;
+		TStrongObjectPtr<UObject> ReplayObject;
+	};
+
+	bool HandleTicker(float DeltaTime);
+	void SendMessage(ActorDebuggerServer::EMessage Type, TFunctionRef<void(FArchive&)> WritePayload);
+	bool ReadMessage(ActorDebuggerServer::EMessage Type, FMemoryView Payload);
+	bool ReadSchema(FMemoryView Payload);
+	bool ReadObject(FMemoryView Payload);
+	bool ReadSubscribed(FMemoryView Payload);
+	bool ReadUpdate(FMemoryView Payload);
+	bool ReadRemoved(FMemoryView Payload);
+
+	/* The object's replay object, created the first time it is needed */
+	UObject* FindOrCreateReplayObject(int32 ObjectId);
+
+	/* Served objects resolve to their replay objects, anything else is looked up by path in this process */
+	UObject* DecodeObjectRef(FArchive& Ar);
+
+	FSocket* Socket {nullptr};
+	TArray<uint8> Received;
+	TArray<uint8> Outgoing;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	TMap<int32, FSchema> Schemas;
+	TMap<int32, FObject> Objects;
+	TMap<FString, int32> ObjectsByPath;
+
+	int32 NextRequest {1};
+	uint64 LastFrame {0};
+};
@@ -0,0 +1,125 @@
+/**
+ * @file ActorDebuggerSchemaCache.h
+ * @brief Declares the FActorDebuggerSchemaCache class, a shared cache of the reflected properties that the Actor Debugger displays for each class.
+ *
+ * Walking a class with TFieldIterator and looking properties up by name is expensive for classes with hundreds of
+ * properties, so each class is compiled once into a flat FActorDebuggerClassSchema. Every entry holds the resolved
+ * FProperty along with its offset, a type tag, the kind of container it is and the formatter for its values, so that
+ * the tree and the row widgets never need to repeat the reflection lookup.
+ *
+ * Classes and Structures:
+ * - EActorDebuggerPropertyType: Type tag describing the value (or element value for containers) of a property.
+ * - EActorDebuggerContainerKind: Describes whether a property is a single value, a static array or a script container.
+ * - FActorDebuggerPropertySchemaEntry: A single precomputed property of a class.
+ * - FActorDebuggerClassSchema: The flat list of filtered properties for one class.
+ * - FActorDebuggerSchemaCache: The shared cache keyed by class. Schemas are invalidated on hot reload and when
+ *   Blueprints are recompiled, since both of these regenerate the FProperty chain of a class.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "ActorDebuggerFormatters.h"
+
+class FProperty;
+class UStruct;
+enum class EReloadCompleteReason;
+
+enum class EActorDebuggerPropertyType : uint8
+{
+	Unknown,
+	Bool,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	Byte,
+	UInt16,
+	UInt32,
+	UInt64,
+	Float,
+	Double,
+	Enum,
+	Name,
+	String,
+	Text,
+	Object,
+	WeakObject,
+	SoftObject,
+	Interface,
+	Struct,
+	Delegate
+};
+
+enum class EActorDebuggerContainerKind : uint8
+{
+	None,
+	StaticArray,
+	Array,
+	Map,
+	Set
+};
+
+struct FActorDebuggerPropertySchemaEntry
+{
+	FProperty* Property {nullptr};
+	FName Name;
+	int32 Offset {0};
+	int32 ElementSize {0};
+	int32 ArrayDim {1};
+	EActorDebuggerPropertyType TypeTag {EActorDebuggerPropertyType::Unknown};
+	EActorDebuggerContainerKind ContainerKind {EActorDebuggerContainerKind::None};
+
+	/* Formats the value, or the element value for containers, like the type tag */
+	FActorDebuggerFormatFunction Formatter {nullptr};
+
+	/* Returns a pointer to this property's value inside the given container (a UObject or struct instance) */
+	FORCEINLINE const uint8* GetValuePtr(const void* Container) const
+	{
+		return static_cast<const uint8*>(Container) + Offset;
+	}
+};
+
+struct FActorDebuggerClassSchema
+{
+	TWeakObjectPtr<const UStruct> Struct;
+	TArray<FActorDebuggerPropertySchemaEntry> Entries;
+};
+
+typedef TSharedPtr<const FActorDebuggerClassSchema, ESPMode::ThreadSafe> FActorDebuggerClassSchemaPtr;
+
+class ACTORDEBUGGER_API FActorDebuggerSchemaCache
+{
+public:
+	static FActorDebuggerSchemaCache& Get();
+
+	/* Returns the schema for the given class or struct, compiling it on first use */
+	FActorDebuggerClassSchemaPtr FindOrBuild(const UStruct* Struct);
+
+	void InvalidateAll();
+
+	void RegisterDelegates();
+	void UnregisterDelegates();
+
+	DECLARE_MULTICAST_DELEGATE(FOnSchemasInvalidated);
+
+	/* Broadcast after cached schemas have been thrown away. Anything holding schema entries should rebuild */
+	FOnSchemasInvalidated OnSchemasInvalidated;
+
+	static EActorDebuggerPropertyType GetPropertyType(const FProperty* Property);
+	static EActorDebuggerContainerKind GetContainerKind(const FProperty* Property);
+
+	/* Returns the property describing the elements of a script container (the values for maps), or the property itself */
+	static const FProperty* GetElementProperty(const FProperty* Property);
+
+private:
+	FActorDebuggerClassSchemaPtr BuildSchema(const UStruct* Struct) const;
+	void HandleReloadComplete(EReloadCompleteReason Reason);
+	void HandleObjectsReinstanced(const TMap<UObject*, UObject*>& OldToNewInstanceMap);
+
+	TMap<const UStruct*, FActorDebuggerClassSchemaPtr> Schemas;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle ObjectsReinstancedHandle;
+};
@@ -0,0 +1,89 @@
+/**
+ * @file ActorDebuggerSearchIndex.h
+ * @brief Declares the FActorDebuggerSearchIndex class, which indexes the names and values of an inspection's nodes for searching.
+ *
+ * The tree is gathered lazily, so most of the properties a search could match don't exist until their parents are
+ * expanded. While a search is active the index gathers the rest of the tree itself, a few nodes at a time under a
+ * per frame time budget, in the order the arena allocated them (breadth first). Results grow as the crawl proceeds.
+ *
+ * Every node gets an entry holding its lower case name and formatted value. Entries are found through a trigram
+ * index: each three character sequence of a name or value maps to the entries that contain it. A query looks up
+ * the shortest list among its own trigrams and checks only those entries, so a query costs the same on a small or
+ * a very large inspection. Queries shorter than three characters check every entry.
+ *
+ * Values are kept up to date without formatting every value every frame. Rows in view report the values they format
+ * anyway, and the index checks the hash of the other values round robin, formatting only those that changed. A
+ * changed value adds its new trigrams, the lists still hold the entry under its old trigrams until the index is
+ * compacted, which is harmless since every candidate is checked against its current text.
+ *
+ * Queries containing '.' match paths: the last part is matched against names and values, each earlier part must
+ * match the name of an ancestor, in order. E.g. "weapon.ammo" finds Ammo inside anything named like Weapon.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerSearchIndex: The entries, the trigram lists and the cursors of the crawl and of the value refresh.
+ *
+ * Console Variables:
+ * - ActorDebugger.SearchBudgetMs: How long the index may spend crawling and refreshing values each frame.
+ * - ActorDebugger.SearchMaxResults: The most matches a query returns.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerInspection.h"
+
+class ACTORDEBUGGER_API FActorDebuggerSearchIndex
+{
+public:
+	/* Forgets every entry, must be called whenever the inspection is reset */
+	void Reset();
+
+	/* Indexes nodes gathered since the last tick, gathers more of the tree and refreshes values that changed,
+	 * until the time budget runs out. Returns true if the results of a query may have changed */
+	bool Tick(FActorDebuggerInspection& Inspection);
+
+	/* Records the value a row formatted, so the index doesn't have to format it again */
+	void SetValue(FReflectedActorPropertyPtr Item, const FString& ValueText);
+
+	/* Fills OutMatches with the nodes matching the query, in the order they were gathered */
+	void Search(const FString& Query, TArray<FReflectedActorPropertyPtr>& OutMatches) const;
+
+	int32 GetNumEntries() const { return Entries.Num(); }
+
+	/* True once every node that can be gathered has been, within the inspection's budgets */
+	bool IsComplete(const FActorDebuggerInspection& Inspection) const;
+
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FEntry
+	{
+		FReflectedActorPropertyPtr Item {nullptr};
+		FString Name;
+		FString Value;
+		uint64 ValueHash {0};
+		bool bHasValue {false};
+	};
+
+	void AddTrigrams(int32 EntryIndex, const FString& Text);
+	void SetEntryValue(int32 EntryIndex, const FString& ValueText, uint64 ValueHash);
+	void Compact();
+	bool Matches(const FEntry& Entry, const FString& Term, TConstArrayView<FString> AncestorTerms) const;
+
+	static uint32 MakeTrigram(const TCHAR* Chars);
+
+	TArray<FEntry> Entries;
+
+	/* Trigram to the entries containing it. Entries are appended as they gain a trigram, so lists are unordered */
+	TMap<uint32, TArray<int32>> Trigrams;
+	int32 NumPostings {0};
+	int32 NumStalePostings {0};
+
+	/* The arena generation the entries belong to */
+	uint32 Generation {0};
+
+	/* The next node to gather the children of and the next entry to check the value of */
+	int32 CrawlCursor {0};
+	int32 ValueCursor {0};
+};
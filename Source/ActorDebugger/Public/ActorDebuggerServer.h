@@ -0,0 +1,365 @@
+/**
+ * @file ActorDebuggerServer.h
+ * @brief Declares the debug server, which publishes the properties of subscribed objects to viewers in other processes.
+ *
+ * Opening a debugger window in the game process costs the game frame time and isn't possible at all without Slate.
+ * The server lets a viewer in another process (see FActorDebuggerRemote) inspect the game instead. It only listens
+ * on the loopback address.
+ *
+ * Messages are a uint32 size, a uint8 type and a payload, in either direction. After a Hello the server sends:
+ *
+ * - Schema: The properties of one class, laid out like a capture schema record. Sent once per class and viewer.
+ * - Object: One served object, its id, schema id, name and path, laid out like a capture object record. Sent again
+ *   with a new schema id when the schemas are invalidated.
+ * - Subscribed: The request id of a subscription and the ids of the objects it resolved to.
+ * - Update: The frame number and the values that changed, each an object id, a property index, a size and the value
+ *   encoded the way captures encode it. References to objects are always sent as their path.
+ * - Removed: The ids of objects no viewer is subscribed to any more.
+ *
+ * Viewers send Subscribe (a request id and a selector, either an object path or an actor or class name as dumps
+ * take them), Unsubscribe (a request id) and SetUpdateRate (updates per second).
+ *
+ * The game thread's share of the work is kept to what changed. Each tick it hashes the values of the served objects
+ * whose viewers are due a sample, an object is sampled as often as the viewer subscribed to it that asks for the
+ * most updates, and copies the ones whose hash changed into a staging batch, like the format pipeline does. A worker task encodes
+ * the batch into messages once, whatever the number of viewers, and hands the encoded frame to the network thread.
+ * The server reports the objects referenced by the copies to garbage collection until they are encoded, the task
+ * holds a GC scope guard while it encodes. A value whose objects were collected anyway, because they were marked as
+ * garbage, isn't encoded and is copied again in the next sample.
+ * The network thread keeps, per viewer, the latest value of every property that changed since that viewer's last
+ * update and sends them as one Update when the viewer is due one, so a viewer that is slow or asks for few updates
+ * only ever gets the latest values. A viewer that hasn't taken ActorDebugger.ServerBacklogKB of what was sent to it
+ * isn't sent more until it catches up.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerServer: Owns the listening socket, the served objects and the network thread.
+ *
+ * Console Variables:
+ * - ActorDebugger.ServerDepth: How many levels of referenced objects are served along with a subscribed object.
+ * - ActorDebugger.ServerUpdateRate: Updates per second sent to a viewer that hasn't asked for another rate.
+ * - ActorDebugger.ServerBacklogKB: How much unsent data a viewer may have before its updates are held back.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/Runnable.h"
+#include "Memory/MemoryView.h"
+#include "Tasks/Task.h"
+#include "UObject/GCObject.h"
+#include "UObject/ObjectKey.h"
+#include "ActorDebuggerCapture.h"
+#include "ActorDebuggerSchemaCache.h"
+#include <atomic>
+
+class FEvent;
+class FRunnableThread;
+class FSocket;
+
+namespace ActorDebuggerServer
+{
+	static constexpr int32 DefaultPort = 41801;
+	static constexpr uint32 Version = 1;
+
+	/* uint32 size of the type and payload, then the type */
+	static constexpr int32 HeaderSize = 5;
+
+	/* Larger messages are taken for a broken stream and close the connection */
+	static constexpr int32 MaxMessageSize = 64 * 1024 * 1024;
+
+	enum class EMessage : uint8
+	{
+		/* uint32 version */
+		Hello = 1,
+		/* int32 schema id, class path, int32 count, then per property name, C++ type, uint8 encoding, int32 element
+		 * size and int32 array dim */
+		Schema = 2,
+		/* int32 object id, int32 schema id, name and path */
+		Object = 3,
+		/* int32 request id, int32 count and the object ids, the object of the selector first */
+		Subscribed = 4,
+		/* uint64 frame, int32 count, then per value int32 object id, int32 property index, int32 size and the bytes */
+		Update = 5,
+		/* int32 count and the object ids */
+		Removed = 6,
+
+		/* int32 request id and the selector */
+		Subscribe = 16,
+		/* int32 request id */
+		Unsubscribe = 17,
+		/* float updates per second */
+		SetUpdateRate = 18
+	};
+
+	/* Appends the header of a message to Out and returns where it starts, the payload is appended after it */
+	ACTORDEBUGGER_API int32 BeginMessage(TArray<uint8>& Out, EMessage Type);
+
+	/* Writes the size of the message started at Start */
+	ACTORDEBUGGER_API void EndMessage(TArray<uint8>& Out, int32 Start);
+
+	/* Reads the message at InOutOffset, if all of it has arrived, and moves the offset past it. Returns false if the
+	 * message is incomplete, bOutError is set if it can never be read */
+	ACTORDEBUGGER_API bool ReadMessage(FMemoryView Data, int32& InOutOffset, EMessage& OutType, FMemoryView& OutPayload, bool& bOutError);
+}
+
+class ACTORDEBUGGER_API FActorDebuggerServer : public FGCObject, private FRunnable
+{
+public:
+	static FActorDebuggerServer& Get();
+
+	//~ Begin FGCObject interface
+	virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+	virtual FString GetReferencerName() const override { return TEXT("FActorDebuggerServer"); }
+	//~ End FGCObject interface
+
+	/* Starts listening on the loopback address. Returns false if the port can't be bound */
+	bool Open(int32 Port = ActorDebuggerServer::DefaultPort);
+
+	/* Disconnects every viewer and stops serving */
+	void Close();
+
+	bool IsOpen() const { return Thread != nullptr; }
+	int32 GetPort() const { return BoundPort; }
+	int32 GetNumClients() const { return NumClients; }
+
+	/* Objects served to at least one viewer */
+	int32 GetNumObjects() const { return ObjectIds.Num(); }
+
+	/* Runs the viewers' commands, copies what changed and hands it to a worker to encode. Called by the server's
+	 * ticker every frame */
+	void Tick();
+
+private:
+	/* An object being served. The ids of released objects are reused once viewers have been told of the release */
+	struct FServedObject
+	{
+		TWeakObjectPtr<UObject> Object;
+		TObjectKey<UObject> Key;
+		FActorDebuggerClassSchemaPtr Schema;
+		int32 SchemaId {INDEX_NONE};
+		TArray<EActorDebuggerCaptureEncoding> Encodings;
+
+		/* The hash of each schema entry when it was last sent */
+		TArray<uint64> Hashes;
+
+		/* Subscriptions of any viewer that include the object, it is removed when this drops to 0 */
+		int32 NumSubscriptions {0};
+
+		/* Set when the object is added and when its schema was looked up again */
+		bool bWriteAll {true};
+
+		/* The shortest update interval of the viewers subscribed to the object, and when it was last sampled */
+		double UpdateInterval {0.0};
+		double SampleTime {0.0};
+	};
+
+	struct FSubscription
+	{
+		uint32 ClientId {0};
+		int32 Request {0};
+		TArray<int32> ObjectIds;
+	};
+
+	/* Sent by the network thread to the game thread */
+	struct FCommand
+	{
+		enum class EType : uint8
+		{
+			Subscribe,
+			Unsubscribe,
+			SetUpdateRate,
+			Disconnected
+		};
+
+		EType Type {EType::Subscribe};
+		uint32 ClientId {0};
+		int32 Request {0};
+		FString Selector;
+		double UpdateInterval {0.0};
+	};
+
+	/* A value copied on the game thread, encoded by the task */
+	struct FStagedValue
+	{
+		int32 ObjectId {INDEX_NONE};
+		int32 PropertyIndex {0};
+		FProperty* Property {nullptr};
+		EActorDebuggerCaptureEncoding Encoding {EActorDebuggerCaptureEncoding::None};
+		UObject* Owner {nullptr};
+		int32 Offset {0};
+
+		/* The value's range of the batch's References, the owner first */
+		int32 FirstReference {0};
+		int32 NumReferences {0};
+	};
+
+	struct FStagedObject
+	{
+		int32 ObjectId {INDEX_NONE};
+		int32 SchemaId {INDEX_NONE};
+		FString Name;
+		FString PathName;
+	};
+
+	struct FStagedSchema
+	{
+		int32 SchemaId {INDEX_NONE};
+		FString ClassPath;
+		FActorDebuggerClassSchemaPtr Schema;
+	};
+
+	/* Everything that happened on the game thread since the last dispatch */
+	struct FBatch
+	{
+		uint64 Frame {0};
+		TArray<uint8, TAlignedHeapAllocator<16>> Buffer;
+		TArray<FStagedValue> Values;
+		TArray<FStagedSchema> Schemas;
+		TArray<FStagedObject> Objects;
+		TArray<FSubscription> Subscriptions;
+		TArray<TPair<uint32, int32>> Unsubscribed;
+		TArray<int32> Removed;
+
+		/* Reported to garbage collection, which clears the objects it collects anyway */
+		TArray<TObjectPtr<UObject>> References;
+
+		/* Values the task didn't encode because one of their references was cleared, by object id and property index */
+		TArray<TPair<int32, int32>> Skipped;
+
+		bool IsEmpty() const;
+		void Reset();
+	};
+
+	/* An encoded schema or object message */
+	struct FDescription
+	{
+		int32 Id {INDEX_NONE};
+
+		/* The schema of an object */
+		int32 SchemaId {INDEX_NONE};
+		TArray<uint8> Message;
+	};
+
+	/* A batch encoded once and shared by every viewer. Values are views into Bytes */
+	struct FEncodedFrame
+	{
+		uint64 Frame {0};
+		TArray<FDescription> Schemas;
+		TArray<FDescription> Objects;
+		TArray<FSubscription> Subscriptions;
+		TArray<TPair<uint32, int32>> Unsubscribed;
+		TArray<int32> Removed;
+
+		struct FValue
+		{
+			int32 ObjectId {INDEX_NONE};
+			int32 PropertyIndex {0};
+			int32 Offset {0};
+			int32 Size {0};
+		};
+		TArray<FValue> Values;
+		TArray<uint8> Bytes;
+	};
+	using FEncodedFramePtr = TSharedPtr<const FEncodedFrame, ESPMode::ThreadSafe>;
+
+	/* Network thread state of one viewer */
+	struct FClient
+	{
+		uint32 Id {0};
+		FSocket* Socket {nullptr};
+		TArray<uint8> Received;
+		TArray<uint8> Outgoing;
+		int32 OutgoingOffset {0};
+
+		TSet<int32> SentSchemas;
+		TSet<int32> SentObjects;
+
+		/* Per object id, how many of the viewer's subscriptions include it */
+		TMap<int32, int32> Subscribed;
+
+		/* The latest value of each property that changed since the last update, keyed by object id and property
+		 * index. The values stay in the frames they were encoded into */
+		TMap<uint64, TPair<FEncodedFramePtr, int32>> Pending;
+
+		double UpdateInterval {0.0};
+		double NextUpdateTime {0.0};
+		bool bClosed {false};
+	};
+
+	// game thread
+	bool HandleTicker(float DeltaTime);
+	void HandleSchemasInvalidated();
+	void ExecuteCommands();
+	void Subscribe(uint32 ClientId, int32 Request, const FString& Selector);
+	void Release(const TArray<int32>& SubscriptionObjectIds);
+	int32 AddObjectGraph(UObject* Object, int32 RemainingDepth, TArray<int32>& OutObjectIds);
+	bool UpdateSchema(int32 ObjectId);
+	void StageChanges();
+	void UpdateIntervals();
+	void StageValue(int32 ObjectId, int32 PropertyIndex, const FActorDebuggerPropertySchemaEntry& Entry, UObject* Object);
+	void Dispatch();
+	void WaitForTask();
+
+	// worker
+	static FEncodedFramePtr EncodeBatch(FBatch& Batch);
+	static void DestroyValues(FBatch& Batch);
+
+	// network thread
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	void AcceptClients();
+	void ApplyFrame(const FEncodedFramePtr& Frame);
+	FClient* FindClient(uint32 ClientId) const;
+	void Describe(FClient& Client, int32 ObjectId);
+	void ReceiveCommands(FClient& Client);
+	void SendUpdate(FClient& Client, double CurrentTime);
+	void SendOutgoing(FClient& Client);
+	void CloseClient(FClient& Client);
+
+	// shared
+	FRunnableThread* Thread {nullptr};
+	FSocket* Listener {nullptr};
+	FEvent* WakeEvent {nullptr};
+	std::atomic<bool> bStopping {false};
+	std::atomic<int32> NumClients {0};
+	int32 BoundPort {0};
+	TQueue<FCommand, EQueueMode::Spsc> Commands;
+	TQueue<FEncodedFramePtr, EQueueMode::Mpsc> Frames;
+
+	// game thread
+	TArray<FServedObject> Objects;
+	TMap<TObjectKey<UObject>, int32> ObjectIds;
+
+	/* Ids of released objects whose removal has been dispatched to the viewers */
+	TArray<int32> FreeObjectIds;
+	TMap<TObjectKey<UClass>, int32> SchemaIds;
+	int32 NumSchemas {0};
+	TArray<FSubscription> Subscriptions;
+
+	/* The update interval of each viewer, as the network thread reported it */
+	TMap<uint32, double> ClientIntervals;
+	bool bIntervalsDirty {false};
+	FBatch Staging;
+	FBatch InFlight;
+	UE::Tasks::FTask Task;
+	bool bInFlight {false};
+	uint64 FrameCounter {0};
+	FTSTicker::FDelegateHandle TickerHandle;
+	FDelegateHandle SchemasInvalidatedHandle;
+
+	// network thread
+	TArray<TUniquePtr<FClient>> Clients;
+	uint32 NextClientId {1};
+
+	/* Every schema and live object described so far, sent to viewers as they need them */
+	TMap<int32, FDescription> SchemaDescriptions;
+	TMap<int32, FDescription> ObjectDescriptions;
+
+	/* The object ids of each subscription by viewer and request, so the viewer's counts can be released */
+	TMap<TPair<uint32, int32>, TArray<int32>> ClientSubscriptions;
+
+	uint64 LastFrame {0};
+};
@@ -0,0 +1,158 @@
+/**
+ * @file ActorDebuggerSnapshot.h
+ * @brief Declares the snapshot store of the Actor Debugger, which records object graphs as hash trees and diffs them.
+ *
+ * A snapshot walks the whole graph below an object the same way the tree does (object references, struct members
+ * and container elements) and records it as a tree of immutable nodes. Every node holds a hash of its own value and
+ * a hash of its whole subtree, which is how equal subtrees are found and shared. A diff never walks below a node both
+ * snapshots share, so it costs time proportional to what changed, not to the size of the graph.
+ *
+ * Nodes are interned by their subtree hash, so a snapshot shares every subtree that didn't change with the
+ * snapshots taken before it and only the changed nodes and their ancestors take memory of their own. A node found by
+ * its hash is only shared if its name, value hash and children match too, so a hash collision costs a node of its
+ * own rather than a wrong value. Leaves are looked up before their value is formatted, so unchanged values aren't
+ * formatted again either.
+ *
+ * References to objects that are expanded are hashed by the object's class and contents rather than its address,
+ * and references back to an object that was already expanded are hashed by the order it was reached in. This lets
+ * snapshots of two different objects of the same class be diffed, e.g. two actors and their components.
+ *
+ * Nodes are named like the rows of the tree ("Health", "[3]" or "[Key]" for elements) and the path of a node is
+ * the names from the root down, e.g. "Weapon.Ammo[0]". Diffs are reported by path, and GetItemPath gives the path
+ * of a row of the tree so rows can be matched with a diff.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerSnapshotNode: An immutable node of a snapshot, shared between snapshots.
+ * - FActorDebuggerSnapshot: The root of one snapshot along with what it was taken of.
+ * - FActorDebuggerDiffEntry: A value that differs between two snapshots.
+ * - FActorDebuggerSnapshotDiff: Every difference between two snapshots, by path.
+ * - FActorDebuggerSnapshots: The named snapshots and the table of interned nodes.
+ *
+ * Console Variables:
+ * - ActorDebugger.SnapshotMaxDepth: How many levels of objects, structs and containers a snapshot records.
+ * - ActorDebugger.SnapshotMaxNodes: How many nodes a single snapshot may record.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerInspection.h"
+
+struct FActorDebuggerSnapshotNode;
+
+typedef TSharedPtr<const FActorDebuggerSnapshotNode, ESPMode::ThreadSafe> FActorDebuggerSnapshotNodePtr;
+
+struct FActorDebuggerSnapshotNode
+{
+	/* The property's name, or "[Index]" and "[Key]" for container elements */
+	FString Name;
+
+	/* The formatted value. Structs have none, their members are their value */
+	FString Value;
+
+	/* Hash of the value alone, and of the name, the value and every node below */
+	uint64 ValueHash {0};
+	uint64 Hash {0};
+
+	TArray<FActorDebuggerSnapshotNodePtr> Children;
+};
+
+struct FActorDebuggerSnapshot
+{
+	FString Name;
+	TWeakObjectPtr<UObject> Object;
+	FString ObjectName;
+	double Time {0.0};
+
+	FActorDebuggerSnapshotNodePtr Root;
+
+	/* Nodes recorded, shared ones included. Truncated if a budget stopped the walk */
+	int32 NumNodes {0};
+	bool bTruncated {false};
+};
+
+typedef TSharedPtr<const FActorDebuggerSnapshot, ESPMode::ThreadSafe> FActorDebuggerSnapshotPtr;
+
+struct FActorDebuggerDiffEntry
+{
+	FString Path;
+	EActorDebuggerDiffKind Kind {EActorDebuggerDiffKind::Changed};
+
+	/* Empty for values that were added or removed */
+	FString OldValue;
+	FString NewValue;
+};
+
+struct FActorDebuggerSnapshotDiff
+{
+	/* Values that differ, in the order the diff found them */
+	TArray<FActorDebuggerDiffEntry> Entries;
+
+	/* The paths of the entries, and of their ancestors as ContainsChanges */
+	TMap<FString, EActorDebuggerDiffKind> Paths;
+
+	/* Pairs of nodes the diff compared, those below equal subtrees are never reached */
+	int32 NumCompared {0};
+
+	EActorDebuggerDiffKind Find(const FString& Path) const
+	{
+		const EActorDebuggerDiffKind* Kind = Paths.Find(Path);
+		return Kind ? *Kind : EActorDebuggerDiffKind::None;
+	}
+
+	void Reset()
+	{
+		Entries.Reset();
+		Paths.Reset();
+		NumCompared = 0;
+	}
+};
+
+class ACTORDEBUGGER_API FActorDebuggerSnapshots
+{
+public:
+	static FActorDebuggerSnapshots& Get();
+
+	/* Records the graph below the object without keeping it, e.g. to diff the live state against a snapshot */
+	FActorDebuggerSnapshotPtr Capture(UObject* Object, const FString& Name = FString());
+
+	/* Records the graph below the object as a named snapshot, replacing any snapshot of the same name. Snapshots
+	 * without a name are named Snapshot1, Snapshot2 and so on */
+	FActorDebuggerSnapshotPtr Take(UObject* Object, const FString& Name = FString());
+
+	FActorDebuggerSnapshotPtr Find(const FString& Name) const;
+	bool Remove(const FString& Name);
+	void Reset();
+
+	/* Names of the kept snapshots, oldest first */
+	TArray<FString> GetNames() const;
+
+	/* Nodes currently held by any snapshot, each shared node counted once */
+	int32 GetNumUniqueNodes() const;
+	SIZE_T GetAllocatedSize() const;
+
+	/* Finds every value of New that differs from Old, skipping subtrees whose hashes are equal */
+	static void Diff(const FActorDebuggerSnapshot& Old, const FActorDebuggerSnapshot& New, FActorDebuggerSnapshotDiff& OutDiff);
+
+	/* The path of a row of the tree, in the form the nodes of a snapshot are named in */
+	static FString GetItemPath(FReflectedActorPropertyPtr Item);
+
+	/* Appends the name of a node to a path */
+	static void AppendPath(FString& Path, const FString& Name);
+
+private:
+	friend class FActorDebuggerSnapshotBuilder;
+
+	/* Returns the node already recorded with this hash, if it is still held by a snapshot */
+	FActorDebuggerSnapshotNodePtr FindNode(uint64 Hash) const;
+	FActorDebuggerSnapshotNodePtr AddNode(const FActorDebuggerSnapshotNodePtr& Node);
+	void PruneNodes();
+
+	TArray<FActorDebuggerSnapshotPtr> Snapshots;
+
+	/* Every node recorded by a snapshot that is still alive, by subtree hash */
+	TMap<uint64, TWeakPtr<const FActorDebuggerSnapshotNode, ESPMode::ThreadSafe>> Nodes;
+	int32 NumNodesAfterPrune {0};
+	int32 NumTaken {0};
+};
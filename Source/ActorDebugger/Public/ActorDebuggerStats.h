@@ -0,0 +1,91 @@
+/**
+ * @file ActorDebuggerStats.h
+ * @brief Declares the STATGROUP_ActorDebugger stats group, which measures what the Actor Debugger itself costs.
+ *
+ * The stats can be viewed with "stat ActorDebugger". The cycle stats are also emitted as CPU trace scopes, so they
+ * show up in Unreal Insights without enabling stat named events.
+ *
+ * Cycle Stats:
+ * - Tick: The widget's per frame update, everything below runs inside it.
+ * - Build Tree: Selecting an object and gathering its top level properties.
+ * - Gather Children: Gathering the children of a node when it is expanded.
+ * - Gather Properties: Gathering the properties of one object.
+ * - Sample Rows: The refresh scheduler checking rows for changes.
+ * - Export Value: Exporting a value to text on the game thread.
+ * - Format Batch: Exporting a batch of values to text on a worker thread.
+ * - Generate Row: The tree view creating the widgets of a row.
+ * - Capture Frame: Writing one frame of a capture to disk.
+ * - Replay Frame: Applying one frame of a capture, or an update from a debug server, to the replay objects.
+ * - Search Index: The search index gathering, indexing and refreshing nodes.
+ * - Search: Running a search query against the index.
+ * - Watchpoints: Evaluating every watchpoint's condition.
+ * - Query: Gathering and scanning the objects of a query.
+ * - Sample Columns: Sampling the columns of a class table and updating its view.
+ * - Snapshot: Walking and hashing an object graph for a snapshot.
+ * - Diff: Comparing two snapshots.
+ * - Collect Calls: Taking the calls recorded by the call tracer out of each thread's buffer.
+ * - Dump: Writing the budgeted slice of every running dump session.
+ * - Serve: The debug server running its viewers' commands and copying the values that changed.
+ * - Encode Updates: Encoding a batch of the debug server's changes on a worker thread.
+ * - Measure Memory: Measuring the memory of the inspected object and the objects below it.
+ * - Measure Object: Measuring one object's memory on a worker thread.
+ *
+ * Counters:
+ * - Nodes: Property nodes held by every open inspection.
+ * - Rows: Rows currently generated by every open debugger widget.
+ * - Exported Bytes: Bytes of text produced by value exports this frame.
+ * - Fallback Exports: Values this frame whose type has no fast formatter and went through ExportText.
+ * - Traced Calls: Calls recorded by the call tracer that were collected this frame.
+ * - Dumped Bytes: Bytes written by dump sessions this frame.
+ * - Served Bytes: Bytes of values the debug server copied to be sent this frame.
+ * - Resource Sizes: Objects whose resource size was taken again by memory measurements this frame.
+ * - Memory Held: Memory held by the inspections and format pipelines of every open debugger widget.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+DECLARE_STATS_GROUP(TEXT("Actor Debugger"), STATGROUP_ActorDebugger, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Tick"), STAT_ActorDebugger_Tick, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Tree"), STAT_ActorDebugger_BuildTree, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gather Children"), STAT_ActorDebugger_GatherChildren, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gather Properties"), STAT_ActorDebugger_GatherProperties, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sample Rows"), STAT_ActorDebugger_SampleRows, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Export Value"), STAT_ActorDebugger_ExportValue, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Format Batch"), STAT_ActorDebugger_FormatBatch, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Row"), STAT_ActorDebugger_GenerateRow, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Capture Frame"), STAT_ActorDebugger_CaptureFrame, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Replay Frame"), STAT_ActorDebugger_ReplayFrame, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Search Index"), STAT_ActorDebugger_SearchIndex, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Search"), STAT_ActorDebugger_Search, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Watchpoints"), STAT_ActorDebugger_Watchpoints, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Query"), STAT_ActorDebugger_Query, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sample Columns"), STAT_ActorDebugger_SampleColumns, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snapshot"), STAT_ActorDebugger_Snapshot, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Diff"), STAT_ActorDebugger_Diff, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Collect Calls"), STAT_ActorDebugger_CollectCalls, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dump"), STAT_ActorDebugger_Dump, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Serve"), STAT_ActorDebugger_Serve, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Encode Updates"), STAT_ActorDebugger_EncodeUpdates, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Measure Memory"), STAT_ActorDebugger_MeasureMemory, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Measure Object"), STAT_ActorDebugger_MeasureObject, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Nodes"), STAT_ActorDebugger_Nodes, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Rows"), STAT_ActorDebugger_Rows, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Exported Bytes"), STAT_ActorDebugger_ExportedBytes, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Fallback Exports"), STAT_ActorDebugger_FallbackExports, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traced Calls"), STAT_ActorDebugger_TracedCalls, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dumped Bytes"), STAT_ActorDebugger_DumpedBytes, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Served Bytes"), STAT_ActorDebugger_ServedBytes, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Resource Sizes"), STAT_ActorDebugger_ResourceSizes, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Memory Held"), STAT_ActorDebugger_MemoryHeld, STATGROUP_ActorDebugger, ACTORDEBUGGER_API);
+
+/* Times the enclosing scope as a cycle stat and as a CPU trace event of the same name */
+#define ACTORDEBUGGER_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Stat)
@@ -0,0 +1,24 @@
+/**
+ * @file ActorDebuggerValueHash.h
+ * @brief Declares helpers for computing a compact hash of a reflected property's value.
+ *
+ * The debugger keeps one 64 bit hash per displayed property instead of the formatted text so that it can tell
+ * whether a value changed without exporting it. Plain old data is hashed straight from its bytes. Strings,
+ * text and script containers are followed to the memory they own so that changes to their contents are seen.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FProperty;
+
+namespace ActorDebugger
+{
+	/* Hashes ArrayDim elements of the given property starting at ValuePtr. Returns Seed if ValuePtr is null */
+	ACTORDEBUGGER_API uint64 HashPropertyValue(const FProperty* Property, const void* ValuePtr, uint64 Seed = 0);
+
+	/* Hashes a single element of the given property, ignoring its ArrayDim */
+	ACTORDEBUGGER_API uint64 HashPropertyElement(const FProperty* Property, const void* ValuePtr, uint64 Seed = 0);
+}
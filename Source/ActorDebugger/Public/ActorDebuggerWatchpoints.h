@@ -0,0 +1,110 @@
+/**
+ * @file ActorDebuggerWatchpoints.h
+ * @brief Declares the FActorDebuggerWatchpoints class, which checks chosen properties every frame and acts when they change or meet a condition.
+ *
+ * A watchpoint is added to a row of the property tree either "on change" or with a condition such as "Health < 10",
+ * "bIsDead == true", "State == EState::Dead", "Target == None" or "Items > 4". The name in front of the operator is
+ * optional, if given it must be the row's name. Containers compare their element count.
+ *
+ * Conditions are compiled once when the watchpoint is added (see FActorDebuggerCondition), so evaluating a watchpoint
+ * is a single indirect call that reads the value straight from the property's memory. Nothing is exported to text
+ * unless the watchpoint triggers. "On change" copies plain old data values and compares the bytes, anything else (strings,
+ * containers, structs holding either) is compared by the hash of its value.
+ *
+ * Conditions trigger when they become true, not on every frame they stay true, and a watchpoint that is added while
+ * its condition already holds waits for it to become false first. When a watchpoint triggers it can log the value,
+ * dump the callstack to the log and pause the game. Watchpoints are checked once per frame by the debugger's ticker,
+ * so the callstack shows where the change was detected rather than the code that made it.
+ *
+ * Classes and Structures:
+ * - EActorDebuggerWatchAction: What a watchpoint does when it triggers.
+ * - FActorDebuggerWatchpoint: One watched node, its compiled condition, its actions and its state.
+ * - FActorDebuggerWatchpoints: The watchpoints of one inspection, evaluated together once per frame.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerCondition.h"
+
+enum class EActorDebuggerWatchAction : uint8
+{
+	None = 0,
+	/* Logs the node's path and its new value */
+	Log = 1 << 0,
+	/* Pauses the play session, or the game outside the editor */
+	Pause = 1 << 1,
+	/* Dumps the callstack to the log */
+	Callstack = 1 << 2
+};
+ENUM_CLASS_FLAGS(EActorDebuggerWatchAction);
+
+struct FActorDebuggerWatchpoint
+{
+	/* Returns true if the value at ValuePtr differs from LastValue and updates LastValue */
+	typedef bool (*FChangeTestFunction)(FActorDebuggerWatchpoint& Watchpoint, const uint8* ValuePtr);
+
+	FReflectedActorPropertyPtr Item {nullptr};
+	uint32 Generation {0};
+	FProperty* Property {nullptr};
+	TWeakObjectPtr<UObject> Owner;
+
+	/* Set when the value's address can't change while its owner is alive */
+	const uint8* StableValuePtr {nullptr};
+
+	EActorDebuggerConditionOp Op {EActorDebuggerConditionOp::Changed};
+	EActorDebuggerWatchAction Actions {EActorDebuggerWatchAction::None};
+
+	/* Compiled for conditions, "on change" watchpoints use ChangeTest instead */
+	FActorDebuggerCondition Condition;
+	FChangeTestFunction ChangeTest {nullptr};
+
+	/* The last value seen by an "on change" watchpoint: its bytes for plain old data, otherwise its hash */
+	TArray<uint8, TInlineAllocator<16>> LastValue;
+
+	/* Whether the condition held the last time it was evaluated, conditions trigger when this becomes true */
+	bool bLastResult {false};
+
+	/* The node's path from the inspected object and the condition as it was entered, for logging */
+	FString Path;
+	FString ConditionText;
+
+	int32 NumTriggers {0};
+};
+
+class ACTORDEBUGGER_API FActorDebuggerWatchpoints
+{
+public:
+	FActorDebuggerWatchpoints() = default;
+	~FActorDebuggerWatchpoints();
+
+	/* Watches the given node, replacing any watchpoint it already has. An empty condition (or "changed") watches
+	 * for changes. Returns false and describes the problem if the condition doesn't fit the node's type */
+	bool Add(FReflectedActorPropertyPtr Item, const FString& Condition, EActorDebuggerWatchAction Actions, FText& OutError);
+
+	/* Returns false if the node isn't watched */
+	bool Remove(FReflectedActorPropertyPtr Item);
+	bool SetActions(FReflectedActorPropertyPtr Item, EActorDebuggerWatchAction Actions);
+	const FActorDebuggerWatchpoint* Find(FReflectedActorPropertyPtr Item) const;
+
+	/* Removes every watchpoint. Must be called before the nodes being watched are released */
+	void Reset();
+
+	/* Evaluates every watchpoint and carries out the actions of those that trigger. Called once per frame on the
+	 * game thread. Returns the number of watchpoints that triggered */
+	int32 Evaluate();
+
+	int32 Num() const { return Watchpoints.Num(); }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	int32 IndexOf(FReflectedActorPropertyPtr Item) const;
+	bool Compile(FActorDebuggerWatchpoint& Watchpoint, const FString& Condition, FText& OutError) const;
+	void Trigger(FActorDebuggerWatchpoint& Watchpoint, const uint8* ValuePtr, bool& bOutPause) const;
+	static const uint8* ResolveValue(const FActorDebuggerWatchpoint& Watchpoint);
+	static void PausePlay();
+
+	TArray<FActorDebuggerWatchpoint> Watchpoints;
+};
@@ -5,30 +5,64 @@
  * @brief Declares the SActorDebuggerWidget class, a Slate widget for visualizing and interacting with actor properties in Unreal Engine.
  *
  * This widget provides a tree view of reflected actor properties, allowing inspection and debugging of UObject instances.
- * It supports dynamic property gathering, filtering of relevant UObject types, and asset identification.
+ * The tree itself is owned by an FActorDebuggerInspection, which gathers the properties of referenced objects only when
+ * the tree view asks for the children of a row.
  * The widget also exposes a multicast delegate for close requests and maintains references to UI elements for displaying actor information.
  *
  * Classes and Types:
  * - SActorDebuggerWidget: Main widget class for actor property debugging.
- * - FReflectedActorPropertyPtr: Smart pointer type for reflected actor properties.
+ * - FReflectedActorPropertyPtr: Pointer to a reflected actor property node owned by the inspection's arena.
  *
  * Key Methods:
  * - Construct: Initializes the widget with Slate arguments.
  * - SetObject: Sets the UObject to be inspected.
- * - GatherProperties: Populates the property tree with reflected properties.
- * - TryGetUObjectValue: Attempts to retrieve a UObject value from a property.
- * - IsUObjectOfInterest: Determines if a UObject should be displayed.
- * - IsAssetObject: Checks if a UObject is an asset.
+ * - SampleItem: Checks one row's value for changes, queueing it for formatting if it changed. Called by the scheduler.
+ * - HandleGenerateRow, HandleRowReleased: Track which items currently have a row generated by the tree view.
+ * - HandleSchemasInvalidated: Rebuilds the tree when the shared schema cache is invalidated.
+ * - HandleObjectsInvalidated: Refreshes the tree when objects in it are destroyed, collected or unloaded, and closes
+ *   the window in the same frame when the selected object is.
+ * - UpdateOverheadReadout: Shows what the debugger itself costs in the header bar.
+ * - HandleRecordClicked, HandleTimelineChanged, HandleLiveClicked: Record the selected rows every frame and scrub
+ *   back through the recording. Recorded rows show the scrubbed frame's value until the widget goes back to live.
+ * - HandleSearchTextChanged, ApplyFilter: Filter the tree down to the properties matching the search box, along
+ *   with their ancestors. The search index gathers the rest of the tree in the background while a filter is active.
+ * - HandleContextMenuOpening, AddWatchpoints: Watch the selected rows for changes or for a condition, logging,
+ *   dumping the callstack or pausing play when they trigger. Watched rows show their name in red.
+ * - StartCapture, StopCapture: Stream the inspected object and the objects it references to a capture file.
+ * - OpenCapture: Replays a capture file. The tree inspects the capture's replay objects and the timeline seeks
+ *   through the capture's frames.
+ * - TakeSnapshot, ShowDiff, ClearDiff: Record the inspected object as a named snapshot and color the rows that
+ *   differ from a snapshot or from another object of the same class. Diffs involving live objects are captured
+ *   and compared again about once a second.
+ * - StartCallTrace, StopCallTrace: Trace the UFunctions called on the inspected object and its subobjects, see
+ *   FActorDebuggerCallTracer. The calls are collected every tick and listed in the call timeline below the tree.
+ * - SetMemoryShown, UpdateMemory: Add the Size and Retained columns and measure the inspected object again about
+ *   once a second while they are shown, see FActorDebuggerMemory.
+ * - SetSortByMemory, SortByMemory: Sort every level of the tree by retained size, largest contributors first.
  *
  * Delegates:
  * - FOnRequestClose: Multicast delegate for widget close requests.
  *
  * Member Variables:
- * - TickerHandle: Handle for periodic updates.
+ * - TickerHandle: Handle for the per frame update.
  * - PropertiesView: Tree view widget for displaying properties.
  * - ActorNameTextBlock, ActorClassNameTextBlock: UI elements for actor information.
+ * - OverheadTextBlock: The readout of the last and average tick cost, nodes, rows and memory held.
  * - CurrentObject: The currently inspected UObject.
- * - RootItems: Array of root property items for the tree view.
+ * - Inspection: Owns the lazily gathered property tree of the current object.
+ * - FormatPipeline: Formats changed values off the game thread.
+ * - RefreshScheduler: Spreads the sampling of rows across frames under a time budget. Shared with every other
+ *   debugger widget, SchedulerClientId identifies this widget's rows.
+ * - VisibleRows: The rows currently generated by the virtualized tree view.
+ * - HistoryRecorder: Records the selected properties every frame while recording.
+ * - Watchpoints: The watchpoints on the rows of the current inspection, evaluated every frame.
+ * - SearchIndex: Indexes the names and values of the inspection's nodes for the search box.
+ * - CaptureWriter: Writes a capture file while capturing.
+ * - CaptureReader: The capture being replayed, if any.
+ * - Diff: The diff the rows are colored by, see FActorDebuggerSnapshots.
+ * - CallTimeline: The calls traced on the inspected object, shown while this widget traces or has traced.
+ * - HeaderRow: The columns of the tree, the memory columns are added and removed at runtime.
+ * - Memory, NodeMemory: The memory of the inspected object's graph and of the rows measured from it.
  */
 #pragma once
 
@@ -36,35 +70,199 @@
 #include "CoreMinimal.h"
 #include "Widgets/Views/STreeView.h"
 #include "ActorPropertyWidget.h"
+#include "ActorDebuggerRefreshScheduler.h"
+#include "ActorDebuggerHistory.h"
+#include "ActorDebuggerCapture.h"
+#include "ActorDebuggerSearchIndex.h"
+#include "ActorDebuggerWatchpoints.h"
+#include "ActorDebuggerSnapshot.h"
+#include "ActorDebuggerCallTracer.h"
+#include "ActorDebuggerMemory.h"
 
 class FProperty;
 class AActor;
 class STextBlock;
+class SSearchBox;
+class SEditableTextBox;
+class SReflectedPropertyTableRow;
+class FActorDebuggerFormatPipeline;
+class SActorDebuggerCallTimeline;
 
 class ACTORDEBUGGER_API SActorDebuggerWidget : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(SActorDebuggerWidget)
+		: _RefreshRate(30.0f)
 	{}
+		/* How many times per second recently changed values are checked for changes */
+		SLATE_ARGUMENT(float, RefreshRate)
 	SLATE_END_ARGS()
 
+	virtual ~SActorDebuggerWidget() override;
+
 	void Construct(const FArguments& InArgs);
 	void SetObject(UObject* Object);
+	UObject* GetObject() const { return CurrentObject; }
+
+	/* Starts writing a capture of the inspected object. Returns false if nothing is inspected or the file can't be created */
+	bool StartCapture(const FString& Filename);
+	void StopCapture();
+
+	/* Opens a capture and inspects its replay objects. Returns false if the capture can't be read */
+	bool OpenCapture(const FString& Filename);
+
+	/* Takes a snapshot of the inspected object, see FActorDebuggerSnapshots::Take */
+	FActorDebuggerSnapshotPtr TakeSnapshot(const FString& Name);
+
+	/* Colors the rows that differ. Target is a snapshot to compare the live object with, two snapshots to compare
+	 * with each other, or the name of another object of the same class. Returns false if Target isn't found */
+	bool ShowDiff(const FString& Target, FText& OutError);
+	void ClearDiff();
+
+	/* Traces the calls made on the inspected object, replacing any trace started by another window. Returns false
+	 * if nothing is inspected */
+	bool StartCallTrace();
+	void StopCallTrace();
+	bool IsCallTracing() const;
+
+	/* Adds or removes the memory columns. The inspected object is measured straight away when they are added */
+	void SetMemoryShown(bool bShown);
+	bool IsMemoryShown() const { return bShowMemory; }
+
+	/* Sorts the tree by retained size, largest first. Only applies while the memory columns are shown */
+	void SetSortByMemory(bool bSort);
+	const FActorDebuggerMemory& GetMemory() const { return Memory; }
+
 	DECLARE_MULTICAST_DELEGATE(FOnRequestClose);
 
 	FOnRequestClose RequestClose;
 private:
 	bool HandleTicker(float DeltaTime);
-	void GatherProperties(TArray<FReflectedActorPropertyPtr>& ItemsToFill, UObject* ContainerObject);
-    UObject* TryGetUObjectValue(UObject* ParentContainer, FProperty* Property);
-	bool IsUObjectOfInterest(UObject* Object);
-	bool IsAssetObject(UObject* Object);	
+	bool SampleItem(const FReflectedActorPropertyPtr& Item);
+	TSharedRef<ITableRow> HandleGenerateRow(FReflectedActorPropertyPtr Item, const TSharedRef<STableViewBase>& OwnerTree);
+	void HandleRowReleased(const TSharedRef<ITableRow>& Row);
+	void HandleGetChildren(FReflectedActorPropertyPtr Item, TArray<FReflectedActorPropertyPtr>& OutChildren);
+	void HandleSearchTextChanged(const FText& Text);
+	void ApplyFilter();
+	void ClearFilter();
+	void HandleSchemasInvalidated();
+	void HandleObjectsInvalidated(bool bRootInvalidated, UObject* RootReplacement);
+	TSharedPtr<SWidget> HandleContextMenuOpening();
+	bool AddWatchpoints(const FString& Condition, EActorDebuggerWatchAction Actions, FText& OutError);
+	void RemoveWatchpoints();
+	void ToggleWatchpointCallstack();
+	bool IsWatchpointCallstackEnabled() const;
+	void UpdateOverheadReadout();
+	FReply HandleRecordClicked();
+	FReply HandleLiveClicked();
+	void HandleTimelineChanged(float Value);
+	void ScrubTo(uint64 Frame);
+	void ApplyScrubbedValues();
+	FText GetRecordButtonText() const;
+	float GetTimelineValue() const;
+	FText GetTimelineText() const;
+	bool IsTimelineEnabled() const;
+	void SeekCapture(int32 Frame);
+	bool IsDiffLive() const;
+	void RefreshDiff();
+	void MarkDiffRows();
+	FReply HandleSnapshotClicked();
+	void HandleDiffTextCommitted(const FText& Text, ETextCommit::Type CommitType);
+	void CollectCalls();
+	FReply HandleCallTraceClicked();
+	void UpdateMemory();
+	bool GetNodeMemory(const FReflectedActorPropertyPtr& Item, FActorDebuggerNodeMemory& OutMemory);
+	void UpdateRowMemory(const FReflectedActorPropertyPtr& Item, SReflectedPropertyTableRow& Row);
+	void SortByMemory(TArray<FReflectedActorPropertyPtr>& Items);
+	void RefreshRootItems();
+	EColumnSortMode::Type GetMemorySortMode() const;
+	void HandleMemorySort(EColumnSortPriority::Type Priority, const FName& ColumnName, EColumnSortMode::Type Mode);
 
 
 	FTSTicker::FDelegateHandle TickerHandle;
 	TSharedPtr<STreeView<FReflectedActorPropertyPtr>> PropertiesView;
+	TSharedPtr<SHeaderRow> HeaderRow;
 	TSharedPtr<STextBlock> ActorNameTextBlock;
 	TSharedPtr<STextBlock> ActorClassNameTextBlock;
+	TSharedPtr<STextBlock> OverheadTextBlock;
+	TSharedPtr<SSearchBox> SearchBox;
+	TSharedPtr<SEditableTextBox> DiffTextBox;
+	TSharedPtr<STextBlock> DiffSummaryTextBlock;
+	TSharedPtr<SActorDebuggerCallTimeline> CallTimeline;
 	TObjectPtr<UObject> CurrentObject{nullptr};
-	TArray<FReflectedActorPropertyPtr> RootItems;
+	FActorDebuggerInspection Inspection;
+
+	/* Formats changed values on worker threads, results are picked up on the next tick */
+	TSharedPtr<FActorDebuggerFormatPipeline> FormatPipeline;
+
+	/* Decides which rows of every open debugger get sampled each frame within the frame budget */
+	TSharedPtr<FActorDebuggerRefreshScheduler> RefreshScheduler;
+	int32 SchedulerClientId {INDEX_NONE};
+
+	/* The items the tree view has generated rows for. The tree view is virtualized so these are the rows in view */
+	TMap<FReflectedActorPropertyPtr, TWeakPtr<SReflectedPropertyTableRow>> VisibleRows;
+
+	/* Declared after the inspection so it is destroyed before the nodes it records are */
+	FActorDebuggerHistoryRecorder HistoryRecorder;
+
+	/* Declared after the inspection so it is destroyed before the nodes it watches are */
+	FActorDebuggerWatchpoints Watchpoints;
+
+	/* Kept up to date while a filter is active, rows in view feed it the values they format */
+	FActorDebuggerSearchIndex SearchIndex;
+
+	/* The active filter. While it is set the tree shows FilteredRootItems and only the children in FilterVisibleItems,
+	 * except below a match where every child is shown */
+	FString FilterText;
+	TArray<FReflectedActorPropertyPtr> FilteredRootItems;
+	TSet<FReflectedActorPropertyPtr> FilterVisibleItems;
+	TSet<FReflectedActorPropertyPtr> FilterMatches;
+
+	/* Written every tick while capturing. Stopped when another object is selected */
+	TUniquePtr<FActorDebuggerCaptureWriter> CaptureWriter;
+
+	/* While a capture is replayed the timeline seeks through its frames instead of the history */
+	TUniquePtr<FActorDebuggerCaptureReader> CaptureReader;
+	int32 CaptureFrame {0};
+
+	/* The diff the rows are colored by. The old side is a snapshot or another object, the new side a snapshot or
+	 * the inspected object. Objects are captured again each time the diff is refreshed */
+	FActorDebuggerSnapshotDiff Diff;
+	FActorDebuggerSnapshotPtr DiffOldSnapshot;
+	FActorDebuggerSnapshotPtr DiffNewSnapshot;
+	TWeakObjectPtr<UObject> DiffOtherObject;
+	bool bDiffActive {false};
+	bool bDiffAgainstObject {false};
+	double LastDiffTime {0.0};
+
+	/* The id of the call trace this widget started, calls are collected while the tracer still runs it. INDEX_NONE
+	 * if this widget hasn't traced its object. The collected calls are kept to reuse their allocation */
+	int32 CallTraceId {INDEX_NONE};
+	TArray<FActorDebuggerCallRecord> CollectedCalls;
+
+	/* Measured about once a second while the memory columns are shown. The rows measured from it are cached until
+	 * it changes, rows that can't be measured aren't cached and are tried again */
+	FActorDebuggerMemory Memory;
+	TMap<FReflectedActorPropertyPtr, FActorDebuggerNodeMemory> NodeMemory;
+	bool bShowMemory {false};
+	bool bSortByMemory {false};
+	double LastMemoryTime {0.0};
+
+	/* The root items in retained size order, the tree shows these while sorting by memory without a filter */
+	TArray<FReflectedActorPropertyPtr> SortedRootItems;
+
+	/* Set while the timeline shows a recorded frame rather than the live values */
+	bool bScrubbing {false};
+	uint64 ScrubFrame {0};
+
+	/* Set while sampling when a container's element count changed, the tree is refreshed once per tick */
+	bool bContainersChanged {false};
+
+	/* The cost of the last tick and a moving average of it, in microseconds */
+	double LastTickMicroseconds {0.0};
+	double AverageTickMicroseconds {0.0};
+	double LastReadoutTime {0.0};
+
+	/* The memory this widget has added to STAT_ActorDebugger_MemoryHeld */
+	int64 ReportedMemory {0};
 };
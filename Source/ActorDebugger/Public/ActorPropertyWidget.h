@@ -2,12 +2,14 @@
  * @file ActorPropertyWidget.h
  * @brief Declares the SActorPropertyWidget class and supporting structures for displaying and interacting with reflected actor properties in the Actor Debugger plugin.
  *
- * This file defines the FReflectedActorProperty structure, which represents a property of an actor, including its name, value, and child properties.
- * It also declares the SActorPropertyWidget Slate widget, which is responsible for rendering and managing the UI for actor properties.
+ * This file declares the SActorPropertyWidget Slate widget, which is responsible for rendering and managing the UI for actor properties.
+ * The FReflectedActorProperty structure it displays is declared in ActorDebuggerInspection.h.
  *
  * Classes and Structures:
- * - FReflectedActorProperty: Holds information about a reflected property, including its owning UObject, property name, and any child properties.
- * - SActorPropertyWidget: A Slate widget for displaying actor properties in a hierarchical view.
+ * - SActorPropertyWidget: A Slate widget for displaying actor properties in a hierarchical view. The hash of the value
+ *   bytes is kept on the FReflectedActorProperty, so that periodic refreshes only export the properties whose bytes
+ *   actually changed. The exported text is only held by the widget, nodes are kept trivially destructible. When given
+ *   an FActorDebuggerFormatPipeline the export itself happens on a worker thread.
  *
  * Usage:
  * Include this header in modules that need to display or interact with actor properties in the Actor Debugger plugin.
@@ -16,35 +18,37 @@
 
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/ITableRow.h"
+#include "ActorDebuggerInspection.h"
 
 class FProperty;
-
-struct FReflectedActorProperty;
-
-typedef TSharedPtr<FReflectedActorProperty> FReflectedActorPropertyPtr;
-
-struct FReflectedActorProperty
-{
-	UObject* Object {nullptr};
-	FString PropertyName;
-    TArray<FReflectedActorPropertyPtr> Children;
-
-    bool IsValid() const
-    {
-        return ::IsValid(Object) && PropertyName.Len() > 0;;
-    }
-};
-
+class STextBlock;
+class FActorDebuggerFormatPipeline;
 
 class ACTORDEBUGGER_API SActorPropertyWidget : public SCompoundWidget
 {
 public:
 	SLATE_BEGIN_ARGS(SActorPropertyWidget){}
         SLATE_ATTRIBUTE(FReflectedActorPropertyPtr, ReflectedProperty)
+		/* If set, values are formatted on worker threads and arrive on a later tick */
+		SLATE_ARGUMENT(TSharedPtr<FActorDebuggerFormatPipeline>, FormatPipeline)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+
+	/* Displays value text that was formatted elsewhere, e.g. by the format pipeline */
+	void SetValueText(const FText& ValueText);
+
+	/* Compares the property's value bytes with the last exported value and exports it again if they differ.
+	 * If a pipeline is given the export is queued on it instead of being done here. Returns true if OutValueText
+	 * was set, i.e. the value changed and was exported immediately */
+	static bool UpdateValue(FReflectedActorPropertyPtr Property, FActorDebuggerFormatPipeline* FormatPipeline, FText& OutValueText);
+
+	/* Exports the property's current value to text on the calling thread, without touching its hash */
+	static FText PropertyValueToText(FReflectedActorPropertyPtr Property);
 	
 private:
-    FText PropertyValueToText(const FReflectedActorPropertyPtr& Property);
+
+	FReflectedActorPropertyPtr PropertyPtr;
+	TSharedPtr<STextBlock> ValueTextBlock;
+	TSharedPtr<FActorDebuggerFormatPipeline> FormatPipeline;
 };
@@ -14,12 +14,17 @@
  * Key Methods:
  *   - Construct: Initializes the table row with the provided arguments and owner table.
  *   - GenerateWidgetForColumn: Generates the appropriate widget for a given column name.
+ *   - SetValueText: Updates the value column after the property's value has changed.
+ *   - SetMemoryText: Updates the memory columns after the inspected object has been measured again.
  *   - GetPropertyNameText: Retrieves the display text for the property name.
+ *   - GetPropertyNameColor: Colors the name of watched properties and of properties that differ in a diff.
  *   - HasChildren: Determines if the property has child properties.
  *   - CreateExpanderArrow: Creates an expander arrow widget for expandable rows.
  *
  * Member Variables:
  *   - PropertyPtr: Pointer to the reflected actor property associated with this row.
+ *   - ValueWidget: The widget displaying the property value, if the value column has been generated.
+ *   - MemorySizeText, MemoryRetainedText: What the memory columns show, kept here so the columns can be added later.
  */
 #pragma once
 
@@ -31,16 +36,29 @@ class ACTORDEBUGGER_API SReflectedPropertyTableRow : public SMultiColumnTableRow
 public:
 	SLATE_BEGIN_ARGS(SReflectedPropertyTableRow) {}
 		SLATE_ATTRIBUTE(FReflectedActorPropertyPtr, ReflectedProperty)
+		SLATE_ARGUMENT(TSharedPtr<FActorDebuggerFormatPipeline>, FormatPipeline)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable);
 	
 	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override;
 
+	void SetValueText(const FText& ValueText);
+	void SetMemoryText(const FText& SizeText, const FText& RetainedText);
+
+	FReflectedActorPropertyPtr GetReflectedProperty() const { return PropertyPtr; }
+
 private:
 	FText GetPropertyNameText() const;
+	FSlateColor GetPropertyNameColor() const;
 	bool HasChildren() const;
 	TSharedRef<SWidget> CreateExpanderArrow();
+	FText GetMemorySizeText() const { return MemorySizeText; }
+	FText GetMemoryRetainedText() const { return MemoryRetainedText; }
 
 	FReflectedActorPropertyPtr PropertyPtr;
+	TSharedPtr<SActorPropertyWidget> ValueWidget;
+	TSharedPtr<FActorDebuggerFormatPipeline> FormatPipeline;
+	FText MemorySizeText;
+	FText MemoryRetainedText;
 };
\ No newline at end of file
@@ -0,0 +1,26 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ActorDebuggerTests : ModuleRules
+{
+	public ActorDebuggerTests(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		// the benchmark types, the benchmark commandlet and the automation tests, kept out of the runtime module
+		// so shipping targets don't register them
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"Slate",
+				"SlateCore",
+				"Json",
+				"ActorDebugger",
+			}
+			);
+	}
+}
@@ -0,0 +1,456 @@
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+#include "ActorDebugger.h"
+#include "ActorDebuggerFormatPipeline.h"
+#include "ActorDebuggerFormatters.h"
+#include "ActorDebuggerRefreshScheduler.h"
+#include "ActorPropertyWidget.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/Parse.h"
+#include "HAL/PlatformMemory.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/Package.h"
+
+namespace ActorDebuggerBenchmark
+{
+    static double CyclesToMilliseconds(uint64 Cycles)
+    {
+        return FPlatformTime::ToSeconds64(Cycles) * 1000.0;
+    }
+
+    static double Percentile(const TArray<double>& SortedValues, double Fraction)
+    {
+        if (SortedValues.Num() == 0)
+        {
+            return 0.0;
+        }
+
+        const int32 Index = FMath::Clamp(FMath::FloorToInt32(Fraction * (SortedValues.Num() - 1)), 0, SortedValues.Num() - 1);
+        return SortedValues[Index];
+    }
+
+    static void CreateChildren(UActorDebuggerBenchmarkObject* Owner, int32 Level, const FActorDebuggerBenchmarkSettings& Settings, FRandomStream& Random, TArray<UActorDebuggerBenchmarkObject*>& OutObjects)
+    {
+        if (Level >= Settings.Depth)
+        {
+            return;
+        }
+
+        for (int32 ChildIndex = 0; ChildIndex < Settings.FanOut; ++ChildIndex)
+        {
+            UActorDebuggerBenchmarkObject* Child = NewObject<UActorDebuggerBenchmarkObject>(Owner);
+            Child->Populate(Random, Settings.ContainerSize);
+            Child->Owner = Owner;
+            Owner->Children.Add(Child);
+            OutObjects.Add(Child);
+
+            CreateChildren(Child, Level + 1, Settings, Random, OutObjects);
+        }
+    }
+}
+
+/*
+* Only settings that are present on the command line are changed
+*/
+void FActorDebuggerBenchmarkSettings::ParseCommandLine(const TCHAR* Params)
+{
+    FParse::Value(Params, TEXT("RootObjects="), NumRootObjects);
+    FParse::Value(Params, TEXT("Depth="), Depth);
+    FParse::Value(Params, TEXT("FanOut="), FanOut);
+    FParse::Value(Params, TEXT("ContainerSize="), ContainerSize);
+    FParse::Value(Params, TEXT("ChangeRate="), ChangeRate);
+    FParse::Value(Params, TEXT("Frames="), NumFrames);
+    FParse::Value(Params, TEXT("FrameRate="), FrameRate);
+    FParse::Value(Params, TEXT("VisibleRows="), VisibleRows);
+    FParse::Value(Params, TEXT("Seed="), Seed);
+
+    NumRootObjects = FMath::Max(NumRootObjects, 0);
+    Depth = FMath::Max(Depth, 0);
+    FanOut = FMath::Max(FanOut, 0);
+    ContainerSize = FMath::Max(ContainerSize, 0);
+    ChangeRate = FMath::Clamp(ChangeRate, 0.0f, 1.0f);
+    NumFrames = FMath::Max(NumFrames, 0);
+    FrameRate = FMath::Max(FrameRate, 1.0f);
+    VisibleRows = FMath::Max(VisibleRows, 0);
+}
+
+TSharedRef<FJsonObject> FActorDebuggerBenchmarkSettings::ToJson() const
+{
+    TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetStringField(TEXT("name"), Name);
+    Json->SetNumberField(TEXT("rootObjects"), NumRootObjects);
+    Json->SetNumberField(TEXT("depth"), Depth);
+    Json->SetNumberField(TEXT("fanOut"), FanOut);
+    Json->SetNumberField(TEXT("containerSize"), ContainerSize);
+    Json->SetNumberField(TEXT("changeRate"), ChangeRate);
+    Json->SetNumberField(TEXT("frames"), NumFrames);
+    Json->SetNumberField(TEXT("frameRate"), FrameRate);
+    Json->SetNumberField(TEXT("visibleRows"), VisibleRows);
+    Json->SetNumberField(TEXT("seed"), Seed);
+    return Json;
+}
+
+FActorDebuggerBenchmarkSettings FActorDebuggerBenchmarkSettings::MakeShape(int32 NumRootObjects, int32 Depth, int32 FanOut, int32 ContainerSize)
+{
+    FActorDebuggerBenchmarkSettings Settings;
+    Settings.NumRootObjects = NumRootObjects;
+    Settings.Depth = Depth;
+    Settings.FanOut = FanOut;
+    Settings.ContainerSize = ContainerSize;
+    return Settings;
+}
+
+/*
+* Presets cover the shapes that have caused trouble before: many small objects, deep graphs and huge containers
+*/
+bool FActorDebuggerBenchmarkSettings::GetPreset(const FString& PresetName, FActorDebuggerBenchmarkSettings& OutSettings)
+{
+    FActorDebuggerBenchmarkSettings Settings;
+    Settings.Name = PresetName;
+
+    if (PresetName == TEXT("Small"))
+    {
+        Settings.NumRootObjects = 2;
+        Settings.Depth = 1;
+        Settings.FanOut = 2;
+        Settings.ContainerSize = 8;
+        Settings.NumFrames = 60;
+    }
+    else if (PresetName == TEXT("Default"))
+    {
+        // the defaults
+    }
+    else if (PresetName == TEXT("Deep"))
+    {
+        Settings.NumRootObjects = 1;
+        Settings.Depth = 10;
+        Settings.FanOut = 1;
+        Settings.ContainerSize = 4;
+    }
+    else if (PresetName == TEXT("Wide"))
+    {
+        Settings.NumRootObjects = 64;
+        Settings.Depth = 2;
+        Settings.FanOut = 4;
+        Settings.ContainerSize = 16;
+    }
+    else if (PresetName == TEXT("LargeContainers"))
+    {
+        Settings.NumRootObjects = 2;
+        Settings.Depth = 0;
+        Settings.FanOut = 0;
+        Settings.ContainerSize = 50000;
+    }
+    else
+    {
+        return false;
+    }
+
+    OutSettings = Settings;
+    return true;
+}
+
+TArray<FString> FActorDebuggerBenchmarkSettings::GetPresetNames()
+{
+    return { TEXT("Small"), TEXT("Default"), TEXT("Deep"), TEXT("Wide"), TEXT("LargeContainers") };
+}
+
+TSharedRef<FJsonObject> FActorDebuggerBenchmarkResults::ToJson() const
+{
+    TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+    Json->SetNumberField(TEXT("objects"), NumObjects);
+    Json->SetNumberField(TEXT("nodes"), NumNodes);
+    Json->SetBoolField(TEXT("nodeBudgetExhausted"), bNodeBudgetExhausted);
+    Json->SetNumberField(TEXT("buildMs"), BuildMilliseconds);
+    Json->SetNumberField(TEXT("expandMs"), ExpandMilliseconds);
+    Json->SetNumberField(TEXT("firstDisplayMs"), FirstDisplayMilliseconds);
+    Json->SetNumberField(TEXT("formatAllMs"), FormatAllMilliseconds);
+    Json->SetNumberField(TEXT("exportTextAllMs"), ExportTextAllMilliseconds);
+    Json->SetNumberField(TEXT("pipelineFormatAllMs"), PipelineFormatAllMilliseconds);
+    Json->SetNumberField(TEXT("refreshAverageUs"), RefreshAverageMicroseconds);
+    Json->SetNumberField(TEXT("refreshMedianUs"), RefreshMedianMicroseconds);
+    Json->SetNumberField(TEXT("refreshP95Us"), RefreshP95Microseconds);
+    Json->SetNumberField(TEXT("refreshMaxUs"), RefreshMaxMicroseconds);
+    Json->SetNumberField(TEXT("sampled"), NumSampled);
+    Json->SetNumberField(TEXT("changed"), NumChanged);
+    Json->SetNumberField(TEXT("deferred"), NumDeferred);
+    Json->SetNumberField(TEXT("formatted"), NumFormatted);
+    Json->SetNumberField(TEXT("containerRebuilds"), NumContainerRebuilds);
+    Json->SetNumberField(TEXT("arenaBytes"), ArenaBytes);
+    Json->SetNumberField(TEXT("usedPhysicalDeltaBytes"), UsedPhysicalDeltaBytes);
+    return Json;
+}
+
+/*
+* Runs every stage of the benchmark against a freshly created graph. The actor is rooted for the duration of
+* the run so a garbage collection can't take it away halfway through
+*/
+FActorDebuggerBenchmarkResults FActorDebuggerBenchmark::Run(const FActorDebuggerBenchmarkSettings& Settings)
+{
+    check(IsInGameThread());
+
+    FActorDebuggerBenchmarkResults Results;
+    const uint64 UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+
+    TArray<UActorDebuggerBenchmarkObject*> Objects;
+    TStrongObjectPtr<AActorDebuggerBenchmarkActor> Actor(CreateActor(Settings, Objects));
+    Results.NumObjects = Objects.Num();
+
+    FActorDebuggerInspection Inspection;
+
+    // build
+    uint64 StartCycles = FPlatformTime::Cycles64();
+    Inspection.SetObject(Actor.Get());
+    Results.BuildMilliseconds = ActorDebuggerBenchmark::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    // expand
+    TArray<FReflectedActorPropertyPtr> Items;
+    StartCycles = FPlatformTime::Cycles64();
+    ExpandAll(Inspection, Items);
+    Results.ExpandMilliseconds = ActorDebuggerBenchmark::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+    Results.NumNodes = Inspection.GetNumNodes();
+    Results.bNodeBudgetExhausted = Inspection.IsNodeBudgetExhausted();
+    Results.ArenaBytes = Inspection.GetArena().GetAllocatedSize();
+
+    const int32 NumVisible = Settings.VisibleRows > 0 ? FMath::Min(Settings.VisibleRows, Items.Num()) : Items.Num();
+
+    // first display, only the rows in view are generated and each exports its value once
+    FText ValueText;
+    StartCycles = FPlatformTime::Cycles64();
+    for (int32 ItemIndex = 0; ItemIndex < NumVisible; ++ItemIndex)
+    {
+        Items[ItemIndex]->bHasValue = false;
+        SActorPropertyWidget::UpdateValue(Items[ItemIndex], nullptr, ValueText);
+    }
+    Results.FirstDisplayMilliseconds = ActorDebuggerBenchmark::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    // format every value, on the game thread and then through the pipeline
+    StartCycles = FPlatformTime::Cycles64();
+    for (FReflectedActorPropertyPtr Item : Items)
+    {
+        Item->bHasValue = false;
+        SActorPropertyWidget::UpdateValue(Item, nullptr, ValueText);
+    }
+    Results.FormatAllMilliseconds = ActorDebuggerBenchmark::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    // the same values through the ExportText fallback, so the formatters can be compared with it
+    TStringBuilder<256> ValueString;
+    StartCycles = FPlatformTime::Cycles64();
+    for (FReflectedActorPropertyPtr Item : Items)
+    {
+        const uint8* ValuePtr = Item->Kind != EReflectedPropertyKind::Page ? Item->ResolveValuePtr() : nullptr;
+        if (ValuePtr && Item->IsContainer() == false)
+        {
+            ValueString.Reset();
+            FActorDebuggerFormatters::ExportText(Item->Property, ValuePtr, Item->Object, ValueString);
+            ValueText = FText::FromString(FString(ValueString.Len(), ValueString.GetData()));
+        }
+    }
+    Results.ExportTextAllMilliseconds = ActorDebuggerBenchmark::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+
+    FActorDebuggerFormatPipeline FormatPipeline;
+    TArray<TPair<FReflectedActorPropertyPtr, FText>> FormattedValues;
+
+    StartCycles = FPlatformTime::Cycles64();
+    for (FReflectedActorPropertyPtr Item : Items)
+    {
+        Item->bHasValue = false;
+        SActorPropertyWidget::UpdateValue(Item, &FormatPipeline, ValueText);
+    }
+    do
+    {
+        FormatPipeline.Dispatch();
+        FormatPipeline.CollectResults(FormattedValues);
+
+        if (FormatPipeline.IsBusy())
+        {
+            FPlatformProcess::Yield();
+        }
+    }
+    while (FormatPipeline.IsBusy() || FormatPipeline.GetNumPending() > 0);
+    Results.PipelineFormatAllMilliseconds = ActorDebuggerBenchmark::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles);
+    FormattedValues.Reset();
+
+    // steady state refresh, driven exactly like the widget's ticker but with simulated frame times
+    FActorDebuggerRefreshScheduler Scheduler;
+    const int32 ClientId = Scheduler.AddClient(Settings.FrameRate, FActorDebuggerRefreshScheduler::FSampleItem::CreateLambda(
+        [&Inspection, &FormatPipeline, &Results](const FReflectedActorPropertyPtr& Item)
+        {
+            const uint64 PreviousHash = Item->ValueHash;
+
+            FText SampledText;
+            if (SActorPropertyWidget::UpdateValue(Item, &FormatPipeline, SampledText))
+            {
+                Results.NumContainerRebuilds += Inspection.RefreshContainerChildren(Item) ? 1 : 0;
+            }
+
+            return Item->ValueHash != PreviousHash;
+        }));
+
+    for (int32 ItemIndex = 0; ItemIndex < NumVisible; ++ItemIndex)
+    {
+        Scheduler.AddItem(ClientId, Items[ItemIndex]);
+    }
+
+    FRandomStream Random(Settings.Seed);
+    const int32 NumChangesPerFrame = FMath::CeilToInt32(Objects.Num() * Settings.ChangeRate);
+
+    TArray<double> FrameMicroseconds;
+    FrameMicroseconds.Reserve(Settings.NumFrames);
+
+    for (int32 Frame = 0; Frame < Settings.NumFrames; ++Frame)
+    {
+        for (int32 ChangeIndex = 0; ChangeIndex < NumChangesPerFrame && Objects.Num() > 0; ++ChangeIndex)
+        {
+            Objects[Random.RandHelper(Objects.Num())]->Mutate(Random);
+        }
+
+        // scheduler times start at one second so that newly added items are already due
+        const double CurrentTime = 1.0 + Frame / Settings.FrameRate;
+
+        StartCycles = FPlatformTime::Cycles64();
+        FormatPipeline.CollectResults(FormattedValues);
+        Scheduler.Tick(CurrentTime);
+        FormatPipeline.Dispatch();
+        FrameMicroseconds.Add(ActorDebuggerBenchmark::CyclesToMilliseconds(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+
+        const FActorDebuggerRefreshStats& Stats = Scheduler.GetStats();
+        Results.NumSampled += Stats.NumSampled;
+        Results.NumChanged += Stats.NumChanged;
+        Results.NumDeferred += Stats.NumDeferred;
+        Results.NumFormatted += FormattedValues.Num();
+        FormattedValues.Reset();
+    }
+
+    FormatPipeline.Reset();
+
+    if (FrameMicroseconds.Num() > 0)
+    {
+        double Total = 0.0;
+        for (double Microseconds : FrameMicroseconds)
+        {
+            Total += Microseconds;
+        }
+
+        FrameMicroseconds.Sort();
+        Results.RefreshAverageMicroseconds = Total / FrameMicroseconds.Num();
+        Results.RefreshMedianMicroseconds = ActorDebuggerBenchmark::Percentile(FrameMicroseconds, 0.5);
+        Results.RefreshP95Microseconds = ActorDebuggerBenchmark::Percentile(FrameMicroseconds, 0.95);
+        Results.RefreshMaxMicroseconds = FrameMicroseconds.Last();
+    }
+
+    // measured before the inspection is released so it includes the tree and the schemas
+    Results.UsedPhysicalDeltaBytes = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(UsedPhysicalBefore);
+
+    Inspection.Reset();
+    Actor->MarkAsGarbage();
+
+    UE_LOG(LogActorDebugger, Display, TEXT("Benchmark %s: %d objects, %d nodes, build %.3fms, expand %.3fms, first display %.3fms, refresh avg %.1fus p95 %.1fus"),
+        *Settings.Name, Results.NumObjects, Results.NumNodes, Results.BuildMilliseconds, Results.ExpandMilliseconds,
+        Results.FirstDisplayMilliseconds, Results.RefreshAverageMicroseconds, Results.RefreshP95Microseconds);
+
+    return Results;
+}
+
+/*
+* The actor is created outside of any world, the inspector only needs its properties. Every object is created
+* from the same seed so runs with the same settings inspect identical graphs
+*/
+AActorDebuggerBenchmarkActor* FActorDebuggerBenchmark::CreateActor(const FActorDebuggerBenchmarkSettings& Settings, TArray<UActorDebuggerBenchmarkObject*>& OutObjects)
+{
+    FRandomStream Random(Settings.Seed);
+
+    AActorDebuggerBenchmarkActor* Actor = NewObject<AActorDebuggerBenchmarkActor>(GetTransientPackage(), NAME_None, RF_Transient);
+
+    for (int32 RootIndex = 0; RootIndex < Settings.NumRootObjects; ++RootIndex)
+    {
+        UActorDebuggerBenchmarkObject* RootObject = NewObject<UActorDebuggerBenchmarkObject>(Actor);
+        RootObject->Populate(Random, Settings.ContainerSize);
+        Actor->Objects.Add(RootObject);
+        OutObjects.Add(RootObject);
+
+        ActorDebuggerBenchmark::CreateChildren(RootObject, 0, Settings, Random, OutObjects);
+    }
+
+    return Actor;
+}
+
+/*
+* Depth first so that OutItems is in display order, which makes its first rows the ones a user would see
+*/
+void FActorDebuggerBenchmark::ExpandAll(FActorDebuggerInspection& Inspection, TArray<FReflectedActorPropertyPtr>& OutItems)
+{
+    TArray<FReflectedActorPropertyPtr> Stack;
+    TArray<FReflectedActorPropertyPtr> Children;
+
+    for (int32 RootIndex = Inspection.GetRootItems().Num() - 1; RootIndex >= 0; --RootIndex)
+    {
+        Stack.Push(Inspection.GetRootItems()[RootIndex]);
+    }
+
+    while (Stack.Num() > 0)
+    {
+        FReflectedActorPropertyPtr Item = Stack.Pop(EAllowShrinking::No);
+        OutItems.Add(Item);
+
+        Inspection.GetChildren(Item, Children);
+        for (int32 ChildIndex = Children.Num() - 1; ChildIndex >= 0; --ChildIndex)
+        {
+            Stack.Push(Children[ChildIndex]);
+        }
+    }
+}
+
+bool FActorDebuggerBenchmark::WriteResults(const FString& Filename, const TArray<TPair<FActorDebuggerBenchmarkSettings, FActorDebuggerBenchmarkResults>>& Runs)
+{
+    TSharedRef<FJsonObject> Document = MakeShared<FJsonObject>();
+    Document->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+    Document->SetStringField(TEXT("platform"), FPlatformProperties::PlatformName());
+    Document->SetStringField(TEXT("buildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+    Document->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+    Document->SetNumberField(TEXT("cores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+    Document->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+
+    TArray<TSharedPtr<FJsonValue>> RunValues;
+    for (const TPair<FActorDebuggerBenchmarkSettings, FActorDebuggerBenchmarkResults>& Run : Runs)
+    {
+        TSharedRef<FJsonObject> RunObject = MakeShared<FJsonObject>();
+        RunObject->SetObjectField(TEXT("settings"), Run.Key.ToJson());
+        RunObject->SetObjectField(TEXT("results"), Run.Value.ToJson());
+        RunValues.Add(MakeShared<FJsonValueObject>(RunObject));
+    }
+    Document->SetArrayField(TEXT("runs"), RunValues);
+
+    FString Output;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+    if (FJsonSerializer::Serialize(Document, Writer) == false)
+    {
+        return false;
+    }
+
+    if (FFileHelper::SaveStringToFile(Output, *Filename) == false)
+    {
+        UE_LOG(LogActorDebugger, Error, TEXT("Failed to write benchmark results to %s"), *Filename);
+        return false;
+    }
+
+    UE_LOG(LogActorDebugger, Display, TEXT("Benchmark results written to %s"), *Filename);
+    return true;
+}
+
+FString FActorDebuggerBenchmark::GetDefaultResultsFilename()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ActorDebugger"), TEXT("Benchmarks"), FDateTime::Now().ToString(TEXT("%Y%m%d-%H%M%S")) + TEXT(".json"));
+}
+
+FActorDebuggerBenchmarkFixture::FActorDebuggerBenchmarkFixture(int32 NumRootObjects, int32 Depth, int32 FanOut, int32 ContainerSize)
+    : Settings(FActorDebuggerBenchmarkSettings::MakeShape(NumRootObjects, Depth, FanOut, ContainerSize))
+{
+    Actor.Reset(FActorDebuggerBenchmark::CreateActor(Settings, Objects));
+}
@@ -0,0 +1,141 @@
+/**
+ * @file ActorDebuggerBenchmark.h
+ * @brief Declares the FActorDebuggerBenchmark class, which measures the inspector core against synthetic object graphs.
+ *
+ * A benchmark run builds an AActorDebuggerBenchmarkActor owning a graph of UActorDebuggerBenchmarkObjects shaped by
+ * the settings (root objects, depth, fan out and container sizes), then times the same steps the debugger window
+ * goes through:
+ *
+ * 1. Build: selecting the actor, which gathers its top level properties.
+ * 2. Expand: expanding every node of the tree down to the depth and node budgets.
+ * 3. First display: exporting the values of the rows that would be in view, as row generation does.
+ * 4. Format all: exporting every value synchronously and through the format pipeline.
+ * 5. Refresh: a number of simulated frames in which a fraction of the objects change and the refresh scheduler
+ *    and format pipeline run exactly as they do in the widget's ticker.
+ *
+ * Memory is reported as the size of the node arena along with the change in used physical memory over the run.
+ * No Slate widgets are created so the benchmark runs headless, e.g. with -nullrhi.
+ *
+ * The benchmark is run by the ActorDebuggerBenchmark commandlet and by the ActorDebugger.Benchmark automation tests.
+ * Results are written as JSON so they can be tracked across versions.
+ *
+ * Classes and Structures:
+ * - FActorDebuggerBenchmarkSettings: The shape of the synthetic graph and how long to run for. Named presets exist
+ *   for the common shapes and any setting can be overridden from the command line.
+ * - FActorDebuggerBenchmarkResults: The timings, counts and memory use of one run.
+ * - FActorDebuggerBenchmark: Runs the benchmark and writes results.
+ * - FActorDebuggerBenchmarkFixture: A synthetic actor and its objects, kept alive for the duration of a test.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+class FJsonObject;
+
+struct FActorDebuggerBenchmarkSettings
+{
+	FString Name {TEXT("Default")};
+
+	/* Objects held directly by the actor */
+	int32 NumRootObjects {8};
+
+	/* Levels of child objects below each root object */
+	int32 Depth {3};
+
+	/* Child objects owned by every object above the last level */
+	int32 FanOut {3};
+
+	/* Elements in every TArray, TSet and TMap of every object */
+	int32 ContainerSize {32};
+
+	/* Fraction of the objects that change every simulated frame */
+	float ChangeRate {0.1f};
+
+	int32 NumFrames {600};
+	float FrameRate {60.0f};
+
+	/* Rows registered with the refresh scheduler, as if this many rows were in view. 0 registers every node */
+	int32 VisibleRows {200};
+
+	int32 Seed {0x5eed};
+
+	/* Overrides settings from -Name=Value pairs, e.g. -Depth=4 -ContainerSize=1000 */
+	void ParseCommandLine(const TCHAR* Params);
+
+	TSharedRef<FJsonObject> ToJson() const;
+
+	/* Default settings with the shape of the graph replaced */
+	static FActorDebuggerBenchmarkSettings MakeShape(int32 NumRootObjects, int32 Depth, int32 FanOut, int32 ContainerSize);
+
+	/* Fills OutSettings with a named preset. Returns false if there is no preset with that name */
+	static bool GetPreset(const FString& PresetName, FActorDebuggerBenchmarkSettings& OutSettings);
+	static TArray<FString> GetPresetNames();
+};
+
+struct FActorDebuggerBenchmarkResults
+{
+	int32 NumObjects {0};
+	int32 NumNodes {0};
+	bool bNodeBudgetExhausted {false};
+
+	double BuildMilliseconds {0.0};
+	double ExpandMilliseconds {0.0};
+	double FirstDisplayMilliseconds {0.0};
+	double FormatAllMilliseconds {0.0};
+
+	/* Formatting every value with ExportText instead of the fast formatters, for comparison */
+	double ExportTextAllMilliseconds {0.0};
+	double PipelineFormatAllMilliseconds {0.0};
+
+	/* Per frame cost of the refresh loop: collecting formatted values, sampling and dispatching */
+	double RefreshAverageMicroseconds {0.0};
+	double RefreshMedianMicroseconds {0.0};
+	double RefreshP95Microseconds {0.0};
+	double RefreshMaxMicroseconds {0.0};
+
+	int64 NumSampled {0};
+	int64 NumChanged {0};
+	int64 NumDeferred {0};
+	int64 NumFormatted {0};
+	int64 NumContainerRebuilds {0};
+
+	int64 ArenaBytes {0};
+	int64 UsedPhysicalDeltaBytes {0};
+
+	TSharedRef<FJsonObject> ToJson() const;
+};
+
+class FActorDebuggerBenchmark
+{
+public:
+	static FActorDebuggerBenchmarkResults Run(const FActorDebuggerBenchmarkSettings& Settings);
+
+	/* Creates the synthetic actor and its object graph. Every object created is added to OutObjects */
+	static AActorDebuggerBenchmarkActor* CreateActor(const FActorDebuggerBenchmarkSettings& Settings, TArray<UActorDebuggerBenchmarkObject*>& OutObjects);
+
+	/* Expands every node of the inspection, filling OutItems in the order a fully expanded tree displays them */
+	static void ExpandAll(FActorDebuggerInspection& Inspection, TArray<FReflectedActorPropertyPtr>& OutItems);
+
+	/* Writes the runs as one JSON document along with the engine version, platform and time of the run */
+	static bool WriteResults(const FString& Filename, const TArray<TPair<FActorDebuggerBenchmarkSettings, FActorDebuggerBenchmarkResults>>& Runs);
+
+	/* Where results go when no filename is given: Saved/ActorDebugger/Benchmarks/<timestamp>.json */
+	static FString GetDefaultResultsFilename();
+};
+
+struct FActorDebuggerBenchmarkFixture
+{
+	FActorDebuggerBenchmarkFixture(int32 NumRootObjects, int32 Depth, int32 FanOut, int32 ContainerSize);
+
+	FActorDebuggerBenchmarkSettings Settings;
+
+	/* Every object below the actor, in the order CreateActor made them */
+	TArray<UActorDebuggerBenchmarkObject*> Objects;
+
+	TStrongObjectPtr<AActorDebuggerBenchmarkActor> Actor;
+};
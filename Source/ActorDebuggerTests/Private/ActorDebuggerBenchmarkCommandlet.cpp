@@ -0,0 +1,57 @@
+#include "ActorDebuggerBenchmarkCommandlet.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebugger.h"
+#include "Misc/Parse.h"
+
+UActorDebuggerBenchmarkCommandlet::UActorDebuggerBenchmarkCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = false;
+    LogToConsole = true;
+}
+
+/*
+* Returns 0 if every preset ran and the results were written, 1 otherwise so that automation can
+* detect a failed run from the exit code
+*/
+int32 UActorDebuggerBenchmarkCommandlet::Main(const FString& Params)
+{
+    TArray<FString> PresetNames;
+
+    FString PresetList;
+    if (FParse::Value(*Params, TEXT("Presets="), PresetList, false))
+    {
+        PresetList.ParseIntoArray(PresetNames, TEXT(","));
+    }
+    else
+    {
+        PresetNames = FActorDebuggerBenchmarkSettings::GetPresetNames();
+    }
+
+    FString Filename;
+    if (FParse::Value(*Params, TEXT("Output="), Filename) == false)
+    {
+        Filename = FActorDebuggerBenchmark::GetDefaultResultsFilename();
+    }
+
+    TArray<TPair<FActorDebuggerBenchmarkSettings, FActorDebuggerBenchmarkResults>> Runs;
+
+    for (const FString& PresetName : PresetNames)
+    {
+        FActorDebuggerBenchmarkSettings Settings;
+        if (FActorDebuggerBenchmarkSettings::GetPreset(PresetName.TrimStartAndEnd(), Settings) == false)
+        {
+            UE_LOG(LogActorDebugger, Error, TEXT("Unknown benchmark preset %s, expected one of %s"), *PresetName, *FString::Join(FActorDebuggerBenchmarkSettings::GetPresetNames(), TEXT(", ")));
+            return 1;
+        }
+
+        Settings.ParseCommandLine(*Params);
+        Runs.Emplace(Settings, FActorDebuggerBenchmark::Run(Settings));
+
+        // each run starts from the same memory state
+        CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+    }
+
+    return FActorDebuggerBenchmark::WriteResults(Filename, Runs) ? 0 : 1;
+}
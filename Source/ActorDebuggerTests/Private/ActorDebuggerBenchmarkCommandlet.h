@@ -0,0 +1,30 @@
+/**
+ * @file ActorDebuggerBenchmarkCommandlet.h
+ * @brief Declares the UActorDebuggerBenchmarkCommandlet class, which runs the Actor Debugger benchmark headless.
+ *
+ * Runs one or more benchmark presets and writes the results of all of them to a single JSON file, e.g.
+ *
+ *   UnrealEditor-Cmd Project.uproject -run=ActorDebuggerBenchmark -nullrhi -unattended -Presets=Small,Wide -Output=Results.json
+ *
+ * Every setting of FActorDebuggerBenchmarkSettings can be overridden on the command line (-Depth=, -FanOut=,
+ * -ContainerSize=, -ChangeRate=, -Frames=, ...) and the override applies to every preset that is run. Without
+ * -Presets every preset is run, without -Output results go to Saved/ActorDebugger/Benchmarks.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ActorDebuggerBenchmarkCommandlet.generated.h"
+
+UCLASS()
+class UActorDebuggerBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UActorDebuggerBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
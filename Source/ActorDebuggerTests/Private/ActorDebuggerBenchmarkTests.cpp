@@ -0,0 +1,57 @@
+#include "Misc/AutomationTest.h"
+#include "ActorDebuggerBenchmark.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Runs the smallest preset so that the benchmark itself can't rot unnoticed. Runs with the engine tests
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerBenchmarkSmokeTest, "ActorDebugger.Benchmark.Smoke", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerBenchmarkSmokeTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkSettings Settings;
+    FActorDebuggerBenchmarkSettings::GetPreset(TEXT("Small"), Settings);
+
+    const FActorDebuggerBenchmarkResults Results = FActorDebuggerBenchmark::Run(Settings);
+
+    TestEqual(TEXT("Every object was created"), Results.NumObjects, Settings.NumRootObjects * (1 + Settings.FanOut));
+    TestTrue(TEXT("The tree was built"), Results.NumNodes > 0);
+    TestTrue(TEXT("Rows were sampled"), Results.NumSampled > 0);
+    TestTrue(TEXT("Changes were detected"), Results.NumChanged > 0);
+
+    return true;
+}
+
+/*
+* Runs every preset and writes the results, one test per preset. Filtered as a performance test so it only
+* runs when asked for, e.g. -ExecCmds="Automation RunFilter Perf"
+*/
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FActorDebuggerBenchmarkPerfTest, "ActorDebugger.Benchmark.Presets", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+void FActorDebuggerBenchmarkPerfTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    for (const FString& PresetName : FActorDebuggerBenchmarkSettings::GetPresetNames())
+    {
+        OutBeautifiedNames.Add(PresetName);
+        OutTestCommands.Add(PresetName);
+    }
+}
+
+bool FActorDebuggerBenchmarkPerfTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkSettings Settings;
+    if (FActorDebuggerBenchmarkSettings::GetPreset(Parameters, Settings) == false)
+    {
+        AddError(FString::Printf(TEXT("Unknown preset %s"), *Parameters));
+        return false;
+    }
+
+    TArray<TPair<FActorDebuggerBenchmarkSettings, FActorDebuggerBenchmarkResults>> Runs;
+    Runs.Emplace(Settings, FActorDebuggerBenchmark::Run(Settings));
+
+    const FString Filename = FActorDebuggerBenchmark::GetDefaultResultsFilename().Replace(TEXT(".json"), *FString::Printf(TEXT("-%s.json"), *Parameters));
+    TestTrue(TEXT("Results were written"), FActorDebuggerBenchmark::WriteResults(Filename, Runs));
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
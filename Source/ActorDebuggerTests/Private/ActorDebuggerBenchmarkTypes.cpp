@@ -0,0 +1,76 @@
+#include "ActorDebuggerBenchmarkTypes.h"
+
+/*
+* Every value is derived from the random stream so that graphs built from the same seed are identical
+*/
+void UActorDebuggerBenchmarkObject::Populate(FRandomStream& Random, int32 ContainerSize)
+{
+    bBool = Random.GetFraction() < 0.5f;
+    Int32 = Random.RandRange(0, 1000);
+    Int64 = static_cast<int64>(Random.RandRange(0, MAX_int32)) << 8;
+    Float = Random.FRandRange(-1000.0f, 1000.0f);
+    Double = Random.FRandRange(-1000.0f, 1000.0f);
+    String = FString::Printf(TEXT("String %d"), Random.RandRange(0, 1000));
+    Name = FName(TEXT("Name"), Random.RandRange(0, 1000));
+    Text = FText::FromString(FString::Printf(TEXT("Text %d"), Random.RandRange(0, 1000)));
+    Enum = static_cast<EActorDebuggerBenchmarkEnum>(Random.RandRange(0, 2));
+    Vector = Random.GetUnitVector() * 100.0;
+    Rotator = FRotator(Random.FRandRange(-180.0f, 180.0f), Random.FRandRange(-180.0f, 180.0f), 0.0f);
+    Transform = FTransform(Rotator, Vector);
+
+    Struct.Int32 = Int32;
+    Struct.Float = Float;
+    Struct.Vector = Vector;
+    Struct.String = String;
+    Struct.Name = Name;
+
+    IntArray.Reset(ContainerSize);
+    StructArray.Reset(ContainerSize);
+    IntSet.Reset();
+    NameMap.Reset();
+
+    for (int32 ElementIndex = 0; ElementIndex < ContainerSize; ++ElementIndex)
+    {
+        IntArray.Add(Random.RandRange(0, 1000));
+
+        FActorDebuggerBenchmarkStruct& Element = StructArray.AddDefaulted_GetRef();
+        Element.Int32 = ElementIndex;
+        Element.Float = Random.GetFraction();
+
+        IntSet.Add(ElementIndex);
+        NameMap.Add(FName(TEXT("Key"), ElementIndex), ElementIndex);
+    }
+}
+
+void UActorDebuggerBenchmarkObject::Mutate(FRandomStream& Random)
+{
+    ++Int32;
+    Float += Random.FRandRange(-1.0f, 1.0f);
+    Vector += Random.GetUnitVector();
+    Transform.SetLocation(Vector);
+    Struct.Int32 = Int32;
+
+    if (IntArray.Num() > 0)
+    {
+        IntArray[Random.RandHelper(IntArray.Num())] = Random.RandRange(0, 1000);
+    }
+
+    if (Random.RandHelper(8) == 0)
+    {
+        String = FString::Printf(TEXT("String %d"), Int32);
+        bBool = !bBool;
+    }
+
+    // element counts change rarely, but when they do the container's children are gathered again
+    if (Random.RandHelper(32) == 0)
+    {
+        if (Random.GetFraction() < 0.5f || IntArray.Num() == 0)
+        {
+            IntArray.Add(Int32);
+        }
+        else
+        {
+            IntArray.Pop(EAllowShrinking::No);
+        }
+    }
+}
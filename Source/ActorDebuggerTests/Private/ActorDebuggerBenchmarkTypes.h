@@ -0,0 +1,139 @@
+/**
+ * @file ActorDebuggerBenchmarkTypes.h
+ * @brief Declares the synthetic actor, object and struct types that the Actor Debugger benchmark and automation tests inspect.
+ *
+ * The types cover every kind of value the inspector handles: plain numbers, strings, names, text, enums, nested
+ * structs, object references and TArray, TSet and TMap containers. Objects own further objects through Children,
+ * which lets a benchmark build object graphs of any depth and fan out, and point back at their owner through Owner,
+ * which gives the inspection's cycle detection something to do.
+ *
+ * Classes and Structures:
+ * - EActorDebuggerBenchmarkEnum: A small enum so enum formatting is part of every measurement.
+ * - FActorDebuggerBenchmarkStruct: A struct with a handful of members, displayed nested and inside containers.
+ * - UActorDebuggerBenchmarkObject: A node of the synthetic object graph.
+ * - AActorDebuggerBenchmarkActor: The actor at the root of the synthetic object graph.
+ *
+ * Copyright Dan Wheeler. All Rights Reserved.
+ */
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "GameFramework/Actor.h"
+#include "ActorDebuggerBenchmarkTypes.generated.h"
+
+UENUM()
+enum class EActorDebuggerBenchmarkEnum : uint8
+{
+	First,
+	Second,
+	Third
+};
+
+USTRUCT(BlueprintType)
+struct FActorDebuggerBenchmarkStruct
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	int32 Int32 {0};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	float Float {0.0f};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FVector Vector {FVector::ZeroVector};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FString String;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FName Name;
+};
+
+UCLASS(Transient)
+class UActorDebuggerBenchmarkObject : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/* Fills every property and every container with ContainerSize elements */
+	void Populate(FRandomStream& Random, int32 ContainerSize);
+
+	/* Changes a few values the way gameplay code would: scalars every time, strings and container sizes rarely */
+	void Mutate(FRandomStream& Random);
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	bool bBool {false};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	int32 Int32 {0};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	int64 Int64 {0};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	float Float {0.0f};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	double Double {0.0};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FString String;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FName Name;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FText Text;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	EActorDebuggerBenchmarkEnum Enum {EActorDebuggerBenchmarkEnum::First};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FVector Vector {FVector::ZeroVector};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FRotator Rotator {FRotator::ZeroRotator};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FTransform Transform;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FActorDebuggerBenchmarkStruct Struct;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TArray<int32> IntArray;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TArray<FActorDebuggerBenchmarkStruct> StructArray;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TSet<int32> IntSet;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TMap<FName, int32> NameMap;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TArray<TObjectPtr<UActorDebuggerBenchmarkObject>> Children;
+
+	/* Points back up the graph, the inspection must not expand it again */
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TObjectPtr<UActorDebuggerBenchmarkObject> Owner;
+};
+
+UCLASS(Transient, NotPlaceable)
+class AActorDebuggerBenchmarkActor : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	int32 Health {100};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	FVector Velocity {FVector::ZeroVector};
+
+	UPROPERTY(BlueprintReadWrite, Category = "Benchmark")
+	TArray<TObjectPtr<UActorDebuggerBenchmarkObject>> Objects;
+};
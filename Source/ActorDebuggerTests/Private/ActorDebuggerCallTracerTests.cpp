@@ -0,0 +1,86 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "HAL/IConsoleManager.h"
+#include "ActorDebuggerCallTracer.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Engine functions must only be hooked when asked for, a traced call must be recorded once with its function and
+* object, calls on other instances of the class must only pass through, and stopping the trace must give the function
+* its own pointer back
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerCallTracerTest, "ActorDebugger.CallTracer", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerCallTracerTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Traced(2, 1, 1, 1);
+    FActorDebuggerBenchmarkFixture Untraced(2, 1, 1, 1);
+
+    UFunction* Function = Traced.Actor->FindFunction(TEXT("GetActorTickInterval"));
+    if (TestNotNull(TEXT("The function is found"), Function) == false)
+    {
+        return false;
+    }
+    const FNativeFuncPtr OriginalFunc = Function->GetNativeFunc();
+
+    struct FGetActorTickIntervalParams
+    {
+        float ReturnValue {-1.0f};
+    };
+
+    FActorDebuggerCallTracer& Tracer = FActorDebuggerCallTracer::Get();
+    TArray<FActorDebuggerCallRecord> Records;
+
+    IConsoleVariable* TraceEngineFunctions = IConsoleManager::Get().FindConsoleVariable(TEXT("ActorDebugger.TraceEngineFunctions"));
+    if (TestNotNull(TEXT("The engine functions variable exists"), TraceEngineFunctions) == false)
+    {
+        return false;
+    }
+    const bool bTraceEngineFunctions = TraceEngineFunctions->GetBool();
+
+    TraceEngineFunctions->Set(false, ECVF_SetByCode);
+    TestTrue(TEXT("The trace starts"), Tracer.Start(Traced.Actor.Get()));
+    TestTrue(TEXT("Engine functions aren't hooked by default"), Function->GetNativeFunc() == OriginalFunc);
+    Tracer.Stop();
+
+    TraceEngineFunctions->Set(true, ECVF_SetByCode);
+    TestTrue(TEXT("The trace starts"), Tracer.Start(Traced.Actor.Get()));
+    TraceEngineFunctions->Set(bTraceEngineFunctions, ECVF_SetByCode);
+    TestTrue(TEXT("The function is hooked"), Function->GetNativeFunc() != OriginalFunc);
+    TestTrue(TEXT("Subobjects are traced"), Tracer.GetNumObjects() > Traced.Actor->Objects.Num());
+
+    Tracer.Collect(Records);
+    Records.Reset();
+
+    FGetActorTickIntervalParams TracedParams;
+    Traced.Actor->ProcessEvent(Function, &TracedParams);
+    FGetActorTickIntervalParams UntracedParams;
+    Untraced.Actor->ProcessEvent(Function, &UntracedParams);
+
+    TestEqual(TEXT("The hook calls the function"), TracedParams.ReturnValue, Traced.Actor->GetActorTickInterval());
+    TestEqual(TEXT("Calls on other objects pass through"), UntracedParams.ReturnValue, Untraced.Actor->GetActorTickInterval());
+
+    TestEqual(TEXT("Only the call on the traced object is recorded"), Tracer.Collect(Records), 1);
+    if (Records.Num() == 1)
+    {
+        const FActorDebuggerCallRecord& Record = Records[0];
+        TestEqual(TEXT("The function is recorded"), Tracer.GetFunctionName(Record.FunctionIndex), Function->GetFName());
+        TestEqual(TEXT("The object is recorded"), Tracer.GetObjectName(Record.ObjectIndex), Traced.Actor->GetName());
+        TestEqual(TEXT("The frame is recorded"), Record.Frame, GFrameCounter);
+        TestEqual(TEXT("The call wasn't made from another traced call"), Record.Depth, 0);
+        TestTrue(TEXT("The call is timed"), Record.EndCycles >= Record.StartCycles && Record.StartCycles >= Tracer.GetStartCycles());
+    }
+
+    Tracer.Stop();
+    TestTrue(TEXT("Stopping puts the function back"), Function->GetNativeFunc() == OriginalFunc);
+
+    Traced.Actor->ProcessEvent(Function, &TracedParams);
+    Records.Reset();
+    TestEqual(TEXT("Nothing is recorded once stopped"), Tracer.Collect(Records), 0);
+
+    return true;
+}
+
+#endif
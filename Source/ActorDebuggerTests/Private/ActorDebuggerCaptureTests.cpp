@@ -0,0 +1,116 @@
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerCapture.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Captures a small graph while mutating it, then replays frames out of order and checks every replayed value
+* against what the graph held when the frame was captured. The same capture is replayed a second time with its
+* index cut off, as if the game had crashed while capturing
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerCaptureRoundTripTest, "ActorDebugger.Capture.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerCaptureRoundTripTest::RunTest(const FString& Parameters)
+{
+    static constexpr int32 NumFrames = 10;
+
+    FActorDebuggerBenchmarkFixture Fixture(2, 1, 2, 4);
+
+    // short keyframe intervals so that seeking crosses keyframes
+    IConsoleVariable* KeyframeInterval = IConsoleManager::Get().FindConsoleVariable(TEXT("ActorDebugger.CaptureKeyframeInterval"));
+    const int32 PreviousKeyframeInterval = KeyframeInterval->GetInt();
+    KeyframeInterval->Set(4, ECVF_SetByCode);
+
+    const FString Filename = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("ActorDebuggerCapture"), TEXT(".adcap"));
+    const FString TruncatedFilename = FPaths::ChangeExtension(Filename, TEXT("truncated.adcap"));
+
+    TArray<int32> ExpectedHealth;
+    TArray<int32> ExpectedInt32;
+    TArray<FString> ExpectedString;
+    TArray<int32> ExpectedArrayNum;
+    {
+        FActorDebuggerCaptureWriter Writer;
+        TestTrue(TEXT("Capture file is created"), Writer.Open(Filename));
+        Writer.AddObjectGraph(Fixture.Actor.Get());
+
+        FRandomStream Random(Fixture.Settings.Seed);
+        for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            Fixture.Actor->Health = Frame * 10;
+            Fixture.Objects[0]->Mutate(Random);
+            Fixture.Objects[0]->String = FString::Printf(TEXT("Frame %d"), Frame);
+            if (Frame == 5)
+            {
+                Fixture.Objects[0]->IntArray.Add(Frame);
+            }
+
+            ExpectedHealth.Add(Fixture.Actor->Health);
+            ExpectedInt32.Add(Fixture.Objects[0]->Int32);
+            ExpectedString.Add(Fixture.Objects[0]->String);
+            ExpectedArrayNum.Add(Fixture.Objects[0]->IntArray.Num());
+
+            Writer.CaptureFrame(Frame / 60.0);
+        }
+
+        Writer.Close();
+    }
+
+    KeyframeInterval->Set(PreviousKeyframeInterval, ECVF_SetByCode);
+
+    // everything but the trailer and the index record in front of it
+    TArray<uint8> Bytes;
+    FFileHelper::LoadFileToArray(Bytes, *Filename);
+    Bytes.SetNum(Bytes.Num() - 16);
+    FFileHelper::SaveArrayToFile(Bytes, *TruncatedFilename);
+
+    for (const FString& CaptureFilename : { Filename, TruncatedFilename })
+    {
+        FActorDebuggerCaptureReader Reader;
+        if (TestTrue(FString::Printf(TEXT("%s opens"), *CaptureFilename), Reader.Open(CaptureFilename)) == false)
+        {
+            continue;
+        }
+
+        TestEqual(TEXT("Every frame is read"), Reader.GetNumFrames(), NumFrames);
+        TestEqual(TEXT("The actor and its objects are captured"), Reader.GetNumObjects(), Fixture.Objects.Num() + 1);
+
+        AActorDebuggerBenchmarkActor* ReplayActor = Cast<AActorDebuggerBenchmarkActor>(Reader.CreateReplayObjects());
+        if (TestNotNull(TEXT("Replay actor"), ReplayActor) == false)
+        {
+            continue;
+        }
+
+        for (const int32 Frame : { 7, 2, 3, 9, 0, 5 })
+        {
+            TestTrue(TEXT("Frame applies"), Reader.ApplyFrame(Frame));
+            TestEqual(FString::Printf(TEXT("Health at frame %d"), Frame), ReplayActor->Health, ExpectedHealth[Frame]);
+
+            if (TestEqual(TEXT("Objects point at replay objects"), ReplayActor->Objects.Num(), Fixture.Settings.NumRootObjects) == false)
+            {
+                break;
+            }
+
+            const UActorDebuggerBenchmarkObject* ReplayObject = ReplayActor->Objects[0];
+            TestTrue(TEXT("Object is a replay object"), ReplayObject && ReplayObject != Fixture.Objects[0]);
+            if (ReplayObject)
+            {
+                TestEqual(FString::Printf(TEXT("Int32 at frame %d"), Frame), ReplayObject->Int32, ExpectedInt32[Frame]);
+                TestEqual(FString::Printf(TEXT("String at frame %d"), Frame), ReplayObject->String, ExpectedString[Frame]);
+                TestEqual(FString::Printf(TEXT("IntArray at frame %d"), Frame), ReplayObject->IntArray.Num(), ExpectedArrayNum[Frame]);
+            }
+        }
+    }
+
+    IFileManager::Get().Delete(*Filename);
+    IFileManager::Get().Delete(*TruncatedFilename);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,134 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerColumns.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* The vector kernels must agree with a plain loop, including the values left over after the last full vector
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerColumnStatsTest, "ActorDebugger.Columns.Stats", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerColumnStatsTest::RunTest(const FString& Parameters)
+{
+    FRandomStream Random(1234);
+    TArray<double> Values;
+    for (int32 Index = 0; Index < 1003; ++Index)
+    {
+        Values.Add(Random.FRandRange(-1000.0f, 1000.0f));
+    }
+    Values[1001] = -5000.0;
+    Values[1002] = 5000.0;
+
+    FActorDebuggerColumnStats Stats;
+    FActorDebuggerColumnTable::ComputeStats(Values.GetData(), Values.Num(), 16, Stats);
+
+    double Sum = 0.0;
+    for (double Value : Values)
+    {
+        Sum += Value;
+    }
+
+    TestEqual(TEXT("Every value is counted"), Stats.NumValues, Values.Num());
+    TestEqual(TEXT("The minimum is found in the values after the last vector"), Stats.Min, -5000.0);
+    TestEqual(TEXT("The maximum is found in the values after the last vector"), Stats.Max, 5000.0);
+    TestEqual(TEXT("Mean"), Stats.Mean, Sum / Values.Num(), 1e-9);
+
+    int32 NumBinned = 0;
+    for (int32 Count : Stats.Histogram)
+    {
+        NumBinned += Count;
+    }
+    TestEqual(TEXT("Every value lands in a bin"), NumBinned, Values.Num());
+    TestEqual(TEXT("The minimum lands in the first bin"), Stats.Histogram[0] > 0, true);
+    TestEqual(TEXT("The maximum lands in the last bin"), Stats.Histogram.Last() > 0, true);
+
+    const double Same[] = { 3.0, 3.0, 3.0, 3.0, 3.0 };
+    FActorDebuggerColumnTable::ComputeStats(Same, UE_ARRAY_COUNT(Same), 16, Stats);
+    TestEqual(TEXT("Equal values all land in the first bin"), Stats.Histogram[0], 5);
+
+    FActorDebuggerColumnTable::ComputeStats(nullptr, 0, 16, Stats);
+    TestEqual(TEXT("No values"), Stats.NumValues, 0);
+
+    return true;
+}
+
+/*
+* Filtering and sorting run on the column buffers, the view must hold exactly the rows that pass in column order,
+* and the statistics must describe the rows in the view
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerColumnTableTest, "ActorDebugger.Columns.Table", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerColumnTableTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(100, 2, 2, 4);
+
+    FActorDebuggerColumnTable Table;
+    Table.SetClass(UActorDebuggerBenchmarkObject::StaticClass());
+
+    FText Error;
+    TestTrue(TEXT("Number column"), Table.AddColumn(TEXT("Int32"), Error));
+    TestTrue(TEXT("Struct member column"), Table.AddColumn(TEXT("Struct.Float"), Error));
+    TestTrue(TEXT("Enum column"), Table.AddColumn(TEXT("Enum"), Error));
+    TestTrue(TEXT("Element count column"), Table.AddColumn(TEXT("IntArray"), Error));
+    TestTrue(TEXT("Text column"), Table.AddColumn(TEXT("String"), Error));
+    TestFalse(TEXT("Unknown properties are rejected"), Table.AddColumn(TEXT("Armor"), Error));
+
+    Table.Sample(nullptr);
+    TestTrue(TEXT("Every instance is a row"), Table.GetNumRows() >= Fixture.Objects.Num());
+
+    const TArray<FActorDebuggerColumn>& Columns = Table.GetColumns();
+    const FActorDebuggerColumn& Int32Column = Columns[0];
+
+    // other tests may have left instances behind, the sampled values are checked against each row's own object
+    bool bSampledCorrectly = true;
+    for (int32 Row = 0; Row < Table.GetNumRows(); ++Row)
+    {
+        if (const UActorDebuggerBenchmarkObject* Object = Cast<UActorDebuggerBenchmarkObject>(Table.GetObject(Row)))
+        {
+            bSampledCorrectly &= Int32Column.Numbers[Row] == Object->Int32 && Columns[1].Numbers[Row] == Object->Struct.Float
+                && Columns[3].Numbers[Row] == Object->IntArray.Num() && Columns[4].Texts[Row] == Object->String;
+        }
+    }
+    TestTrue(TEXT("The buffers hold each row's values"), bSampledCorrectly);
+    TestEqual(TEXT("Enums are shown by name"), Columns[2].FormatValue(0).IsEmpty(), false);
+
+    Table.SortBy(0, false);
+    bool bSorted = true;
+    for (int32 ViewIndex = 1; ViewIndex < Table.GetView().Num(); ++ViewIndex)
+    {
+        bSorted &= Int32Column.Numbers[Table.GetView()[ViewIndex - 1]] >= Int32Column.Numbers[Table.GetView()[ViewIndex]];
+    }
+    TestTrue(TEXT("The view is sorted by the column"), bSorted);
+    TestEqual(TEXT("The largest value comes first"), Int32Column.Numbers[Table.GetView()[0]], Int32Column.Stats.Max);
+
+    TestTrue(TEXT("Number filter"), Table.SetFilter(TEXT("Int32 > 500"), Error));
+    int32 NumExpected = 0;
+    for (int32 Row = 0; Row < Table.GetNumRows(); ++Row)
+    {
+        NumExpected += Int32Column.Numbers[Row] > 500.0 ? 1 : 0;
+    }
+    TestEqual(TEXT("The filter keeps exactly the rows that pass"), Table.GetView().Num(), NumExpected);
+    TestTrue(TEXT("The statistics describe the view"), Int32Column.Stats.Min > 500.0);
+
+    TestTrue(TEXT("Enum filter by name"), Table.SetFilter(TEXT("Enum == Second"), Error));
+    bool bFilteredByEnum = true;
+    for (int32 Row : Table.GetView())
+    {
+        bFilteredByEnum &= Columns[2].FormatValue(Row).EndsWith(TEXT("Second"));
+    }
+    TestTrue(TEXT("Only rows with the enum value pass"), bFilteredByEnum);
+
+    TestFalse(TEXT("Filters must name a column"), Table.SetFilter(TEXT("Int64 > 5"), Error));
+    TestFalse(TEXT("Number columns need numbers"), Table.SetFilter(TEXT("Int32 > many"), Error));
+
+    TestTrue(TEXT("An empty filter shows every row"), Table.SetFilter(FString(), Error));
+    TestEqual(TEXT("Every row is in the view"), Table.GetView().Num(), Table.GetNumRows());
+
+    Table.RemoveColumn(0);
+    TestEqual(TEXT("Removing the sorted column stops sorting"), Table.GetSortColumn(), INDEX_NONE);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,125 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Dom/JsonObject.h"
+#include "ActorDebuggerDump.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ActorDebuggerDumpTests
+{
+    /* Splits the JSON written so far into its lines, one per pass */
+    static TArray<TSharedPtr<FJsonObject>> ParsePasses(const TArray<uint8>& Bytes)
+    {
+        FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num());
+        TArray<FString> Lines;
+        FString(Text.Length(), Text.Get()).ParseIntoArrayLines(Lines);
+
+        TArray<TSharedPtr<FJsonObject>> Passes;
+        for (const FString& Line : Lines)
+        {
+            TSharedPtr<FJsonObject> Pass;
+            FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Line), Pass);
+            Passes.Add(Pass);
+        }
+        return Passes;
+    }
+}
+
+using namespace ActorDebuggerDumpTests;
+
+/*
+* A tree dump must be valid JSON holding the actor's values and its expanded subobjects, a delta stream must only
+* write what changed, and a binary dump must start with its header
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerDumpTest, "ActorDebugger.Dump", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerDumpTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(2, 1, 1, 4);
+    UObject* Roots[] = { Fixture.Actor.Get() };
+
+    // a single pass of whole trees closes once written
+    {
+        TArray<uint8> Bytes;
+        FActorDebuggerDumpSession Session;
+        TestTrue(TEXT("The tree dump starts"), Session.Start(Roots, FActorDebuggerDumpSession::FOptions(), MakeUnique<FMemoryWriter>(Bytes)));
+        TestFalse(TEXT("A single pass finishes"), Session.Tick(0.0, 1000.0));
+
+        TArray<TSharedPtr<FJsonObject>> Passes = ParsePasses(Bytes);
+        if (TestEqual(TEXT("One pass is written"), Passes.Num(), 1) && TestTrue(TEXT("The pass is JSON"), Passes[0].IsValid()))
+        {
+            const TArray<TSharedPtr<FJsonValue>>& DumpedObjects = Passes[0]->GetArrayField(TEXT("objects"));
+            if (TestEqual(TEXT("The actor is dumped"), DumpedObjects.Num(), 1))
+            {
+                const TSharedPtr<FJsonObject> DumpedActor = DumpedObjects[0]->AsObject();
+                TestEqual(TEXT("The actor is described"), DumpedActor->GetStringField(TEXT("@name")), Fixture.Actor->GetName());
+                TestEqual(TEXT("Numbers are JSON numbers"), static_cast<int32>(DumpedActor->GetNumberField(TEXT("Health"))), Fixture.Actor->Health);
+
+                const TArray<TSharedPtr<FJsonValue>>& DumpedChildren = DumpedActor->GetArrayField(TEXT("Objects"));
+                TestEqual(TEXT("Containers are arrays"), DumpedChildren.Num(), Fixture.Actor->Objects.Num());
+                TestTrue(TEXT("Subobjects are expanded"), DumpedChildren.Num() > 0 && DumpedChildren[0]->Type == EJson::Object && DumpedChildren[0]->AsObject()->HasField(TEXT("@class")));
+            }
+        }
+    }
+
+    // a stream writes everything once, then only what changed when a pass is due
+    {
+        TArray<uint8> Bytes;
+        FActorDebuggerDumpSession::FOptions Options;
+        Options.bDeltas = true;
+        Options.Interval = 1.0;
+
+        FActorDebuggerDumpSession Session;
+        TestTrue(TEXT("The stream starts"), Session.Start(Roots, Options, MakeUnique<FMemoryWriter>(Bytes)));
+        TestTrue(TEXT("Subobjects are watched"), Session.GetNumObjects() > 1);
+
+        TestTrue(TEXT("The stream keeps running"), Session.Tick(0.0, 1000.0));
+        Session.Tick(0.5, 1000.0);
+        TestEqual(TEXT("No pass is written before the interval"), Session.GetNumPasses(), 1);
+
+        Fixture.Actor->Health += 5;
+        Session.Tick(1.0, 1000.0);
+        Session.Stop();
+
+        TArray<TSharedPtr<FJsonObject>> Passes = ParsePasses(Bytes);
+        if (TestEqual(TEXT("Two passes are written"), Passes.Num(), 2) && Passes[1].IsValid())
+        {
+            TestTrue(TEXT("The second pass holds changes"), Passes[1]->GetBoolField(TEXT("delta")));
+
+            const TArray<TSharedPtr<FJsonValue>>& ChangedObjects = Passes[1]->GetArrayField(TEXT("objects"));
+            if (TestEqual(TEXT("Only the changed object is written"), ChangedObjects.Num(), 1))
+            {
+                const TSharedPtr<FJsonObject> ChangedActor = ChangedObjects[0]->AsObject();
+                TestEqual(TEXT("The changed value is written"), static_cast<int32>(ChangedActor->GetNumberField(TEXT("Health"))), Fixture.Actor->Health);
+                TestFalse(TEXT("Unchanged values aren't written"), ChangedActor->HasField(TEXT("Objects")));
+                TestFalse(TEXT("Objects are only described once"), ChangedActor->HasField(TEXT("@name")));
+            }
+        }
+    }
+
+    // binary dumps start with their header
+    {
+        TArray<uint8> Bytes;
+        FActorDebuggerDumpSession::FOptions Options;
+        Options.Format = EActorDebuggerDumpFormat::Binary;
+
+        FActorDebuggerDumpSession Session;
+        Session.Start(Roots, Options, MakeUnique<FMemoryWriter>(Bytes));
+        Session.Tick(0.0, 1000.0);
+
+        uint32 Magic = 0;
+        if (TestTrue(TEXT("The binary dump is written"), Bytes.Num() > sizeof(Magic)))
+        {
+            FMemory::Memcpy(&Magic, Bytes.GetData(), sizeof(Magic));
+            TestEqual(TEXT("The binary dump starts with its magic"), Magic, ActorDebuggerDump::Magic);
+        }
+    }
+
+    return true;
+}
+
+#endif
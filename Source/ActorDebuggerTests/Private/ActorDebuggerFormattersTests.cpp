@@ -0,0 +1,108 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "UObject/UnrealType.h"
+#include "ActorDebuggerFormatters.h"
+#include "ActorDebuggerSchemaCache.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* The fast formatters must produce text that imports back to the same value, and the same text as ExportText for
+* the types whose export is unambiguous. Types without a formatter of their own must fall back to ExportText
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerFormattersTest, "ActorDebugger.Formatters", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerFormattersTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(2, 1, 1, 4);
+
+    // values that survive the round trip through text exactly
+    UActorDebuggerBenchmarkObject* Object = Fixture.Objects[0];
+    Object->bBool = true;
+    Object->Int32 = -42;
+    Object->Int64 = 1ll << 40;
+    Object->Float = 1.5f;
+    Object->Double = -0.25;
+    Object->Name = TEXT("Bob");
+    Object->String = TEXT("Hello there");
+    Object->Enum = EActorDebuggerBenchmarkEnum::Second;
+    Object->Vector = FVector(1.5, -2.0, 0.25);
+    Object->Rotator = FRotator(10.0, 20.5, -30.0);
+    Object->Transform = FTransform(FQuat::Identity, FVector(1.0, 2.0, 3.0), FVector(2.0));
+    Object->Owner = Fixture.Objects[1];
+
+    auto Format = [Object](const FProperty* Property, FActorDebuggerFormatFunction Formatter)
+    {
+        TStringBuilder<256> Builder;
+        Formatter(Property, Property->ContainerPtrToValuePtr<uint8>(Object), Object, Builder);
+        return FString(Builder.Len(), Builder.GetData());
+    };
+
+    auto CheckProperty = [this, Object, &Format](const TCHAR* PropertyName, bool bSameAsExportText)
+    {
+        const FProperty* Property = UActorDebuggerBenchmarkObject::StaticClass()->FindPropertyByName(PropertyName);
+        if (TestNotNull(PropertyName, Property) == false)
+        {
+            return;
+        }
+
+        const FActorDebuggerFormatFunction Formatter = FActorDebuggerFormatters::Select(Property);
+        TestFalse(FString::Printf(TEXT("%s has a fast formatter"), PropertyName), FActorDebuggerFormatters::IsFallback(Formatter));
+
+        const FString Text = Format(Property, Formatter);
+        if (bSameAsExportText)
+        {
+            TestEqual(FString::Printf(TEXT("%s is formatted like ExportText"), PropertyName), Text, Format(Property, &FActorDebuggerFormatters::ExportText));
+        }
+
+        TArray<uint8, TAlignedHeapAllocator<16>> Imported;
+        Imported.SetNumZeroed(Property->GetSize());
+        Property->InitializeValue(Imported.GetData());
+
+        const TCHAR* End = Property->ImportText_Direct(*Text, Imported.GetData(), Object, PPF_None);
+        TestNotNull(FString::Printf(TEXT("%s text '%s' imports"), PropertyName, *Text), End);
+        TestTrue(FString::Printf(TEXT("%s text '%s' imports to the same value"), PropertyName, *Text), Property->Identical(Property->ContainerPtrToValuePtr<uint8>(Object), Imported.GetData()));
+
+        Property->DestroyValue(Imported.GetData());
+    };
+
+    CheckProperty(TEXT("bBool"), true);
+    CheckProperty(TEXT("Int32"), true);
+    CheckProperty(TEXT("Int64"), true);
+    CheckProperty(TEXT("Float"), false);
+    CheckProperty(TEXT("Double"), false);
+    CheckProperty(TEXT("Name"), true);
+    CheckProperty(TEXT("String"), true);
+    CheckProperty(TEXT("Enum"), false);
+    CheckProperty(TEXT("Vector"), false);
+    CheckProperty(TEXT("Rotator"), false);
+    CheckProperty(TEXT("Transform"), false);
+    CheckProperty(TEXT("Owner"), false);
+
+    const FProperty* EnumProperty = UActorDebuggerBenchmarkObject::StaticClass()->FindPropertyByName(TEXT("Enum"));
+    TestEqual(TEXT("Enums are shown without the enum's name"), Format(EnumProperty, FActorDebuggerFormatters::Select(EnumProperty)), FString(TEXT("Second")));
+
+    const FProperty* OwnerProperty = UActorDebuggerBenchmarkObject::StaticClass()->FindPropertyByName(TEXT("Owner"));
+    Object->Owner = nullptr;
+    TestEqual(TEXT("Null references are shown as None"), Format(OwnerProperty, FActorDebuggerFormatters::Select(OwnerProperty)), FString(TEXT("None")));
+
+    TestTrue(TEXT("Text falls back to ExportText"), FActorDebuggerFormatters::IsFallback(FActorDebuggerFormatters::Select(UActorDebuggerBenchmarkObject::StaticClass()->FindPropertyByName(TEXT("Text")))));
+    TestTrue(TEXT("Other structs fall back to ExportText"), FActorDebuggerFormatters::IsFallback(FActorDebuggerFormatters::Select(UActorDebuggerBenchmarkObject::StaticClass()->FindPropertyByName(TEXT("Struct")))));
+
+    // containers show their element count, their entries carry the formatter of their elements
+    FActorDebuggerClassSchemaPtr Schema = FActorDebuggerSchemaCache::Get().FindOrBuild(UActorDebuggerBenchmarkObject::StaticClass());
+    for (const FActorDebuggerPropertySchemaEntry& Entry : Schema->Entries)
+    {
+        TestTrue(TEXT("Every entry has a formatter"), Entry.Formatter != nullptr);
+        if (Entry.Name == TEXT("IntArray") || Entry.Name == TEXT("NameMap"))
+        {
+            TestTrue(TEXT("Containers format their elements"), Entry.Formatter == FActorDebuggerFormatters::Select(FActorDebuggerSchemaCache::GetElementProperty(Entry.Property)));
+            TestFalse(TEXT("Integer elements have a fast formatter"), FActorDebuggerFormatters::IsFallback(Entry.Formatter));
+        }
+    }
+
+    return true;
+}
+
+#endif
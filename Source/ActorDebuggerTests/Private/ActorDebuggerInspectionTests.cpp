@@ -0,0 +1,262 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerInspection.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ActorDebuggerInspectionTests
+{
+    static FReflectedActorPropertyPtr FindChild(FActorDebuggerInspection& Inspection, FReflectedActorPropertyPtr Parent, const TCHAR* Name)
+    {
+        TArray<FReflectedActorPropertyPtr> Children;
+        if (Parent)
+        {
+            Inspection.GetChildren(Parent, Children);
+        }
+        else
+        {
+            Children = Inspection.GetRootItems();
+        }
+
+        FReflectedActorPropertyPtr* Found = Children.FindByPredicate([Name](FReflectedActorPropertyPtr Child)
+        {
+            return Child->GetDisplayName().ToString() == Name;
+        });
+        return Found ? *Found : nullptr;
+    }
+
+    /* Sets a console variable for the duration of a test */
+    struct FScopedConsoleVariable
+    {
+        FScopedConsoleVariable(const TCHAR* Name, int32 Value)
+            : Variable(IConsoleManager::Get().FindConsoleVariable(Name))
+        {
+            check(Variable);
+            PreviousValue = Variable->GetInt();
+            Variable->Set(Value, ECVF_SetByCode);
+        }
+
+        ~FScopedConsoleVariable()
+        {
+            Variable->Set(PreviousValue, ECVF_SetByCode);
+        }
+
+        IConsoleVariable* Variable;
+        int32 PreviousValue {0};
+    };
+}
+
+using namespace ActorDebuggerInspectionTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerInspectionLazyBuildTest, "ActorDebugger.Inspection.LazyBuild", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerInspectionLazyBuildTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(3, 1, 2, 4);
+
+    FActorDebuggerInspection Inspection;
+    Inspection.SetObject(Fixture.Actor.Get());
+
+    TestTrue(TEXT("Root items are gathered"), Inspection.GetRootItems().Num() > 0);
+    TestEqual(TEXT("Nothing below the root items is gathered up front"), Inspection.GetNumNodes(), Inspection.GetRootItems().Num());
+
+    FReflectedActorPropertyPtr ObjectsItem = FindChild(Inspection, nullptr, TEXT("Objects"));
+    if (TestNotNull(TEXT("Objects property"), ObjectsItem) == false)
+    {
+        return false;
+    }
+
+    TestTrue(TEXT("Objects can be expanded before its children are gathered"), ObjectsItem->CanHaveChildren());
+
+    TArray<FReflectedActorPropertyPtr> Children;
+    Inspection.GetChildren(ObjectsItem, Children);
+    TestEqual(TEXT("One child per root object"), Children.Num(), 3);
+    TestEqual(TEXT("Only the container's elements were gathered"), Inspection.GetNumNodes(), Inspection.GetRootItems().Num() + 3);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerInspectionCycleTest, "ActorDebugger.Inspection.Cycles", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerInspectionCycleTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(2, 3, 2, 2);
+
+    FActorDebuggerInspection Inspection;
+    Inspection.SetObject(Fixture.Actor.Get());
+
+    TArray<FReflectedActorPropertyPtr> Items;
+    FActorDebuggerBenchmark::ExpandAll(Inspection, Items);
+
+    // every object points back at its owner, each object must still be expanded exactly once
+    TSet<UObject*> ExpandedObjects;
+    int32 NumExpansions = 0;
+    for (FReflectedActorPropertyPtr Item : Items)
+    {
+        if (Item->ChildObject)
+        {
+            ExpandedObjects.Add(Item->ChildObject);
+            ++NumExpansions;
+        }
+    }
+
+    TestEqual(TEXT("Every object is expanded"), ExpandedObjects.Num(), Fixture.Objects.Num());
+    TestEqual(TEXT("No object is expanded twice"), NumExpansions, Fixture.Objects.Num());
+    TestFalse(TEXT("The node budget is not reached"), Inspection.IsNodeBudgetExhausted());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerInspectionPagingTest, "ActorDebugger.Inspection.ContainerPaging", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerInspectionPagingTest::RunTest(const FString& Parameters)
+{
+    FScopedConsoleVariable PageSize(TEXT("ActorDebugger.ContainerPageSize"), 10);
+
+    FActorDebuggerBenchmarkFixture Fixture(1, 0, 0, 25);
+
+    FActorDebuggerInspection Inspection;
+    Inspection.SetObject(Fixture.Actor.Get());
+
+    FReflectedActorPropertyPtr ObjectsItem = FindChild(Inspection, nullptr, TEXT("Objects"));
+    FReflectedActorPropertyPtr ObjectItem = ObjectsItem ? FindChild(Inspection, ObjectsItem, TEXT("[0]")) : nullptr;
+    FReflectedActorPropertyPtr IntArrayItem = ObjectItem ? FindChild(Inspection, ObjectItem, TEXT("IntArray")) : nullptr;
+    if (TestNotNull(TEXT("IntArray property"), IntArrayItem) == false)
+    {
+        return false;
+    }
+
+    TArray<FReflectedActorPropertyPtr> Pages;
+    Inspection.GetChildren(IntArrayItem, Pages);
+    if (TestEqual(TEXT("25 elements make 3 pages of 10"), Pages.Num(), 3) == false)
+    {
+        return false;
+    }
+
+    const int32 NumNodesBeforeExpanding = Inspection.GetNumNodes();
+
+    TArray<FReflectedActorPropertyPtr> Elements;
+    Inspection.GetChildren(Pages.Last(), Elements);
+    TestEqual(TEXT("The last page holds the remaining 5 elements"), Elements.Num(), 5);
+    TestEqual(TEXT("Only the expanded page's elements are gathered"), Inspection.GetNumNodes(), NumNodesBeforeExpanding + 5);
+    TestEqual(TEXT("Elements of a page keep their index in the container"), Elements[0]->LogicalIndex, 20);
+    TestTrue(TEXT("Elements of a page resolve through the page"), Elements[0]->ResolveValuePtr() == reinterpret_cast<const uint8*>(&Fixture.Objects[0]->IntArray[20]));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerInspectionChangeTest, "ActorDebugger.Inspection.ChangeDetection", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerInspectionChangeTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(1, 0, 0, 4);
+
+    FActorDebuggerInspection Inspection;
+    Inspection.SetObject(Fixture.Actor.Get());
+
+    FReflectedActorPropertyPtr ObjectsItem = FindChild(Inspection, nullptr, TEXT("Objects"));
+    FReflectedActorPropertyPtr ObjectItem = ObjectsItem ? FindChild(Inspection, ObjectsItem, TEXT("[0]")) : nullptr;
+    FReflectedActorPropertyPtr IntItem = ObjectItem ? FindChild(Inspection, ObjectItem, TEXT("Int32")) : nullptr;
+    FReflectedActorPropertyPtr IntArrayItem = ObjectItem ? FindChild(Inspection, ObjectItem, TEXT("IntArray")) : nullptr;
+    if (TestNotNull(TEXT("Int32 property"), IntItem) == false || TestNotNull(TEXT("IntArray property"), IntArrayItem) == false)
+    {
+        return false;
+    }
+
+    const uint64 IntHash = IntItem->HashValue();
+    TestEqual(TEXT("An unchanged value hashes the same"), IntItem->HashValue(), IntHash);
+    ++Fixture.Objects[0]->Int32;
+    TestNotEqual(TEXT("A changed value hashes differently"), IntItem->HashValue(), IntHash);
+
+    TArray<FReflectedActorPropertyPtr> Elements;
+    Inspection.GetChildren(IntArrayItem, Elements);
+    TestFalse(TEXT("An unchanged container keeps its children"), Inspection.RefreshContainerChildren(IntArrayItem));
+
+    Fixture.Objects[0]->IntArray.Add(1);
+    TestTrue(TEXT("A container that grew gathers its children again"), Inspection.RefreshContainerChildren(IntArrayItem));
+    Inspection.GetChildren(IntArrayItem, Elements);
+    TestEqual(TEXT("The new element has a node"), Elements.Num(), 5);
+
+    Fixture.Objects[0]->IntArray.Reset();
+    TestNull(TEXT("Removed elements resolve to nothing"), Elements[0]->ResolveValuePtr());
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerInspectionArenaTest, "ActorDebugger.Inspection.ArenaReuse", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerInspectionArenaTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(4, 2, 2, 16);
+
+    FActorDebuggerInspection Inspection;
+    TArray<FReflectedActorPropertyPtr> Items;
+
+    Inspection.SetObject(Fixture.Actor.Get());
+    FActorDebuggerBenchmark::ExpandAll(Inspection, Items);
+
+    const int64 FirstGeneration = Inspection.GetGeneration();
+    const int64 FirstAllocatedSize = Inspection.GetArena().GetAllocatedSize();
+    const int32 FirstNumNodes = Inspection.GetNumNodes();
+    FReflectedActorPropertyPtr FirstRootItem = Inspection.GetRootItems()[0];
+
+    Items.Reset();
+    Inspection.SetObject(Fixture.Actor.Get());
+    FActorDebuggerBenchmark::ExpandAll(Inspection, Items);
+
+    TestNotEqual(TEXT("Rebuilding starts a new generation"), static_cast<int64>(Inspection.GetGeneration()), FirstGeneration);
+    TestEqual(TEXT("The same tree is built again"), Inspection.GetNumNodes(), FirstNumNodes);
+    TestEqual(TEXT("Rebuilding reuses the arena's pages"), static_cast<int64>(Inspection.GetArena().GetAllocatedSize()), FirstAllocatedSize);
+    TestTrue(TEXT("Nodes are reused in place"), Inspection.GetRootItems()[0] == FirstRootItem);
+    TestTrue(TEXT("Reused nodes carry the new generation"), FirstRootItem->Generation == Inspection.GetGeneration());
+
+    return true;
+}
+
+/*
+* Collecting an expanded object has to invalidate its nodes and unlink its subtree in the same garbage collection,
+* without touching the rest of the tree
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerInspectionInvalidationTest, "ActorDebugger.Inspection.Invalidation", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerInspectionInvalidationTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(2, 1, 2, 4);
+
+    FActorDebuggerInspection Inspection;
+    Inspection.SetObject(Fixture.Actor.Get());
+
+    int32 NumBroadcasts = 0;
+    bool bRootInvalidated = false;
+    Inspection.OnObjectsInvalidated.AddLambda([&NumBroadcasts, &bRootInvalidated](bool bInvalidatedRoot, UObject* RootReplacement)
+    {
+        ++NumBroadcasts;
+        bRootInvalidated = bInvalidatedRoot;
+    });
+
+    FReflectedActorPropertyPtr ObjectsItem = FindChild(Inspection, nullptr, TEXT("Objects"));
+    FReflectedActorPropertyPtr FirstItem = ObjectsItem ? FindChild(Inspection, ObjectsItem, TEXT("[0]")) : nullptr;
+    FReflectedActorPropertyPtr SecondItem = ObjectsItem ? FindChild(Inspection, ObjectsItem, TEXT("[1]")) : nullptr;
+    FReflectedActorPropertyPtr MemberItem = FirstItem ? FindChild(Inspection, FirstItem, TEXT("Int32")) : nullptr;
+    if (TestNotNull(TEXT("Member of the first object"), MemberItem) == false || TestNotNull(TEXT("Second object"), SecondItem) == false)
+    {
+        return false;
+    }
+
+    Fixture.Actor->Objects[0]->MarkAsGarbage();
+    CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+
+    TestEqual(TEXT("The collection is reported once"), NumBroadcasts, 1);
+    TestFalse(TEXT("The inspected object is still alive"), bRootInvalidated);
+    TestTrue(TEXT("The inspection is still alive"), Inspection.IsObjectAlive());
+    TestFalse(TEXT("Nodes of the collected object are invalid"), MemberItem->IsValid());
+    TestTrue(TEXT("Nodes of the collected object don't resolve"), MemberItem->ResolveValuePtr() == nullptr);
+    TestTrue(TEXT("The collected object's subtree is unlinked"), MemberItem->IsDetached() && FirstItem->NumChildren == 0 && FirstItem->CanHaveChildren() == false);
+    TestTrue(TEXT("Other objects are untouched"), SecondItem->IsValid() && SecondItem->CanHaveChildren());
+
+    Inspection.InvalidateObjects([&Fixture.Actor](const FActorDebuggerObjectHandle& ObjectHandle) { return ObjectHandle.Object == Fixture.Actor.Get(); });
+    TestTrue(TEXT("Losing the inspected object is reported"), bRootInvalidated);
+    TestFalse(TEXT("The inspection knows its object is gone"), Inspection.IsObjectAlive());
+    TestFalse(TEXT("Every node of the object is invalid at once"), SecondItem->IsValid());
+
+    return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
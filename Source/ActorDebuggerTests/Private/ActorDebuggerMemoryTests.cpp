@@ -0,0 +1,126 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "HAL/IConsoleManager.h"
+#include "ActorDebuggerMemory.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ActorDebuggerMemoryTests
+{
+    static FReflectedActorPropertyPtr FindRootItem(FActorDebuggerInspection& Inspection, const TCHAR* Name)
+    {
+        for (FReflectedActorPropertyPtr Item : Inspection.GetRootItems())
+        {
+            if (Item->GetDisplayName().ToString() == Name)
+            {
+                return Item;
+            }
+        }
+        return nullptr;
+    }
+}
+
+using namespace ActorDebuggerMemoryTests;
+
+/*
+* Every object below the actor must be counted exactly once, unused capacity must show up as slack, and an update
+* that finds nothing changed must keep its results while a changed value must not, and resource sizes must be taken
+* again once they are old enough
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerMemoryFootprintTest, "ActorDebugger.Memory.Footprint", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerMemoryFootprintTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(4, 2, 3, 16);
+    Fixture.Objects[0]->IntArray.Reserve(Fixture.Objects[0]->IntArray.Num() + 64);
+
+    FActorDebuggerMemory Memory;
+    TestTrue(TEXT("The first update has results"), Memory.Update(Fixture.Actor.Get()));
+
+    for (UActorDebuggerBenchmarkObject* Object : Fixture.Objects)
+    {
+        TestNotNull(*FString::Printf(TEXT("%s is measured"), *Object->GetName()), Memory.Find(Object));
+    }
+
+    int64 TotalExclusive = 0;
+    for (const FActorDebuggerObjectFootprint& Footprint : Memory.GetObjects())
+    {
+        TotalExclusive += Footprint.Exclusive;
+    }
+    TestEqual(TEXT("The root retains every object once"), Memory.GetRetained(), TotalExclusive);
+
+    if (const FActorDebuggerObjectFootprint* Footprint = Memory.Find(Fixture.Objects[0]))
+    {
+        TestTrue(TEXT("Reserved capacity is slack"), Footprint->Size.GetSlack() >= 64 * static_cast<int64>(sizeof(int32)));
+    }
+
+    const uint32 Generation = Memory.GetGeneration();
+    TestFalse(TEXT("An unchanged graph isn't reported as changed"), Memory.Update(Fixture.Actor.Get()));
+    TestEqual(TEXT("An unchanged graph keeps its generation"), Memory.GetGeneration(), Generation);
+    TestEqual(TEXT("Unchanged objects keep their resource sizes"), Memory.GetNumResourceSizesTaken(), 0);
+
+    Fixture.Objects[1]->String = FString::ChrN(256, TEXT('x'));
+    TestTrue(TEXT("A longer string is reported as changed"), Memory.Update(Fixture.Actor.Get()));
+    TestTrue(TEXT("The changed object's resource size is taken again"), Memory.GetNumResourceSizesTaken() > 0);
+
+    IConsoleVariable* ResourceRefreshSeconds = IConsoleManager::Get().FindConsoleVariable(TEXT("ActorDebugger.MemoryResourceRefreshSeconds"));
+    if (TestNotNull(TEXT("The resource refresh variable exists"), ResourceRefreshSeconds))
+    {
+        const float PreviousRefreshSeconds = ResourceRefreshSeconds->GetFloat();
+        ResourceRefreshSeconds->Set(0.0f, ECVF_SetByCode);
+        Memory.Update(Fixture.Actor.Get());
+        ResourceRefreshSeconds->Set(PreviousRefreshSeconds, ECVF_SetByCode);
+        TestEqual(TEXT("Old resource sizes are taken again"), Memory.GetNumResourceSizesTaken(), Memory.GetObjects().Num());
+    }
+
+    return true;
+}
+
+/*
+* A row retains its value and the objects first reached through it, a plain value retains only itself, and the
+* largest contributors come back largest first
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerMemoryNodesTest, "ActorDebugger.Memory.Nodes", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerMemoryNodesTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(4, 2, 2, 8);
+
+    FActorDebuggerInspection Inspection;
+    Inspection.SetObject(Fixture.Actor.Get());
+
+    FActorDebuggerMemory Memory;
+    Memory.Update(Fixture.Actor.Get());
+
+    FActorDebuggerNodeMemory NodeMemory;
+    FReflectedActorPropertyPtr ObjectsItem = FindRootItem(Inspection, TEXT("Objects"));
+    if (TestNotNull(TEXT("The Objects row exists"), ObjectsItem) && TestTrue(TEXT("The Objects row is measured"), Memory.MeasureNode(*ObjectsItem, NodeMemory)))
+    {
+        int64 RootObjectsRetained = 0;
+        for (UActorDebuggerBenchmarkObject* RootObject : Fixture.Actor->Objects)
+        {
+            const FActorDebuggerObjectFootprint* Footprint = Memory.Find(RootObject);
+            RootObjectsRetained += Footprint ? Footprint->Retained : 0;
+        }
+        TestEqual(TEXT("The Objects row retains its objects and their children"), NodeMemory.Retained - NodeMemory.Value.GetTotal(), RootObjectsRetained);
+    }
+
+    FReflectedActorPropertyPtr HealthItem = FindRootItem(Inspection, TEXT("Health"));
+    if (TestNotNull(TEXT("The Health row exists"), HealthItem) && TestTrue(TEXT("The Health row is measured"), Memory.MeasureNode(*HealthItem, NodeMemory)))
+    {
+        TestEqual(TEXT("An int32 takes its own bytes"), NodeMemory.Value.Inline, static_cast<int64>(sizeof(int32)));
+        TestEqual(TEXT("An int32 retains nothing else"), NodeMemory.Retained, static_cast<int64>(sizeof(int32)));
+    }
+
+    TArray<int32> Contributors;
+    Memory.GetLargestContributors(5, Contributors);
+    TestEqual(TEXT("The requested number of contributors is returned"), Contributors.Num(), 5);
+    for (int32 Index = 1; Index < Contributors.Num(); ++Index)
+    {
+        TestTrue(TEXT("Contributors are largest first"), Memory.GetObjects()[Contributors[Index - 1]].Exclusive >= Memory.GetObjects()[Contributors[Index]].Exclusive);
+    }
+
+    return true;
+}
+
+#endif
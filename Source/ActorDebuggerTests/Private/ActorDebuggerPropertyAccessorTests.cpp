@@ -0,0 +1,77 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerPropertyAccessor.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* A compiled accessor must read the same values as the objects hold, refuse objects of other classes and values of
+* other types, be shared when compiled again, and read a batch of objects the same as one object at a time
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerPropertyAccessorTest, "ActorDebugger.PropertyAccessor", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerPropertyAccessorTest::RunTest(const FString& Parameters)
+{
+    TArray<FActorDebuggerBenchmarkFixture> Fixtures;
+    TArray<AActorDebuggerBenchmarkActor*> Actors;
+    for (int32 Index = 0; Index < 3; ++Index)
+    {
+        AActorDebuggerBenchmarkActor* Created = Fixtures.Emplace_GetRef(2, 1, 1, 4).Actor.Get();
+        Created->Health = Index * 10;
+        Created->Objects[1]->Vector = FVector(Index, 0.0, 0.0);
+        Actors.Add(Created);
+    }
+    AActorDebuggerBenchmarkActor* Actor = Actors[0];
+
+    auto Compile = [this](const TCHAR* Path)
+    {
+        FText Error;
+        FActorDebuggerPropertyAccessor Accessor = FActorDebuggerPropertyAccessor::Compile(AActorDebuggerBenchmarkActor::StaticClass(), Path, Error);
+        TestTrue(FString::Printf(TEXT("%s compiles: %s"), Path, *Error.ToString()), Accessor.IsValid());
+        return Accessor;
+    };
+
+    FActorDebuggerPropertyAccessor Health = Compile(TEXT("Health"));
+    FActorDebuggerPropertyAccessor Float = Compile(TEXT("Objects[0].Struct.Float"));
+    FActorDebuggerPropertyAccessor Vector = Compile(TEXT("Objects[1].Vector"));
+    FActorDebuggerPropertyAccessor Count = Compile(TEXT("Objects[0].IntArray"));
+    FActorDebuggerPropertyAccessor Name = Compile(TEXT("Objects[0].Name"));
+
+    double Number = 0.0;
+    TestTrue(TEXT("Integers are read"), Health.ReadNumber(Actor, Number) && Number == Actor->Health);
+    TestTrue(TEXT("Struct members are read through references"), Float.ReadNumber(Actor, Number) && Number == Actor->Objects[0]->Struct.Float);
+    TestTrue(TEXT("Containers are read as their element count"), Count.ReadNumber(Actor, Number) && Number == Actor->Objects[0]->IntArray.Num());
+
+    FVector VectorValue;
+    TestTrue(TEXT("Vectors are read"), Vector.ReadVector(Actor, VectorValue) && VectorValue == Actor->Objects[1]->Vector);
+    TestFalse(TEXT("Vectors aren't numbers"), Vector.ReadNumber(Actor, Number));
+
+    FString Text;
+    TestTrue(TEXT("Any value is read as text"), Name.ReadString(Actor, Text) && Text == Actor->Objects[0]->Name.ToString());
+
+    TestFalse(TEXT("Objects of other classes aren't read"), Health.ReadNumber(Actor->Objects[0], Number));
+    TestFalse(TEXT("Null objects aren't read"), Health.ReadNumber(nullptr, Number));
+
+    TestTrue(TEXT("Compiling again returns the same accessor"), Compile(TEXT("Health")).GetPath() == Health.GetPath());
+
+    FText Error;
+    TestFalse(TEXT("Unknown names don't compile"), FActorDebuggerPropertyAccessor::Compile(AActorDebuggerBenchmarkActor::StaticClass(), TEXT("Missing"), Error).IsValid());
+
+    // a batch reads the same values as single reads, unresolved entries are flagged
+    TArray<UObject*> Batch = { Actors[0], Actors[1], Actors[0]->Objects[0], Actors[2] };
+    TArray<double> Numbers;
+    TArray<bool> Resolved;
+    TestEqual(TEXT("Every actor resolves"), Health.ReadNumbers(Batch, Numbers, Resolved), 3);
+    TestTrue(TEXT("The batch has an entry per object"), Numbers.Num() == Batch.Num() && Resolved.Num() == Batch.Num());
+    TestTrue(TEXT("The batch reads every actor"), Numbers[0] == 0.0 && Numbers[1] == 10.0 && Numbers[3] == 20.0);
+    TestTrue(TEXT("Objects of other classes are flagged"), Resolved[2] == false && Numbers[2] == 0.0);
+
+    TArray<FVector> Vectors;
+    TestEqual(TEXT("Every actor's vector resolves"), Vector.ReadVectors(Batch, Vectors, Resolved), 3);
+    TestTrue(TEXT("The batch reads every vector"), Vectors[1] == Actors[1]->Objects[1]->Vector && Vectors[3] == Actors[2]->Objects[1]->Vector);
+
+    return true;
+}
+
+#endif
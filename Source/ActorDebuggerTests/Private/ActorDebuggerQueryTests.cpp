@@ -0,0 +1,97 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerQuery.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ActorDebuggerQueryTests
+{
+    /* Objects left behind by other tests may match as well, only this test's objects are counted */
+    static int32 CountMatches(const FActorDebuggerQuery& Query, const TArray<UActorDebuggerBenchmarkObject*>& Objects)
+    {
+        TSet<const UObject*> OwnObjects;
+        for (const UActorDebuggerBenchmarkObject* Object : Objects)
+        {
+            OwnObjects.Add(Object);
+        }
+
+        int32 NumMatches = 0;
+        for (const UObject* Match : Query.Run(nullptr).Matches)
+        {
+            NumMatches += OwnObjects.Contains(Match) ? 1 : 0;
+        }
+        return NumMatches;
+    }
+
+    template<typename TPredicate>
+    static int32 CountExpected(const TArray<UActorDebuggerBenchmarkObject*>& Objects, TPredicate Predicate)
+    {
+        return Objects.FilterByPredicate(Predicate).Num();
+    }
+}
+
+using namespace ActorDebuggerQueryTests;
+
+/*
+* The parallel scan has to find exactly the objects a plain loop over the same values finds, through struct members,
+* object references, array elements and element counts, and predicates that don't fit the class must not compile
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerQueryTest, "ActorDebugger.Query.Run", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerQueryTest::RunTest(const FString& Parameters)
+{
+    // enough objects for the scan to run in parallel
+    FActorDebuggerBenchmarkFixture Fixture(100, 2, 2, 4);
+    UClass* Class = UActorDebuggerBenchmarkObject::StaticClass();
+
+    FActorDebuggerQuery Query;
+    FText Error;
+
+    TestTrue(TEXT("A number predicate compiles"), Query.Compile(Class, { TEXT("Int32 > 500") }, Error));
+    TestEqual(TEXT("Number predicate"), CountMatches(Query, Fixture.Objects),
+        CountExpected(Fixture.Objects, [](const UActorDebuggerBenchmarkObject* Object) { return Object->Int32 > 500; }));
+
+    TestTrue(TEXT("Predicates over struct members compile"), Query.Compile(Class, { TEXT("Struct.Int32 <= 250"), TEXT("bBool == true") }, Error));
+    TestEqual(TEXT("Every predicate must hold"), CountMatches(Query, Fixture.Objects),
+        CountExpected(Fixture.Objects, [](const UActorDebuggerBenchmarkObject* Object) { return Object->Struct.Int32 <= 250 && Object->bBool; }));
+
+    TestTrue(TEXT("Object predicates compile"), Query.Compile(Class, { TEXT("Owner == None") }, Error));
+    TestEqual(TEXT("Only the roots have no owner"), CountMatches(Query, Fixture.Objects), Fixture.Settings.NumRootObjects);
+
+    TestTrue(TEXT("Paths through object references compile"), Query.Compile(Class, { TEXT("Owner.Int32 >= 500") }, Error));
+    TestEqual(TEXT("Paths through None don't match"), CountMatches(Query, Fixture.Objects),
+        CountExpected(Fixture.Objects, [](const UActorDebuggerBenchmarkObject* Object) { return Object->Owner && Object->Owner->Int32 >= 500; }));
+
+    TestTrue(TEXT("Paths through arrays of objects compile"), Query.Compile(Class, { TEXT("Children[1].Enum == Second") }, Error));
+    TestEqual(TEXT("Array elements and enums by name"), CountMatches(Query, Fixture.Objects),
+        CountExpected(Fixture.Objects, [](const UActorDebuggerBenchmarkObject* Object) { return Object->Children.Num() > 1 && Object->Children[1]->Enum == EActorDebuggerBenchmarkEnum::Second; }));
+
+    TestTrue(TEXT("Element count predicates compile"), Query.Compile(Class, { TEXT("IntArray == 4"), TEXT("StructArray[2].Int32 == 2") }, Error));
+    TestEqual(TEXT("Element counts and struct array elements"), CountMatches(Query, Fixture.Objects), Fixture.Objects.Num());
+
+    TestTrue(TEXT("Indices past the end of a TArray compile"), Query.Compile(Class, { TEXT("IntArray[4] >= 0") }, Error));
+    TestEqual(TEXT("Indices past the end don't match"), CountMatches(Query, Fixture.Objects), 0);
+
+    TestTrue(TEXT("An empty list of predicates compiles"), Query.Compile(Class, {}, Error));
+    TestEqual(TEXT("An empty list matches every object"), CountMatches(Query, Fixture.Objects), Fixture.Objects.Num());
+
+    TestFalse(TEXT("Unknown properties"), Query.Compile(Class, { TEXT("Armor > 1") }, Error));
+    TestFalse(TEXT("Unknown struct members"), Query.Compile(Class, { TEXT("Struct.Armor > 1") }, Error));
+    TestFalse(TEXT("Only arrays can be indexed"), Query.Compile(Class, { TEXT("Int32[0] > 1") }, Error));
+    TestFalse(TEXT("Numbers can't be stepped into"), Query.Compile(Class, { TEXT("Int32.Value > 1") }, Error));
+    TestFalse(TEXT("Predicates need an operator"), Query.Compile(Class, { TEXT("Int32") }, Error));
+    TestFalse(TEXT("Operands must parse as the property's type"), Query.Compile(Class, { TEXT("Int32 > many") }, Error));
+    TestFalse(TEXT("Names can't be ordered"), Query.Compile(Class, { TEXT("Name < Foo") }, Error));
+
+    TestTrue(TEXT("Queries compile from text, classes with their prefix"), Query.Compile(TEXT("UActorDebuggerBenchmarkObject Int32 > 500 && Owner != None"), Error));
+    TestTrue(TEXT("The class is found"), Query.GetClass() == Class);
+    TestEqual(TEXT("The query prints as it would be typed"), Query.ToString(), FString(TEXT("ActorDebuggerBenchmarkObject Int32 > 500 && Owner != None")));
+    TestEqual(TEXT("Query from text"), CountMatches(Query, Fixture.Objects),
+        CountExpected(Fixture.Objects, [](const UActorDebuggerBenchmarkObject* Object) { return Object->Int32 > 500 && Object->Owner; }));
+    TestFalse(TEXT("Unknown classes"), Query.Compile(TEXT("NoSuchClass Int32 > 1"), Error));
+
+    return true;
+}
+
+#endif
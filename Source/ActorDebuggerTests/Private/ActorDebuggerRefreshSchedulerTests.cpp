@@ -0,0 +1,73 @@
+#include "Misc/AutomationTest.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerRefreshScheduler.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+* Several debuggers share one scheduler. Each client's rows must be sampled by that client, and a client
+* inspecting another object or going away must not disturb the rows of the others
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerRefreshSchedulerClientsTest, "ActorDebugger.RefreshScheduler.Clients", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerRefreshSchedulerClientsTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(2, 1, 1, 2);
+
+    FActorDebuggerInspection InspectionA;
+    FActorDebuggerInspection InspectionB;
+    InspectionA.SetObject(Fixture.Objects[0]);
+    InspectionB.SetObject(Fixture.Objects[1]);
+
+    // a generous budget so that every due row is sampled in one tick
+    IConsoleVariable* Budget = IConsoleManager::Get().FindConsoleVariable(TEXT("ActorDebugger.RefreshBudgetUs"));
+    const float PreviousBudget = Budget->GetFloat();
+    Budget->Set(1000000.0f, ECVF_SetByCode);
+
+    TSet<FReflectedActorPropertyPtr> SampledByA;
+    TSet<FReflectedActorPropertyPtr> SampledByB;
+
+    FActorDebuggerRefreshScheduler Scheduler;
+    const int32 ClientA = Scheduler.AddClient(30.0f, FActorDebuggerRefreshScheduler::FSampleItem::CreateLambda(
+        [&SampledByA](const FReflectedActorPropertyPtr& Item) { SampledByA.Add(Item); return false; }));
+    const int32 ClientB = Scheduler.AddClient(30.0f, FActorDebuggerRefreshScheduler::FSampleItem::CreateLambda(
+        [&SampledByB](const FReflectedActorPropertyPtr& Item) { SampledByB.Add(Item); return false; }));
+
+    for (FReflectedActorPropertyPtr Item : InspectionA.GetRootItems())
+    {
+        Scheduler.AddItem(ClientA, Item);
+    }
+    for (FReflectedActorPropertyPtr Item : InspectionB.GetRootItems())
+    {
+        Scheduler.AddItem(ClientB, Item);
+    }
+
+    Scheduler.Tick(1.0);
+    TestEqual(TEXT("Every row of A is sampled by A"), SampledByA.Num(), InspectionA.GetRootItems().Num());
+    TestEqual(TEXT("Every row of B is sampled by B"), SampledByB.Num(), InspectionB.GetRootItems().Num());
+    TestTrue(TEXT("A only samples its own rows"), SampledByA.Intersect(TSet<FReflectedActorPropertyPtr>(InspectionB.GetRootItems())).Num() == 0);
+
+    SampledByA.Reset();
+    SampledByB.Reset();
+    Scheduler.ResetClient(ClientA);
+    Scheduler.Tick(10.0);
+    TestEqual(TEXT("A has no rows after it is reset"), SampledByA.Num(), 0);
+    TestEqual(TEXT("B keeps its rows when A is reset"), SampledByB.Num(), InspectionB.GetRootItems().Num());
+
+    SampledByB.Reset();
+    Scheduler.RemoveClient(ClientB);
+    Scheduler.Tick(20.0);
+    TestEqual(TEXT("A removed client's rows go with it"), SampledByB.Num(), 0);
+    TestEqual(TEXT("One client is left"), Scheduler.GetNumClients(), 1);
+
+    Budget->Set(PreviousBudget, ECVF_SetByCode);
+
+    TSharedRef<FActorDebuggerRefreshScheduler> Shared = FActorDebuggerRefreshScheduler::GetShared();
+    TestTrue(TEXT("The shared scheduler is shared while it is held"), &FActorDebuggerRefreshScheduler::GetShared().Get() == &Shared.Get());
+
+    return true;
+}
+
+#endif
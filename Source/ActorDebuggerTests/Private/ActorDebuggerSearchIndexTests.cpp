@@ -0,0 +1,101 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerSearchIndex.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ActorDebuggerSearchIndexTests
+{
+    /* Ticks the index until it has gathered and indexed the whole tree */
+    static void TickUntilComplete(FActorDebuggerSearchIndex& SearchIndex, FActorDebuggerInspection& Inspection)
+    {
+        for (int32 Tick = 0; Tick < 10000; ++Tick)
+        {
+            const bool bChanged = SearchIndex.Tick(Inspection);
+            if (bChanged == false && SearchIndex.IsComplete(Inspection))
+            {
+                break;
+            }
+        }
+    }
+
+    static bool ContainsNamed(const TArray<FReflectedActorPropertyPtr>& Matches, const UObject* Object, const TCHAR* Name)
+    {
+        return Matches.ContainsByPredicate([Object, Name](FReflectedActorPropertyPtr Match)
+        {
+            return Match->Object == Object && Match->GetDisplayName().ToString() == Name;
+        });
+    }
+
+    static bool HasAncestorContaining(FReflectedActorPropertyPtr Item, const TCHAR* Name)
+    {
+        for (FReflectedActorPropertyPtr Ancestor = Item->Parent; Ancestor; Ancestor = Ancestor->Parent)
+        {
+            if (Ancestor->GetDisplayName().ToString().Contains(Name))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+using namespace ActorDebuggerSearchIndexTests;
+
+/*
+* The index has to find properties that were never expanded, follow values as they change and match paths
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerSearchIndexTest, "ActorDebugger.SearchIndex.Search", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerSearchIndexTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(3, 2, 2, 4);
+    UActorDebuggerBenchmarkObject* Deepest = Fixture.Objects.Last();
+    Deepest->String = TEXT("Needle");
+
+    FActorDebuggerInspection Inspection;
+    Inspection.SetObject(Fixture.Actor.Get());
+
+    FActorDebuggerSearchIndex SearchIndex;
+    TickUntilComplete(SearchIndex, Inspection);
+
+    TestTrue(TEXT("The index gathered the tree"), Inspection.GetNumNodes() > Inspection.GetRootItems().Num());
+    TestEqual(TEXT("Every node is indexed"), SearchIndex.GetNumEntries(), Inspection.GetNumNodes());
+
+    TArray<FReflectedActorPropertyPtr> Matches;
+    SearchIndex.Search(TEXT("NEEDLE"), Matches);
+    TestTrue(TEXT("Values are found regardless of case"), ContainsNamed(Matches, Deepest, TEXT("String")));
+
+    SearchIndex.Search(TEXT("Int32"), Matches);
+    TestTrue(TEXT("Names are found on every level"), ContainsNamed(Matches, Fixture.Objects[0], TEXT("Int32")) && ContainsNamed(Matches, Deepest, TEXT("Int32")));
+
+    SearchIndex.Search(TEXT("Struct.Int32"), Matches);
+    TestTrue(TEXT("Paths match members of the named ancestor"), Matches.Num() > 0);
+    TestTrue(TEXT("Paths only match below the named ancestor"), Matches.ContainsByPredicate([](FReflectedActorPropertyPtr Match)
+    {
+        return HasAncestorContaining(Match, TEXT("Struct")) == false;
+    }) == false);
+
+    SearchIndex.Search(TEXT("NoSuchProperty"), Matches);
+    TestEqual(TEXT("Nothing matches an unknown term"), Matches.Num(), 0);
+
+    // the value refresh picks up the change without anything in view
+    Deepest->String = TEXT("Haystack");
+    TickUntilComplete(SearchIndex, Inspection);
+
+    SearchIndex.Search(TEXT("needle"), Matches);
+    TestFalse(TEXT("The old value no longer matches"), ContainsNamed(Matches, Deepest, TEXT("String")));
+
+    SearchIndex.Search(TEXT("haystack"), Matches);
+    TestTrue(TEXT("The new value matches"), ContainsNamed(Matches, Deepest, TEXT("String")));
+
+    // a new inspection starts over
+    Inspection.SetObject(Fixture.Objects[0]);
+    SearchIndex.Tick(Inspection);
+    TestTrue(TEXT("The index follows the inspection's generation"), SearchIndex.GetNumEntries() <= Inspection.GetNumNodes());
+
+    return true;
+}
+
+#endif
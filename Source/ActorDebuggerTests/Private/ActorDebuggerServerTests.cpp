@@ -0,0 +1,137 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerServer.h"
+#include "ActorDebuggerRemote.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ActorDebuggerServerTests
+{
+    /* Ticks the server and the viewer the way their tickers would until the condition holds or time runs out */
+    static bool PumpUntil(TFunctionRef<bool()> Condition)
+    {
+        const double EndTime = FPlatformTime::Seconds() + 5.0;
+        while (FPlatformTime::Seconds() < EndTime)
+        {
+            FActorDebuggerServer::Get().Tick();
+            FActorDebuggerRemote::Get().Tick();
+            if (Condition())
+            {
+                return true;
+            }
+            FPlatformProcess::Sleep(0.005f);
+        }
+        return false;
+    }
+}
+
+using namespace ActorDebuggerServerTests;
+
+/*
+* Messages split anywhere must only be read once all of their bytes have arrived, and a size no message can have
+* must be reported as an error rather than waited for
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerServerMessageTest, "ActorDebugger.Server.Messages", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerServerMessageTest::RunTest(const FString& Parameters)
+{
+    using namespace ActorDebuggerServer;
+
+    TArray<uint8> Stream;
+    const int32 Start = BeginMessage(Stream, EMessage::SetUpdateRate);
+    float UpdateRate = 10.0f;
+    Stream.Append(reinterpret_cast<const uint8*>(&UpdateRate), sizeof(UpdateRate));
+    EndMessage(Stream, Start);
+
+    for (int32 Available = 0; Available < Stream.Num(); ++Available)
+    {
+        int32 Offset = 0;
+        EMessage Type;
+        FMemoryView Payload;
+        bool bError = false;
+        TestFalse(FString::Printf(TEXT("%d bytes aren't a message"), Available), ReadMessage(MakeMemoryView(Stream.GetData(), Available), Offset, Type, Payload, bError));
+        TestFalse(TEXT("A partial message isn't an error"), bError);
+    }
+
+    int32 Offset = 0;
+    EMessage Type = EMessage::Hello;
+    FMemoryView Payload;
+    bool bError = false;
+    if (TestTrue(TEXT("The whole message is read"), ReadMessage(MakeMemoryView(Stream), Offset, Type, Payload, bError)))
+    {
+        TestTrue(TEXT("The type is read"), Type == EMessage::SetUpdateRate);
+        TestEqual(TEXT("The payload is read"), static_cast<int32>(Payload.GetSize()), static_cast<int32>(sizeof(UpdateRate)));
+        TestEqual(TEXT("The offset moves past the message"), Offset, Stream.Num());
+    }
+
+    const uint32 BrokenSize = MaxMessageSize + 1;
+    FMemory::Memcpy(Stream.GetData(), &BrokenSize, sizeof(BrokenSize));
+    Offset = 0;
+    TestFalse(TEXT("An oversized message isn't read"), ReadMessage(MakeMemoryView(Stream), Offset, Type, Payload, bError));
+    TestTrue(TEXT("An oversized message is an error"), bError);
+
+    return true;
+}
+
+/*
+* A viewer in the same process subscribes to an actor over the loopback address. Its replay actor must receive the
+* actor's values and its subobjects, then only what changes, and unsubscribing must stop serving the objects
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerServerRoundTripTest, "ActorDebugger.Server.RoundTrip", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerServerRoundTripTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(2, 1, 1, 4);
+    Fixture.Actor->Health = 42;
+    Fixture.Objects[0]->String = TEXT("Served");
+
+    FActorDebuggerServer& Server = FActorDebuggerServer::Get();
+    FActorDebuggerRemote& Remote = FActorDebuggerRemote::Get();
+
+    // any free port, the default one may be taken by another process
+    if (TestTrue(TEXT("The server listens"), Server.Open(0)) == false)
+    {
+        return false;
+    }
+
+    AActorDebuggerBenchmarkActor* ReplayActor = nullptr;
+    const FDelegateHandle SubscribedHandle = Remote.OnSubscribed.AddLambda([&ReplayActor](int32 Request, UObject* ReplayObject)
+    {
+        ReplayActor = Cast<AActorDebuggerBenchmarkActor>(ReplayObject);
+    });
+
+    if (TestTrue(TEXT("The viewer connects"), Remote.Connect(Server.GetPort())))
+    {
+        const int32 Request = Remote.Subscribe(Fixture.Actor->GetPathName());
+        Remote.SetUpdateRate(0.0f);
+
+        TestTrue(TEXT("The subscription is answered"), PumpUntil([&ReplayActor] { return ReplayActor != nullptr; }));
+        TestTrue(TEXT("The actor's subobjects are served"), Server.GetNumObjects() > 1);
+
+        if (ReplayActor)
+        {
+            TestTrue(TEXT("The values arrive"), PumpUntil([&] { return ReplayActor->Health == Fixture.Actor->Health; }));
+            TestTrue(TEXT("References point at replay objects"), ReplayActor->Objects.Num() > 0 && ReplayActor->Objects[0] && ReplayActor->Objects[0] != Fixture.Objects[0]);
+            if (ReplayActor->Objects.Num() > 0 && ReplayActor->Objects[0])
+            {
+                TestEqual(TEXT("Subobject values arrive"), ReplayActor->Objects[0]->String, Fixture.Objects[0]->String);
+            }
+
+            const uint64 FrameBefore = Remote.GetLastFrame();
+            Fixture.Actor->Health = 7;
+            TestTrue(TEXT("Changes arrive"), PumpUntil([&] { return ReplayActor->Health == 7; }));
+            TestTrue(TEXT("Changes come in a later frame"), Remote.GetLastFrame() > FrameBefore);
+        }
+
+        Remote.Unsubscribe(Request);
+        TestTrue(TEXT("Unsubscribed objects aren't served"), PumpUntil([&Server] { return Server.GetNumObjects() == 0; }));
+    }
+
+    Remote.OnSubscribed.Remove(SubscribedHandle);
+    Remote.Disconnect();
+    Server.Close();
+
+    return true;
+}
+
+#endif
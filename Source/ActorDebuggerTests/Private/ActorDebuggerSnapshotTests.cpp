@@ -0,0 +1,120 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerSnapshot.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ActorDebuggerSnapshotTests
+{
+    static FReflectedActorPropertyPtr FindChild(FActorDebuggerInspection& Inspection, FReflectedActorPropertyPtr Parent, const TCHAR* Name)
+    {
+        TArray<FReflectedActorPropertyPtr> Children;
+        if (Parent)
+        {
+            Inspection.GetChildren(Parent, Children);
+        }
+        else
+        {
+            Children = Inspection.GetRootItems();
+        }
+
+        for (FReflectedActorPropertyPtr Child : Children)
+        {
+            if (Child->GetDisplayName().ToString() == Name)
+            {
+                return Child;
+            }
+        }
+        return nullptr;
+    }
+}
+
+using namespace ActorDebuggerSnapshotTests;
+
+/*
+* A diff has to find exactly the values that changed while comparing far fewer nodes than the snapshots hold, and
+* a second snapshot has to share the nodes that didn't change with the first
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerSnapshotDiffTest, "ActorDebugger.Snapshot.Diff", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerSnapshotDiffTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(4, 2, 3, 16);
+
+    FActorDebuggerSnapshots& Snapshots = FActorDebuggerSnapshots::Get();
+    Snapshots.Reset();
+
+    FActorDebuggerSnapshotPtr Before = Snapshots.Take(Fixture.Actor.Get(), TEXT("Before"));
+    if (TestNotNull(TEXT("The snapshot is taken"), Before.Get()) == false)
+    {
+        return false;
+    }
+    const int32 NumNodesBefore = Snapshots.GetNumUniqueNodes();
+
+    Fixture.Actor->Objects[1]->Int32 += 1;
+    Fixture.Actor->Objects[2]->Struct.Float += 1.0f;
+
+    FActorDebuggerSnapshotPtr After = Snapshots.Take(Fixture.Actor.Get(), TEXT("After"));
+
+    FActorDebuggerSnapshotDiff Diff;
+    FActorDebuggerSnapshots::Diff(*Before, *After, Diff);
+
+    TestEqual(TEXT("Only the changed values differ"), Diff.Entries.Num(), 2);
+    TestTrue(TEXT("The changed value is found by path"), Diff.Find(TEXT("Objects[1].Int32")) == EActorDebuggerDiffKind::Changed);
+    TestTrue(TEXT("Changed struct members are found by path"), Diff.Find(TEXT("Objects[2].Struct.Float")) == EActorDebuggerDiffKind::Changed);
+    TestTrue(TEXT("Ancestors of a change contain changes"), Diff.Find(TEXT("Objects[1]")) == EActorDebuggerDiffKind::ContainsChanges);
+    TestTrue(TEXT("Unchanged values don't differ"), Diff.Find(TEXT("Objects[0]")) == EActorDebuggerDiffKind::None);
+    TestTrue(FString::Printf(TEXT("The diff compared %d of %d nodes"), Diff.NumCompared, After->NumNodes), Diff.NumCompared * 10 < After->NumNodes);
+
+    // only the changed values and their ancestors are new
+    const int32 NumNewNodes = Snapshots.GetNumUniqueNodes() - NumNodesBefore;
+    TestTrue(FString::Printf(TEXT("The second snapshot added %d nodes"), NumNewNodes), NumNewNodes * 10 < After->NumNodes);
+
+    // rows of the tree have the same paths as the nodes of a snapshot
+    FActorDebuggerInspection Inspection;
+    Inspection.SetObject(Fixture.Actor.Get());
+    FReflectedActorPropertyPtr Item = FindChild(Inspection, FindChild(Inspection, FindChild(Inspection, nullptr, TEXT("Objects")), TEXT("[1]")), TEXT("Int32"));
+    if (TestNotNull(TEXT("The row is found"), Item))
+    {
+        TestEqual(TEXT("Rows are matched to the diff by path"), FActorDebuggerSnapshots::GetItemPath(Item), FString(TEXT("Objects[1].Int32")));
+    }
+
+    // elements added to a container are reported as added
+    Fixture.Actor->Objects[0]->IntArray.Add(7);
+    FActorDebuggerSnapshotPtr Grown = Snapshots.Capture(Fixture.Actor.Get());
+    FActorDebuggerSnapshots::Diff(*After, *Grown, Diff);
+    TestTrue(TEXT("Added elements are found by path"), Diff.Find(FString::Printf(TEXT("Objects[0].IntArray[%d]"), Fixture.Actor->Objects[0]->IntArray.Num() - 1)) == EActorDebuggerDiffKind::Added);
+    TestTrue(TEXT("The element count changed"), Diff.Find(TEXT("Objects[0].IntArray")) == EActorDebuggerDiffKind::Changed);
+
+    Snapshots.Reset();
+    return true;
+}
+
+/*
+* Objects built the same way have equal snapshots however their references are laid out, so two objects of the
+* same class can be compared
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerSnapshotObjectsTest, "ActorDebugger.Snapshot.Objects", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerSnapshotObjectsTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture First(1, 2, 2, 4);
+    FActorDebuggerBenchmarkFixture Second(1, 2, 2, 4);
+
+    FActorDebuggerSnapshots& Snapshots = FActorDebuggerSnapshots::Get();
+    UActorDebuggerBenchmarkObject* FirstRoot = First.Actor->Objects[0];
+    UActorDebuggerBenchmarkObject* SecondRoot = Second.Actor->Objects[0];
+
+    FActorDebuggerSnapshotDiff Diff;
+    FActorDebuggerSnapshots::Diff(*Snapshots.Capture(FirstRoot), *Snapshots.Capture(SecondRoot), Diff);
+    TestEqual(TEXT("Objects built from the same seed don't differ"), Diff.Entries.Num(), 0);
+
+    SecondRoot->Children[0]->Name = TEXT("Different");
+    FActorDebuggerSnapshots::Diff(*Snapshots.Capture(FirstRoot), *Snapshots.Capture(SecondRoot), Diff);
+    TestEqual(TEXT("One value differs"), Diff.Entries.Num(), 1);
+    TestTrue(TEXT("The value is found by path"), Diff.Find(TEXT("Children[0].Name")) == EActorDebuggerDiffKind::Changed);
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "Misc/AutomationTest.h"
+#include "UObject/StrongObjectPtr.h"
+#include "ActorDebuggerWatchpoints.h"
+#include "ActorDebuggerBenchmark.h"
+#include "ActorDebuggerBenchmarkTypes.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace ActorDebuggerWatchpointsTests
+{
+    static FReflectedActorPropertyPtr FindRootItem(const FActorDebuggerInspection& Inspection, const TCHAR* Name)
+    {
+        for (FReflectedActorPropertyPtr Item : Inspection.GetRootItems())
+        {
+            if (Item->GetDisplayName().ToString() == Name)
+            {
+                return Item;
+            }
+        }
+        return nullptr;
+    }
+}
+
+using namespace ActorDebuggerWatchpointsTests;
+
+/*
+* Conditions have to trigger once when they become true, reject operands that don't fit the property's type, and
+* "on change" has to see changes to plain old data and to values that are compared by hash
+*/
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorDebuggerWatchpointsTest, "ActorDebugger.Watchpoints.Evaluate", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+bool FActorDebuggerWatchpointsTest::RunTest(const FString& Parameters)
+{
+    FActorDebuggerBenchmarkFixture Fixture(1, 1, 1, 4);
+    UActorDebuggerBenchmarkObject* Object = Fixture.Objects[0];
+
+    FActorDebuggerInspection Inspection;
+    FActorDebuggerWatchpoints Watchpoints;
+    FText Error;
+
+    Inspection.SetObject(Fixture.Actor.Get());
+    FReflectedActorPropertyPtr Health = FindRootItem(Inspection, TEXT("Health"));
+    if (TestNotNull(TEXT("Health row"), Health) == false)
+    {
+        return false;
+    }
+
+    Fixture.Actor->Health = 100;
+    TestTrue(TEXT("A condition naming its row compiles"), Watchpoints.Add(Health, TEXT("Health < 10"), EActorDebuggerWatchAction::None, Error));
+    TestTrue(TEXT("The row is marked as watched"), Health->bWatched);
+    TestEqual(TEXT("Nothing triggers while the condition is false"), Watchpoints.Evaluate(), 0);
+
+    Fixture.Actor->Health = 5;
+    TestEqual(TEXT("The condition triggers when it becomes true"), Watchpoints.Evaluate(), 1);
+    TestEqual(TEXT("The condition doesn't trigger again while it stays true"), Watchpoints.Evaluate(), 0);
+
+    Fixture.Actor->Health = 50;
+    Watchpoints.Evaluate();
+    Fixture.Actor->Health = 10;
+    TestEqual(TEXT("The operator is applied exactly"), Watchpoints.Evaluate(), 0);
+    Fixture.Actor->Health = 9;
+    TestEqual(TEXT("The condition triggers each time it becomes true"), Watchpoints.Evaluate(), 1);
+
+    TestFalse(TEXT("Operands must parse as the property's type"), Watchpoints.Add(Health, TEXT("Health < ten"), EActorDebuggerWatchAction::None, Error));
+    TestFalse(TEXT("Ints aren't compared with bools"), Watchpoints.Add(Health, TEXT("== true"), EActorDebuggerWatchAction::None, Error));
+    TestFalse(TEXT("The name must be the row's"), Watchpoints.Add(Health, TEXT("Armor < 10"), EActorDebuggerWatchAction::None, Error));
+    TestEqual(TEXT("A rejected condition keeps the previous watchpoint"), Watchpoints.Num(), 1);
+
+    // the nodes are reused by the next inspection, the watchpoints must go first
+    Watchpoints.Reset();
+    TestFalse(TEXT("Reset unmarks the row"), Health->bWatched);
+    Inspection.SetObject(Object);
+
+    Object->bBool = false;
+    Object->Enum = EActorDebuggerBenchmarkEnum::First;
+    Object->String = TEXT("Haystack");
+    Object->Owner = nullptr;
+
+    TestTrue(TEXT("Bool condition"), Watchpoints.Add(FindRootItem(Inspection, TEXT("bBool")), TEXT("bBool == true"), EActorDebuggerWatchAction::None, Error));
+    TestTrue(TEXT("Enum condition by name"), Watchpoints.Add(FindRootItem(Inspection, TEXT("Enum")), TEXT("== Second"), EActorDebuggerWatchAction::None, Error));
+    TestTrue(TEXT("String condition"), Watchpoints.Add(FindRootItem(Inspection, TEXT("String")), TEXT("== \"Needle\""), EActorDebuggerWatchAction::None, Error));
+    TestTrue(TEXT("Object condition"), Watchpoints.Add(FindRootItem(Inspection, TEXT("Owner")), TEXT("!= None"), EActorDebuggerWatchAction::None, Error));
+    TestTrue(TEXT("Element count condition"), Watchpoints.Add(FindRootItem(Inspection, TEXT("IntArray")), FString::Printf(TEXT("> %d"), Object->IntArray.Num()), EActorDebuggerWatchAction::None, Error));
+    TestFalse(TEXT("Names can't be ordered"), Watchpoints.Add(FindRootItem(Inspection, TEXT("Name")), TEXT("< Foo"), EActorDebuggerWatchAction::None, Error));
+    TestEqual(TEXT("Nothing triggers before the values change"), Watchpoints.Evaluate(), 0);
+
+    Object->bBool = true;
+    Object->Enum = EActorDebuggerBenchmarkEnum::Second;
+    Object->String = TEXT("Needle");
+    Object->Owner = Object;
+    Object->IntArray.Add(1);
+    TestEqual(TEXT("Every condition triggers"), Watchpoints.Evaluate(), 5);
+
+    Watchpoints.Reset();
+
+    TestTrue(TEXT("Plain old data on change"), Watchpoints.Add(FindRootItem(Inspection, TEXT("Float")), FString(), EActorDebuggerWatchAction::None, Error));
+    TestTrue(TEXT("Struct on change"), Watchpoints.Add(FindRootItem(Inspection, TEXT("Struct")), TEXT("changed"), EActorDebuggerWatchAction::None, Error));
+    TestEqual(TEXT("Nothing triggers before the values change"), Watchpoints.Evaluate(), 0);
+
+    Object->Float += 1.0f;
+    Object->Struct.String += TEXT("!");
+    TestEqual(TEXT("Both changes are seen"), Watchpoints.Evaluate(), 2);
+    TestEqual(TEXT("Changes are only reported once"), Watchpoints.Evaluate(), 0);
+
+    Watchpoints.Reset();
+    return true;
+}
+
+#endif